@@ -145,6 +145,7 @@ class ConvDriver : public Driver
     int FindForward(int& ret_algo_count,
                     int request_algo_count,
                     std::vector<miopenConvAlgoPerf_t>& perf_results);
+    int ResolveSolvers();
     int RunForwardGPU();
     int RunForwardCPU();
 
@@ -257,6 +258,9 @@ int ConvDriver<Tgpu, Tref>::ParseCmdLineArgs(int argc, char* argv[])
         miopenEnableProfiling(GetHandle(), true);
     }
 
+    if(inflags.GetValueInt("cpu_reference") == 1)
+        selected_cpu_conv_engine() = cpu_conv_engine::reference;
+
     forward_allowed = (inflags.GetValueInt("forw") == 0 || inflags.GetValueInt("forw") & 1);
     bwd_allowed     = (inflags.GetValueInt("forw") == 0 || inflags.GetValueInt("forw") & 2);
     wrw_allowed     = (inflags.GetValueInt("forw") == 0 || inflags.GetValueInt("forw") & 4);
@@ -382,6 +386,12 @@ int ConvDriver<Tgpu, Tref>::AddCmdLineArgs()
                          "",
                          "dy data filename for backward weight computation (Default=)",
                          "string");
+    inflags.AddInputFlag("cpu_reference",
+                         'R',
+                         "0",
+                         "Verify against the element-wise CPU convolution instead of the "
+                         "im2col/GEMM one (Default=0)",
+                         "int");
 
     return 0;
 }
@@ -929,6 +939,19 @@ int ConvDriver<Tgpu, Tref>::FindForward(int& ret_algo_count,
         (inflags.GetValueInt("search") == 1) ? true : false);
 }
 
+template <typename Tgpu, typename Tref>
+int ConvDriver<Tgpu, Tref>::ResolveSolvers()
+{
+    if(!forward_allowed)
+        return 0;
+
+    int ret_algo_count;
+    int request_algo_count = 1;
+    std::vector<miopenConvAlgoPerf_t> perf_results(request_algo_count);
+
+    return FindForward(ret_algo_count, request_algo_count, perf_results);
+}
+
 template <typename Tgpu, typename Tref>
 int ConvDriver<Tgpu, Tref>::RunForwardGPU()
 {
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2017 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Merges perf-db or find-db files tuned on several machines into one database.
+//
+//   MIOpenDbMerge [--find] [--validate] -o <output> <input>...
+//
+// The kind of database is taken from the output name (*.fdb.txt is a find-db) unless --find or
+// --perf is given. --validate drops perf-db entries that are not valid on the device of this
+// machine, so it shall run on a machine with the same device the inputs were tuned on.
+
+#include <miopen/db_merge.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/make_unique.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+int Usage()
+{
+    std::cerr << "Usage: MIOpenDbMerge [--find|--perf] [--validate] -o <output> <input>..."
+              << std::endl;
+    return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string output;
+    std::vector<std::string> inputs;
+    bool validate  = false;
+    int find_given = -1;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "-o" && i + 1 < argc)
+            output = argv[++i];
+        else if(arg == "--find")
+            find_given = 1;
+        else if(arg == "--perf")
+            find_given = 0;
+        else if(arg == "--validate")
+            validate = true;
+        else if(!arg.empty() && arg[0] == '-')
+            return Usage();
+        else
+            inputs.push_back(arg);
+    }
+    if(output.empty() || inputs.empty())
+        return Usage();
+
+    const bool is_find =
+        find_given == -1 ? miopen::EndsWith(output, ".fdb.txt") : find_given == 1;
+    if(validate && is_find)
+    {
+        std::cerr << "--validate applies to perf-db files only" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<miopen::Handle> handle;
+    miopen::DbEntryValidator validator;
+    if(validate)
+    {
+        handle    = miopen::make_unique<miopen::Handle>();
+        validator = miopen::MakePerfDbValidator(*handle);
+    }
+
+    miopen::DbMerger merger{is_find ? miopen::DbKind::Find : miopen::DbKind::Perf, validator};
+    for(const auto& input : inputs)
+    {
+        if(!merger.AddFile(input))
+        {
+            std::cerr << "Cannot read " << input << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if(!merger.WriteFile(output))
+    {
+        std::cerr << "Cannot write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << output << ": " << merger.GetStats() << std::endl;
+    return EXIT_SUCCESS;
+}
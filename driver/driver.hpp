@@ -133,7 +133,7 @@ void PadBufferSize(size_t& sz, int datatype_sz)
     printf("Usage: ./driver *base_arg* *other_args*\n");
     printf(
         "Supported Base Arguments: conv[fp16], CBAInfer[fp16], pool[fp16], lrn[fp16], activ[fp16], "
-        "softmax[fp16], bnorm[fp16], rnn, gemm\n");
+        "softmax[fp16], bnorm[fp16], rnn, gemm, net\n");
     exit(0);
 }
 
@@ -151,7 +151,7 @@ std::string ParseBaseArg(int argc, char* argv[])
        arg != "CBAInferfp16" && arg != "pool" && arg != "poolfp16" && arg != "lrn" &&
        arg != "lrnfp16" && arg != "activ" && arg != "activfp16" && arg != "softmax" &&
        arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" && arg != "rnn" &&
-       arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/)
+       arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/ && arg != "net")
 
     {
         printf("Invalid Base Input Argument\n");
@@ -169,15 +169,38 @@ class Driver
     Driver()
     {
         data_type = miopenFloat;
+        if(SharedHandle() != nullptr)
+        {
+            handle      = SharedHandle();
+            owns_handle = false;
+        }
+        else
+        {
+            handle = CreateHandle();
+        }
+
+        miopenGetStream(handle, &q);
+    }
+
+    static miopenHandle_t CreateHandle()
+    {
+        miopenHandle_t h;
 #if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
+        miopenCreate(&h);
 #elif MIOPEN_BACKEND_HIP
         hipStream_t s;
         hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
+        miopenCreateWithStream(&h, s);
 #endif
+        return h;
+    }
 
-        miopenGetStream(handle, &q);
+    // When set, drivers constructed afterwards run on this handle instead of creating their own,
+    // so that several layers share one stream and one kernel cache.
+    static miopenHandle_t& SharedHandle()
+    {
+        static miopenHandle_t shared = nullptr;
+        return shared;
     }
 
     miopenHandle_t GetHandle() { return handle; }
@@ -188,7 +211,11 @@ class Driver
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(owns_handle)
+            miopenDestroy(handle);
+    }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs() = 0;
@@ -201,8 +228,12 @@ class Driver
     virtual int RunBackwardGPU()         = 0;
     virtual int VerifyBackward()         = 0;
 
+    // Runs only the algorithm search of the forward pass. Primitives without a search do nothing.
+    virtual int ResolveSolvers() { return 0; }
+
     protected:
     miopenHandle_t handle;
+    bool owns_handle = true;
     miopenDataType_t data_type;
 
 #if MIOPEN_BACKEND_OPENCL
@@ -212,6 +243,32 @@ class Driver
 #endif
 };
 
+// Runs the forward and/or backward passes selected by the forw flag, verifying them if requested.
+inline void RunDriverPasses(Driver& drv, const std::string& base_arg)
+{
+    int fargval = ((base_arg != "CBAInfer") && (base_arg != "CBAInferfp16"))
+                      ? drv.GetInputFlags().GetValueInt("forw")
+                      : 1;
+    bool bnFwdInVer = (fargval == 2 && (base_arg == "bnorm"));
+    bool verifyarg  = (drv.GetInputFlags().GetValueInt("verify") == 1);
+
+    if(fargval & 1 || fargval == 0 || bnFwdInVer)
+    {
+        drv.RunForwardGPU();
+        if(verifyarg)
+            drv.VerifyForward();
+    }
+
+    if(fargval != 1)
+    {
+        drv.RunBackwardGPU();
+        if(verifyarg)
+        {
+            drv.VerifyBackward();
+        }
+    }
+}
+
 template <typename T>
 std::ostream& operator<<(std::ostream& os, const std::vector<T>& vs)
 {
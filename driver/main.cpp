@@ -33,102 +33,113 @@
 #include "driver.hpp"
 #include "gemm_driver.hpp"
 #include "lrn_driver.hpp"
+#include "net_driver.hpp"
 #include "pool_driver.hpp"
 #include "softmax_driver.hpp"
 #include "rnn_driver.hpp"
 #include "miopen/config.h"
 
-int main(int argc, char* argv[])
+// Returns nullptr for an unknown base_arg.
+Driver* MakeDriver(const std::string& base_arg)
 {
-    // show command
-    std::cout << "MIOpenDriver:";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    Driver* drv;
     if(base_arg == "conv")
     {
-        drv = new ConvDriver<float, float>();
+        return new ConvDriver<float, float>();
     }
-    else if(base_arg == "convfp16")
+    if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, float>();
+        return new ConvDriver<float16, float>();
     }
-    else if(base_arg == "convint8")
+    if(base_arg == "convint8")
     {
-        drv = new ConvDriver<int8_t, float>();
+        return new ConvDriver<int8_t, float>();
     }
-    else if(base_arg == "CBAInfer")
+    if(base_arg == "CBAInfer")
     {
-        drv = new CBAInferFusionDriver<float, double>();
+        return new CBAInferFusionDriver<float, double>();
     }
-    else if(base_arg == "CBAInferfp16")
+    if(base_arg == "CBAInferfp16")
     {
-        drv = new CBAInferFusionDriver<float16, double>();
+        return new CBAInferFusionDriver<float16, double>();
     }
-    else if(base_arg == "pool")
+    if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
-    else if(base_arg == "poolfp16")
+    if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
-    else if(base_arg == "lrn")
+    if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
-    else if(base_arg == "lrnfp16")
+    if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
-    else if(base_arg == "activ")
+    if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
-    else if(base_arg == "activfp16")
+    if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
-    else if(base_arg == "softmax")
+    if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
-    else if(base_arg == "softmaxfp16")
+    if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
 #if MIOPEN_USE_GEMM
-    else if(base_arg == "gemm")
+    if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
 // TODO half is not supported in gemm
-//    else if(base_arg == "gemmfp16")
+//    if(base_arg == "gemmfp16")
 //    {
-//        drv = new GemmDriver<float16>();
+//        return new GemmDriver<float16>();
 //    }
 #endif
-    else if(base_arg == "bnorm")
+    if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
-    else if(base_arg == "bnormfp16")
+    if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double, float>();
+        return new BatchNormDriver<float16, double, float>();
     }
-    else if(base_arg == "rnn")
+    if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float, double>();
+        return new RNNDriver<float, double>();
     }
-    else if(base_arg == "rnnfp16")
+    if(base_arg == "rnnfp16")
     {
-        drv = new RNNDriver<float16, double>();
+        return new RNNDriver<float16, double>();
     }
-    else
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    // show command
+    std::cout << "MIOpenDriver:";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "net")
+        return RunNet(argc, argv, MakeDriver);
+
+    Driver* drv = MakeDriver(base_arg);
+    if(drv == nullptr)
     {
         printf("Incorrect BaseArg\n");
         exit(0);
@@ -139,27 +150,7 @@ int main(int argc, char* argv[])
     drv->GetandSetData();
     drv->AllocateBuffersAndCopy();
 
-    int fargval = ((base_arg != "CBAInfer") && (base_arg != "CBAInferfp16"))
-                      ? drv->GetInputFlags().GetValueInt("forw")
-                      : 1;
-    bool bnFwdInVer = (fargval == 2 && (base_arg == "bnorm"));
-    bool verifyarg  = (drv->GetInputFlags().GetValueInt("verify") == 1);
-
-    if(fargval & 1 || fargval == 0 || bnFwdInVer)
-    {
-        drv->RunForwardGPU();
-        if(verifyarg)
-            drv->VerifyForward();
-    }
-
-    if(fargval != 1)
-    {
-        drv->RunBackwardGPU();
-        if(verifyarg)
-        {
-            drv->VerifyBackward();
-        }
-    }
+    RunDriverPasses(*drv, base_arg);
 
     return 0;
 }
@@ -30,7 +30,8 @@ POSSIBILITY OF SUCH DAMAGE.
 ///////////////////////////////////////////////////////////
 
 template <typename Tcheck /* the data type used in CPU checkings (usually double) */>
-int mloSoftmaxForwardRunHost(int n, int c, int h, int w, Tcheck* channel_max, Tcheck* outhost)
+int mloSoftmaxForwardRunHost(
+    int n, int c, int h, int w, Tcheck* channel_max, Tcheck* outhost, bool log_softmax = false)
 {
 
     int ret = 0;
@@ -59,7 +60,11 @@ int mloSoftmaxForwardRunHost(int n, int c, int h, int w, Tcheck* channel_max, Tc
 
             for(int j = 0; j < c; j++)
             {
-                outhost[(i * c + j) * h * w + s] /= channel_max[i * h * w + s];
+                if(log_softmax)
+                    outhost[(i * c + j) * h * w + s] =
+                        log(outhost[(i * c + j) * h * w + s] / channel_max[i * h * w + s]);
+                else
+                    outhost[(i * c + j) * h * w + s] /= channel_max[i * h * w + s];
             }
         }
     }
@@ -69,8 +74,14 @@ int mloSoftmaxForwardRunHost(int n, int c, int h, int w, Tcheck* channel_max, Tc
 
 template <typename Tgpu /* the data type used in GPU computations (usually half) */,
           typename Tcheck /* the data type used in CPU checkings (usually double) */>
-int mloSoftmaxBackwardRunHost(
-    int n, int c, int h, int w, Tcheck* channel_dot, Tgpu* out, Tcheck* dinhost)
+int mloSoftmaxBackwardRunHost(int n,
+                              int c,
+                              int h,
+                              int w,
+                              Tcheck* channel_dot,
+                              Tgpu* out,
+                              Tcheck* dinhost,
+                              bool log_softmax = false)
 {
 
     int ret = 0;
@@ -79,6 +90,22 @@ int mloSoftmaxBackwardRunHost(
     {
         for(int s = 0; s < h * w; s++)
         {
+            if(log_softmax)
+            {
+                // dx = dy - exp(y) * sum(dy)
+                for(int j = 0; j < c; j++)
+                {
+                    channel_dot[i * h * w + s] += dinhost[(i * c + j) * h * w + s];
+                }
+                for(int j = 0; j < c; j++)
+                {
+                    dinhost[(i * c + j) * h * w + s] -=
+                        exp(static_cast<Tcheck>(out[(i * c + j) * h * w + s])) *
+                        channel_dot[i * h * w + s];
+                }
+                continue;
+            }
+
             for(int j = 0; j < c; j++)
             {
                 channel_dot[i * h * w + s] += static_cast<Tcheck>(out[(i * c + j) * h * w + s]) *
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_NET_DRIVER_HPP
+#define GUARD_MIOPEN_NET_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include "timer.hpp"
+
+#include <miopen/trace.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct NetLayer
+{
+    std::string base_arg;
+    std::vector<std::string> args;
+    std::unique_ptr<Driver> drv;
+    float first_ms      = 0.0;
+    float warm_total_ms = 0.0;
+};
+
+// One layer per line: either a command printed by MIOPEN_ENABLE_LOGGING_CMD, of which everything
+// up to the MIOpenDriver token is dropped, or a plain "base_arg flags..." line. Blank lines and
+// lines starting with '#' are skipped.
+inline std::vector<NetLayer> ParseNetLayers(std::istream& is)
+{
+    const std::string driver_name = "MIOpenDriver";
+
+    std::vector<NetLayer> layers;
+    std::string line;
+    while(std::getline(is, line))
+    {
+        std::istringstream ss(line);
+        std::vector<std::string> tokens{std::istream_iterator<std::string>(ss),
+                                        std::istream_iterator<std::string>()};
+        if(tokens.empty() || tokens.front()[0] == '#')
+            continue;
+
+        auto first = std::find_if(tokens.begin(), tokens.end(), [&](const std::string& token) {
+            return token.size() >= driver_name.size() &&
+                   token.compare(token.size() - driver_name.size(), driver_name.size(),
+                                 driver_name) == 0;
+        });
+        first = (first == tokens.end()) ? tokens.begin() : std::next(first);
+        if(first == tokens.end())
+            continue;
+
+        NetLayer layer;
+        layer.base_arg = *first;
+        layer.args.assign(std::next(first), tokens.end());
+        layers.push_back(std::move(layer));
+    }
+    return layers;
+}
+
+inline miopen::trace::Histogram
+SumHistograms(const std::map<std::string, miopen::trace::Histogram>& histograms,
+              const std::string& prefix)
+{
+    miopen::trace::Histogram sum;
+    for(auto it = histograms.lower_bound(prefix);
+        it != histograms.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+        ++it)
+        sum.Merge(it->second);
+    return sum;
+}
+
+inline void PrintHitRate(const char* what, std::size_t lookups, std::size_t misses)
+{
+    if(lookups == 0)
+        return;
+    printf("%s hit rate: %.1f%% (%zu of %zu)\n",
+           what,
+           100.0 * (lookups - misses) / lookups,
+           lookups - misses,
+           lookups);
+}
+
+// Replays a list of layers back-to-back on one handle and reports per-layer and end-to-end
+// times together with the Find, kernel-compile and cache statistics collected by the tracer.
+inline int RunNet(int argc,
+                  char* argv[],
+                  const std::function<Driver*(const std::string& base_arg)>& make_driver)
+{
+    InputFlags inflags;
+    inflags.AddInputFlag(
+        "file", 'f', "", "Layer list, one MIOpenDriver command per line (Default=)", "string");
+    inflags.AddInputFlag(
+        "iter", 'i', "10", "Number of passes over the network (Default=10)", "int");
+    inflags.AddInputFlag(
+        "dry-run", 'd', "0", "Only run the algorithm search of each layer (Default=0)", "int");
+    inflags.Parse(argc, argv);
+
+    std::ifstream file(inflags.GetValueStr("file"));
+    if(!file)
+    {
+        printf("Cannot open layer list: %s\n", inflags.GetValueStr("file").c_str());
+        return 1;
+    }
+    auto layers        = ParseNetLayers(file);
+    const int iters    = std::max(inflags.GetValueInt("iter"), 1);
+    const bool dry_run = inflags.GetValueInt("dry-run") == 1;
+
+    // The statistics come from the trace histograms; this has to happen before the first
+    // MIOpen call since the setting is read once.
+    setenv("MIOPEN_ENABLE_TRACE", "1", 0);
+
+    Driver::SharedHandle() = Driver::CreateHandle();
+
+    for(auto& layer : layers)
+    {
+        std::vector<std::string> args{argv[0], layer.base_arg};
+        args.insert(args.end(), layer.args.begin(), layer.args.end());
+        // Each pass over the network runs every layer once; verification is left to the
+        // single-layer mode.
+        args.insert(args.end(), {"-i", "1", "-V", "0"});
+        std::vector<char*> cargs;
+        for(auto& arg : args)
+            cargs.push_back(&arg[0]);
+
+        layer.drv.reset(make_driver(layer.base_arg));
+        if(layer.drv == nullptr)
+        {
+            printf("Incorrect BaseArg in layer list: %s\n", layer.base_arg.c_str());
+            return 1;
+        }
+        layer.drv->AddCmdLineArgs();
+        layer.drv->ParseCmdLineArgs(static_cast<int>(cargs.size()), cargs.data());
+        layer.drv->GetandSetData();
+        layer.drv->AllocateBuffersAndCopy();
+    }
+
+    Timer t;
+    float first_pass_ms = 0.0;
+    float warm_total_ms = 0.0;
+    for(int i = 0; i < iters; i++)
+    {
+        for(auto& layer : layers)
+        {
+            t.start();
+            if(dry_run)
+                layer.drv->ResolveSolvers();
+            else
+                RunDriverPasses(*layer.drv, layer.base_arg);
+            t.stop();
+
+            if(i == 0)
+            {
+                layer.first_ms = t.gettime_ms();
+                first_pass_ms += layer.first_ms;
+            }
+            else
+            {
+                layer.warm_total_ms += t.gettime_ms();
+                warm_total_ms += t.gettime_ms();
+            }
+        }
+    }
+
+    const int warm_iters = iters - 1;
+    printf("%5s %12s %12s  %s\n", "Layer", "First(ms)", "Mean(ms)", "Command");
+    for(std::size_t l = 0; l < layers.size(); l++)
+    {
+        std::string command = layers[l].base_arg;
+        for(const auto& arg : layers[l].args)
+            command += " " + arg;
+        printf("%5zu %12.3f %12.3f  %s\n",
+               l,
+               layers[l].first_ms,
+               warm_iters > 0 ? layers[l].warm_total_ms / warm_iters : layers[l].first_ms,
+               command.c_str());
+    }
+    printf("End-to-end: first pass %.3f ms, mean pass %.3f ms over %d passes\n",
+           first_pass_ms,
+           warm_iters > 0 ? warm_total_ms / warm_iters : first_pass_ms,
+           iters);
+
+    const auto histograms = miopen::trace::GetHistograms();
+    const auto find       = SumHistograms(histograms, "find/ConvolutionDescriptor::");
+    const auto regenerate = SumHistograms(histograms, "find/FindDb::Regenerate");
+    const auto loads      = SumHistograms(histograms, "compile/");
+    const auto builds     = SumHistograms(histograms, "build/");
+    printf("Find: %zu calls, %.3f ms\n", find.count, find.total / 1.0e6);
+    PrintHitRate("Find-db", find.count, regenerate.count);
+    printf("Kernel programs: %zu loaded in %.3f ms, %zu built from source in %.3f ms\n",
+           loads.count,
+           loads.total / 1.0e6,
+           builds.count,
+           builds.total / 1.0e6);
+    PrintHitRate("Kernel binary cache", loads.count, builds.count);
+    printf("Kernel launches: %zu\n", SumHistograms(histograms, "launch/").count);
+
+    layers.clear();
+    miopenDestroy(Driver::SharedHandle());
+    Driver::SharedHandle() = nullptr;
+    return 0;
+}
+
+#endif // GUARD_MIOPEN_NET_DRIVER_HPP
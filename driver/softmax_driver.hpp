@@ -143,6 +143,11 @@ int SoftmaxDriver<Tgpu, Tref>::AddCmdLineArgs()
     inflags.AddInputFlag("in_w", 'W', "32", "Input Width (Default=32)", "int");
     inflags.AddInputFlag("alpha", 'A', "1.0", "Softmax shift (Default=1.0)", "float");
     inflags.AddInputFlag("beta", 'B', "0.0", "Softmax scale (Default=0.0)", "float");
+    inflags.AddInputFlag("algorithm",
+                         'a',
+                         "1",
+                         "Softmax algorithm: 0 fast, 1 accurate, 2 log (Default=1)",
+                         "int");
     inflags.AddInputFlag("iter", 'i', "10", "Number of Iterations (Default=10)", "int");
     inflags.AddInputFlag("verify", 'V', "1", "Verify Each Layer (Default=1)", "int");
     inflags.AddInputFlag("time", 't', "0", "Time Each Layer (Default=0)", "int");
@@ -224,21 +229,30 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
 
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
 
-    miopenSoftmaxForward(
-        GetHandle(), &alpha, inputTensor, in_dev->GetMem(), &beta, outputTensor, out_dev->GetMem());
+    const auto algorithm = static_cast<miopenSoftmaxAlgorithm_t>(inflags.GetValueInt("algorithm"));
+
+    miopenSoftmaxForward_V2(GetHandle(),
+                            &alpha,
+                            inputTensor,
+                            in_dev->GetMem(),
+                            &beta,
+                            outputTensor,
+                            out_dev->GetMem(),
+                            algorithm);
 
     Timer t;
     START_TIME
 
     for(int i = 0; i < inflags.GetValueInt("iter"); i++)
     {
-        miopenSoftmaxForward(GetHandle(),
-                             &alpha,
-                             inputTensor,
-                             in_dev->GetMem(),
-                             &beta,
-                             outputTensor,
-                             out_dev->GetMem());
+        miopenSoftmaxForward_V2(GetHandle(),
+                                &alpha,
+                                inputTensor,
+                                in_dev->GetMem(),
+                                &beta,
+                                outputTensor,
+                                out_dev->GetMem(),
+                                algorithm);
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -268,31 +282,34 @@ template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
 {
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
+    const auto algorithm = static_cast<miopenSoftmaxAlgorithm_t>(inflags.GetValueInt("algorithm"));
 
-    miopenSoftmaxBackward(GetHandle(),
-                          &alpha,
-                          outputTensor,
-                          out_dev->GetMem(),
-                          dOutputTensor,
-                          dout_dev->GetMem(),
-                          &beta,
-                          dInputTensor,
-                          din_dev->GetMem());
+    miopenSoftmaxBackward_V2(GetHandle(),
+                             &alpha,
+                             outputTensor,
+                             out_dev->GetMem(),
+                             dOutputTensor,
+                             dout_dev->GetMem(),
+                             &beta,
+                             dInputTensor,
+                             din_dev->GetMem(),
+                             algorithm);
 
     Timer t;
     START_TIME
 
     for(int i = 0; i < inflags.GetValueInt("iter"); i++)
     {
-        miopenSoftmaxBackward(GetHandle(),
-                              &alpha,
-                              outputTensor,
-                              out_dev->GetMem(),
-                              dOutputTensor,
-                              dout_dev->GetMem(),
-                              &beta,
-                              dInputTensor,
-                              din_dev->GetMem());
+        miopenSoftmaxBackward_V2(GetHandle(),
+                                 &alpha,
+                                 outputTensor,
+                                 out_dev->GetMem(),
+                                 dOutputTensor,
+                                 dout_dev->GetMem(),
+                                 &beta,
+                                 dInputTensor,
+                                 din_dev->GetMem(),
+                                 algorithm);
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -323,7 +340,13 @@ int SoftmaxDriver<Tgpu, Tref>::VerifyForward()
     Tref max_val = (sizeof(Tgpu) == 4) ? 3.402823466e+38f : 65504.;
     std::vector<Tref> channel_max(n * h * w, static_cast<Tref>(-max_val));
 
-    mloSoftmaxForwardRunHost<Tref>(n, c, h, w, channel_max.data(), outhost.data());
+    mloSoftmaxForwardRunHost<Tref>(n,
+                                   c,
+                                   h,
+                                   w,
+                                   channel_max.data(),
+                                   outhost.data(),
+                                   inflags.GetValueInt("algorithm") == miopenSoftmaxLog);
 
     auto error           = miopen::rms_range(outhost, out);
     const Tref tolerance = 1e-3; // 1e-6;
@@ -355,8 +378,14 @@ int SoftmaxDriver<Tgpu, Tref>::VerifyBackward()
     std::copy(dout.begin(), dout.end(), dinhost.begin());
     std::vector<Tref> channel_dot(n * h * w, static_cast<Tref>(0.0));
 
-    mloSoftmaxBackwardRunHost<Tgpu, Tref>(
-        n, c, h, w, channel_dot.data(), out.data(), dinhost.data());
+    mloSoftmaxBackwardRunHost<Tgpu, Tref>(n,
+                                          c,
+                                          h,
+                                          w,
+                                          channel_dot.data(),
+                                          out.data(),
+                                          dinhost.data(),
+                                          inflags.GetValueInt("algorithm") == miopenSoftmaxLog);
 
     auto error           = miopen::rms_range(dinhost, din);
     const Tref tolerance = 1e-3; // 1e-6;
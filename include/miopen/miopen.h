@@ -32,6 +32,7 @@
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <miopen/config.h>
 #include <miopen/export.h>
@@ -184,6 +185,50 @@ MIOPEN_EXPORT miopenStatus_t miopenSetStream(miopenHandle_t handle,
 MIOPEN_EXPORT miopenStatus_t miopenGetStream(miopenHandle_t handle,
                                              miopenAcceleratorQueue_t* streamID);
 
+/*! @brief Add an accelerator command queue to a handle
+ *
+ * A handle can own several streams. Stream 0 is the one the handle was created with. Work issued
+ * through the handle goes to the stream selected by the calling thread, see miopenSetActiveStream.
+ * @param handle     MIOpen handle (input)
+ * @param streamID   Accelerator queue to add, or nullptr to have MIOpen create one (input)
+ * @param index      Index of the added stream (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenAddStream(miopenHandle_t handle,
+                                             miopenAcceleratorQueue_t streamID,
+                                             int* index);
+
+/*! @brief Get the number of streams owned by a handle
+ *
+ * @param handle     MIOpen handle (input)
+ * @param count      Number of streams (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetStreamCount(miopenHandle_t handle, int* count);
+
+/*! @brief Select the stream used by the calling thread
+ *
+ * The selection is per host thread, so several threads can issue work on different streams of
+ * the same handle concurrently. Threads that never call this use stream 0.
+ * @param handle     MIOpen handle (input)
+ * @param index      Stream index returned by miopenAddStream, or 0 (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetActiveStream(miopenHandle_t handle, int index);
+
+/*! @brief Make one stream of a handle wait for another
+ *
+ * Work issued on stream waitingIndex after this call starts only once all work issued so far on
+ * stream signallingIndex has completed. The host is not blocked.
+ * @param handle            MIOpen handle (input)
+ * @param waitingIndex      Index of the stream that waits (input)
+ * @param signallingIndex   Index of the stream that is waited on (input)
+ * @return                  miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenStreamWaitStream(miopenHandle_t handle,
+                                                    int waitingIndex,
+                                                    int signallingIndex);
+
 /*! @brief Set allocator for previously created miopenHandle
  *
  * Set a command queue for an accelerator device
@@ -208,9 +253,8 @@ MIOPEN_EXPORT miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
 /*! @brief Get time for last kernel launched
  *
  * This function is used only when profiling mode has been enabled.
- * Kernel timings are based on the MIOpen handle and is not thread-safe.
- * In order to use multi-threaded profiling, create an MIOpen handle for each
- * concurrent thread.
+ * Kernel timings are kept per host thread: this returns the time of the last kernel the
+ * calling thread launched through the handle.
  *
  * @param handle     MIOpen handle (input)
  * @param time       Pointer to a float type to contain kernel time in milliseconds (output)
@@ -221,6 +265,7 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
 /*! @brief Enable profiling to retrieve kernel time
  *
  * Enable or disable kernel profiling. This profiling is only for kernel time.
+ * The setting applies to the calling thread only.
  * @param handle     MIOpen handle (input)
  * @param enable     Boolean to toggle profiling (input)
  * @return           miopenStatus_t
@@ -247,6 +292,15 @@ MIOPEN_DECLARE_OBJECT(miopenFusionOpDescriptor);
  */
 MIOPEN_DECLARE_OBJECT(miopenTensorDescriptor);
 
+/*! @ingroup tensor
+ * @brief Creates the miopenTensorExpression_t type
+ *
+ * Tensor expression is an object that describes a chain of element-wise tensor operations which
+ * is executed as a single fused kernel.
+ *
+ */
+MIOPEN_DECLARE_OBJECT(miopenTensorExpression);
+
 /*! @ingroup convolutions
 * @brief Creates the miopenConvolutionDescriptor_t type
  *
@@ -300,6 +354,18 @@ typedef enum {
         4, /*!< Pack of four 8-bit int points in NCHW_VECT_C format (Partially supported) */
 } miopenDataType_t;
 
+/*! @ingroup tensor
+ * @enum miopenTensorLayout_t
+ * Memory layouts of 4-D and 5-D tensors. Lengths are always given in NCHW (NCDHW) order; the
+ * layout only decides the order of the strides.
+*/
+typedef enum {
+    miopenTensorNCHW  = 0, /*!< Channels-first 4-D layout (default) */
+    miopenTensorNHWC  = 1, /*!< Channels-last 4-D layout */
+    miopenTensorNCDHW = 2, /*!< Channels-first 5-D layout (default) */
+    miopenTensorNDHWC = 3, /*!< Channels-last 5-D layout */
+} miopenTensorLayout_t;
+
 /*! @ingroup pooling
  * @enum miopenIndexType_t
  * MIOpen index datatypes.
@@ -464,6 +530,27 @@ MIOPEN_EXPORT miopenStatus_t miopenSetTensorDescriptor(miopenTensorDescriptor_t
                                                        int* dimsA,
                                                        int* stridesA);
 
+/*! @brief Set shape and memory layout of a packed 4-D or 5-D tensor
+ *
+ * Interface for setting a fully packed tensor in a given memory layout. The lengths are given in
+ * NCHW (NCDHW) order regardless of the layout, which only determines the strides. Convolutions
+ * use layout-native kernels for channels-last tensors where available, and otherwise transpose
+ * through the workspace reported by the GetWorkSpaceSize functions.
+ *
+ * @param tensorDesc   Tensor descriptor type (output)
+ * @param dataType     MIOpen datatype (input)
+ * @param tensorLayout Memory layout (input)
+ * @param lens         Array containing the lengths in NCHW (NCDHW) order (input)
+ * @param num_lens     Number of lengths; 4 for 4-D layouts, 5 for 5-D layouts (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenSetNdTensorDescriptorWithLayout(miopenTensorDescriptor_t tensorDesc,
+                                      miopenDataType_t dataType,
+                                      miopenTensorLayout_t tensorLayout,
+                                      int* lens,
+                                      int num_lens);
+
 /*! @brief Set shape of N-dimensional tensor
  *
  * Interface for querying tensor size. MIOpen has support for 1, 2, 3, 4, 5 dimensional tensor of
@@ -580,6 +667,114 @@ MIOPEN_EXPORT miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
                                                    const miopenTensorDescriptor_t yDesc,
                                                    void* y);
 
+/*! @brief Creates an empty tensor expression
+ *
+ * A tensor expression chains up to six element-wise steps (miopenTensorExpressionAddOp,
+ * miopenTensorExpressionAddScale, miopenTensorExpressionAddSet and miopenTensorExpressionAddCast)
+ * over up to four tensors. miopenExecuteTensorExpression runs the whole chain as one kernel that
+ * reads and writes every tensor once, instead of one kernel and one memory pass per step.
+ * Results match running the equivalent miopenOpTensor, miopenScaleTensor and miopenSetTensor
+ * calls one after the other.
+ *
+ * All tensors must have the same number of dimensions. A tensor may have length 1 in any
+ * dimension to be broadcast, unless it is written by one of the steps.
+ *
+ * @param expr       Pointer to a tensor expression (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenCreateTensorExpression(miopenTensorExpression_t* expr);
+
+/*! @brief Adds a tensor operand to a tensor expression
+ *
+ * @param expr       Tensor expression (input)
+ * @param tensorDesc Tensor descriptor of the operand (input)
+ * @param index      Index of the operand, used to refer to it in steps (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTensorExpressionAddTensor(
+    miopenTensorExpression_t expr, const miopenTensorDescriptor_t tensorDesc, int* index);
+
+/*! @brief Adds the step \f$ C = op ( alpha1[0] * A, alpha2[0] * B ) + beta[0] * C \f$
+ *
+ * @param expr       Tensor expression (input)
+ * @param tensorOp   Operation from miopenTensorOp_t (input)
+ * @param alpha1     Pointer to the float scaling factor of A (input)
+ * @param a          Operand index of A (input)
+ * @param alpha2     Pointer to the float scaling factor of B (input)
+ * @param b          Operand index of B (input)
+ * @param beta       Pointer to the float scaling factor of C (input)
+ * @param c          Operand index of C (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTensorExpressionAddOp(miopenTensorExpression_t expr,
+                                                         miopenTensorOp_t tensorOp,
+                                                         const void* alpha1,
+                                                         int a,
+                                                         const void* alpha2,
+                                                         int b,
+                                                         const void* beta,
+                                                         int c);
+
+/*! @brief Adds the step \f$ Y = alpha[0] * Y \f$
+ *
+ * @param expr       Tensor expression (input)
+ * @param y          Operand index of Y (input)
+ * @param alpha      Pointer to the float scaling factor (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTensorExpressionAddScale(miopenTensorExpression_t expr,
+                                                            int y,
+                                                            const void* alpha);
+
+/*! @brief Adds the step \f$ Y = alpha[0] \f$
+ *
+ * @param expr       Tensor expression (input)
+ * @param y          Operand index of Y (input)
+ * @param alpha      Pointer to the float fill value (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTensorExpressionAddSet(miopenTensorExpression_t expr,
+                                                          int y,
+                                                          const void* alpha);
+
+/*! @brief Adds the step \f$ Y = alpha[0] * X \f$ converted to the data type of Y
+ *
+ * Values above the largest value of the data type of Y are clamped to it.
+ *
+ * @param expr       Tensor expression (input)
+ * @param alpha      Pointer to the float scaling factor (input)
+ * @param x          Operand index of X (input)
+ * @param y          Operand index of Y (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenTensorExpressionAddCast(miopenTensorExpression_t expr,
+                                                           const void* alpha,
+                                                           int x,
+                                                           int y);
+
+/*! @brief Executes a tensor expression as a single fused kernel
+ *
+ * The kernel is compiled on first use and cached in the handle; it only depends on the data
+ * types and the steps of the expression, not on tensor lengths or scaling factors.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param expr       Tensor expression (input)
+ * @param buffers    Device buffers of the operands, in the order they were added (input)
+ * @param numBuffers Number of entries of buffers, must match the number of operands (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenExecuteTensorExpression(miopenHandle_t handle,
+                                                           const miopenTensorExpression_t expr,
+                                                           void* const* buffers,
+                                                           int numBuffers);
+
+/*! @brief Destroys a tensor expression
+ *
+ * @param expr       Tensor expression (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenDestroyTensorExpression(miopenTensorExpression_t expr);
+
 /** @} */
 // CLOSEOUT TENSOR DOXYGEN GROUP
 
@@ -836,6 +1031,22 @@ typedef struct
     size_t memory; /*!< Workspace required to run the selected algorithm represented in the union */
 } miopenConvAlgoPerf_t;
 
+/*! @struct miopenConvSolution_t
+
+ * @brief Solution of a forward convolution problem, as used by the immediate mode
+ *
+ * A solution names one way of running a convolution, which can be compiled and run without a
+ * previous miopenFindConvolutionForwardAlgorithm(). The solution id is stable across MIOpen
+ * versions and can be stored by the caller.
+ */
+typedef struct
+{
+    float time;                         /*!< Measured by a previous Find or estimated, in ms */
+    size_t workspace_size;              /*!< Workspace required to run the solution */
+    uint64_t solution_id;               /*!< Identifies the solution */
+    miopenConvFwdAlgorithm_t algorithm; /*!< Algorithm the solution belongs to */
+} miopenConvSolution_t;
+
 /*! @brief Query the workspace size required for a forward convolution layer
  *
  * This call is required and must be executed once before running
@@ -918,6 +1129,169 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                                       size_t workSpaceSize,
                                       bool exhaustiveSearch);
 
+/*! @brief Limit the time miopenFindConvolutionForwardAlgorithm() spends timing candidates
+ *
+ * With a budget set, the forward Find searches and times candidate solvers in the order of their
+ * estimated cost (see MIOPEN_CONV_COST_MODEL) and stops once the budget is used up or the
+ * remaining candidates cannot plausibly beat the fastest one measured so far. The candidates that
+ * were not timed are reported by miopenGetConvolutionFindSkipped(). Results of a search that
+ * skipped candidates are not stored in the find-db.
+ *
+ * @param convDesc   Convolution layer descriptor (output)
+ * @param budgetMs   Budget in milliseconds, 0 disables the limit (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenSetConvolutionFindTimeBudget(miopenConvolutionDescriptor_t convDesc, float budgetMs);
+
+/*! @brief Get the number of candidates skipped by the last forward Find
+ *
+ * Refers to the last miopenFindConvolutionForwardAlgorithm() the calling thread ran with the
+ * handle.
+ *
+ * @param handle     MIOpen handle (input)
+ * @param count      Number of candidates miopenFindConvolutionForwardAlgorithm() did not time
+ * (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionFindSkippedCount(miopenHandle_t handle,
+                                                                  int* count);
+
+/*! @brief Get a candidate skipped by the last forward Find
+ *
+ * Refers to the last miopenFindConvolutionForwardAlgorithm() the calling thread ran with the
+ * handle. The returned name stays valid until that thread's next Find with the handle.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param index          Index of the skipped candidate, less than the skipped count (input)
+ * @param solverName     Solver id of the skipped candidate (output)
+ * @param estimatedTime  Time in milliseconds predicted by the cost model (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionFindSkipped(miopenHandle_t handle,
+                                                             int index,
+                                                             const char** solverName,
+                                                             float* estimatedTime);
+
+/*! @brief Query the number of applicable forward solutions (immediate mode)
+ *
+ * Immediate mode runs a convolution without miopenFindConvolutionForwardAlgorithm(). The caller
+ * picks one of the solutions returned by miopenConvolutionForwardGetSolution(), optionally
+ * compiles it ahead of time with miopenConvolutionForwardCompileSolution() and runs it with
+ * miopenConvolutionForwardImmediate(). Transpose convolutions are not supported.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param solutionCount  Number of applicable solutions (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardGetSolutionCount(miopenHandle_t handle,
+                                         const miopenTensorDescriptor_t wDesc,
+                                         const miopenTensorDescriptor_t xDesc,
+                                         const miopenConvolutionDescriptor_t convDesc,
+                                         const miopenTensorDescriptor_t yDesc,
+                                         size_t* solutionCount);
+
+/*! @brief Query the applicable forward solutions, fastest first (immediate mode)
+ *
+ * No kernel is compiled or timed. The time of a solution is the one measured by a previous Find
+ * for the same problem if the find-db has it, and the estimate of the convolution cost model
+ * otherwise.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param maxSolutionCount Capacity of the solutions array (input)
+ * @param solutionCount  Number of solutions written to the array (output)
+ * @param solutions      Array of solutions (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardGetSolution(miopenHandle_t handle,
+                                    const miopenTensorDescriptor_t wDesc,
+                                    const miopenTensorDescriptor_t xDesc,
+                                    const miopenConvolutionDescriptor_t convDesc,
+                                    const miopenTensorDescriptor_t yDesc,
+                                    const size_t maxSolutionCount,
+                                    size_t* solutionCount,
+                                    miopenConvSolution_t* solutions);
+
+/*! @brief Query the workspace a forward solution requires (immediate mode)
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param solution_id    Id of an applicable solution (input)
+ * @param workSpaceSize  Size of the workspace in bytes (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardGetSolutionWorkspaceSize(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t wDesc,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const miopenConvolutionDescriptor_t convDesc,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 const uint64_t solution_id,
+                                                 size_t* workSpaceSize);
+
+/*! @brief Compile the kernels of a forward solution (immediate mode)
+ *
+ * Optional: miopenConvolutionForwardImmediate() compiles the solution on first use otherwise.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param solution_id    Id of an applicable solution (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
+                                        const miopenTensorDescriptor_t wDesc,
+                                        const miopenTensorDescriptor_t xDesc,
+                                        const miopenConvolutionDescriptor_t convDesc,
+                                        const miopenTensorDescriptor_t yDesc,
+                                        const uint64_t solution_id);
+
+/*! @brief Execute a forward convolution with the given solution (immediate mode)
+ *
+ * Computes y = w * x without a previous miopenFindConvolutionForwardAlgorithm().
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param w              Weights tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param y              Data tensor y (output)
+ * @param workSpace      Workspace tensor (input)
+ * @param workSpaceSize  Size of the workspace, at least the solution's workspace_size (input)
+ * @param solution_id    Id of an applicable solution (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardImmediate(miopenHandle_t handle,
+                                  const miopenTensorDescriptor_t wDesc,
+                                  const void* w,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const void* x,
+                                  const miopenConvolutionDescriptor_t convDesc,
+                                  const miopenTensorDescriptor_t yDesc,
+                                  void* y,
+                                  void* workSpace,
+                                  size_t workSpaceSize,
+                                  const uint64_t solution_id);
+
 /*! @brief Execute a forward convolution layer
  *
  * Runs the forward convolution layer based on the selected algorithm. The function
@@ -1888,6 +2262,15 @@ miopenDestroyActivationDescriptor(miopenActivationDescriptor_t activDesc);
  *
  *  @{
  */
+/*! @enum miopenSoftmaxAlgorithm_t
+ * Softmax flavors, all computed over the channels of each pixel
+ */
+typedef enum {
+    miopenSoftmaxFast     = 0, /*!< exp(x) / sum(exp(x)), without subtracting the channel max */
+    miopenSoftmaxAccurate = 1, /*!< exp(x - max) / sum(exp(x - max)) */
+    miopenSoftmaxLog      = 2, /*!< (x - max) - log(sum(exp(x - max))) */
+} miopenSoftmaxAlgorithm_t;
+
 /*! @brief Execute a softmax forward layer
  *
  * MIOpen does not support Softmax modes. MIOpen implements the SOFTMAX_MODE_CHANNEL flavor.
@@ -1934,6 +2317,94 @@ MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
                                                    const miopenTensorDescriptor_t dxDesc,
                                                    void* dx);
 
+/*! @brief Execute an out-of-place softmax forward layer
+ *
+ * Computes y = alpha * softmax(x) + beta * y over the channels. x and y must be packed 4-D
+ * tensors of the same lengths; they may alias, in which case the softmax is done in place.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param beta           Floating point blending factor for the previous y, allocated on the host
+ * (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param y              Data tensor y (input/output)
+ * @param algorithm      Softmax flavor (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSoftmaxForward_V2(miopenHandle_t handle,
+                                                     const void* alpha,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const void* x,
+                                                     const void* beta,
+                                                     const miopenTensorDescriptor_t yDesc,
+                                                     void* y,
+                                                     miopenSoftmaxAlgorithm_t algorithm);
+
+/*! @brief Execute an out-of-place softmax backwards layer
+ *
+ * Computes dx = alpha * gradient + beta * dx, where the gradient is taken with respect to the
+ * input of the forward softmax of the same algorithm. dy and dx may alias. For a forward pass
+ * with a scale, pass alpha multiplied by that scale.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param yDesc          Tensor descriptor for input data tensor y (input)
+ * @param y              Output of the forward softmax y (input)
+ * @param dyDesc         Tensor descriptor for input data tensor dy (input)
+ * @param dy             Data delta tensor dy (input)
+ * @param beta           Floating point blending factor for the previous dx, allocated on the host
+ * (input)
+ * @param dxDesc         Tensor descriptor for data output tensor dx (input)
+ * @param dx             Output data delta tensor dx (input/output)
+ * @param algorithm      Softmax flavor used in the forward pass (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
+                                                      const void* alpha,
+                                                      const miopenTensorDescriptor_t yDesc,
+                                                      const void* y,
+                                                      const miopenTensorDescriptor_t dyDesc,
+                                                      const void* dy,
+                                                      const void* beta,
+                                                      const miopenTensorDescriptor_t dxDesc,
+                                                      void* dx,
+                                                      miopenSoftmaxAlgorithm_t algorithm);
+
+/*! @brief Execute a softmax forward layer on a scaled and masked input
+ *
+ * Computes y = alpha * softmax(scale * x + mask) + beta * y in one pass, as used by attention
+ * layers. The additive mask is optional; each of its lengths must either match x or be 1, in
+ * which case it is broadcast along that dimension.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param alpha          Floating point scaling factor, allocated on the host (input)
+ * @param xDesc          Tensor descriptor for data input tensor x (input)
+ * @param x              Data tensor x (input)
+ * @param scale          Factor applied to x before the mask is added (input)
+ * @param maskDesc       Tensor descriptor for the mask, or NULL (input)
+ * @param mask           Additive mask tensor, or NULL (input)
+ * @param beta           Floating point blending factor for the previous y, allocated on the host
+ * (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param y              Data tensor y (input/output)
+ * @param algorithm      Softmax flavor (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenScaledMaskedSoftmaxForward(miopenHandle_t handle,
+                                 const void* alpha,
+                                 const miopenTensorDescriptor_t xDesc,
+                                 const void* x,
+                                 float scale,
+                                 const miopenTensorDescriptor_t maskDesc,
+                                 const void* mask,
+                                 const void* beta,
+                                 const miopenTensorDescriptor_t yDesc,
+                                 void* y,
+                                 miopenSoftmaxAlgorithm_t algorithm);
+
 /** @} */
 // CLOSEOUT SOFTMAX DOXYGEN GROUP
 
@@ -2098,6 +2569,23 @@ MIOPEN_EXPORT miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescripto
                                                        miopenFusionOpDescriptor_t* biasOp,
                                                        const miopenTensorDescriptor_t bDesc);
 
+// Tensor add create ops ---
+/*! @brief Creates an operator adding a second tensor to its input, e.g. the shortcut of a
+* residual block.
+*
+* Supported after a batch normalization inference operator, optionally followed by an activation.
+* The second tensor must have the same descriptor as the input of the operator.
+*
+* @param fusePlanDesc   A fusion plan descriptor (input)
+* @param addOp          Pointer to an operator type (output)
+* @param residualDesc   Descriptor of the tensor to add (input)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenCreateOpTensorAddForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                               miopenFusionOpDescriptor_t* addOp,
+                               const miopenTensorDescriptor_t residualDesc);
+
 // Batch normalization create ops ---
 /*! @brief Creates a forward inference batch normalization operator.
 *
@@ -2311,6 +2799,26 @@ MIOPEN_EXPORT miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t arg
                                                         const void* alpha,
                                                         const void* beta,
                                                         const void* bias);
+
+// Tensor add forward set arguments ---
+/*! @brief Sets the arguments for the forward tensor add op
+*
+* The kernels compute a plain sum, so alpha and beta are ignored and may be nullptr. They keep
+* the signature in line with the other forward set arguments functions.
+*
+* @param args           An arguments object type (output)
+* @param addOp          Forward tensor add operator (input)
+* @param alpha          Unused (input)
+* @param beta           Unused (input)
+* @param residual       Pointer to the tensor to add (input)
+* @return               miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t
+miopenSetOpArgsTensorAddForward(miopenOperatorArgs_t args,
+                                const miopenFusionOpDescriptor_t addOp,
+                                const void* alpha,
+                                const void* beta,
+                                const void* residual);
 /*! @brief Executes the fusion plan
 *
 *
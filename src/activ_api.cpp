@@ -27,6 +27,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor.hpp>
 
 #include <array>
@@ -78,6 +79,7 @@ extern "C" miopenStatus_t miopenActivationForward(miopenHandle_t handle,
                                                   const miopenTensorDescriptor_t yDesc,
                                                   void* y)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(activDesc, alpha, xDesc, x, beta, yDesc, y);
     return miopen::try_([&] {
@@ -104,6 +106,7 @@ extern "C" miopenStatus_t miopenActivationBackward(miopenHandle_t handle,
                                                    const miopenTensorDescriptor_t dxDesc,
                                                    void* dx)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(activDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx);
 
     return miopen::try_([&] {
@@ -68,7 +68,7 @@ void DeriveBNTensorDescriptor(TensorDescriptor& derivedBnDesc,
 TensorDescriptor BuildReshaped4DTensorDescriptor(const miopen::TensorDescriptor& tDesc)
 {
     auto dataType = tDesc.GetType();
-    std::vector<size_t> dims(tDesc.GetLengths());
+    auto dims     = tDesc.GetLengths();
 
     // NxCxDxHxW -> NxCx(D*H)xW
     dims[2] *= dims[3];
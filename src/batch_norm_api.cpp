@@ -27,6 +27,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
 
@@ -61,6 +62,7 @@ miopenBatchNormalizationForwardInference(miopenHandle_t handle,
                                          void* estimatedVariance,
                                          double epsilon)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(bn_mode,
                         xDesc,
                         x,
@@ -118,6 +120,7 @@ miopenBatchNormalizationForwardTraining(miopenHandle_t handle,
                                         void* resultSaveMean,
                                         void* resultSaveInvVariance)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(bn_mode,
                         xDesc,
@@ -212,6 +215,7 @@ miopenBatchNormalizationBackward(miopenHandle_t handle,
                                  const void* savedMean,
                                  const void* savedInvVariance)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(bn_mode,
                         xDesc,
@@ -0,0 +1,482 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv_cost_model.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/solver_cache.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_COST_MODEL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_FIND_TOP_K)
+
+namespace miopen {
+
+namespace {
+
+std::vector<std::string> Split(const std::string& s, char delim)
+{
+    std::vector<std::string> parts;
+    std::istringstream ss(s);
+    std::string part;
+    while(std::getline(ss, part, delim))
+        parts.push_back(part);
+    return parts;
+}
+
+bool ParsePair(const std::string& s, int& a, int& b)
+{
+    const auto parts = Split(s, 'x');
+    if(parts.size() != 2)
+        return false;
+    a = std::stoi(parts[0]);
+    b = std::stoi(parts[1]);
+    return true;
+}
+
+// Inverse of EncodeDataTypesForKey(): one type name, or three concatenated ones.
+bool ParseDataTypes(std::string s, ProblemDescription& problem)
+{
+    const std::array<miopenDataType_t, 5> types = {
+        {miopenInt8x4, miopenInt8, miopenInt32, miopenHalf, miopenFloat}};
+    std::vector<miopenDataType_t> parsed;
+    while(!s.empty())
+    {
+        const auto it = std::find_if(types.begin(), types.end(), [&](auto t) {
+            return StartsWith(s, GetDataTypeName(t));
+        });
+        if(it == types.end())
+            return false;
+        parsed.push_back(*it);
+        s = s.substr(GetDataTypeName(*it).size());
+    }
+    if(parsed.size() == 1)
+        parsed.resize(3, parsed[0]);
+    if(parsed.size() != 3)
+        return false;
+    problem.in_data_type      = parsed[0];
+    problem.weights_data_type = parsed[1];
+    problem.out_data_type     = parsed[2];
+    return true;
+}
+
+struct SolverEfficiency
+{
+    const char* prefix;
+    double efficiency; // fraction of the peak MAC rate
+};
+
+// Matched in order, so more specific prefixes come first
+const std::array<SolverEfficiency, 13>& Efficiencies()
+{
+    static const std::array<SolverEfficiency, 13> table = {{
+        {"ConvBinWinograd", 0.8},
+        {"ConvAsm1x1U", 0.7},
+        {"ConvAsm3x3U", 0.6},
+        {"ConvAsmBwdWrW", 0.5},
+        {"ConvAsm", 0.5},
+        {"gemm", 0.55},
+        {"fft", 0.35},
+        {"ConvOclDirectFwd1x1", 0.35},
+        {"ConvOclDirectFwd3x3", 0.3},
+        {"ConvOclDirectFwd11x11", 0.3},
+        {"ConvOclBwdWrW", 0.2},
+        {"ConvOclDirectFwdGen", 0.2},
+        {"ConvOclDirectFwd", 0.15},
+    }};
+    return table;
+}
+
+// Solves (a + lambda * I) x = b by Gaussian elimination with partial pivoting
+template <std::size_t N>
+bool SolveRidge(std::array<std::array<double, N>, N> a,
+                std::array<double, N> b,
+                std::array<double, N>& x)
+{
+    for(std::size_t i = 0; i < N; i++)
+        a[i][i] += 1e-6;
+    for(std::size_t col = 0; col < N; col++)
+    {
+        std::size_t pivot = col;
+        for(std::size_t row = col + 1; row < N; row++)
+            if(std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                pivot = row;
+        if(std::abs(a[pivot][col]) < 1e-12)
+            return false;
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        for(std::size_t row = col + 1; row < N; row++)
+        {
+            const auto f = a[row][col] / a[col][col];
+            for(std::size_t k = col; k < N; k++)
+                a[row][k] -= f * a[col][k];
+            b[row] -= f * b[col];
+        }
+    }
+    for(std::size_t i = N; i-- > 0;)
+    {
+        double sum = b[i];
+        for(std::size_t k = i + 1; k < N; k++)
+            sum -= a[i][k] * x[k];
+        x[i] = sum / a[i][i];
+    }
+    return true;
+}
+
+std::mutex& ModelMutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+std::shared_ptr<const ConvCostModel>& ModelInstance()
+{
+    static std::shared_ptr<const ConvCostModel> model;
+    return model;
+}
+
+std::shared_ptr<const ConvCostModel> LoadModelFromEnv()
+{
+    const char* const path = GetStringEnv(MIOPEN_CONV_COST_MODEL{});
+    if(path == nullptr)
+        return std::make_shared<HeuristicConvCostModel>();
+
+    auto model = std::make_shared<LinearConvCostModel>();
+    if(EndsWith(path, ".fdb.txt"))
+    {
+        model->Fit(LoadConvCostSamples(path));
+        MIOPEN_LOG_I("Fitted cost model for " << model->GetWeights().size() << " solvers from <"
+                                              << path
+                                              << ">");
+        return model;
+    }
+
+    std::ifstream file(path);
+    if(!file || !model->Load(file))
+    {
+        MIOPEN_LOG_W("Failed to load cost model from <" << path << ">, using heuristics");
+        return std::make_shared<HeuristicConvCostModel>();
+    }
+    return model;
+}
+
+} // namespace
+
+ConvCostFeatures ConvCostFeatures::From(const ProblemDescription& problem, Handle* handle)
+{
+    ConvCostFeatures f;
+    const double groups = std::max(problem.group_counts, 1);
+    // The forward output is the smaller spatial side, whatever the direction
+    const double out_hw = std::min(static_cast<double>(problem.in_height) * problem.in_width,
+                                   static_cast<double>(problem.out_height) * problem.out_width);
+    const double in_hw = std::max(static_cast<double>(problem.in_height) * problem.in_width,
+                                  static_cast<double>(problem.out_height) * problem.out_width);
+
+    if(problem.in_data_type != static_cast<miopenDataType_t>(-1))
+        f.type_size = GetTypeSize(problem.in_data_type);
+    f.filter_size  = std::max(1, problem.kernel_size_h * problem.kernel_size_w);
+    f.group_inputs = std::max(1.0, problem.n_inputs / groups);
+    f.out_pixels   = std::max(1.0, problem.batch_sz * out_hw);
+    f.macs         = f.out_pixels * problem.n_outputs * f.group_inputs * f.filter_size;
+    f.bytes        = f.type_size *
+              (problem.batch_sz * (in_hw * problem.n_inputs + out_hw * problem.n_outputs) +
+               f.filter_size * f.group_inputs * problem.n_outputs);
+    f.strided      = problem.kernel_stride_h > 1 || problem.kernel_stride_w > 1;
+    f.dilated      = problem.kernel_dilation_h > 1 || problem.kernel_dilation_w > 1;
+    if(handle != nullptr)
+        f.compute_units = handle->GetMaxComputeUnits();
+    return f;
+}
+
+std::array<double, ConvCostFeatures::vector_size> ConvCostFeatures::AsVector() const
+{
+    return {{1.0,
+             std::log(std::max(macs, 1.0)),
+             std::log(std::max(bytes, 1.0)),
+             std::log(group_inputs),
+             std::log(out_pixels)}};
+}
+
+float HeuristicConvCostModel::Estimate(const ConvCostFeatures& f,
+                                       const std::string& solver_id) const
+{
+    // Nominal GCN device: 64 lanes per CU at 1 GHz, 8 GB/s of DRAM bandwidth per CU
+    const double macs_per_ms  = f.compute_units * 64.0 * 1e6 * (f.type_size == 2 ? 2.0 : 1.0);
+    const double bytes_per_ms = f.compute_units * 8e6;
+    const double launch_ms    = 0.01;
+
+    double efficiency = 0.1;
+    for(auto&& e : Efficiencies())
+    {
+        if(StartsWith(solver_id, e.prefix))
+        {
+            efficiency = e.efficiency;
+            break;
+        }
+    }
+
+    double macs     = f.macs;
+    double bytes    = f.bytes;
+    double launches = 1;
+    if(StartsWith(solver_id, "ConvBinWinograd"))
+    {
+        // F(2x2,3x3) saves 2.25x of the multiplies on unit-stride 3x3 filters
+        if(f.filter_size == 9 && !f.strided && !f.dilated)
+            macs /= 2.25;
+        else
+            efficiency /= 2;
+    }
+    else if(solver_id == "gemm")
+    {
+        // Im2Col writes and the GEMM reads the unfolded input
+        if(f.filter_size > 1 || f.strided)
+        {
+            bytes += 2 * f.type_size * f.out_pixels * f.group_inputs * f.filter_size;
+            launches += 1;
+        }
+    }
+    else if(solver_id == "fft")
+    {
+        // Independent of the filter size, but pays for the forward and inverse transforms
+        macs = macs / f.filter_size * 4;
+        launches += 4;
+    }
+
+    // Too few output pixels leave CUs idle
+    const double occupancy = std::min(1.0, f.out_pixels / (f.compute_units * 64.0));
+    const double compute   = macs / (macs_per_ms * efficiency * std::max(occupancy, 0.05));
+    const double memory    = bytes / bytes_per_ms;
+    return static_cast<float>(std::max(compute, memory) + launches * launch_ms);
+}
+
+float LinearConvCostModel::Estimate(const ConvCostFeatures& features,
+                                    const std::string& solver_id) const
+{
+    const auto it = weights.find(solver_id);
+    if(it == weights.end())
+        return fallback.Estimate(features, solver_id);
+
+    const auto v  = features.AsVector();
+    double log_ms = 0;
+    for(std::size_t i = 0; i < v.size(); i++)
+        log_ms += it->second[i] * v[i];
+    return static_cast<float>(std::exp(log_ms));
+}
+
+void LinearConvCostModel::Fit(const std::vector<ConvCostSample>& samples)
+{
+    constexpr auto n = ConvCostFeatures::vector_size;
+    struct Normal
+    {
+        std::array<std::array<double, n>, n> xtx{};
+        std::array<double, n> xty{};
+        std::size_t count = 0;
+    };
+    std::map<std::string, Normal> systems;
+
+    for(auto&& s : samples)
+    {
+        if(!(s.time > 0))
+            continue;
+        const auto v = ConvCostFeatures::From(s.problem).AsVector();
+        const auto y = std::log(static_cast<double>(s.time));
+        auto& sys    = systems[s.solver_id];
+        for(std::size_t i = 0; i < n; i++)
+        {
+            for(std::size_t j = 0; j < n; j++)
+                sys.xtx[i][j] += v[i] * v[j];
+            sys.xty[i] += v[i] * y;
+        }
+        sys.count++;
+    }
+
+    weights.clear();
+    for(auto&& sys : systems)
+    {
+        // Fewer samples than unknowns leave the fit undetermined
+        if(sys.second.count < n)
+            continue;
+        Weights w{};
+        if(SolveRidge(sys.second.xtx, sys.second.xty, w))
+            weights[sys.first] = w;
+    }
+}
+
+void LinearConvCostModel::Save(std::ostream& os) const
+{
+    os << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for(auto&& w : weights)
+    {
+        os << w.first << ':';
+        for(std::size_t i = 0; i < w.second.size(); i++)
+            os << (i == 0 ? "" : ",") << w.second[i];
+        os << '\n';
+    }
+}
+
+bool LinearConvCostModel::Load(std::istream& is)
+{
+    std::map<std::string, Weights> loaded;
+    std::string line;
+    while(std::getline(is, line))
+    {
+        if(line.empty() || line[0] == '#')
+            continue;
+        const auto colon = line.find(':');
+        if(colon == std::string::npos)
+            return false;
+        const auto values = Split(line.substr(colon + 1), ',');
+        if(values.size() != ConvCostFeatures::vector_size)
+            return false;
+        Weights w{};
+        try
+        {
+            for(std::size_t i = 0; i < w.size(); i++)
+                w[i] = std::stod(values[i]);
+        }
+        catch(const std::exception&)
+        {
+            return false;
+        }
+        loaded[line.substr(0, colon)] = w;
+    }
+    weights = std::move(loaded);
+    return true;
+}
+
+boost::optional<ProblemDescription> ParseConvProblemKey(const std::string& key)
+{
+    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F[_g2]
+    const auto underscore = key.find('_');
+    const auto parts      = Split(key.substr(0, underscore), '-');
+    if(parts.size() != 15)
+        return boost::none;
+
+    ProblemDescription p;
+    try
+    {
+        p.n_inputs   = std::stoi(parts[0]);
+        p.in_height  = std::stoi(parts[1]);
+        p.in_width   = std::stoi(parts[2]);
+        p.n_outputs  = std::stoi(parts[4]);
+        p.out_height = std::stoi(parts[5]);
+        p.out_width  = std::stoi(parts[6]);
+        p.batch_sz   = std::stoi(parts[7]);
+        p.bias       = std::stoi(parts[11]);
+        if(!ParsePair(parts[3], p.kernel_size_h, p.kernel_size_w) ||
+           !ParsePair(parts[8], p.pad_h, p.pad_w) ||
+           !ParsePair(parts[9], p.kernel_stride_h, p.kernel_stride_w) ||
+           !ParsePair(parts[10], p.kernel_dilation_h, p.kernel_dilation_w))
+            return boost::none;
+
+        p.group_counts = 1;
+        if(underscore != std::string::npos)
+        {
+            const auto optional = key.substr(underscore + 1);
+            if(optional.empty() || optional[0] != 'g')
+                return boost::none;
+            p.group_counts = std::stoi(optional.substr(1));
+        }
+    }
+    catch(const std::exception&)
+    {
+        return boost::none;
+    }
+
+    p.in_layout  = parts[12];
+    p.out_layout = parts[12];
+    if(!ParseDataTypes(parts[13], p))
+        return boost::none;
+
+    if(parts[14] == "F")
+        p.direction.Set(1);
+    else if(parts[14] == "B")
+        p.direction.Set(0);
+    else if(parts[14] == "W")
+        p.direction.SetBackwardWrW();
+    else
+        return boost::none;
+    return p;
+}
+
+std::vector<ConvCostSample> LoadConvCostSamples(const std::string& find_db_path)
+{
+    std::vector<ConvCostSample> samples;
+    std::ifstream file(find_db_path);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        // KEY=ID:VALUES;ID:VALUES
+        const auto eq = line.find('=');
+        if(eq == std::string::npos)
+            continue;
+        const auto problem = ParseConvProblemKey(line.substr(0, eq));
+        if(!problem)
+            continue;
+        for(auto&& entry : Split(line.substr(eq + 1), ';'))
+        {
+            const auto colon = entry.find(':');
+            if(colon == std::string::npos)
+                continue;
+            FindDbData data;
+            if(!data.Deserialize(entry.substr(colon + 1)) || !(data.time > 0))
+                continue;
+            samples.push_back({*problem, data.solver_id, data.time});
+        }
+    }
+    return samples;
+}
+
+std::shared_ptr<const ConvCostModel> GetConvCostModel()
+{
+    std::lock_guard<std::mutex> lock(ModelMutex());
+    auto& model = ModelInstance();
+    if(model == nullptr)
+        model = LoadModelFromEnv();
+    return model;
+}
+
+void SetConvCostModel(std::shared_ptr<const ConvCostModel> model)
+{
+    {
+        std::lock_guard<std::mutex> lock(ModelMutex());
+        ModelInstance() = std::move(model);
+    }
+    // The solver caches keep the order the previous model ranked the solvers in
+    InvalidateSolverCaches();
+}
+
+std::size_t GetConvFindTopK() { return Value(MIOPEN_CONV_FIND_TOP_K{}); }
+
+} // namespace miopen
@@ -28,6 +28,7 @@
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/layout_staging.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/miopen.h>
 #include <miopen/mlo_internal.hpp>
@@ -185,7 +186,7 @@ TensorDescriptor ConvolutionDescriptor::GetForwardOutputTensor(const TensorDescr
     }
 
     std::size_t out_c;
-    std::vector<std::size_t> out_lens(spatial_dim + 2);
+    TensorLengths out_lens(spatial_dim + 2);
 
     auto out_spatial = boost::adaptors::slice(out_lens, 2, 2 + spatial_dim);
 
@@ -370,6 +371,10 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
                                                            const TensorDescriptor& yDesc) const
 {
     MIOPEN_LOG_I2("");
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(staging.Any())
+        return staging.Size() + ForwardGetWorkSpaceSize(
+                                    handle, staging.Desc(1), staging.Desc(0), staging.Desc(2));
     {
         const std::size_t spatial_dim = GetSpatialDimension();
 
@@ -445,6 +450,10 @@ ConvolutionDescriptor::BackwardDataGetWorkSpaceSize(Handle& handle,
                                                     const TensorDescriptor& dxDesc) const
 {
     MIOPEN_LOG_I2("");
+    LayoutStaging staging{{dyDesc, wDesc, dxDesc}};
+    if(staging.Any())
+        return staging.Size() + BackwardDataGetWorkSpaceSize(
+                                    handle, staging.Desc(1), staging.Desc(0), staging.Desc(2));
     {
         auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + GetSpatialDimension());
 
@@ -672,6 +681,10 @@ std::size_t ConvolutionDescriptor::ConvolutionBackwardWeightsGetWorkSpaceSize(
     const TensorDescriptor& dwDesc) const
 {
     MIOPEN_LOG_I2("");
+    LayoutStaging staging{{dyDesc, xDesc, dwDesc}};
+    if(staging.Any())
+        return staging.Size() + ConvolutionBackwardWeightsGetWorkSpaceSize(
+                                    handle, staging.Desc(0), staging.Desc(1), staging.Desc(2));
 
     std::size_t workspace_size = 0;
     {
@@ -27,6 +27,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <algorithm>
 
@@ -88,6 +89,42 @@ extern "C" miopenStatus_t miopenSetConvolutionGroupCount(miopenConvolutionDescri
     return miopen::try_([&] { miopen::deref(convDesc).group_count = groupCount; });
 }
 
+extern "C" miopenStatus_t miopenSetConvolutionFindTimeBudget(miopenConvolutionDescriptor_t convDesc,
+                                                             float budgetMs)
+{
+    MIOPEN_LOG_FUNCTION(convDesc, budgetMs);
+    return miopen::try_([&] {
+        if(budgetMs < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Find time budget cannot be negative");
+        miopen::deref(convDesc).find_time_budget = budgetMs;
+    });
+}
+
+extern "C" miopenStatus_t miopenGetConvolutionFindSkippedCount(miopenHandle_t handle, int* count)
+{
+    MIOPEN_LOG_FUNCTION(count);
+    return miopen::try_([&] {
+        miopen::deref(count) = static_cast<int>(miopen::deref(handle).GetFindSkipped().size());
+    });
+}
+
+extern "C" miopenStatus_t miopenGetConvolutionFindSkipped(miopenHandle_t handle,
+                                                          int index,
+                                                          const char** solverName,
+                                                          float* estimatedTime)
+{
+    MIOPEN_LOG_FUNCTION(index, solverName, estimatedTime);
+    return miopen::try_([&] {
+        const auto& skipped = miopen::deref(handle).GetFindSkipped();
+        if(index < 0 || index >= static_cast<int>(skipped.size()))
+            MIOPEN_THROW(miopenStatusBadParm, "Skipped candidate index is out of range");
+        if(solverName != nullptr)
+            *solverName = skipped[index].solver_id.c_str();
+        if(estimatedTime != nullptr)
+            *estimatedTime = skipped[index].estimate;
+    });
+}
+
 extern "C" miopenStatus_t
 miopenSetTransposeConvOutputPadding(miopenConvolutionDescriptor_t convDesc, int adj_h, int adj_w)
 {
@@ -232,6 +269,7 @@ miopenConvolutionForwardGetWorkSpaceSize(miopenHandle_t handle,
                                          const miopenTensorDescriptor_t yDesc,
                                          size_t* workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(wDesc, yDesc, convDesc, workSpaceSize);
     miopen::try_([&] {
@@ -266,6 +304,7 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                                       size_t workSpaceSize,
                                       bool exhaustiveSearch)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(xDesc,
                         x,
@@ -348,6 +387,7 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                                                    void* workSpace,
                                                    size_t workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         alpha, xDesc, x, wDesc, w, convDesc, algo, beta, yDesc, y, workSpace, workSpaceSize);
@@ -434,6 +474,118 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionForwardGetSolutionCount(miopenHandle_t handle,
+                                         const miopenTensorDescriptor_t wDesc,
+                                         const miopenTensorDescriptor_t xDesc,
+                                         const miopenConvolutionDescriptor_t convDesc,
+                                         const miopenTensorDescriptor_t yDesc,
+                                         size_t* solutionCount)
+{
+    MIOPEN_LOG_FUNCTION(wDesc, xDesc, convDesc, yDesc, solutionCount);
+    return miopen::try_([&] {
+        miopen::deref(solutionCount) =
+            miopen::deref(convDesc)
+                .GetForwardSolutions(miopen::deref(handle),
+                                     miopen::deref(wDesc),
+                                     miopen::deref(xDesc),
+                                     miopen::deref(yDesc))
+                .size();
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardGetSolution(miopenHandle_t handle,
+                                    const miopenTensorDescriptor_t wDesc,
+                                    const miopenTensorDescriptor_t xDesc,
+                                    const miopenConvolutionDescriptor_t convDesc,
+                                    const miopenTensorDescriptor_t yDesc,
+                                    const size_t maxSolutionCount,
+                                    size_t* solutionCount,
+                                    miopenConvSolution_t* solutions)
+{
+    MIOPEN_LOG_FUNCTION(wDesc, xDesc, convDesc, yDesc, maxSolutionCount, solutionCount);
+    return miopen::try_([&] {
+        if(maxSolutionCount > 0 && solutions == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
+        const auto all = miopen::deref(convDesc).GetForwardSolutions(miopen::deref(handle),
+                                                                     miopen::deref(wDesc),
+                                                                     miopen::deref(xDesc),
+                                                                     miopen::deref(yDesc));
+        miopen::deref(solutionCount) = std::min(maxSolutionCount, all.size());
+        std::copy_n(all.begin(), *solutionCount, solutions);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardGetSolutionWorkspaceSize(miopenHandle_t handle,
+                                                 const miopenTensorDescriptor_t wDesc,
+                                                 const miopenTensorDescriptor_t xDesc,
+                                                 const miopenConvolutionDescriptor_t convDesc,
+                                                 const miopenTensorDescriptor_t yDesc,
+                                                 const uint64_t solution_id,
+                                                 size_t* workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(wDesc, xDesc, convDesc, yDesc, solution_id, workSpaceSize);
+    return miopen::try_([&] {
+        miopen::deref(workSpaceSize) =
+            miopen::deref(convDesc).GetForwardSolutionWorkspaceSize(miopen::deref(handle),
+                                                                    miopen::deref(wDesc),
+                                                                    miopen::deref(xDesc),
+                                                                    miopen::deref(yDesc),
+                                                                    solution_id);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
+                                        const miopenTensorDescriptor_t wDesc,
+                                        const miopenTensorDescriptor_t xDesc,
+                                        const miopenConvolutionDescriptor_t convDesc,
+                                        const miopenTensorDescriptor_t yDesc,
+                                        const uint64_t solution_id)
+{
+    MIOPEN_LOG_FUNCTION(wDesc, xDesc, convDesc, yDesc, solution_id);
+    return miopen::try_([&] {
+        miopen::deref(convDesc).CompileForwardSolution(miopen::deref(handle),
+                                                       miopen::deref(wDesc),
+                                                       miopen::deref(xDesc),
+                                                       miopen::deref(yDesc),
+                                                       solution_id);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenConvolutionForwardImmediate(miopenHandle_t handle,
+                                  const miopenTensorDescriptor_t wDesc,
+                                  const void* w,
+                                  const miopenTensorDescriptor_t xDesc,
+                                  const void* x,
+                                  const miopenConvolutionDescriptor_t convDesc,
+                                  const miopenTensorDescriptor_t yDesc,
+                                  void* y,
+                                  void* workSpace,
+                                  size_t workSpaceSize,
+                                  const uint64_t solution_id)
+{
+    MIOPEN_TRACE_API();
+
+    MIOPEN_LOG_FUNCTION(
+        wDesc, w, xDesc, x, convDesc, yDesc, y, workSpace, workSpaceSize, solution_id);
+    return miopen::try_([&] {
+        miopen::deref(convDesc).ConvolutionForwardImmediate(miopen::deref(handle),
+                                                            miopen::deref(wDesc),
+                                                            DataCast(w),
+                                                            miopen::deref(xDesc),
+                                                            DataCast(x),
+                                                            miopen::deref(yDesc),
+                                                            DataCast(y),
+                                                            DataCast(workSpace),
+                                                            workSpaceSize,
+                                                            solution_id);
+    });
+}
+
 extern "C" miopenStatus_t miopenConvolutionForwardBias(miopenHandle_t handle,
                                                        const void* alpha,
                                                        const miopenTensorDescriptor_t bDesc,
@@ -442,6 +594,7 @@ extern "C" miopenStatus_t miopenConvolutionForwardBias(miopenHandle_t handle,
                                                        const miopenTensorDescriptor_t yDesc,
                                                        void* y)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(alpha, bDesc, b, beta, yDesc, y);
     return miopen::try_([&] {
@@ -476,6 +629,7 @@ miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                                            size_t workSpaceSize,
                                            bool exhaustiveSearch)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(dyDesc,
                         dy,
@@ -558,6 +712,7 @@ miopenConvolutionBackwardData(miopenHandle_t handle,
                               void* workSpace,
                               size_t workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         alpha, dyDesc, dy, wDesc, w, convDesc, algo, beta, dxDesc, dx, workSpace, workSpaceSize);
@@ -644,6 +799,7 @@ miopenConvolutionBackwardDataGetWorkSpaceSize(miopenHandle_t handle,
                                               const miopenTensorDescriptor_t dxDesc,
                                               size_t* workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(dyDesc, wDesc, convDesc, dxDesc, workSpaceSize);
     return miopen::try_([&] {
@@ -668,6 +824,7 @@ miopenConvolutionBackwardWeightsGetWorkSpaceSize(miopenHandle_t handle,
                                                  const miopenTensorDescriptor_t dwDesc,
                                                  size_t* workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(dyDesc, xDesc, convDesc, dwDesc, workSpaceSize);
     return miopen::try_([&] {
@@ -698,6 +855,7 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
                                               size_t workSpaceSize,
                                               bool exhaustiveSearch)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(dyDesc,
                         dy,
@@ -780,6 +938,7 @@ miopenConvolutionBackwardWeights(miopenHandle_t handle,
                                  void* workSpace,
                                  size_t workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         alpha, dyDesc, dy, xDesc, x, convDesc, algo, beta, dwDesc, dw, workSpace, workSpaceSize);
@@ -811,6 +970,7 @@ extern "C" miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle,
                                                         const miopenTensorDescriptor_t dbDesc,
                                                         void* db)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(alpha, dyDesc, dy, beta, dbDesc, db);
     return miopen::try_([&] {
         ConvolutionBackwardBias(miopen::deref(handle),
@@ -29,6 +29,7 @@
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/filesystem.hpp>
@@ -104,6 +105,7 @@ using shared_lock    = std::shared_lock<LockFile>;
 
 boost::optional<DbRecord> Db::FindRecord(const std::string& key)
 {
+    MIOPEN_TRACE_SCOPE("db", "Db::FindRecord");
     const auto lock = shared_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
     return FindRecordUnsafe(key, nullptr);
@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_merge.hpp>
+#include <miopen/conv_cost_model.hpp>
+#include <miopen/each_args.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/rank.hpp>
+#include <miopen/solver.hpp>
+
+#include <boost/optional.hpp>
+
+#include <fstream>
+#include <ostream>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+/// Builds the context a perf-db key was tuned for, assuming packed NCHW tensors as Find does.
+struct PerfDbKeyContext : mlo_construct_direct2D
+{
+    PerfDbKeyContext(const ProblemDescription& problem, Handle& handle)
+        : mlo_construct_direct2D(problem.direction.IsForward() ? 1 : 0)
+    {
+        static_cast<ProblemDescription&>(_search_params) = problem;
+
+        auto& p              = _search_params;
+        p.in_stride          = p.in_width;
+        p.in_channel_stride  = p.in_width * p.in_height;
+        p.in_batch_stride    = p.in_channel_stride * p.n_inputs;
+        p.out_stride         = p.out_width;
+        p.out_channel_stride = p.out_width * p.out_height;
+        p.out_batch_stride   = p.out_channel_stride * p.n_outputs;
+
+        const std::size_t elem = GetTypeSize(p.in_data_type);
+        p.bot_sz               = elem * p.in_batch_stride * p.batch_sz;
+        p.top_sz               = elem * p.out_batch_stride * p.batch_sz;
+        p.weights_sz = elem * p.n_outputs * p.n_inputs / p.group_counts * p.kernel_size_h *
+                       p.kernel_size_w;
+        p.bias_sz = p.bias != 0 ? elem * p.n_outputs : 0;
+
+        setStream(&handle);
+        detectRocm();
+        setupFloats();
+    }
+
+    const ConvolutionContext& Get() const { return _search_params; }
+};
+
+template <class Solver>
+auto IsValidEntry(rank<1>, Solver s, const ConvolutionContext& context, const std::string& values)
+    -> decltype(s.IsValidPerformanceConfig(context, s.GetPerformanceConfig(context)))
+{
+    decltype(s.GetPerformanceConfig(context)) config{};
+    return config.Deserialize(values) && s.IsValidPerformanceConfig(context, config);
+}
+
+template <class Solver>
+bool IsValidEntry(rank<0>, Solver, const ConvolutionContext&, const std::string&)
+{
+    return false;
+}
+
+template <class... Solvers>
+bool IsValidPerfDbEntry(const ConvolutionContext& context,
+                        const std::string& id,
+                        const std::string& values)
+{
+    bool valid = false;
+    miopen::each_args(
+        [&](auto solver) {
+            if(solver::SolverDbId(solver) == id)
+                valid = IsValidEntry(rank<1>{}, solver, context, values);
+        },
+        Solvers{}...);
+    return valid;
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const DbMergeStats& stats)
+{
+    return os << stats.files << " files, " << stats.records << " records, " << stats.entries
+              << " entries, " << stats.conflicts << " conflicts (" << stats.by_time
+              << " resolved by time, " << stats.by_vote << " by vote), " << stats.invalid
+              << " invalid, " << stats.malformed << " malformed";
+}
+
+DbEntryValidator MakePerfDbValidator(Handle& handle)
+{
+    return [&handle](const std::string& key, const std::string& id, const std::string& values) {
+        const auto problem = ParseConvProblemKey(key);
+        if(!problem)
+            return false;
+        const PerfDbKeyContext context{*problem, handle};
+        // clang-format off
+        return IsValidPerfDbEntry<
+            solver::ConvAsm3x3U,
+            solver::ConvAsm1x1U,
+            solver::ConvBiasActivAsm1x1U,
+            solver::ConvOclDirectFwd,
+            solver::ConvOclDirectFwdFused,
+            solver::ConvOclDirectFwd1x1,
+            solver::ConvAsmBwdWrW3x3,
+            solver::ConvAsmBwdWrW1x1,
+            solver::ConvOclBwdWrW2<1>,
+            solver::ConvOclBwdWrW2<2>,
+            solver::ConvOclBwdWrW2<4>,
+            solver::ConvOclBwdWrW2<8>,
+            solver::ConvOclBwdWrW2<16>
+        >(context.Get(), id, values);
+        // clang-format on
+    };
+}
+
+DbMerger::DbMerger(DbKind kind_, DbEntryValidator validate_)
+    : kind(kind_), validate(std::move(validate_))
+{
+}
+
+bool DbMerger::AddFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if(!file)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << path);
+        return false;
+    }
+    Add(file);
+    return true;
+}
+
+void DbMerger::Add(std::istream& stream)
+{
+    ++stats.files;
+    std::string line;
+    while(std::getline(stream, line))
+    {
+        if(line.empty())
+            continue;
+        // KEY=ID:VALUES;ID:VALUES
+        const auto eq = line.find('=');
+        if(eq == std::string::npos || eq == 0)
+        {
+            ++stats.malformed;
+            continue;
+        }
+        const auto key = line.substr(0, eq);
+        std::istringstream contents(line.substr(eq + 1));
+        std::string entry;
+        while(std::getline(contents, entry, ';'))
+        {
+            const auto colon = entry.find(':');
+            if(colon == std::string::npos || colon == 0)
+            {
+                ++stats.malformed;
+                continue;
+            }
+            AddEntry(key, entry.substr(0, colon), entry.substr(colon + 1));
+        }
+    }
+}
+
+void DbMerger::AddEntry(const std::string& key, const std::string& id, const std::string& values)
+{
+    float time = -1;
+    if(kind == DbKind::Find)
+    {
+        FindDbData data;
+        if(!data.Deserialize(values))
+        {
+            ++stats.malformed;
+            return;
+        }
+        time = data.time;
+    }
+    if(validate && !validate(key, id, values))
+    {
+        MIOPEN_LOG_I2("Invalid entry dropped: " << key << '=' << id << ':' << values);
+        ++stats.invalid;
+        return;
+    }
+
+    auto& candidates = records[key][id];
+    for(auto& c : candidates)
+    {
+        if(c.values == values)
+        {
+            ++c.votes;
+            return;
+        }
+    }
+    candidates.push_back({values, 1, time});
+}
+
+const DbMerger::Candidate& DbMerger::Resolve(const std::vector<Candidate>& candidates)
+{
+    if(candidates.size() == 1)
+        return candidates.front();
+    ++stats.conflicts;
+
+    const Candidate* fastest = nullptr;
+    for(const auto& c : candidates)
+        if(c.time > 0 && (fastest == nullptr || c.time < fastest->time))
+            fastest = &c;
+    if(fastest != nullptr)
+    {
+        ++stats.by_time;
+        return *fastest;
+    }
+
+    // Candidates are in the order they were first seen, so ties go to the earlier input.
+    const Candidate* majority = &candidates.front();
+    for(const auto& c : candidates)
+        if(c.votes > majority->votes)
+            majority = &c;
+    ++stats.by_vote;
+    return *majority;
+}
+
+void DbMerger::Write(std::ostream& stream)
+{
+    stats.records   = 0;
+    stats.entries   = 0;
+    stats.conflicts = 0;
+    stats.by_time   = 0;
+    stats.by_vote   = 0;
+
+    for(const auto& record : records)
+    {
+        stream << record.first << '=';
+        auto separator = "";
+        for(const auto& id : record.second)
+        {
+            stream << separator << id.first << ':' << Resolve(id.second).values;
+            separator = ";";
+            ++stats.entries;
+        }
+        stream << '\n';
+        ++stats.records;
+    }
+}
+
+bool DbMerger::WriteFile(const std::string& path)
+{
+    std::ofstream file(path);
+    if(!file)
+    {
+        MIOPEN_LOG_E("File is unwritable: " << path);
+        return false;
+    }
+    Write(file);
+    return static_cast<bool>(file);
+}
+
+} // namespace miopen
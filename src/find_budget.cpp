@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_budget.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace miopen {
+
+constexpr float FindBudget::plausibility;
+
+FindBudget::FindBudget(float budget_ms_)
+    : budget_ms(budget_ms_), start(std::chrono::steady_clock::now())
+{
+}
+
+void FindBudget::Add(const std::string& algorithm,
+                     const std::string& solver_id,
+                     float estimate,
+                     Evaluate evaluate)
+{
+    candidates.push_back({{algorithm, solver_id, estimate}, std::move(evaluate)});
+}
+
+void FindBudget::Run()
+{
+    const bool limited = budget_ms > 0;
+    if(limited)
+    {
+        std::stable_sort(candidates.begin(), candidates.end(), [](const auto& l, const auto& r) {
+            return l.info.estimate < r.info.estimate;
+        });
+    }
+
+    auto best        = std::numeric_limits<float>::max();
+    auto calibration = std::numeric_limits<float>::max();
+    for(auto&& c : candidates)
+    {
+        if(limited && best != std::numeric_limits<float>::max())
+        {
+            const auto elapsed = std::chrono::duration<float, std::milli>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count();
+            const auto calibrated = c.info.estimate * calibration;
+            if(elapsed >= budget_ms || calibrated > best * plausibility)
+            {
+                MIOPEN_LOG_I2(c.info.algorithm << " " << c.info.solver_id << ": Skipped, estimate "
+                                               << calibrated
+                                               << " ms, best "
+                                               << best
+                                               << " ms, elapsed "
+                                               << elapsed
+                                               << " ms");
+                skipped.push_back(c.info);
+                continue;
+            }
+        }
+
+        const auto time = c.evaluate();
+        if(time < 0)
+            continue;
+        best = std::min(best, time);
+        if(c.info.estimate > 0)
+            calibration = std::min(calibration, time / c.info.estimate);
+    }
+    candidates.clear();
+}
+
+} // namespace miopen
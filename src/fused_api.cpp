@@ -33,6 +33,7 @@
 #include <miopen/fusion_plan.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor.hpp>
 
 // Return an error code that is "NotImplemented", if it exists then return success
@@ -75,6 +76,7 @@ extern "C" miopenStatus_t miopenFusionPlanGetOp(miopenFusionPlanDescriptor_t fus
 extern "C" miopenStatus_t miopenCompileFusionPlan(miopenHandle_t handle,
                                                   miopenFusionPlanDescriptor_t fusePlanDesc)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(/*handle,*/ fusePlanDesc);
     miopenStatus_t res = miopenStatusUnknownError;
     miopen::try_([&] { res = miopen::deref(fusePlanDesc).Compile(miopen::deref(handle)); });
@@ -87,6 +89,7 @@ miopenFusionPlanGetWorkSpaceSize(miopenHandle_t handle,
                                  size_t* workSpaceSize,
                                  miopenConvFwdAlgorithm_t algo)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(fusePlanDesc, workSpaceSize);
     miopenStatus_t res = miopenStatusUnknownError;
     miopen::try_([&] {
@@ -184,6 +187,22 @@ extern "C" miopenStatus_t miopenCreateOpBiasForward(miopenFusionPlanDescriptor_t
     return res;
 }
 
+extern "C" miopenStatus_t
+miopenCreateOpTensorAddForward(miopenFusionPlanDescriptor_t fusePlanDesc,
+                               miopenFusionOpDescriptor_t* addOp,
+                               const miopenTensorDescriptor_t residualDesc)
+{
+    MIOPEN_LOG_FUNCTION(fusePlanDesc, addOp, residualDesc);
+    miopenStatus_t res = miopenStatusUnknownError;
+    miopen::try_([&] {
+        auto aod =
+            std::make_shared<miopen::TensorAddFusionOpDescriptor>(miopen::deref(residualDesc));
+        miopen::deref(addOp) = aod.get();
+        res                  = miopen::deref(fusePlanDesc).AddOp(aod);
+    });
+    return res;
+}
+
 // Batch normalization create op
 extern "C" miopenStatus_t
 miopenCreateOpBatchNormInference(miopenFusionPlanDescriptor_t fusePlanDesc,
@@ -272,6 +291,20 @@ extern "C" miopenStatus_t miopenSetOpArgsBiasForward(miopenOperatorArgs_t args,
     });
 }
 
+extern "C" miopenStatus_t miopenSetOpArgsTensorAddForward(miopenOperatorArgs_t args,
+                                                          const miopenFusionOpDescriptor_t addOp,
+                                                          const void* alpha,
+                                                          const void* beta,
+                                                          const void* residual)
+{
+
+    MIOPEN_LOG_FUNCTION(args, addOp, alpha, beta, residual);
+    return miopen::try_([&] {
+        auto&& op = dynamic_cast<miopen::TensorAddFusionOpDescriptor&>(miopen::deref(addOp));
+        op.SetArgs(miopen::deref(args), alpha, beta, DataCast(residual));
+    });
+}
+
 extern "C" miopenStatus_t miopenSetOpArgsActivForward(miopenOperatorArgs_t args,
                                                       const miopenFusionOpDescriptor_t activFwdOp,
                                                       const void* alpha,
@@ -430,6 +463,7 @@ extern "C" miopenStatus_t miopenExecuteFusionPlan(const miopenHandle_t handle,
                                                   void* output,
                                                   miopenOperatorArgs_t args)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(fusePlanDesc, inputDesc, input, outputDesc, output, args);
     return miopen::try_([&] {
 
@@ -30,14 +30,51 @@
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/visit_float.hpp>
+#include <miopen/solver_cache.hpp>
 #include <ostream>
 #include <ios>
 #include <algorithm>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <half.hpp>
 
 namespace miopen {
 
+static std::string GetTensorKey(const TensorDescriptor& desc)
+{
+    std::ostringstream ss;
+    LogRange(ss, desc.GetLengths(), ",") << ';';
+    LogRange(ss, desc.GetStrides(), ",") << ';' << desc.GetType();
+    return ss.str();
+}
+
+struct FusionGraphState
+{
+    FusionMDGraph graph;
+    bool is_valid;
+};
+
+// Metadata graphs walked for the ops of plans seen before, keyed by FusionPlanDescriptor::plan_key
+static SolverCache<std::shared_ptr<const FusionGraphState>>& fusion_graphs()
+{
+    static SolverCache<std::shared_ptr<const FusionGraphState>> cache;
+    return cache;
+}
+
+// Keyed by FusionPlanDescriptor::GetCompiledKey()
+static SolverCache<std::shared_ptr<const CompiledFusionPlan>>& compiled_fusion_plans()
+{
+    static SolverCache<std::shared_ptr<const CompiledFusionPlan>> cache;
+    return cache;
+}
+
+static SolverCache<std::size_t>& fusion_plan_workspaces()
+{
+    static SolverCache<std::size_t> cache;
+    return cache;
+}
+
 FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
                                            const TensorDescriptor& inDesc)
     : fusion_dir(dir),
@@ -49,7 +86,8 @@ FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
       kernel_name(""),
       algorithm_name(""),
       network_config(inDesc.ToString()),
-      data_type(inDesc.GetType())
+      data_type(inDesc.GetType()),
+      plan_key(std::to_string(dir) + '|' + GetTensorKey(inDesc))
 {
 }
 
@@ -57,8 +95,10 @@ FusionPlanDescriptor::~FusionPlanDescriptor() { op_map.clear(); }
 
 miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> desc)
 {
+    auto key = plan_key + '|' + desc->GetPlanKey();
+    const auto cached = IsSolverCacheEnabled() ? fusion_graphs().Find(key) : boost::none;
     // load the md graph for the first op
-    if(op_count == 0)
+    if(op_count == 0 && !cached)
     {
         FusionMDGraph::Init(lu, desc->kind());
     }
@@ -70,6 +110,13 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
     desc->GetOutputDesc(output_desc);
     op_map.emplace_back(desc);
     op_count++;
+    plan_key = std::move(key);
+    if(cached)
+    {
+        lu       = (*cached)->graph;
+        is_valid = (*cached)->is_valid;
+        return is_valid ? miopenStatusSuccess : miopenStatusUnsupportedOp;
+    }
     is_valid = false;
     miopen::try_([&] {
         is_valid = lu.Advance(desc, [&](const std::string& sym, int& val) -> bool {
@@ -88,6 +135,10 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
             return false;
         });
     });
+    if(IsSolverCacheEnabled())
+        fusion_graphs().Insert(plan_key,
+                               std::make_shared<const FusionGraphState>(
+                                   FusionGraphState{lu, is_valid}));
     if(is_valid)
         return miopenStatusSuccess;
     else
@@ -134,6 +185,17 @@ miopenStatus_t FusionPlanDescriptor::GetWorkspaceSizeImmed(Handle& handle,
                                                            size_t& workSpaceSize,
                                                            miopenConvFwdAlgorithm_t /*algo*/)
 {
+    const auto key = GetCompiledKey(handle);
+    if(IsSolverCacheEnabled())
+    {
+        const auto cached = fusion_plan_workspaces().Find(key);
+        if(cached)
+        {
+            workSpaceSize = *cached;
+            return miopenStatusSuccess;
+        }
+    }
+
     workSpaceSize = 0;
     for(auto&& op : op_map)
     {
@@ -148,6 +210,8 @@ miopenStatus_t FusionPlanDescriptor::GetWorkspaceSizeImmed(Handle& handle,
                 workSpaceSize = tmp_sz;
         }
     }
+    if(IsSolverCacheEnabled())
+        fusion_plan_workspaces().Insert(key, workSpaceSize);
     return miopenStatusSuccess;
 }
 
@@ -171,7 +235,10 @@ miopenStatus_t FusionPlanDescriptor::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
     bool res = lu.SetConvAlgo(algo);
 
     if(res)
+    {
+        plan_key += "|algo" + std::to_string(algo);
         return miopenStatusSuccess;
+    }
     else
         return miopenStatusUnknownError;
 }
@@ -183,6 +250,8 @@ std::ostream& operator<<(std::ostream& stream, const FusionPlanDescriptor& fpd)
 }
 
 // Fusion operator descriptors
+std::string FusionOpDescriptor::GetPlanKey() const { return std::to_string(kind()); }
+
 // Conv Forward
 miopenStatus_t ConvForwardOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
 {
@@ -190,6 +259,13 @@ miopenStatus_t ConvForwardOpDescriptor::GetOutputDesc(TensorDescriptor& output_d
         [&]() { output_desc = base_desc.GetForwardOutputTensor(input_desc, filter_desc); });
 }
 
+std::string ConvForwardOpDescriptor::GetPlanKey() const
+{
+    std::ostringstream ss;
+    ss << FusionOpDescriptor::GetPlanKey() << ';' << base_desc << ';' << GetTensorKey(filter_desc);
+    return ss.str();
+}
+
 miopenStatus_t ConvForwardOpDescriptor::SetArgs(OperatorArgs& args,
                                                 const void* /*alpha*/,
                                                 const void* /*beta*/,
@@ -368,6 +444,11 @@ miopenStatus_t ActivFwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& outpu
     output_desc = input_desc;
     return miopenStatusSuccess;
 }
+
+std::string ActivFwdFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + std::to_string(activMode);
+}
 // Activ Backwards-----------------------------------------
 miopenStatus_t ActivBwdFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                    const void* /*alpha*/,
@@ -449,6 +530,11 @@ miopenStatus_t ActivBwdFusionOpDescriptor::GetOutputDesc(TensorDescriptor& outpu
     output_desc = input_desc;
     return miopenStatusSuccess;
 }
+
+std::string ActivBwdFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + std::to_string(activMode);
+}
 //==============================
 
 miopenStatus_t BatchNormInferenceFusionOpDescriptor::SetArgs(OperatorArgs& args,
@@ -505,6 +591,12 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetOutputDesc(TensorDescrip
     return miopenStatusSuccess;
 }
 
+std::string BatchNormInferenceFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + std::to_string(mode) + ';' +
+           GetTensorKey(base_desc);
+}
+
 OpKernelArg BatchNormInferenceFusionOpDescriptor::GetOpAttr(const std::string& k) const
 {
     int v;
@@ -614,6 +706,12 @@ miopenStatus_t BatchNormFwdTrainFusionOpDescriptor::GetOutputDesc(TensorDescript
     return miopenStatusSuccess;
 }
 
+std::string BatchNormFwdTrainFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + std::to_string(mode) + ';' +
+           std::to_string(static_cast<int>(runningMeanVar));
+}
+
 // end BN forward training -----------------------------
 
 // Batch Normalization Backward Training --------------
@@ -712,6 +810,12 @@ miopenStatus_t BatchNormBwdTrainFusionOpDescriptor::GetOutputDesc(TensorDescript
     return miopenStatusSuccess;
 }
 
+std::string BatchNormBwdTrainFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + std::to_string(mode) + ';' +
+           std::to_string(static_cast<int>(useBatchStats));
+}
+
 // end BN backwards training ---------------------------
 
 // Bias forward
@@ -721,6 +825,11 @@ miopenStatus_t BiasFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_de
     return miopenStatusSuccess;
 }
 
+std::string BiasFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + GetTensorKey(base_desc);
+}
+
 miopenStatus_t BiasFusionOpDescriptor::SetArgs(OperatorArgs& args,
                                                const void* /*alpha*/,
                                                const void* /*beta*/,
@@ -749,6 +858,63 @@ std::vector<std::pair<std::string, OpKernelArg>> BiasFusionOpDescriptor::GetArgs
     return keys;
 }
 
+// TensorAdd forward
+
+miopenStatus_t TensorAddFusionOpDescriptor::GetOutputDesc(TensorDescriptor& output_desc)
+{
+    output_desc = input_desc;
+    return miopenStatusSuccess;
+}
+
+std::string TensorAddFusionOpDescriptor::GetPlanKey() const
+{
+    return FusionOpDescriptor::GetPlanKey() + ';' + GetTensorKey(base_desc);
+}
+
+miopenStatus_t TensorAddFusionOpDescriptor::SetArgs(OperatorArgs& args,
+                                                    const void* /*alpha*/,
+                                                    const void* /*beta*/,
+                                                    ConstData_t residual)
+{
+    auto residual_any = OpKernelArg(residual);
+    args.ins_arg("residual" + std::to_string(GetIdx()), residual_any);
+    return miopenStatusSuccess;
+}
+
+std::string TensorAddFusionOpDescriptor::GetArgKey(const std::string& k) const
+{
+    return k + std::to_string(GetIdx());
+}
+
+bool TensorAddFusionOpDescriptor::GetOpAttr(const std::string& sym, int& val) const
+{
+    if(sym == "add_matches_input")
+    {
+        // The kernels read the residual with the indices of their input
+        val = static_cast<int>(base_desc == input_desc);
+        return true;
+    }
+    return false;
+}
+
+OpKernelArg TensorAddFusionOpDescriptor::GetOpAttr(const std::string& k) const
+{
+    int v;
+    if(GetOpAttr(k, v))
+    {
+        return OpKernelArg(v);
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown TensorAdd Op Attribute");
+}
+
+std::vector<std::pair<std::string, OpKernelArg>> TensorAddFusionOpDescriptor::GetArgs() const
+{
+    ConstData_t residual = nullptr;
+    std::vector<std::pair<std::string, OpKernelArg>> keys;
+    keys.emplace_back("residual" + std::to_string(GetIdx()), OpKernelArg(residual));
+    return keys;
+}
+
 static inline void
 find_replace_first(std::string& s_where, const std::string& s_find, const std::string& s_replace)
 {
@@ -926,6 +1092,19 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         MIOPEN_LOG_I2("A previous attempt to add an operator failed");
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    const auto compiled_key = GetCompiledKey(handle);
+    if(IsSolverCacheEnabled())
+    {
+        const auto cached = compiled_fusion_plans().Find(compiled_key);
+        if(cached && Restore(handle, **cached))
+        {
+            MIOPEN_LOG_I2("Compiled before: " << program_name << ',' << kernel_name);
+            compiled_plan = *cached;
+            return miopenStatusSuccess;
+        }
+    }
+
+    CompiledFusionPlan compiled;
     network_config =
         input_desc.ToString() + ((input_desc.GetType() == miopenHalf) ? "FP16" : "FP32");
     network_config +=
@@ -1050,6 +1229,9 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                                  vld,
                                  vgd,
                                  compile_config);
+                compiled.compile_config = compile_config;
+                compiled.vld            = vld;
+                compiled.vgd            = vgd;
 
                 status = miopenStatusSuccess;
             }
@@ -1062,9 +1244,52 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         }
     }
     arg_list = CalcArgOrder(handle);
+
+    if(status == miopenStatusSuccess && IsSolverCacheEnabled())
+    {
+        compiled.graph              = lu;
+        compiled.kernel_source_type = kernel_source_type;
+        compiled.network_config     = network_config;
+        compiled.program_name       = program_name;
+        compiled.kernel_name        = kernel_name;
+        compiled.algorithm_name     = algorithm_name;
+        compiled.arg_list           = arg_list;
+
+        compiled_plan = std::make_shared<const CompiledFusionPlan>(std::move(compiled));
+        compiled_fusion_plans().Insert(compiled_key, compiled_plan);
+    }
     return status;
 }
 
+std::string FusionPlanDescriptor::GetCompiledKey(Handle& handle) const
+{
+    return plan_key + '|' + handle.GetDbPathFilename();
+}
+
+bool FusionPlanDescriptor::Restore(Handle& handle, const CompiledFusionPlan& compiled)
+{
+    if(handle.GetKernels(compiled.algorithm_name, compiled.network_config).empty())
+    {
+        if(compiled.vgd.empty())
+            return false;
+        handle.AddKernel(compiled.algorithm_name,
+                         compiled.network_config,
+                         compiled.program_name,
+                         compiled.kernel_name,
+                         compiled.vld,
+                         compiled.vgd,
+                         compiled.compile_config);
+    }
+    lu                 = compiled.graph;
+    kernel_source_type = compiled.kernel_source_type;
+    network_config     = compiled.network_config;
+    program_name       = compiled.program_name;
+    kernel_name        = compiled.kernel_name;
+    algorithm_name     = compiled.algorithm_name;
+    arg_list           = compiled.arg_list;
+    return true;
+}
+
 std::vector<Exec_arg_t> FusionPlanDescriptor::CalcArgOrder(Handle& handle)
 {
     std::vector<Exec_arg_t> arg_keys;
@@ -28,6 +28,7 @@
 #include <miopen/env.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/measure_time.hpp>
 
 #if MIOPEN_USE_ROCBLAS
 #include <half.hpp>
@@ -42,6 +43,12 @@
 
 #include <boost/range/adaptors.hpp>
 
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <shared_mutex>
+#include <unordered_map>
+
 #if MIOPEN_USE_ROCBLAS
 #define ROCBLAS_TIMING_MEMSET_SIZE (10 * 1024 * 1024)
 #endif
@@ -165,6 +172,187 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     return gemm_backend_enforced;
 }
 
+static miopenStatus_t CallGemmStridedBatchedImpl(Handle& handle,
+                                                 GemmDescriptor gemm_desc,
+                                                 ConstData_t A,
+                                                 int a_offset,
+                                                 ConstData_t B,
+                                                 int b_offset,
+                                                 Data_t C,
+                                                 int c_offset,
+                                                 std::string* kcache_key,
+                                                 bool enqueue_dummy_kernel,
+                                                 GemmBackend_t gemm_backend);
+
+static miopenStatus_t CallGemmStridedBatchedSequentialImpl(Handle& handle,
+                                                           GemmDescriptor gemm_desc,
+                                                           ConstData_t A,
+                                                           int a_offset,
+                                                           ConstData_t B,
+                                                           int b_offset,
+                                                           Data_t C,
+                                                           int c_offset,
+                                                           std::string* kcache_key,
+                                                           bool enqueue_dummy_kernel,
+                                                           GemmBackend_t gemm_backend);
+
+// A strided batched GEMM whose batches write disjoint parts of C can run either as one
+// strided batched call or as a sequence of plain GEMMs. Which one is faster depends on the
+// shape and the device, so Find measures both and the result is kept here for the execution
+// path, keyed by the device as well as the GEMM. Every strided batched call looks the key up,
+// so it is a plain struct and lookups only take a shared lock.
+struct GemmPathKey
+{
+    std::size_t device;
+    GemmDescriptor gemm_desc;
+    GemmBackend_t gemm_backend;
+
+    friend bool operator==(const GemmPathKey& x, const GemmPathKey& y)
+    {
+        const auto& a = x.gemm_desc;
+        const auto& b = y.gemm_desc;
+        return x.device == y.device && x.gemm_backend == y.gemm_backend &&
+               a.isColMajor == b.isColMajor && a.transA == b.transA && a.transB == b.transB &&
+               a.m == b.m && a.n == b.n && a.k == b.k && a.lda == b.lda && a.ldb == b.ldb &&
+               a.ldc == b.ldc && a.batch_count == b.batch_count && a.strideA == b.strideA &&
+               a.strideB == b.strideB && a.strideC == b.strideC && a.alpha == b.alpha &&
+               a.beta == b.beta && a.dataType == b.dataType;
+    }
+};
+
+struct GemmPathKeyHash
+{
+    std::size_t operator()(const GemmPathKey& key) const
+    {
+        const auto& g     = key.gemm_desc;
+        std::size_t value = key.device;
+        for(const long long int x : {static_cast<long long int>(g.m),
+                                     static_cast<long long int>(g.n),
+                                     static_cast<long long int>(g.k),
+                                     static_cast<long long int>(g.batch_count),
+                                     g.strideA,
+                                     g.strideB,
+                                     g.strideC})
+            value = value * 31 + std::hash<long long int>{}(x);
+        return value;
+    }
+};
+
+struct GemmPathPreferences
+{
+    std::atomic<bool> empty{true};
+    std::shared_timed_mutex mutex;
+    std::unordered_map<GemmPathKey, CallGemmType_t, GemmPathKeyHash> paths;
+};
+
+static GemmPathPreferences& gemm_path_preferences()
+{
+    static GemmPathPreferences preferences;
+    return preferences;
+}
+
+static GemmPathKey
+gemm_path_key(Handle& handle, const GemmDescriptor& gemm_desc, GemmBackend_t gemm_backend)
+{
+    return {handle.GetDbPathHash(),
+            gemm_desc,
+            enforce_gemm_backend(gemm_desc.dataType, gemm_backend)};
+}
+
+static CallGemmType_t GetPreferredGemmPath(Handle& handle,
+                                           const GemmDescriptor& gemm_desc,
+                                           GemmBackend_t gemm_backend,
+                                           CallGemmType_t default_path)
+{
+    if(gemm_desc.batch_count <= 1 || !IsGemmBatchDisjoint(gemm_desc))
+        return default_path;
+
+    auto& preferences = gemm_path_preferences();
+    if(preferences.empty.load(std::memory_order_acquire))
+        return default_path;
+
+    const auto key = gemm_path_key(handle, gemm_desc, gemm_backend);
+    std::shared_lock<std::shared_timed_mutex> lock(preferences.mutex);
+    const auto it = preferences.paths.find(key);
+    return it == preferences.paths.end() ? default_path : it->second;
+}
+
+// Times `call` with MeasureTime(), the warm-up included, and leaves the median as the kernel
+// time of the handle.
+static miopenStatus_t MeasureGemm(Handle& handle,
+                                  const std::function<miopenStatus_t()>& call,
+                                  float* const time_out = nullptr,
+                                  const float best      = std::numeric_limits<float>::max())
+{
+    const auto timing = MeasureTime(
+        [&](float& time) {
+            const auto status = call();
+            time              = handle.GetKernelTime();
+            return static_cast<int>(status);
+        },
+        best);
+    if(timing.status != 0)
+        return static_cast<miopenStatus_t>(timing.status);
+    if(time_out != nullptr)
+        *time_out = timing.time;
+    handle.ResetKernelTime();
+    handle.AccumKernelTime(timing.time);
+    return miopenStatusSuccess;
+}
+
+// Times both interchangeable paths of a strided batched GEMM, remembers the faster one and
+// leaves its time as the kernel time of the handle.
+static miopenStatus_t MeasureGemmStridedBatchedPaths(Handle& handle,
+                                                     const GemmDescriptor& gemm_desc,
+                                                     ConstData_t A,
+                                                     int a_offset,
+                                                     ConstData_t B,
+                                                     int b_offset,
+                                                     Data_t C,
+                                                     int c_offset,
+                                                     std::string* kcache_key,
+                                                     GemmBackend_t gemm_backend)
+{
+    const auto call = [&](CallGemmType_t path, std::string* key, bool dummy) {
+        if(path == callGemmStridedBatched)
+            return CallGemmStridedBatchedImpl(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, key, dummy, gemm_backend);
+        return CallGemmStridedBatchedSequentialImpl(
+            handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, key, dummy, gemm_backend);
+    };
+
+    auto best_path = callGemmStridedBatched;
+    auto best_time = std::numeric_limits<float>::max();
+
+    for(auto path : {callGemmStridedBatched, callGemmStridedBatchedSequential})
+    {
+        float time        = 0;
+        const auto status = MeasureGemm(
+            handle, [&]() { return call(path, kcache_key, true); }, &time, best_time);
+        if(status != miopenStatusSuccess)
+            return status;
+
+        MIOPEN_LOG_I2("gemm path " << path << ": " << time << " ms");
+        if(time < best_time)
+        {
+            best_time = time;
+            best_path = path;
+        }
+    }
+
+    {
+        const auto key    = gemm_path_key(handle, gemm_desc, gemm_backend);
+        auto& preferences = gemm_path_preferences();
+        std::unique_lock<std::shared_timed_mutex> lock(preferences.mutex);
+        preferences.paths[key] = best_path;
+        preferences.empty.store(false, std::memory_order_release);
+    }
+
+    handle.ResetKernelTime();
+    handle.AccumKernelTime(best_time);
+    return miopenStatusSuccess;
+}
+
 miopenStatus_t CallGemmTimeMeasure(Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -183,20 +371,19 @@ miopenStatus_t CallGemmTimeMeasure(Handle& handle,
     case callGemm:
     {
         if(time_precision)
-        {
-            // rocBLAS need a warm-up call for accurate timing
-            CallGemm(handle,
-                     gemm_desc,
-                     A,
-                     a_offset,
-                     B,
-                     b_offset,
-                     C,
-                     c_offset,
-                     nullptr,
-                     false,
-                     gemm_backend);
-        }
+            return MeasureGemm(handle, [&]() {
+                return CallGemm(handle,
+                                gemm_desc,
+                                A,
+                                a_offset,
+                                B,
+                                b_offset,
+                                C,
+                                c_offset,
+                                kcache_key,
+                                true,
+                                gemm_backend);
+            });
 
         return CallGemm(handle,
                         gemm_desc,
@@ -212,22 +399,28 @@ miopenStatus_t CallGemmTimeMeasure(Handle& handle,
     }
     case callGemmStridedBatched:
     {
-        if(time_precision)
+        if(time_precision && gemm_desc.batch_count > 1 && IsGemmBatchDisjoint(gemm_desc) &&
+           enforce_gemm_backend(gemm_desc.dataType, gemm_backend) == GemmBackend_t::rocblas)
         {
-            // rocBLAS need extra warm-up call for accurate timing
-            CallGemmStridedBatched(handle,
-                                   gemm_desc,
-                                   A,
-                                   a_offset,
-                                   B,
-                                   b_offset,
-                                   C,
-                                   c_offset,
-                                   nullptr,
-                                   false,
-                                   gemm_backend);
+            return MeasureGemmStridedBatchedPaths(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, kcache_key, gemm_backend);
         }
 
+        if(time_precision)
+            return MeasureGemm(handle, [&]() {
+                return CallGemmStridedBatched(handle,
+                                              gemm_desc,
+                                              A,
+                                              a_offset,
+                                              B,
+                                              b_offset,
+                                              C,
+                                              c_offset,
+                                              kcache_key,
+                                              true,
+                                              gemm_backend);
+            });
+
         return CallGemmStridedBatched(handle,
                                       gemm_desc,
                                       A,
@@ -242,22 +435,28 @@ miopenStatus_t CallGemmTimeMeasure(Handle& handle,
     }
     case callGemmStridedBatchedSequential:
     {
-        if(time_precision)
+        if(time_precision && gemm_desc.batch_count > 1 && IsGemmBatchDisjoint(gemm_desc) &&
+           enforce_gemm_backend(gemm_desc.dataType, gemm_backend) == GemmBackend_t::rocblas)
         {
-            // rocBLAS need a warm-up call for accurate timing
-            CallGemmStridedBatchedSequential(handle,
-                                             gemm_desc,
-                                             A,
-                                             a_offset,
-                                             B,
-                                             b_offset,
-                                             C,
-                                             c_offset,
-                                             nullptr,
-                                             false,
-                                             gemm_backend);
+            return MeasureGemmStridedBatchedPaths(
+                handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, kcache_key, gemm_backend);
         }
 
+        if(time_precision)
+            return MeasureGemm(handle, [&]() {
+                return CallGemmStridedBatchedSequential(handle,
+                                                        gemm_desc,
+                                                        A,
+                                                        a_offset,
+                                                        B,
+                                                        b_offset,
+                                                        C,
+                                                        c_offset,
+                                                        kcache_key,
+                                                        true,
+                                                        gemm_backend);
+            });
+
         return CallGemmStridedBatchedSequential(handle,
                                                 gemm_desc,
                                                 A,
@@ -346,7 +545,7 @@ miopenStatus_t CallGemm(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -383,7 +582,7 @@ miopenStatus_t CallGemm(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -419,7 +618,7 @@ miopenStatus_t CallGemm(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -556,17 +755,17 @@ miopenStatus_t CallGemm(Handle& handle,
     return miopenStatusUnknownError;
 }
 
-miopenStatus_t CallGemmStridedBatched(Handle& handle,
-                                      GemmDescriptor gemm_desc,
-                                      ConstData_t A,
-                                      int a_offset,
-                                      ConstData_t B,
-                                      int b_offset,
-                                      Data_t C,
-                                      int c_offset,
-                                      std::string* kcache_key,
-                                      bool enqueue_dummy_kernel,
-                                      GemmBackend_t gemm_backend)
+static miopenStatus_t CallGemmStridedBatchedImpl(Handle& handle,
+                                                 GemmDescriptor gemm_desc,
+                                                 ConstData_t A,
+                                                 int a_offset,
+                                                 ConstData_t B,
+                                                 int b_offset,
+                                                 Data_t C,
+                                                 int c_offset,
+                                                 std::string* kcache_key,
+                                                 bool enqueue_dummy_kernel,
+                                                 GemmBackend_t gemm_backend)
 {
 #if !MIOPEN_USE_ROCBLAS
     (void)enqueue_dummy_kernel;
@@ -629,7 +828,7 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_strided_batched_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -671,7 +870,7 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_strided_batched_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -712,7 +911,7 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
 
             std::size_t zero = 0;
             rb_status        = rocblas_gemm_strided_batched_ex(
-                handle.rhandle().get(),
+                handle.rhandle(),
                 gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                 gemm_desc.m,
@@ -771,17 +970,17 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
 
     case GemmBackend_t::miopengemm: {
 #if MIOPEN_USE_MIOPENGEMM
-        return CallGemmStridedBatchedSequential(handle,
-                                                gemm_desc,
-                                                A,
-                                                a_offset,
-                                                B,
-                                                b_offset,
-                                                C,
-                                                c_offset,
-                                                kcache_key,
-                                                enqueue_dummy_kernel,
-                                                gemm_backend);
+        return CallGemmStridedBatchedSequentialImpl(handle,
+                                                    gemm_desc,
+                                                    A,
+                                                    a_offset,
+                                                    B,
+                                                    b_offset,
+                                                    C,
+                                                    c_offset,
+                                                    kcache_key,
+                                                    enqueue_dummy_kernel,
+                                                    gemm_backend);
 #else
         return miopenStatusNotImplemented;
 #endif
@@ -791,17 +990,17 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
     return miopenStatusUnknownError;
 }
 
-miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
-                                                GemmDescriptor gemm_desc,
-                                                ConstData_t A,
-                                                int a_offset,
-                                                ConstData_t B,
-                                                int b_offset,
-                                                Data_t C,
-                                                int c_offset,
-                                                std::string* kcache_key,
-                                                bool enqueue_dummy_kernel,
-                                                GemmBackend_t gemm_backend)
+static miopenStatus_t CallGemmStridedBatchedSequentialImpl(Handle& handle,
+                                                           GemmDescriptor gemm_desc,
+                                                           ConstData_t A,
+                                                           int a_offset,
+                                                           ConstData_t B,
+                                                           int b_offset,
+                                                           Data_t C,
+                                                           int c_offset,
+                                                           std::string* kcache_key,
+                                                           bool enqueue_dummy_kernel,
+                                                           GemmBackend_t gemm_backend)
 {
 #if !MIOPEN_USE_ROCBLAS
     (void)enqueue_dummy_kernel;
@@ -866,7 +1065,7 @@ miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
             for(int i = 0; i < gemm_desc.batch_count; ++i)
             {
                 rb_status = rocblas_gemm_ex(
-                    handle.rhandle().get(),
+                    handle.rhandle(),
                     gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.m,
@@ -906,7 +1105,7 @@ miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
             for(int i = 0; i < gemm_desc.batch_count; ++i)
             {
                 rb_status = rocblas_gemm_ex(
-                    handle.rhandle().get(),
+                    handle.rhandle(),
                     gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.m,
@@ -945,7 +1144,7 @@ miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
             for(int i = 0; i < gemm_desc.batch_count; ++i)
             {
                 rb_status = rocblas_gemm_ex(
-                    handle.rhandle().get(),
+                    handle.rhandle(),
                     gemm_desc.transA ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.transB ? rocblas_operation_transpose : rocblas_operation_none,
                     gemm_desc.m,
@@ -1109,6 +1308,204 @@ miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
     return miopenStatusUnknownError;
 }
 
+miopenStatus_t CallGemmStridedBatched(Handle& handle,
+                                      GemmDescriptor gemm_desc,
+                                      ConstData_t A,
+                                      int a_offset,
+                                      ConstData_t B,
+                                      int b_offset,
+                                      Data_t C,
+                                      int c_offset,
+                                      std::string* kcache_key,
+                                      bool enqueue_dummy_kernel,
+                                      GemmBackend_t gemm_backend)
+{
+    if(GetPreferredGemmPath(handle, gemm_desc, gemm_backend, callGemmStridedBatched) ==
+       callGemmStridedBatchedSequential)
+    {
+        return CallGemmStridedBatchedSequentialImpl(handle,
+                                                    gemm_desc,
+                                                    A,
+                                                    a_offset,
+                                                    B,
+                                                    b_offset,
+                                                    C,
+                                                    c_offset,
+                                                    kcache_key,
+                                                    enqueue_dummy_kernel,
+                                                    gemm_backend);
+    }
+
+    return CallGemmStridedBatchedImpl(handle,
+                                      gemm_desc,
+                                      A,
+                                      a_offset,
+                                      B,
+                                      b_offset,
+                                      C,
+                                      c_offset,
+                                      kcache_key,
+                                      enqueue_dummy_kernel,
+                                      gemm_backend);
+}
+
+miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
+                                                GemmDescriptor gemm_desc,
+                                                ConstData_t A,
+                                                int a_offset,
+                                                ConstData_t B,
+                                                int b_offset,
+                                                Data_t C,
+                                                int c_offset,
+                                                std::string* kcache_key,
+                                                bool enqueue_dummy_kernel,
+                                                GemmBackend_t gemm_backend)
+{
+    if(GetPreferredGemmPath(handle, gemm_desc, gemm_backend, callGemmStridedBatchedSequential) ==
+       callGemmStridedBatched)
+    {
+        return CallGemmStridedBatchedImpl(handle,
+                                          gemm_desc,
+                                          A,
+                                          a_offset,
+                                          B,
+                                          b_offset,
+                                          C,
+                                          c_offset,
+                                          kcache_key,
+                                          enqueue_dummy_kernel,
+                                          gemm_backend);
+    }
+
+    return CallGemmStridedBatchedSequentialImpl(handle,
+                                                gemm_desc,
+                                                A,
+                                                a_offset,
+                                                B,
+                                                b_offset,
+                                                C,
+                                                c_offset,
+                                                kcache_key,
+                                                enqueue_dummy_kernel,
+                                                gemm_backend);
+}
+
+bool IsGemmBatchDisjoint(const GemmDescriptor& gemm_desc)
+{
+    if(gemm_desc.batch_count <= 1)
+        return true;
+
+    // span of one C matrix in memory
+    const long long int c_span =
+        gemm_desc.isColMajor
+            ? static_cast<long long int>(gemm_desc.ldc) * (gemm_desc.n - 1) + gemm_desc.m
+            : static_cast<long long int>(gemm_desc.ldc) * (gemm_desc.m - 1) + gemm_desc.n;
+
+    return gemm_desc.strideC >= c_span;
+}
+
+static bool is_same_gemm_shape(const GemmDescriptor& a, const GemmDescriptor& b)
+{
+    return a.isColMajor == b.isColMajor && a.transA == b.transA && a.transB == b.transB &&
+           a.m == b.m && a.n == b.n && a.k == b.k && a.lda == b.lda && a.ldb == b.ldb &&
+           a.ldc == b.ldc && a.alpha == b.alpha && a.beta == b.beta && a.dataType == b.dataType;
+}
+
+std::vector<GemmGroupMember> CoalesceGemmGroup(const std::vector<GemmGroupMember>& members)
+{
+    std::vector<GemmGroupMember> runs;
+
+    for(const auto& member : members)
+    {
+        if(!runs.empty() && member.gemm_desc.batch_count == 1)
+        {
+            auto& run  = runs.back();
+            auto& desc = run.gemm_desc;
+
+            if(is_same_gemm_shape(desc, member.gemm_desc) && run.A == member.A &&
+               run.B == member.B && run.C == member.C)
+            {
+                if(desc.batch_count == 1)
+                {
+                    GemmDescriptor candidate = desc;
+                    candidate.batch_count    = 2;
+                    candidate.strideA        = member.a_offset - run.a_offset;
+                    candidate.strideB        = member.b_offset - run.b_offset;
+                    candidate.strideC        = member.c_offset - run.c_offset;
+
+                    if(IsGemmBatchDisjoint(candidate))
+                    {
+                        desc = candidate;
+                        continue;
+                    }
+                }
+                else if(member.a_offset == run.a_offset + desc.batch_count * desc.strideA &&
+                        member.b_offset == run.b_offset + desc.batch_count * desc.strideB &&
+                        member.c_offset == run.c_offset + desc.batch_count * desc.strideC)
+                {
+                    desc.batch_count++;
+                    continue;
+                }
+            }
+        }
+
+        runs.push_back(member);
+    }
+
+    return runs;
+}
+
+miopenStatus_t CallGemmGrouped(Handle& handle,
+                               const std::vector<GemmGroupMember>& members,
+                               bool enqueue_dummy_kernel,
+                               GemmBackend_t gemm_backend)
+{
+    const auto runs = CoalesceGemmGroup(members);
+    MIOPEN_LOG_I2("grouped gemm: " << members.size() << " gemm(s) in " << runs.size()
+                                   << " submission(s)");
+
+    float time = 0;
+    for(const auto& run : runs)
+    {
+        const auto status = run.gemm_desc.batch_count == 1
+                                ? CallGemm(handle,
+                                           run.gemm_desc,
+                                           run.A,
+                                           run.a_offset,
+                                           run.B,
+                                           run.b_offset,
+                                           run.C,
+                                           run.c_offset,
+                                           nullptr,
+                                           enqueue_dummy_kernel,
+                                           gemm_backend)
+                                : CallGemmStridedBatched(handle,
+                                                         run.gemm_desc,
+                                                         run.A,
+                                                         run.a_offset,
+                                                         run.B,
+                                                         run.b_offset,
+                                                         run.C,
+                                                         run.c_offset,
+                                                         nullptr,
+                                                         enqueue_dummy_kernel,
+                                                         gemm_backend);
+        if(status != miopenStatusSuccess)
+            return status;
+
+        if(handle.IsProfilingEnabled())
+            time += handle.GetKernelTime();
+    }
+
+    if(handle.IsProfilingEnabled())
+    {
+        handle.ResetKernelTime();
+        handle.AccumKernelTime(time);
+    }
+
+    return miopenStatusSuccess;
+}
+
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
                                            const TensorDescriptor& xDesc,
@@ -1416,6 +1813,57 @@ GemmDescriptor CreateGemmStridedBatchedDescriptorConv1x1Fwd(const TensorDescript
                           xDesc.GetType()};
 }
 
+// y = x * transpose(w), x and y channels-last
+GemmDescriptor CreateGemmDescriptorConvChannelsLast1x1Fwd(const TensorDescriptor& wDesc,
+                                                          const TensorDescriptor& xDesc,
+                                                          const TensorDescriptor& yDesc)
+{
+#ifndef NDEBUG
+    assert(wDesc.GetType() == xDesc.GetType() && wDesc.GetType() == yDesc.GetType());
+#else
+    (void)yDesc;
+#endif
+
+    int in_c  = xDesc.GetLengths()[1];
+    int wei_k = wDesc.GetLengths()[0];
+
+    // All of N and the spatial dimensions form the rows, since C (K) is innermost
+    auto in_pixels = xDesc.GetElementSize() / in_c;
+
+    bool isColMajor       = false;
+    bool transA           = false;
+    bool transB           = true;
+    int m                 = in_pixels;
+    int n                 = wei_k;
+    int k                 = in_c;
+    int lda               = k;
+    int ldb               = k;
+    int ldc               = n;
+    int batch_count       = 1;
+    long long int strideA = 0;
+    long long int strideB = 0;
+    long long int strideC = 0;
+    float alpha           = 1.;
+    float beta            = 0.;
+
+    return GemmDescriptor{isColMajor,
+                          transA,
+                          transB,
+                          m,
+                          n,
+                          k,
+                          lda,
+                          ldb,
+                          ldc,
+                          batch_count,
+                          strideA,
+                          strideB,
+                          strideC,
+                          alpha,
+                          beta,
+                          xDesc.GetType()};
+}
+
 // dx[i] = transpose(w) * dy[i], i is batch id
 GemmDescriptor CreateGemmStridedBatchedDescriptorConv1x1BwdData(const TensorDescriptor& wDesc,
                                                                 const TensorDescriptor& dyDesc,
@@ -75,6 +75,36 @@ extern "C" miopenStatus_t miopenGetStream(miopenHandle_t handle, miopenAccelerat
     return miopen::try_([&] { miopen::deref(streamID) = miopen::deref(handle).GetStream(); });
 }
 
+extern "C" miopenStatus_t
+miopenAddStream(miopenHandle_t handle, miopenAcceleratorQueue_t streamID, int* index)
+{
+    return miopen::try_([&] { miopen::deref(index) = miopen::deref(handle).AddStream(streamID); });
+}
+
+extern "C" miopenStatus_t miopenGetStreamCount(miopenHandle_t handle, int* count)
+{
+    return miopen::try_([&] { miopen::deref(count) = miopen::deref(handle).GetStreamCount(); });
+}
+
+extern "C" miopenStatus_t miopenSetActiveStream(miopenHandle_t handle, int index)
+{
+    return miopen::try_([&] {
+        if(index < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Stream index is negative");
+        miopen::deref(handle).SetActiveStream(index);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenStreamWaitStream(miopenHandle_t handle, int waitingIndex, int signallingIndex)
+{
+    return miopen::try_([&] {
+        if(waitingIndex < 0 || signallingIndex < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Stream index is negative");
+        miopen::deref(handle).StreamWaitStream(waitingIndex, signallingIndex);
+    });
+}
+
 extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
                                              miopenAllocatorFunction allocator,
                                              miopenDeallocatorFunction deallocator,
@@ -32,6 +32,7 @@
 #include <boost/filesystem.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/gemm_geometry.hpp>
+#include <miopen/trace.hpp>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -39,6 +40,7 @@
 
 #include <cassert>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 namespace miopen {
@@ -138,8 +140,9 @@ struct HandleImpl
 
     void elapsed_time(hipEvent_t start, hipEvent_t stop)
     {
-        if(enable_profiling)
-            hipEventElapsedTime(&this->profiling_result, start, stop);
+        auto& state = thread_state();
+        if(state.enable_profiling)
+            hipEventElapsedTime(&state.profiling_result, start, stop);
     }
 
     std::function<void(hipEvent_t, hipEvent_t)> elapsed_time_handler()
@@ -157,13 +160,47 @@ struct HandleImpl
             MIOPEN_THROW("Running handle on wrong device");
     }
 
-    bool enable_profiling  = false;
-    StreamPtr stream       = nullptr;
-    float profiling_result = 0.0;
-    int device             = -1;
+    detail::ThreadHandleState& thread_state() const
+    {
+        return detail::GetThreadHandleState(id, alive);
+    }
+
+    // Callers hold streams_mutex
+    std::size_t active_stream() const
+    {
+        return streams.size() == 1 ? 0 : thread_state().active_stream;
+    }
+
+    // Callers hold streams_mutex
+    void push_stream(StreamPtr stream)
+    {
+#if MIOPEN_USE_ROCBLAS
+        rocblas_handle x = nullptr;
+        rocblas_create_handle(&x);
+        auto rhandle = rocblas_handle_ptr{x};
+        rocblas_set_stream(rhandle.get(), stream.get());
+        rhandles.push_back(std::move(rhandle));
+#endif
+        streams.push_back(std::move(stream));
+    }
+
+    // AddStream may grow streams while other threads launch work, so every access to it after
+    // construction holds streams_mutex
+    std::vector<StreamPtr> streams;
+#if MIOPEN_USE_ROCBLAS
+    // One rocBLAS handle per stream, parallel to streams
+    std::vector<rocblas_handle_ptr> rhandles;
+#endif
+    std::mutex streams_mutex;
+    int device = -1;
     Allocator allocator{};
     KernelCache cache;
+    std::mutex cache_mutex;
+    std::once_flag db_path_hash_once;
+    std::size_t db_path_hash = 0;
     hipCtx_t ctx;
+    const std::size_t id = detail::NewHandleId();
+    const std::shared_ptr<const void> alive = std::make_shared<char>();
 };
 
 Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
@@ -172,15 +209,11 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
     this->impl->ctx    = get_ctx();
 
     if(stream == nullptr)
-        this->impl->stream = HandleImpl::reference_stream(nullptr);
+        this->impl->push_stream(HandleImpl::reference_stream(nullptr));
     else
-        this->impl->stream = HandleImpl::reference_stream(stream);
+        this->impl->push_stream(HandleImpl::reference_stream(stream));
 
     this->SetAllocator(nullptr, nullptr, nullptr);
-
-#if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
-#endif
 }
 
 Handle::Handle() : impl(new HandleImpl())
@@ -188,31 +221,99 @@ Handle::Handle() : impl(new HandleImpl())
 #if MIOPEN_BUILD_DEV
     this->impl->device = set_default_device();
     this->impl->ctx    = get_ctx();
-    this->impl->stream = impl->create_stream();
+    this->impl->push_stream(impl->create_stream());
 #else
     this->impl->device = get_device_id();
     this->impl->ctx    = get_ctx();
-    this->impl->stream = HandleImpl::reference_stream(nullptr);
+    this->impl->push_stream(HandleImpl::reference_stream(nullptr));
 #endif
     this->SetAllocator(nullptr, nullptr, nullptr);
-
-#if MIOPEN_USE_ROCBLAS
-    rhandle_ = CreateRocblasHandle();
-#endif
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    if(impl != nullptr)
+        detail::EraseThreadHandleState(impl->id);
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
-    this->impl->stream = HandleImpl::reference_stream(streamID);
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    const auto index     = impl->active_stream();
+    impl->streams[index] = HandleImpl::reference_stream(streamID);
 
 #if MIOPEN_USE_ROCBLAS
-    rocblas_set_stream(this->rhandle_.get(), this->GetStream());
+    rocblas_set_stream(impl->rhandles[index].get(), streamID);
 #endif
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->streams[impl->active_stream()].get();
+}
+
+std::size_t Handle::AddStream()
+{
+    this->impl->set_ctx();
+    auto stream = impl->create_stream();
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    impl->push_stream(std::move(stream));
+    return impl->streams.size() - 1;
+}
+
+std::size_t Handle::AddStream(miopenAcceleratorQueue_t stream)
+{
+    if(stream == nullptr)
+        return this->AddStream();
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    impl->push_stream(HandleImpl::reference_stream(stream));
+    return impl->streams.size() - 1;
+}
+
+std::size_t Handle::GetStreamCount() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->streams.size();
+}
+
+void Handle::SetActiveStream(std::size_t index) const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    if(index >= impl->streams.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Stream index out of range: " + std::to_string(index));
+    impl->thread_state().active_stream = index;
+}
+
+std::size_t Handle::GetActiveStream() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->active_stream();
+}
+
+void Handle::StreamWaitStream(std::size_t waiting, std::size_t signalling) const
+{
+    hipStream_t waiting_stream    = nullptr;
+    hipStream_t signalling_stream = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->streams_mutex);
+        if(waiting >= impl->streams.size() || signalling >= impl->streams.size())
+            MIOPEN_THROW(miopenStatusBadParm, "Stream index out of range");
+        waiting_stream    = impl->streams[waiting].get();
+        signalling_stream = impl->streams[signalling].get();
+    }
+    if(waiting == signalling)
+        return;
+
+    this->impl->set_ctx();
+    auto ev     = make_hip_event();
+    auto status = hipEventRecord(ev.get(), signalling_stream);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Recording stream event failed");
+    status = hipStreamWaitEvent(waiting_stream, ev.get(), 0);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Waiting for stream event failed");
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -224,9 +325,22 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
     this->impl->allocator.context = allocatorContext;
 }
 
-void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
+void Handle::EnableProfiling(bool enable)
+{
+    this->impl->thread_state().enable_profiling = enable;
+}
+
+float Handle::GetKernelTime() const { return this->impl->thread_state().profiling_result; }
 
-float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+const std::vector<FindSkipped>& Handle::GetFindSkipped() const
+{
+    return this->impl->thread_state().find_skipped;
+}
+
+void Handle::SetFindSkipped(std::vector<FindSkipped> skipped) const
+{
+    this->impl->thread_state().find_skipped = std::move(skipped);
+}
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz)
 {
@@ -271,45 +385,66 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& params,
                                std::size_t cache_index)
 {
-
-    auto obj = this->impl->cache.AddKernel(
-        *this, algorithm, network_config, program_name, kernel_name, vld, vgd, params, cache_index);
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           this->impl->cache_mutex,
+                                           algorithm,
+                                           network_config,
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index);
     return this->Run(obj);
 }
 
 void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config)
 {
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     return this->impl->cache.HasKernels(algorithm, network_config);
 }
 
 KernelInvoke Handle::Run(Kernel k)
 {
     this->impl->set_ctx();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
+    if(this->impl->thread_state().enable_profiling || MIOPEN_GPU_SYNC)
         return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
     else
         return k.Invoke(this->GetStream());
 }
 
+KernelInvoke Handle::Run(Kernel k, const std::vector<size_t>& vgd)
+{
+    assert(!vgd.empty() && vgd.size() <= 3);
+    auto invoke = this->Run(std::move(k));
+    invoke.gdims.fill(1);
+    std::copy(vgd.begin(), vgd.end(), invoke.gdims.begin());
+    return invoke;
+}
+
 Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
 {
+    MIOPEN_TRACE_SCOPE("compile", [&] { return program_name; });
     this->impl->set_ctx();
     params += " -mcpu=" + this->GetDeviceName();
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
     if(cache_file.empty())
     {
+        MIOPEN_TRACE_SCOPE("build", [&] { return program_name; });
         auto p = HIPOCProgram{program_name, params, is_kernel_str};
 
         // Save to cache
@@ -352,10 +487,16 @@ void Handle::Finish() const
 }
 void Handle::Flush() const {}
 
-bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+bool Handle::IsProfilingEnabled() const
+{
+    return this->impl->thread_state().enable_profiling;
+}
 
-void Handle::ResetKernelTime() { this->impl->profiling_result = 0.0; }
-void Handle::AccumKernelTime(float curr_time) { this->impl->profiling_result += curr_time; }
+void Handle::ResetKernelTime() { this->impl->thread_state().profiling_result = 0.0; }
+void Handle::AccumKernelTime(float curr_time)
+{
+    this->impl->thread_state().profiling_result += curr_time;
+}
 
 std::size_t Handle::GetLocalMemorySize()
 {
@@ -403,6 +544,14 @@ std::string Handle::GetDeviceName()
     return GetDeviceNameFromMap(n);
 }
 
+std::size_t Handle::GetDbPathHash()
+{
+    std::call_once(impl->db_path_hash_once, [&] {
+        impl->db_path_hash = std::hash<std::string>{}(this->GetDbPathFilename());
+    });
+    return impl->db_path_hash;
+}
+
 shared<Data_t> Handle::CreateSubBuffer(Data_t data, std::size_t offset, std::size_t)
 {
     auto cdata = reinterpret_cast<char*>(data);
@@ -416,13 +565,10 @@ shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset
 }
 
 #if MIOPEN_USE_ROCBLAS
-rocblas_handle_ptr Handle::CreateRocblasHandle() const
+rocblas_handle Handle::rhandle() const
 {
-    rocblas_handle x = nullptr;
-    rocblas_create_handle(&x);
-    auto result = rocblas_handle_ptr{x};
-    rocblas_set_stream(result.get(), GetStream());
-    return result;
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->rhandles[impl->active_stream()].get();
 }
 #endif
 } // namespace miopen
@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_kernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 #include <thread>
 #include <hip/hip_hcc.h>
 #include <hip/hip_runtime.h>
@@ -36,6 +37,8 @@ namespace miopen {
 
 void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 {
+    MIOPEN_TRACE_SCOPE("launch", trace_name);
+
     HipEventPtr start = nullptr;
     HipEventPtr stop  = nullptr;
     void* config[]    = {
@@ -99,6 +102,6 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
                                       std::function<void(hipEvent_t, hipEvent_t)> callback)
 {
-    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, callback};
+    return HIPOCKernelInvoke{stream, fun, ldims, gdims, name, trace_name, callback};
 }
 } // namespace miopen
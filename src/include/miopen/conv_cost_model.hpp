@@ -0,0 +1,164 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_COST_MODEL_HPP_
+#define GUARD_MIOPEN_CONV_COST_MODEL_HPP_
+
+#include <miopen/problem_description.hpp>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Problem properties a cost model looks at. Filled from a ProblemDescription and, when
+/// available, the device the problem runs on.
+struct ConvCostFeatures
+{
+    double macs               = 0; // multiply-accumulates of the direct algorithm
+    double bytes              = 0; // input, weights and output
+    double filter_size        = 1; // kernel_size_h * kernel_size_w
+    double group_inputs       = 1; // input channels per group
+    double out_pixels         = 1; // batch * output height * output width
+    double type_size          = 4;
+    bool strided              = false;
+    bool dilated              = false;
+    std::size_t compute_units = 64;
+
+    static ConvCostFeatures From(const ProblemDescription& problem, Handle* handle = nullptr);
+
+    static constexpr std::size_t vector_size = 5;
+    /// Regressors of the linear model: 1 and the logarithms of macs, bytes, group_inputs and
+    /// out_pixels.
+    std::array<double, vector_size> AsVector() const;
+};
+
+/// Predicts the time in ms that a solver takes for a problem, without running anything.
+/// Solver ids are those stored in find-db: SolverDbId() for the solvers, "gemm" and "fft" for
+/// the GEMM and FFT algorithms.
+class ConvCostModel
+{
+    public:
+    virtual ~ConvCostModel() = default;
+    virtual float Estimate(const ConvCostFeatures& features,
+                           const std::string& solver_id) const = 0;
+};
+
+/// Deterministic roofline estimate: the larger of compute time at a per-solver fraction of the
+/// device peak and memory time, plus a launch overhead. Good enough to order solvers when no
+/// measurements exist.
+class HeuristicConvCostModel : public ConvCostModel
+{
+    public:
+    float Estimate(const ConvCostFeatures& features, const std::string& solver_id) const override;
+};
+
+/// One measured time, e.g. a find-db entry.
+struct ConvCostSample
+{
+    ProblemDescription problem;
+    std::string solver_id;
+    float time = 0;
+};
+
+/// Per-solver least-squares fit of log(time) on ConvCostFeatures::AsVector(). Solvers without
+/// enough samples are estimated by the heuristic model.
+class LinearConvCostModel : public ConvCostModel
+{
+    public:
+    using Weights = std::array<double, ConvCostFeatures::vector_size>;
+
+    float Estimate(const ConvCostFeatures& features, const std::string& solver_id) const override;
+
+    void Fit(const std::vector<ConvCostSample>& samples);
+    const std::map<std::string, Weights>& GetWeights() const { return weights; }
+
+    /// Text format, one "solver_id:w0,w1,w2,w3,w4" line per solver.
+    void Save(std::ostream& os) const;
+    bool Load(std::istream& is);
+
+    private:
+    std::map<std::string, Weights> weights;
+    HeuristicConvCostModel fallback;
+};
+
+/// Parses a db key written by ProblemDescription::Serialize().
+boost::optional<ProblemDescription> ParseConvProblemKey(const std::string& key);
+
+/// Reads all entries of a find-db text file. Entries with unparsable keys or non-positive
+/// times are skipped.
+std::vector<ConvCostSample> LoadConvCostSamples(const std::string& find_db_path);
+
+/// The model used to rank solvers. Unless replaced with SetConvCostModel(), this is the model
+/// named by MIOPEN_CONV_COST_MODEL: a file written by LinearConvCostModel::Save(), or a find-db
+/// file (*.fdb.txt) to fit on first use. Without the variable the heuristic model is used.
+std::shared_ptr<const ConvCostModel> GetConvCostModel();
+void SetConvCostModel(std::shared_ptr<const ConvCostModel> model);
+
+/// Number of top-ranked applicable solvers that Find evaluates; 0 means all
+/// (MIOPEN_CONV_FIND_TOP_K).
+std::size_t GetConvFindTopK();
+
+inline float EstimateConvCost(const ProblemDescription& problem,
+                              const std::string& solver_id,
+                              Handle* handle = nullptr)
+{
+    return GetConvCostModel()->Estimate(ConvCostFeatures::From(problem, handle), solver_id);
+}
+
+/// Stable-sorts solutions (anything with a solver_id member) by estimated time, fastest first.
+template <class Solution>
+void RankByConvCost(const ProblemDescription& problem,
+                    std::vector<Solution>& solutions,
+                    Handle* handle = nullptr)
+{
+    const auto features = ConvCostFeatures::From(problem, handle);
+    const auto model    = GetConvCostModel();
+    std::vector<std::pair<float, Solution>> ranked;
+    ranked.reserve(solutions.size());
+    for(auto&& s : solutions)
+        ranked.emplace_back(model->Estimate(features, s.solver_id), std::move(s));
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& l, const auto& r) {
+        return l.first < r.first;
+    });
+    solutions.clear();
+    for(auto&& r : ranked)
+        solutions.push_back(std::move(r.second));
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_COST_MODEL_HPP_
@@ -31,6 +31,7 @@
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -39,6 +40,8 @@ namespace miopen {
 
 namespace solver {
 struct ConvSolution;
+template <class Solution>
+struct DeferredSolution;
 } // namespace solver
 struct Handle;
 struct TensorDescriptor;
@@ -204,6 +207,18 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                             std::string& network_config,
                             ExtraKernelArgs& extraArgs) const;
 
+    /// Same solutions as FindDataDirectSolutions(), but each is only searched when its find
+    /// is called.
+    std::vector<miopen::solver::DeferredSolution<miopen::solver::ConvSolution>>
+    DeferDataDirectSolutions(Handle& handle,
+                             const TensorDescriptor& xDesc,
+                             const TensorDescriptor& wDesc,
+                             const TensorDescriptor& yDesc,
+                             bool exhaustiveSearch,
+                             bool isForward,
+                             std::string& network_config,
+                             ExtraKernelArgs& extraArgs) const;
+
     void ConvolutionForward(Handle& handle,
                             const void* alpha,
                             const TensorDescriptor& xDesc,
@@ -217,6 +232,37 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                             Data_t workSpace,
                             std::size_t workSpaceSize) const;
 
+    /// Applicable forward solutions, fastest first. Times are taken from find-db when a Find
+    /// was run before, and from the convolution cost model otherwise.
+    std::vector<miopenConvSolution_t> GetForwardSolutions(Handle& handle,
+                                                          const TensorDescriptor& wDesc,
+                                                          const TensorDescriptor& xDesc,
+                                                          const TensorDescriptor& yDesc) const;
+
+    std::size_t GetForwardSolutionWorkspaceSize(Handle& handle,
+                                                const TensorDescriptor& wDesc,
+                                                const TensorDescriptor& xDesc,
+                                                const TensorDescriptor& yDesc,
+                                                std::uint64_t solution_id) const;
+
+    void CompileForwardSolution(Handle& handle,
+                                const TensorDescriptor& wDesc,
+                                const TensorDescriptor& xDesc,
+                                const TensorDescriptor& yDesc,
+                                std::uint64_t solution_id) const;
+
+    /// Runs a solution without a previous Find, compiling it first if needed.
+    void ConvolutionForwardImmediate(Handle& handle,
+                                     const TensorDescriptor& wDesc,
+                                     ConstData_t w,
+                                     const TensorDescriptor& xDesc,
+                                     ConstData_t x,
+                                     const TensorDescriptor& yDesc,
+                                     Data_t y,
+                                     Data_t workSpace,
+                                     std::size_t workSpaceSize,
+                                     std::uint64_t solution_id) const;
+
     std::size_t BackwardDataGetWorkSpaceSizeGEMM(const TensorDescriptor& wDesc,
                                                  const TensorDescriptor& dyDesc) const;
 
@@ -308,6 +354,8 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     std::vector<int> trans_output_pads;
     int group_count;
     float lowp_quant; // quantization factor for low precision
+    /// Wall-clock budget of forward Find in ms, 0 means unlimited
+    float find_time_budget = 0;
 };
 
 void ConvolutionBackwardBias(Handle& handle,
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_MERGE_HPP_
+#define GUARD_MIOPEN_DB_MERGE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+enum class DbKind
+{
+    Perf, // *.pdb.txt, *.updb.txt: ID is the solver, VALUES its performance config
+    Find, // *.fdb.txt: ID is the algorithm, VALUES a FindDbData
+};
+
+struct DbMergeStats
+{
+    std::size_t files     = 0;
+    std::size_t records   = 0; // keys written
+    std::size_t entries   = 0; // ID:VALUES pairs written
+    std::size_t conflicts = 0; // key and ID pairs with different VALUES in the inputs
+    std::size_t by_time   = 0; // conflicts resolved by the fastest measured time
+    std::size_t by_vote   = 0; // conflicts resolved by majority vote
+    std::size_t invalid   = 0; // entries dropped by the validator
+    std::size_t malformed = 0; // lines and entries that could not be parsed
+};
+
+std::ostream& operator<<(std::ostream& os, const DbMergeStats& stats);
+
+/// Returns false for an entry that shall not be merged.
+using DbEntryValidator = std::function<bool(
+    const std::string& key, const std::string& id, const std::string& values)>;
+
+/// Checks perf-db entries with IsValidPerformanceConfig() of their solver, for the problem
+/// parsed from the key on the device of `handle`. Entries of solvers that are not searchable in
+/// this version, and records with keys that cannot be parsed, are rejected.
+DbEntryValidator MakePerfDbValidator(Handle& handle);
+
+/// Merges text databases tuned on several machines into one, e.g. to be installed as the system
+/// database of all machines with the same device.
+///
+/// When inputs disagree on the VALUES of an ID, find-db entries are resolved by the fastest
+/// measured time, and perf-db entries, which carry no time, by majority vote. A tie goes to the
+/// input added first, so inputs shall be added in the order of preference.
+class DbMerger
+{
+    public:
+    explicit DbMerger(DbKind kind_, DbEntryValidator validate_ = nullptr);
+
+    /// Returns false if the file cannot be read.
+    bool AddFile(const std::string& path);
+    void Add(std::istream& stream);
+
+    /// Writes the merged records sorted by key, and updates the resolution counts of the stats.
+    void Write(std::ostream& stream);
+    /// Returns false if the file cannot be written.
+    bool WriteFile(const std::string& path);
+
+    const DbMergeStats& GetStats() const { return stats; }
+
+    private:
+    struct Candidate
+    {
+        std::string values;
+        std::size_t votes;
+        float time; // find-db only, <= 0 if not measured
+    };
+
+    void AddEntry(const std::string& key, const std::string& id, const std::string& values);
+    const Candidate& Resolve(const std::vector<Candidate>& candidates);
+
+    DbKind kind;
+    DbEntryValidator validate;
+    std::map<std::string, std::map<std::string, std::vector<Candidate>>> records;
+    DbMergeStats stats;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_MERGE_HPP_
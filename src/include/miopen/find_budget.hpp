@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_BUDGET_HPP_
+#define GUARD_MIOPEN_FIND_BUDGET_HPP_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// A Find candidate that was not timed.
+struct FindSkipped
+{
+    std::string algorithm;
+    std::string solver_id;
+    float estimate; // ms, as predicted by the cost model
+};
+
+/// Evaluates Find candidates under a wall-clock budget.
+///
+/// Without a budget every candidate is evaluated in the order it was added. With one, candidates
+/// run in the order of their estimated time. Measured times calibrate the estimates: the
+/// smallest ratio of measured to estimated time seen so far is applied to the estimates of the
+/// remaining candidates. A candidate is skipped when its calibrated estimate, even if
+/// `plausibility` times too pessimistic, cannot beat the best measured time, or when the budget
+/// has run out. The first candidate always runs.
+class FindBudget
+{
+    public:
+    /// Returns the measured time in ms, or a negative value if the candidate is not applicable.
+    using Evaluate = std::function<float()>;
+
+    static constexpr float plausibility = 2.0f;
+
+    /// budget_ms <= 0 means unlimited.
+    explicit FindBudget(float budget_ms_);
+
+    void Add(const std::string& algorithm,
+             const std::string& solver_id,
+             float estimate,
+             Evaluate evaluate);
+    void Run();
+
+    const std::vector<FindSkipped>& GetSkipped() const { return skipped; }
+
+    private:
+    struct Candidate
+    {
+        FindSkipped info;
+        Evaluate evaluate;
+    };
+
+    float budget_ms;
+    std::chrono::steady_clock::time_point start;
+    std::vector<Candidate> candidates;
+    std::vector<FindSkipped> skipped;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_BUDGET_HPP_
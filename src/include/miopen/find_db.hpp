@@ -38,6 +38,7 @@
 #include <miopen/env.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/trace.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_FIND_DB)
 
@@ -46,10 +47,13 @@ namespace miopen {
 class FindDb
 {
     public:
+    /// The regenerator returns false when it left out candidates, e.g. because a Find time
+    /// budget ran out. Such a record is returned but not stored, so that a later Find
+    /// evaluates the missing candidates.
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
                                           const TProblemDescription& problem,
-                                          const std::function<void(DbRecord&)>& regenerator)
+                                          const std::function<bool(DbRecord&)>& regenerator)
     {
         std::vector<PerfField> ret;
         FindDb find_db{handle, problem};
@@ -58,13 +62,39 @@ class FindDb
             return ret;
 
         find_db.record = DbRecord(problem);
-        regenerator(*find_db.record);
+        bool complete  = true;
+        {
+            MIOPEN_TRACE_SCOPE("find", "FindDb::Regenerate");
+            complete = regenerator(*find_db.record);
+        }
 
         for(const auto& pair : find_db.record->As<FindDbData>())
             // cppcheck-suppress useStlAlgorithm
             ret.push_back(
                 {pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace});
 
+        if(!complete)
+            find_db.record = boost::none;
+        return ret;
+    }
+
+    /// Returns the results of a previous Find for the problem without running one.
+    template <class TProblemDescription>
+    static std::vector<PerfField> Peek(Handle& handle, const TProblemDescription& problem)
+    {
+        std::vector<PerfField> ret;
+        if(!IsEnabled(MIOPEN_DEBUG_ENABLE_FIND_DB{}))
+            return ret;
+
+        Db db{GetFindDbPath() + "/" + handle.GetDbPathFilename() + ".cd.fdb.txt", false};
+        const boost::optional<DbRecord> record = db.FindRecord(problem);
+        if(!record)
+            return ret;
+
+        for(const auto& pair : record->As<FindDbData>())
+            // cppcheck-suppress useStlAlgorithm
+            ret.push_back(
+                {pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace});
         return ret;
     }
 
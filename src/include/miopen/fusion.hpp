@@ -74,6 +74,8 @@ struct FusionOpDescriptor : miopenFusionOpDescriptor
                                            const std::vector<solver::AnySolver>& solvers);
     friend std::ostream& operator<<(std::ostream& stream, const FusionOpDescriptor& x);
     virtual miopenFusionOp_t kind() const = 0;
+    /// Identifies the kind of the op and the attributes its part of a fused kernel depends on.
+    virtual std::string GetPlanKey() const;
     virtual std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const = 0;
     virtual std::string GetArgKey(const std::string& k) const = 0;
     virtual OpKernelArg GetOpAttr(const std::string& k) const = 0;
@@ -103,6 +105,30 @@ struct BiasFusionOpDescriptor : FusionOpDescriptor
     std::string GetArgKey(const std::string& k) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBiasForward; };
+    std::string GetPlanKey() const override;
+    std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
+    std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
+    TensorDescriptor base_desc;
+};
+
+/// Adds a second tensor of the same shape as its input, e.g. the shortcut of a residual block.
+struct TensorAddFusionOpDescriptor : FusionOpDescriptor
+{
+    TensorAddFusionOpDescriptor(TensorDescriptor& desc) : base_desc(desc){};
+    miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
+    miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
+    miopenStatus_t GetCompileParms(std::string& compile_config,
+                                   Handle& handle,
+                                   FusionKernelSourceType source,
+                                   const std::vector<solver::AnySolver>& solvers) override;
+    miopenStatus_t
+    SetArgs(OperatorArgs& args, const void* alpha, const void* beta, ConstData_t residual);
+    std::vector<std::pair<std::string, OpKernelArg>> GetArgs() const override;
+    std::string GetArgKey(const std::string& k) const override;
+    OpKernelArg GetOpAttr(const std::string& k) const override;
+    bool GetOpAttr(const std::string& sym, int& val) const override;
+    miopenFusionOp_t kind() const override { return miopenFusionOpTensorAdd; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     TensorDescriptor base_desc;
@@ -128,6 +154,7 @@ struct ActivFwdFusionOpDescriptor : FusionOpDescriptor
     bool GetOpAttr(const std::string& sym, int& val) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpActivForward; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     miopenActivationMode_t activMode;
@@ -154,6 +181,7 @@ struct ActivBwdFusionOpDescriptor : FusionOpDescriptor
     std::string GetArgKey(const std::string& k) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpActivBackward; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     miopenActivationMode_t activMode;
@@ -182,6 +210,7 @@ struct BatchNormInferenceFusionOpDescriptor : FusionOpDescriptor
     OpKernelArg GetOpAttr(const std::string& k) const override;
     bool GetOpAttr(const std::string& sym, int& val) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBatchNormInference; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
 
@@ -215,6 +244,7 @@ struct BatchNormFwdTrainFusionOpDescriptor : FusionOpDescriptor
     bool GetOpAttr(const std::string& sym, int& val) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBatchNormFwdTrain; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     void calcBNParams(Handle& handle,
@@ -255,6 +285,7 @@ struct BatchNormBwdTrainFusionOpDescriptor : FusionOpDescriptor
     bool GetOpAttr(const std::string& sym, int& val) const override;
     OpKernelArg GetOpAttr(const std::string& k) const override;
     miopenFusionOp_t kind() const override { return miopenFusionOpBatchNormBwdTrain; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
     void calcBNParams(Handle& handle,
@@ -291,6 +322,7 @@ struct ConvForwardOpDescriptor : FusionOpDescriptor
                                    const std::vector<solver::AnySolver>& solvers) override;
     bool isASMApplicable(Handle& handle);
     miopenFusionOp_t kind() const override { return miopenFusionOpConvForward; };
+    std::string GetPlanKey() const override;
     std::vector<size_t> GetLocalWGSz(Handle& handle, std::string algorithm_name) override;
     std::vector<size_t> GetGlobalWGSz(Handle& handle, std::string algorithm_name) override;
 
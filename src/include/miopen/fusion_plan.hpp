@@ -32,6 +32,24 @@ struct Exec_arg_t
     }
 };
 
+/// What compiling a fusion plan produced, kept so that compiling an identical plan again
+/// costs a lookup.
+struct CompiledFusionPlan
+{
+    FusionMDGraph graph; // With the chosen vertex
+    FusionKernelSourceType kernel_source_type = OpenclText;
+    std::string network_config;
+    std::string program_name;
+    std::string kernel_name;
+    std::string algorithm_name;
+    std::vector<Exec_arg_t> arg_list;
+    // How the kernel was built, for handles that do not have it. Empty if it was not built,
+    // having been found in the kernel cache of the handle.
+    std::string compile_config;
+    std::vector<size_t> vld;
+    std::vector<size_t> vgd;
+};
+
 struct FusionPlanDescriptor : miopenFusionPlanDescriptor
 {
     FusionPlanDescriptor(miopenFusionDirection_t dir, const TensorDescriptor& inDesc);
@@ -60,6 +78,8 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::string GetKernelName(Handle& handle);
     std::string GetProgramName(Handle& handle);
     std::string GetAlgorithmName(Handle& handle);
+    /// What Compile() put into the solver cache or found there; nullptr if the cache is disabled.
+    std::shared_ptr<const CompiledFusionPlan> GetCompiledPlan() const { return compiled_plan; }
 
     protected:
     auto GetLocalWGSz();
@@ -69,6 +89,8 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     OpKernelArg GetDevAttribute(const std::string& k, Handle& handle) const;
     OpKernelArg GetTensorAttr(const std::string& sym) const;
     bool GetTensorAttr(const std::string& sym, int& val) const;
+    std::string GetCompiledKey(Handle& handle) const;
+    bool Restore(Handle& handle, const CompiledFusionPlan& compiled);
 
     private:
     miopenFusionDirection_t fusion_dir;
@@ -87,6 +109,8 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::string network_config;
     miopenDataType_t data_type;
     std::vector<Exec_arg_t> arg_list;
+    std::string plan_key; // The direction, the input and the ops added so far
+    std::shared_ptr<const CompiledFusionPlan> compiled_plan;
 };
 
 } // namespace miopen
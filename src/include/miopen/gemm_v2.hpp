@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_GEMM_V2_HPP_
 
 #include <string>
+#include <vector>
 
 #include <miopen/common.hpp>
 #include <miopen/miopen.h>
@@ -78,6 +79,26 @@ struct GemmDescriptor
     friend std::ostream& operator<<(std::ostream& stream, const GemmDescriptor& gemm_desc);
 };
 
+// One GEMM of a grouped submission. Members may differ in shape and in buffers.
+struct GemmGroupMember
+{
+    GemmDescriptor gemm_desc;
+    ConstData_t A;
+    int a_offset;
+    ConstData_t B;
+    int b_offset;
+    Data_t C;
+    int c_offset;
+};
+
+// True if the batches of a strided batched GEMM write disjoint parts of C, i.e. running them
+// as one strided batched call or one by one gives the same result.
+bool IsGemmBatchDisjoint(const GemmDescriptor& gemm_desc);
+
+// Merges consecutive single-batch members that share shape and buffers and whose offsets
+// advance by a constant stride into strided batched members.
+std::vector<GemmGroupMember> CoalesceGemmGroup(const std::vector<GemmGroupMember>& members);
+
 miopenStatus_t CallGemmTimeMeasure(Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -128,6 +149,13 @@ CallGemmStridedBatchedSequential(Handle& handle,
                                  bool enqueue_dummy_kernel,
                                  GemmBackend_t gemm_backend = GemmBackend_t::rocblas);
 
+// Runs every member of the group, submitting each coalesced run as one strided batched GEMM.
+// Kernel time, if profiling is enabled, is the sum over all submissions.
+miopenStatus_t CallGemmGrouped(Handle& handle,
+                               const std::vector<GemmGroupMember>& members,
+                               bool enqueue_dummy_kernel,
+                               GemmBackend_t gemm_backend = GemmBackend_t::rocblas);
+
 // GEMM parameters for Convolution (using Im2Col) Fwd
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
@@ -164,6 +192,12 @@ GemmDescriptor CreateGemmStridedBatchedDescriptorConv1x1Fwd(const TensorDescript
                                                             const TensorDescriptor& xDesc,
                                                             const TensorDescriptor& yDesc);
 
+// GEMM parameters for 1x1 Convolution Fwd on channels-last (NHWC, NDHWC) x and y
+// y = x * transpose(w), x and y viewed as (N*H*W) x C and (N*H*W) x K matrices
+GemmDescriptor CreateGemmDescriptorConvChannelsLast1x1Fwd(const TensorDescriptor& wDesc,
+                                                          const TensorDescriptor& xDesc,
+                                                          const TensorDescriptor& yDesc);
+
 // strided batched GEMM parameters for 1x1 Convolution Bwd-Data
 // dx[i] = transpose(w) * dy[i], i is batch id
 GemmDescriptor CreateGemmStridedBatchedDescriptorConv1x1BwdData(const TensorDescriptor& wDesc,
@@ -34,9 +34,14 @@
 #include <limits>
 #include <iterator>
 #include <chrono>
+#include <memory>
+#include <type_traits>
 
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/measure_time.hpp>
+#include <miopen/perf_space.hpp>
+#include <miopen/tuning_session.hpp>
 
 namespace miopen {
 namespace solver {
@@ -61,9 +66,28 @@ namespace solver {
 ///     For convolutions, Context represents a problem configuration.
 /// - operator==(const PerformanceConfig&)
 ///     Ordinary semantics.
+/// - static Space(const Context& c, bool spare) (optional)
+///     Returns PerfSpace<PerformanceConfig> declaring the same set as above.
+///     If present, the set is enumerated by it instead, which skips the invalid
+///     parts of the set without visiting them and sizes the set cheaply.
 template <typename PerformanceConfig, typename Context>
 class ComputedContainer;
 
+template <typename PerformanceConfig, typename Context, typename = void>
+struct HasPerfSpace : std::false_type
+{
+};
+
+template <typename PerformanceConfig, typename Context>
+struct HasPerfSpace<
+    PerformanceConfig,
+    Context,
+    std::enable_if_t<std::is_same<decltype(PerformanceConfig::Space(std::declval<const Context&>(),
+                                                                    false)),
+                                  PerfSpace<PerformanceConfig>>{}>> : std::true_type
+{
+};
+
 template <typename PerformanceConfig, typename Context>
 class ComputedIterator : public std::iterator<std::input_iterator_tag, PerformanceConfig>
 {
@@ -114,6 +138,38 @@ class ComputedIterator : public std::iterator<std::input_iterator_tag, Performan
     friend class ComputedContainer<PerformanceConfig, Context>;
 };
 
+template <typename PerformanceConfig>
+class PerfSpaceIterator : public std::iterator<std::input_iterator_tag, PerformanceConfig>
+{
+    std::shared_ptr<const PerfSpace<PerformanceConfig>> space; // Null at the end.
+    typename PerfSpace<PerformanceConfig>::Cursor cursor;
+
+    public:
+    PerfSpaceIterator() = default;
+    PerfSpaceIterator(std::shared_ptr<const PerfSpace<PerformanceConfig>> space_)
+        : space(std::move(space_))
+    {
+        if(!space->First(cursor))
+            space = nullptr;
+    }
+
+    PerfSpaceIterator& operator++()
+    {
+        if(space != nullptr && !space->Next(cursor))
+            space = nullptr;
+        return *this;
+    }
+    const PerformanceConfig& operator*() const { return cursor.value; }
+    bool operator!=(PerfSpaceIterator const& other) const
+    {
+        if(space == other.space)
+            if(space == nullptr || cursor.positions == other.cursor.positions)
+                return false;
+        return true;
+    }
+    bool operator==(PerfSpaceIterator const& other) const { return !(*this != other); }
+};
+
 template <typename PerformanceConfig, typename Context>
 class ComputedContainer
 {
@@ -133,15 +189,37 @@ class ComputedContainer
     /// for the sake of flexibility. Nevertheless, all element accesses of
     /// the "computed container" shall be const.
 
+    using HasSpace = HasPerfSpace<PerformanceConfig, Context>;
+
+    auto GetSpace() const
+    {
+        return std::make_shared<const PerfSpace<PerformanceConfig>>(
+            PerformanceConfig::Space(problem, spare));
+    }
+
+    auto Begin(std::true_type) const { return PerfSpaceIterator<PerformanceConfig>{GetSpace()}; }
+    auto Begin(std::false_type) const
+    {
+        return ComputedIterator<PerformanceConfig, Context>{problem, spare};
+    }
+
+    std::size_t Size(std::true_type) const { return GetSpace()->Size(); }
+    std::size_t Size(std::false_type) const { return std::distance(begin(), end()); }
+
     public:
-    using const_iterator = ComputedIterator<PerformanceConfig, Context>;
+    using const_iterator = std::conditional_t<HasSpace{},
+                                              PerfSpaceIterator<PerformanceConfig>,
+                                              ComputedIterator<PerformanceConfig, Context>>;
 
     ComputedContainer(const Context& problem_, const bool spare_ = false)
         : problem(problem_), spare(spare_)
     {
     }
-    const_iterator begin() const { return {problem, spare}; }
+    const_iterator begin() const { return Begin(HasSpace{}); }
     const_iterator end() const { return {}; }
+    bool empty() const { return begin() == end(); }
+    /// Counts the elements. Cheap if PerformanceConfig has a Space().
+    std::size_t size() const { return Size(HasSpace{}); }
 };
 
 class Timer
@@ -228,20 +306,6 @@ class HeartBeat
     }
 };
 
-inline void InitRandomly(std::vector<float>& vec, const double offset, const double factor)
-{
-    float* p = vec.data();
-    for(unsigned long i = 0; i < vec.size(); ++i)
-        *p++ = static_cast<float>((rand() * (1.0 / RAND_MAX) + offset) * factor);
-}
-
-inline void InitRandomly(std::vector<float>& vec)
-{
-    float* p = vec.data();
-    for(unsigned long i = 0; i < vec.size(); ++i)
-        *p++ = static_cast<float>(rand() * (1.0 / RAND_MAX));
-}
-
 inline size_t divide_round_plus_inf(const size_t x, const unsigned y)
 {
     assert(/*x >= 0 &&*/ y > 0);
@@ -316,32 +380,26 @@ auto GenericSearch(const Solver s,
         wei_size = default_solution.workspce_sz;
     }
 
-    std::vector<float> top(top_size);
-    std::vector<float> bot(bot_size);
-    std::vector<float> wei(wei_size);
-    std::vector<float> bias(bias_size);
-    InitRandomly(bot);
-    if(!(context.direction.IsBackwardData() || context.direction.IsForward()))
-        InitRandomly(top);
-    if(!context.direction.IsBackwardWrW())
-        InitRandomly(wei, -0.5, 0.001);
-    if(context.bias)
-        InitRandomly(bias);
-
-    miopen::Handle profile_h;
-    auto bot_ocl_buf  = profile_h.Write(bot);
-    auto top_ocl_buf  = profile_h.Write(top);
-    auto wei_ocl_buf  = profile_h.Write(wei);
-    auto bias_ocl_buf = context.bias ? profile_h.Write(bias) : nullptr;
-
-    const ComputedContainer<PerformanceConfig, Context> main(context);
-    const int main_size = std::distance(main.begin(), main.end());
-    const ComputedContainer<PerformanceConfig, Context> spare(context, true);
-    const int spare_size = std::distance(spare.begin(), spare.end());
-    const bool useSpare  = (main_size == 0);
-
-    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
-    const int n_runs_total = useSpare ? spare_size : main_size;
+    using Contents = TuningSession::Contents;
+    using Operand  = TuningSession::Operand;
+    const TuningSession::Scope session_scope;
+    auto& session   = session_scope.Get();
+    auto& profile_h = session.GetHandle();
+
+    const bool is_wrw = context.direction.IsBackwardWrW();
+
+    const auto bot_ocl_buf = session.GetBuffer<float>(Operand::Bot, bot_size, Contents::Uniform);
+    const auto top_ocl_buf = session.GetBuffer<float>(
+        Operand::Top, top_size, is_wrw ? Contents::Uniform : Contents::Output);
+    const auto wei_ocl_buf = session.GetBuffer<float>(
+        Operand::Weights, wei_size, is_wrw ? Contents::Output : Contents::Weights);
+    const auto bias_ocl_buf =
+        context.bias ? session.GetBuffer<float>(Operand::Bias, bias_size, Contents::Uniform)
+                     : nullptr;
+
+    const bool useSpare = ComputedContainer<PerformanceConfig, Context>(context).empty();
+    const ComputedContainer<PerformanceConfig, Context> all_configs(context, useSpare);
+    const int n_runs_total = all_configs.size();
     MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
                                << (useSpare ? " (spare)" : "")
                                << "...");
@@ -377,66 +435,40 @@ auto GenericSearch(const Solver s,
 
         if(ret == 0)
         {
-            ret = s.RunAndMeasureSolution(profile_h,
-                                          bot_ocl_buf.get(),
-                                          top_ocl_buf.get(),
-                                          wei_ocl_buf.get(),
-                                          context.bias ? bias_ocl_buf.get() : nullptr,
-                                          context,
-                                          current_solution,
-                                          elapsed_time);
+            const auto timing = MeasureTime(
+                [&](float& time) {
+                    return s.RunAndMeasureSolution(profile_h,
+                                                   bot_ocl_buf,
+                                                   top_ocl_buf,
+                                                   wei_ocl_buf,
+                                                   bias_ocl_buf,
+                                                   context,
+                                                   current_solution,
+                                                   time);
+                },
+                best_time);
+            ret          = timing.status;
+            elapsed_time = timing.time;
         }
 
         if(ret == 0)
         {
-            // Smooth the jitter of measurements:
-            // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-            // then re-run it 4 times more and compute average time,
-            // and decide using average of all 5 attempts vs. the best.
-            if(elapsed_time / best_time < 1.05f)
+            is_passed = true;
+            if(elapsed_time < best_time)
             {
-                MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time << " = "
-                                                      << (elapsed_time / best_time));
-                float temp;
-                for(int i = 0; i < 4; ++i)
-                {
-                    ret = s.RunAndMeasureSolution(profile_h,
-                                                  bot_ocl_buf.get(),
-                                                  top_ocl_buf.get(),
-                                                  wei_ocl_buf.get(),
-                                                  context.bias ? bias_ocl_buf.get() : nullptr,
-                                                  context,
-                                                  current_solution,
-                                                  temp);
-                    if(ret != 0)
-                    {
-                        break;
-                    }
-                    elapsed_time += temp;
-                }
-                if(ret == 0)
-                {
-                    is_passed = true;
-                    elapsed_time /= 5;
-                    if(elapsed_time < best_time)
-                    {
-                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                         << ' '
-                                         << elapsed_time
-                                         << " < "
-                                         << best_time
-                                         << ' '
-                                         << current_config);
-                        best_config = current_config;
-                        best_time   = elapsed_time;
-                        n_best      = n_current;
-                    }
-                    else
-                    {
-                        MIOPEN_LOG_I2(
-                            "Average is not better: " << elapsed_time << " >= " << best_time);
-                    }
-                }
+                MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                                 << elapsed_time
+                                 << " < "
+                                 << best_time
+                                 << ' '
+                                 << current_config);
+                best_config = current_config;
+                best_time   = elapsed_time;
+                n_best      = n_current;
+            }
+            else
+            {
+                MIOPEN_LOG_I2("Not better: " << elapsed_time << " >= " << best_time);
             }
         }
 
@@ -461,19 +493,22 @@ auto GenericSearch(const Solver s,
                           << best_config);
     if(!is_passed)
         MIOPEN_THROW("Search failed");
-    // Run once with the default config and show score.
-    float default_time = 0.0f;
+    // Measure the default config the same way and show score.
     profile_h.EnableProfiling(true);
-    if(s.RunAndMeasureSolution(profile_h,
-                               bot_ocl_buf.get(),
-                               top_ocl_buf.get(),
-                               wei_ocl_buf.get(),
-                               context.bias ? bias_ocl_buf.get() : nullptr,
-                               context,
-                               default_solution,
-                               default_time) == 0)
+    const auto default_timing = MeasureTime([&](float& time) {
+        return s.RunAndMeasureSolution(profile_h,
+                                       bot_ocl_buf,
+                                       top_ocl_buf,
+                                       wei_ocl_buf,
+                                       bias_ocl_buf,
+                                       context,
+                                       default_solution,
+                                       time);
+    });
+    if(default_timing.status == 0)
     {
-        const float score = (best_time > 0.0f) ? default_time / best_time : 0.0f;
+        const float default_time = default_timing.time;
+        const float score        = (best_time > 0.0f) ? default_time / best_time : 0.0f;
         MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
     }
     profile_h.EnableProfiling(false);
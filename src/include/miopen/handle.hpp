@@ -35,8 +35,10 @@
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
+#include <miopen/find_budget.hpp>
 #include <miopen/simple_hash.hpp>
-#include <boost/range/adaptor/transformed.hpp>
+#include <atomic>
+#include <iterator>
 #include <vector>
 #include <unordered_map>
 
@@ -57,6 +59,63 @@ using GemmKey = std::pair<std::string, std::string>;
 using rocblas_handle_ptr = MIOPEN_MANAGE_PTR(rocblas_handle, rocblas_destroy_handle);
 #endif
 
+namespace detail {
+
+inline std::size_t NewHandleId()
+{
+    static std::atomic<std::size_t> next{0};
+    return next++;
+}
+
+/// What a host thread keeps per handle: the stream it selected, its profiling state and the
+/// outcome of its last Find, so that threads sharing a handle neither enqueue on nor time nor
+/// report each other's work.
+struct ThreadHandleState
+{
+    std::size_t active_stream = 0;
+    bool enable_profiling     = false;
+    float profiling_result    = 0.0;
+    std::vector<FindSkipped> find_skipped;
+};
+
+struct ThreadHandleEntry
+{
+    /// Expires when the handle is destroyed
+    std::weak_ptr<const void> alive;
+    ThreadHandleState state;
+};
+
+/// Handles are keyed by id rather than by address, since a destroyed handle's address may be
+/// reused.
+inline std::unordered_map<std::size_t, ThreadHandleEntry>& GetThreadHandleEntries()
+{
+    thread_local std::unordered_map<std::size_t, ThreadHandleEntry> entries;
+    return entries;
+}
+
+/// State of the calling thread for the handle with the given id. `alive` lives as long as the
+/// handle. A handle only removes the entry of the thread that destroys it, so entries of
+/// destroyed handles are dropped whenever a thread first uses another handle.
+inline ThreadHandleState& GetThreadHandleState(std::size_t handle_id,
+                                               const std::shared_ptr<const void>& alive)
+{
+    auto& entries = GetThreadHandleEntries();
+    const auto it = entries.find(handle_id);
+    if(it != entries.end())
+        return it->second.state;
+
+    for(auto i = entries.begin(); i != entries.end();)
+        i = i->second.alive.expired() ? entries.erase(i) : std::next(i);
+    return entries.emplace(handle_id, ThreadHandleEntry{alive, {}}).first->second.state;
+}
+
+inline void EraseThreadHandleState(std::size_t handle_id)
+{
+    GetThreadHandleEntries().erase(handle_id);
+}
+
+} // namespace detail
+
 struct Handle : miopenHandle
 {
 
@@ -65,9 +124,26 @@ struct Handle : miopenHandle
     Handle(Handle&&) noexcept;
     ~Handle();
 
+    /// Returns or replaces the stream selected by the calling thread
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
 
+    /// A handle owns one or more streams. Stream 0 is the one the handle was created with.
+    /// Every host thread picks the stream its calls enqueue on with SetActiveStream (stream 0
+    /// by default), so independent work can overlap and several threads can drive one handle.
+    /// Kernel objects are shared between streams; launches hold a per-kernel lock from setting
+    /// the arguments until the launch is enqueued. Streams may be added while other threads
+    /// launch work. Profiling is per thread as well: EnableProfiling and GetKernelTime only
+    /// see the calling thread's launches.
+    std::size_t AddStream();
+    std::size_t AddStream(miopenAcceleratorQueue_t stream);
+    std::size_t GetStreamCount() const;
+    void SetActiveStream(std::size_t index) const;
+    std::size_t GetActiveStream() const;
+    /// Work enqueued on stream `waiting` after this call starts only after everything enqueued
+    /// so far on stream `signalling` has completed. Does not block the host.
+    void StreamWaitStream(std::size_t waiting, std::size_t signalling) const;
+
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
@@ -80,6 +156,10 @@ struct Handle : miopenHandle
     float GetKernelTime() const;
     bool IsProfilingEnabled() const;
 
+    /// Candidates the last budgeted Find of the calling thread did not time
+    const std::vector<FindSkipped>& GetFindSkipped() const;
+    void SetFindSkipped(std::vector<FindSkipped> skipped) const;
+
     KernelInvoke AddKernel(const std::string& algorithm,
                            const std::string& network_config,
                            const std::string& program_name,
@@ -93,10 +173,26 @@ struct Handle : miopenHandle
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config)
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config)
+    {
+        std::vector<KernelInvoke> result;
+        for(auto&& k : this->GetKernelsImpl(algorithm, network_config))
+            result.push_back(this->Run(k));
+        return result;
+    }
+    /// Same as above, but the kernels are launched with the global work size vgd rather than
+    /// the one they were added with. Launchers whose programs do not depend on the batch size
+    /// leave the launch dimensions out of network_config and pass them here, so that one
+    /// compiled kernel serves every batch size.
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config,
+                                         const std::vector<size_t>& vgd)
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        std::vector<KernelInvoke> result;
+        for(auto&& k : this->GetKernelsImpl(algorithm, network_config))
+            result.push_back(this->Run(k, vgd));
+        return result;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config)
     {
@@ -110,8 +206,11 @@ struct Handle : miopenHandle
     }
 
     KernelInvoke Run(Kernel k);
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config);
+    KernelInvoke Run(Kernel k, const std::vector<size_t>& vgd);
+    /// Copies the cached kernels: a reference into the cache could be invalidated by another
+    /// thread adding kernels.
+    std::vector<Kernel> GetKernelsImpl(const std::string& algorithm,
+                                       const std::string& network_config);
 
     Program LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str);
 
@@ -169,18 +268,19 @@ struct Handle : miopenHandle
         // clang-format on
     }
 
+    /// Hash of GetDbPathFilename(), computed once per handle, for tables that are keyed by the
+    /// kind of device and looked up on every call
+    std::size_t GetDbPathHash();
+
     std::unique_ptr<HandleImpl> impl;
 #if MIOPEN_USE_MIOPENGEMM
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
 
 #if MIOPEN_USE_ROCBLAS
-    rocblas_handle_ptr& rhandle() { return rhandle_; }
-
-    private:
-    rocblas_handle_ptr CreateRocblasHandle() const;
-
-    rocblas_handle_ptr rhandle_;
+    /// rocBLAS handle bound to the stream selected by the calling thread. Every stream has its
+    /// own handle, so threads on different streams never rebind each other's.
+    rocblas_handle rhandle() const;
 #endif
 };
 } // namespace miopen
@@ -32,6 +32,7 @@
 #include <miopen/hipoc_program.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <miopen/trace.hpp>
 #include <vector>
 #include <memory.h>
 
@@ -123,6 +124,8 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> ldims = {};
     std::array<size_t, 3> gdims = {};
     std::string name;
+    // Name of the kernel in the launch trace, interned when the kernel was created
+    const char* trace_name = nullptr;
     std::function<void(hipEvent_t, hipEvent_t)> callback;
 
     // Workaround for aggregate types in c++11
@@ -132,8 +135,15 @@ struct HIPOCKernelInvoke
                       std::array<size_t, 3> pldims,
                       std::array<size_t, 3> pgdims,
                       std::string pname,
+                      const char* ptrace_name,
                       std::function<void(hipEvent_t, hipEvent_t)> pcallback)
-        : stream(pstream), fun(pfun), ldims(pldims), gdims(pgdims), name(pname), callback(pcallback)
+        : stream(pstream),
+          fun(pfun),
+          ldims(pldims),
+          gdims(pgdims),
+          name(pname),
+          trace_name(ptrace_name),
+          callback(pcallback)
     {
     }
     void operator()(std::vector<OpKernelArg>& any_args) const
@@ -176,7 +186,8 @@ struct HIPOCKernel
     std::array<size_t, 3> ldims = {};
     std::array<size_t, 3> gdims = {};
     std::string kernel_module;
-    hipFunction_t fun = nullptr;
+    hipFunction_t fun      = nullptr;
+    const char* trace_name = nullptr;
 
     HIPOCKernel() {}
     HIPOCKernel(HIPOCProgram p,
@@ -198,6 +209,7 @@ struct HIPOCKernel
             MIOPEN_THROW_HIP_STATUS(status,
                                     "Failed to get function: " + kernel_module + " from " +
                                         program.GetBinary().string());
+        trace_name = trace::Intern(name);
     }
 
     HIPOCKernelInvoke Invoke(hipStream_t stream,
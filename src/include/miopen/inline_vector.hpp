@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_INLINE_VECTOR_HPP_
+#define GUARD_MIOPEN_INLINE_VECTOR_HPP_
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// A vector with a fixed capacity that keeps its elements inline, so that creating and copying
+/// one never touches the heap. Exceeding the capacity throws miopenStatusBadParm.
+///
+/// It converts implicitly to std::vector and compares equal to one holding the same elements,
+/// so that code written against std::vector keeps working where only reading is required.
+template <class T, std::size_t N>
+struct inline_vector
+{
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    inline_vector() = default;
+    explicit inline_vector(std::size_t n, const T& x = T{}) { this->resize(n, x); }
+    inline_vector(std::initializer_list<T> x) : inline_vector(x.begin(), x.end()) {}
+
+    template <class Iterator,
+              class = typename std::iterator_traits<Iterator>::iterator_category>
+    inline_vector(Iterator first, Iterator last)
+    {
+        const auto n = std::distance(first, last);
+        if(n < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid range");
+        Reserve(n);
+        std::copy(first, last, data_.begin());
+        size_ = n;
+    }
+
+    template <class U>
+    inline_vector(const std::vector<U>& x) : inline_vector(x.begin(), x.end())
+    {
+    }
+
+    template <class U>
+    operator std::vector<U>() const
+    {
+        return {this->begin(), this->end()};
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr std::size_t capacity() { return N; }
+    static constexpr std::size_t max_size() { return N; }
+
+    T* data() { return data_.data(); }
+    const T* data() const { return data_.data(); }
+
+    iterator begin() { return data_.data(); }
+    iterator end() { return data_.data() + size_; }
+    const_iterator begin() const { return data_.data(); }
+    const_iterator end() const { return data_.data() + size_; }
+    const_iterator cbegin() const { return this->begin(); }
+    const_iterator cend() const { return this->end(); }
+    reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+    reverse_iterator rend() { return reverse_iterator(this->begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+    T& operator[](std::size_t i) { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+    T& at(std::size_t i)
+    {
+        if(i >= size_)
+            MIOPEN_THROW(miopenStatusBadParm, "Index out of range");
+        return data_[i];
+    }
+    const T& at(std::size_t i) const
+    {
+        if(i >= size_)
+            MIOPEN_THROW(miopenStatusBadParm, "Index out of range");
+        return data_[i];
+    }
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    void clear() { size_ = 0; }
+    void resize(std::size_t n, const T& x = T{})
+    {
+        Reserve(n);
+        if(n > size_)
+            std::fill(data_.begin() + size_, data_.begin() + n, x);
+        size_ = n;
+    }
+    void push_back(const T& x)
+    {
+        Reserve(size_ + 1);
+        data_[size_++] = x;
+    }
+    void pop_back() { --size_; }
+    template <class Iterator>
+    void assign(Iterator first, Iterator last)
+    {
+        *this = inline_vector(first, last);
+    }
+
+    friend bool operator==(const inline_vector& x, const inline_vector& y)
+    {
+        return std::equal(x.begin(), x.end(), y.begin(), y.end());
+    }
+    friend bool operator!=(const inline_vector& x, const inline_vector& y) { return !(x == y); }
+    friend bool operator<(const inline_vector& x, const inline_vector& y)
+    {
+        return std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+    }
+    friend bool operator>(const inline_vector& x, const inline_vector& y) { return y < x; }
+    friend bool operator<=(const inline_vector& x, const inline_vector& y) { return !(y < x); }
+    friend bool operator>=(const inline_vector& x, const inline_vector& y) { return !(x < y); }
+
+    template <class U>
+    friend bool operator==(const inline_vector& x, const std::vector<U>& y)
+    {
+        return std::equal(x.begin(), x.end(), y.begin(), y.end());
+    }
+    template <class U>
+    friend bool operator==(const std::vector<U>& x, const inline_vector& y)
+    {
+        return y == x;
+    }
+    template <class U>
+    friend bool operator!=(const inline_vector& x, const std::vector<U>& y)
+    {
+        return !(x == y);
+    }
+    template <class U>
+    friend bool operator!=(const std::vector<U>& x, const inline_vector& y)
+    {
+        return !(y == x);
+    }
+
+    private:
+    static void Reserve(std::size_t n)
+    {
+        if(n > N)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "At most " + std::to_string(N) + " elements are supported");
+    }
+
+    std::array<T, N> data_{};
+    std::size_t size_ = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_INLINE_VECTOR_HPP_
@@ -47,6 +47,7 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -65,7 +66,12 @@ class KernelCache
     using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
     using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
 
+    /// Builds the program unless it is cached, and caches the kernel under (algorithm,
+    /// network_config) unless either is empty. cache_mutex guards the cache and is held only
+    /// while it is read or updated: the program is built without it, so a compile does not
+    /// block other threads' kernel lookups.
     Kernel AddKernel(Handle& h,
+                     std::mutex& cache_mutex,
                      const std::string& algorithm,
                      const std::string& network_config,
                      const std::string& program_name,
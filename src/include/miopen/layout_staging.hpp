@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LAYOUT_STAGING_HPP_
+#define GUARD_MIOPEN_LAYOUT_STAGING_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/tensor.hpp>
+
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Lets operations that only understand the default NCHW (NCDHW) layouts run on channels-last
+/// tensors. Every tensor that is not in a default layout is given a packed default-layout copy at
+/// the front of the workspace; the rest of the workspace is left to the operation itself.
+struct LayoutStaging
+{
+    explicit LayoutStaging(const std::vector<TensorDescriptor>& descs);
+
+    /// True if at least one tensor is staged.
+    bool Any() const { return size > 0; }
+    /// Workspace bytes taken by the staged copies.
+    std::size_t Size() const { return size; }
+    /// Sum of the transpose kernel times so far; valid when profiling is enabled.
+    float Time() const { return time; }
+
+    /// Descriptor the operation should see for tensor i.
+    const TensorDescriptor& Desc(std::size_t i) const;
+
+    /// Buffer to read tensor i from, copying src into the staging area if tensor i is staged.
+    ConstData_t In(Handle& handle, std::size_t i, ConstData_t src, Data_t workSpace);
+    /// Buffer to write tensor i to; call Commit() afterwards to copy it back into dst.
+    Data_t Out(Handle& handle, std::size_t i, Data_t dst, Data_t workSpace);
+    /// Copies output tensor i from its staging area back into dst. No-op if i is not staged.
+    void Commit(Handle& handle, std::size_t i, Data_t dst);
+
+    /// The part of the workspace after the staged copies, or nullptr if nothing is left.
+    Data_t Rest(Handle& handle, Data_t workSpace, std::size_t workSpaceSize);
+    std::size_t RestSize(std::size_t workSpaceSize) const;
+
+    private:
+    struct Entry
+    {
+        TensorDescriptor original;
+        TensorDescriptor staged;
+        bool is_staged;
+        std::size_t offset;
+        std::size_t bytes;
+        shared<Data_t> buffer;
+    };
+
+    Data_t Bind(Handle& handle, Entry& e, Data_t workSpace);
+
+    std::vector<Entry> entries;
+    shared<Data_t> rest;
+    std::size_t size = 0;
+    float time       = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LAYOUT_STAGING_HPP_
@@ -28,10 +28,12 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <type_traits>
 
+#include <miopen/config.h>
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
 
@@ -193,9 +195,32 @@ const char* LoggingLevelToCString(LoggingLevel level);
 
 std::string PlatformName();
 
+/// \return true if messages of the level are compiled in (see MIOPEN_LOG_MAX_LEVEL).
+constexpr bool IsLoggingCompiled(LoggingLevel level)
+{
+    return static_cast<int>(level) <= MIOPEN_LOG_MAX_LEVEL;
+}
+
+namespace detail {
+
+/// The most detailed enabled logging level. Until MIOPEN_LOG_LEVEL has been
+/// read it holds a value above Trace, so that every check falls through to
+/// IsLoggingResolve(), which stores the actual level.
+extern std::atomic<int> logging_level;
+
+bool IsLoggingResolve(LoggingLevel level);
+
+} // namespace detail
+
 /// \return true if level is enabled.
 /// \param level - one of the values defined in LoggingLevel.
-bool IsLogging(LoggingLevel level = LoggingLevel::Error);
+/// A disabled level costs one relaxed load and one branch.
+inline bool IsLogging(LoggingLevel level = LoggingLevel::Error)
+{
+    if(static_cast<int>(level) > detail::logging_level.load(std::memory_order_relaxed))
+        return false;
+    return detail::IsLoggingResolve(level);
+}
 bool IsLoggingCmd();
 bool IsLoggingTraceDetailed();
 
@@ -248,7 +273,7 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
 #define MIOPEN_LOG(level, ...)                                                              \
     do                                                                                      \
     {                                                                                       \
-        if(miopen::IsLogging(level))                                                        \
+        if(miopen::IsLoggingCompiled(level) && miopen::IsLogging(level))                    \
         {                                                                                   \
             std::stringstream miopen_log_ss;                                                \
             miopen_log_ss << miopen::PlatformName() << ": " << LoggingLevelToCString(level) \
@@ -29,6 +29,7 @@
 #include <miopen/fusion_ops.hpp>
 #include <miopen/fusion.hpp>
 
+#include <memory>
 #include <unordered_map>
 
 namespace miopen {
@@ -110,9 +111,11 @@ struct FusionMDGraph
     std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> cur_vertex;
     std::set<miopenConvFwdAlgorithm_t> conv_algo_set;
 
-    std::unordered_map<MDGraph_vertex_ptr,
-                       std::unordered_map<MDGraph_vertex_ptr, FusionMDGraph_Edge_Map_Vec>>
-        edge_list;
+    using EdgeList =
+        std::unordered_map<MDGraph_vertex_ptr,
+                           std::unordered_map<MDGraph_vertex_ptr, FusionMDGraph_Edge_Map_Vec>>;
+    /// Only Init() adds edges, so copies of a graph share them.
+    std::shared_ptr<EdgeList> edge_list = std::make_shared<EdgeList>();
 };
 
 } // namespace miopen
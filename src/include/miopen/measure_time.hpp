@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MEASURE_TIME_HPP_
+#define GUARD_MIOPEN_MEASURE_TIME_HPP_
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace miopen {
+
+/// How long a candidate is timed during auto-tuning.
+struct TimingPolicy
+{
+    int warmup         = 1;     // untimed runs before the first sample
+    int min_samples    = 3;     // the spread of the latest this many samples is checked
+    int max_samples    = 9;     // stop even if the samples are still spread out
+    float cv_target    = 0.03f; // stop once stddev / mean of the samples is below this
+    float reject_ratio = 1.1f;  // stop once the fastest sample is this much slower than the best
+};
+
+struct TimingResult
+{
+    int status    = 0;     // of the first run that failed, 0 if none did
+    float time    = 0;     // median of the samples, ms
+    int samples   = 0;
+    bool rejected = false; // stopped early as clearly slower than the best known time
+};
+
+/// Median of `samples`, which are reordered. 0 if there are none.
+float Median(std::vector<float>& samples);
+
+/// Standard deviation over mean. 0 for less than two samples.
+float CoefficientOfVariation(const std::vector<float>& samples);
+
+/// Times a candidate robustly: runs it `policy.warmup` times, then samples it until the latest
+/// `policy.min_samples` samples agree within `policy.cv_target`, and reports the median of all
+/// samples. Sampling stops early when even the fastest sample is `policy.reject_ratio` times
+/// slower than `best`, the best time known so far, as the candidate cannot win then. `run` shall
+/// return 0 and the time of one run in ms, or a non-zero status, which ends the measurement.
+TimingResult MeasureTime(const std::function<int(float&)>& run,
+                         float best                 = std::numeric_limits<float>::max(),
+                         const TimingPolicy& policy = TimingPolicy{});
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEASURE_TIME_HPP_
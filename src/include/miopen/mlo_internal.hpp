@@ -228,6 +228,8 @@ struct ConvolutionContext : ProblemDescription
 
 namespace solver {
 struct ConvSolution;
+template <class Solution>
+struct DeferredSolution;
 
 } // namespace solver
 
@@ -314,6 +316,8 @@ struct mlo_construct_direct2D
 
     miopen::solver::ConvSolution FindSolution();
     std::vector<miopen::solver::ConvSolution> FindAllSolutions();
+    std::vector<miopen::solver::DeferredSolution<miopen::solver::ConvSolution>>
+    DeferAllSolutions();
     miopen::MultiFileDb GetDb() const;
 
     /*
@@ -480,7 +484,7 @@ struct mlo_construct_direct2D
                                      w_stride);
 
         int data_len = miopen::GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = miopen::IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -521,7 +525,7 @@ struct mlo_construct_direct2D
                                      w_stride);
 
         int data_len = miopen::GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = miopen::IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -33,6 +33,7 @@
 #include <functional>
 #include <memory>
 #include <miopen/miopen.h>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <utility>
@@ -42,6 +43,7 @@
 #include <miopen/each_args.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <miopen/trace.hpp>
 
 namespace miopen {
 
@@ -91,9 +93,15 @@ struct OCLKernelInvoke
     std::array<size_t, 3> global_work_dim    = {};
     std::array<size_t, 3> local_work_dim     = {};
     std::function<void(cl_event&)> callback;
+    // Kernel arguments are state of the shared cl_kernel, so setting them and enqueueing must not
+    // interleave with another thread launching the same kernel on a different stream
+    std::shared_ptr<std::mutex> args_mutex = nullptr;
+    // Name of the kernel in the launch trace, interned when the kernel was created
+    const char* trace_name = nullptr;
 
     void operator()(std::vector<OpKernelArg> args) const
     {
+        auto lock = lock_args();
         for(size_t idx = 0; idx < args.size(); idx++)
         {
             auto arg      = args[idx];
@@ -106,20 +114,27 @@ struct OCLKernelInvoke
                              OpenCLErrorMessage(status));
             }
         }
-        run();
+        run(lock);
     }
 
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
+        auto lock = lock_args();
         each_args_i(
             std::bind(
                 OCLSetKernelArg{}, kernel.get(), std::placeholders::_1, std::placeholders::_2),
             xs...);
-        run();
+        run(lock);
     }
 
-    void run() const;
+    std::unique_lock<std::mutex> lock_args() const
+    {
+        return args_mutex ? std::unique_lock<std::mutex>(*args_mutex)
+                          : std::unique_lock<std::mutex>();
+    }
+
+    void run(std::unique_lock<std::mutex>& lock) const;
     std::string GetName() const;
 };
 
@@ -128,12 +143,13 @@ class OCLKernel
 
     public:
     OCLKernel() {}
-    OCLKernel(ClKernelPtr k) : kernel(std::move(k)) {}
+    OCLKernel(ClKernelPtr k) : kernel(std::move(k)) { trace_name = trace::Intern(GetName()); }
     OCLKernel(ClKernelPtr k, std::vector<size_t> local_dims, std::vector<size_t> global_dims)
         : kernel(std::move(k)), ldims(std::move(local_dims)), gdims(std::move(global_dims))
     {
         assert(ldims.size() == gdims.size());
         assert(!ldims.empty() && ldims.size() <= 3);
+        trace_name = trace::Intern(GetName());
     }
 
     OCLKernel(SharedProgramPtr p,
@@ -152,6 +168,7 @@ class OCLKernel
         {
             std::fill(ldims.begin(), ldims.end(), 0);
         }
+        trace_name = trace::Intern(kernel_name);
     }
 
     OCLKernelInvoke Invoke(cl_command_queue q,
@@ -169,6 +186,8 @@ class OCLKernel
     SharedKernelPtr kernel;
     std::vector<size_t> ldims;
     std::vector<size_t> gdims;
+    std::shared_ptr<std::mutex> args_mutex = std::make_shared<std::mutex>();
+    const char* trace_name                 = nullptr;
 };
 
 } // namespace miopen
@@ -0,0 +1,258 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PERF_SPACE_HPP_
+#define GUARD_MIOPEN_PERF_SPACE_HPP_
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Values l, l+1, ..., h.
+inline std::vector<int> LinearDomain(const int l, const int h)
+{
+    std::vector<int> values;
+    for(auto v = l; v <= h; ++v)
+        values.push_back(v);
+    return values;
+}
+
+/// Values l, 2l, 4l, ..., h.
+inline std::vector<int> TwoPowerDomain(const int l, const int h)
+{
+    std::vector<int> values;
+    for(auto v = l; v <= h; v *= 2)
+        values.push_back(v);
+    return values;
+}
+
+namespace detail {
+
+template <class T, class = std::enable_if_t<std::is_integral<T>{}>>
+void SetPerfField(T& field, const int value)
+{
+    field = static_cast<T>(value);
+}
+
+template <class T, class = std::enable_if_t<!std::is_integral<T>{}>, class = void>
+void SetPerfField(T&, int)
+{
+    MIOPEN_THROW("Only integral fields of a performance config may have a domain");
+}
+
+} // namespace detail
+
+/// The set of performance configs of a solver for a given problem, declared rather than
+/// computed by SetNextValue() and IsValid().
+///
+/// The fields are those reported by PerformanceConfig::Visit(). Each field takes the values
+/// of its domain, or keeps the value it has in the first config if it has none. Constraints
+/// are predicates over the config which shall depend only on the fields they name. Configs are
+/// enumerated like SetNextValue() does, the first visited field changing fastest, and every
+/// constraint is checked as soon as the fields it names are set, so that a sub-space where it
+/// fails is skipped as a whole.
+///
+/// Together, domains and constraints shall describe exactly the configs that are valid for
+/// the problem.
+template <class PerformanceConfig>
+class PerfSpace
+{
+    public:
+    using Predicate = std::function<bool(const PerformanceConfig&)>;
+
+    /// Position of the enumeration. positions[k] is into the domain of the k-th field counted
+    /// from the last visited one.
+    struct Cursor
+    {
+        PerformanceConfig value;
+        std::vector<std::size_t> positions;
+    };
+
+    explicit PerfSpace(const PerformanceConfig& first_) : first(first_)
+    {
+        PerformanceConfig::Visit(first, [&](auto&&, const std::string& name) {
+            names.push_back(name);
+            domains.push_back({});
+        });
+        checks.resize(names.size() + 1);
+    }
+
+    /// Values of the field `name` in the order of enumeration.
+    PerfSpace& Domain(const std::string& name, std::vector<int> values)
+    {
+        domains[Index(name)] = std::move(values);
+        return *this;
+    }
+
+    /// `predicate` shall depend only on the fields named by `fields` and on the problem.
+    PerfSpace& Constraint(std::initializer_list<const char*> fields, Predicate predicate)
+    {
+        // Checked at the deepest level its fields are set at, before anything if it names none
+        int level = -1;
+        for(const auto field : fields)
+            level = std::max(level, Level(field));
+        checks[level + 1].push_back(std::move(predicate));
+        last_checked = std::max(last_checked, level);
+        return *this;
+    }
+
+    /// Whether `config` satisfies all the constraints. Domains are not checked.
+    bool IsSatisfied(const PerformanceConfig& config) const
+    {
+        return std::all_of(checks.begin(), checks.end(), [&](const auto& level) {
+            return Check(level, config);
+        });
+    }
+
+    /// Number of configs without any constraint.
+    std::size_t RawSize() const
+    {
+        std::size_t size = 1;
+        for(auto level = 0; level < Levels(); ++level)
+            size *= DomainSize(level);
+        return size;
+    }
+
+    /// Number of valid configs. Only the levels that have constraints are enumerated.
+    std::size_t Size() const
+    {
+        if(!Check(checks.front(), first))
+            return 0;
+        auto value = first;
+        return Count(value, 0);
+    }
+
+    /// Sets `cursor` to the first valid config.
+    bool First(Cursor& cursor) const
+    {
+        cursor.value = first;
+        cursor.positions.assign(Levels(), 0);
+        if(!Check(checks.front(), cursor.value))
+            return false;
+        return Seek(cursor, 0, true);
+    }
+
+    /// Advances `cursor` to the next valid config.
+    bool Next(Cursor& cursor) const { return Seek(cursor, Levels() - 1, false); }
+
+    private:
+    PerformanceConfig first;
+    std::vector<std::string> names;
+    std::vector<std::vector<int>> domains;      // by field
+    std::vector<std::vector<Predicate>> checks; // by level + 1, those naming no field first
+    int last_checked = -1;
+
+    int Levels() const { return static_cast<int>(names.size()); }
+
+    int Index(const std::string& name) const
+    {
+        const auto it = std::find(names.begin(), names.end(), name);
+        if(it == names.end())
+            MIOPEN_THROW("No performance config field " + name);
+        return static_cast<int>(it - names.begin());
+    }
+
+    int Level(const std::string& name) const { return Levels() - 1 - Index(name); }
+
+    std::size_t DomainSize(const int level) const
+    {
+        const auto& domain = domains[Levels() - 1 - level];
+        return domain.empty() ? 1 : domain.size();
+    }
+
+    void Set(PerformanceConfig& config, const int level, const std::size_t position) const
+    {
+        const auto index   = Levels() - 1 - level;
+        const auto& domain = domains[index];
+        if(domain.empty())
+            return;
+        auto i = 0;
+        PerformanceConfig::Visit(config, [&](auto&& field, auto&&) {
+            if(i++ == index)
+                detail::SetPerfField(field, domain[position]);
+        });
+    }
+
+    static bool Check(const std::vector<Predicate>& predicates, const PerformanceConfig& config)
+    {
+        return std::all_of(
+            predicates.begin(), predicates.end(), [&](const auto& p) { return p(config); });
+    }
+
+    bool Seek(Cursor& cursor, int level, bool fresh) const
+    {
+        for(;;)
+        {
+            if(level == Levels())
+                return true;
+            if(level < 0)
+                return false;
+            auto& position = cursor.positions[level];
+            position       = fresh ? 0 : position + 1;
+            for(; position < DomainSize(level); ++position)
+            {
+                Set(cursor.value, level, position);
+                if(Check(checks[level + 1], cursor.value))
+                    break;
+            }
+            fresh = position < DomainSize(level);
+            level += fresh ? 1 : -1;
+        }
+    }
+
+    std::size_t Count(PerformanceConfig& value, const int level) const
+    {
+        if(level > last_checked)
+        {
+            std::size_t size = 1;
+            for(auto l = level; l < Levels(); ++l)
+                size *= DomainSize(l);
+            return size;
+        }
+
+        std::size_t size = 0;
+        for(std::size_t position = 0; position < DomainSize(level); ++position)
+        {
+            Set(value, level, position);
+            if(Check(checks[level + 1], value))
+                size += Count(value, level + 1);
+        }
+        return size;
+    }
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PERF_SPACE_HPP_
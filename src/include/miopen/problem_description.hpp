@@ -45,13 +45,24 @@ size_t SetDescFromMLDesc(TTo& to, const TensorDescriptor& tensor, const TFunc me
     std::tie(n, c, h, w)     = miopen::tien<4>(tensor.GetLengths(), 1);
     std::tie(ns, cs, hs, ws) = miopen::tien<4>(tensor.GetStrides(), 0);
 
-    (to.*method)("NCHW", tensor.GetType(), n, c, h, w, ns, cs, hs, ws);
+    // Default layouts keep the historical "NCHW" tag so that existing db keys stay valid
+    std::string layout = "NCHW";
+    if(!tensor.IsDefaultLayout())
+        layout = tensor.GetLayout(tensor.GetSize() == 5 ? "NCDHW" : "NCHW");
+
+    (to.*method)(layout, tensor.GetType(), n, c, h, w, ns, cs, hs, ws);
 
     return tensor.GetElementSpace();
 }
 
 struct ConvolutionDescriptor;
 
+// Layout tags for which the descriptor setters size the tensor from its lengths alone
+inline bool IsPackedLayoutTag(const std::string& layout)
+{
+    return layout == "NCHW" || layout == "NHWC" || layout == "NDHWC";
+}
+
 inline std::string GetDataTypeName(miopenDataType_t data_type)
 {
     switch(data_type)
@@ -129,6 +140,14 @@ struct ProblemDescription
         void Set(T) = delete;
         void SetBackwardWrW() { v = Value::BackwardWrW; }
     } direction;
+
+    /// True if both data tensors use the default layout. Solvers accept only such problems unless
+    /// they declare otherwise via IsLayoutSupported().
+    bool IsLayoutDefault() const
+    {
+        return (in_layout.empty() || in_layout == "NCHW") &&
+               (out_layout.empty() || out_layout == "NCHW");
+    }
     int GetBackwardPadW() const { return kernel_size_w - pad_w - 1; }
     int GetBackwardPadH() const { return kernel_size_h - pad_h - 1; }
 
@@ -176,7 +195,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -209,7 +228,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -288,7 +307,7 @@ struct ProblemDescription
         kernel_size_h     = height;
         weights_data_type = data_type;
         int data_len      = GetTypeSize(data_type);
-        size_t size       = (layout == "NCHW")
+        size_t size       = IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         weights_sz = size;
@@ -310,7 +329,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         if(direction.IsForward())
@@ -359,7 +378,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsPackedLayoutTag(layout)
                           ? batch * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         if(direction.IsForward())
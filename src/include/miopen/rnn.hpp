@@ -33,7 +33,11 @@
 #include <miopen/object.hpp>
 
 #include <cstddef>
+#include <functional>
 #include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <vector>
 
@@ -60,6 +64,92 @@ struct c_array_view
 
 void profileRNNkernels(Handle& handle, unsigned char select, float& ctime);
 
+// A maximal run of consecutive time steps that share one batch size. Sequences are packed
+// time-major in descending batch order, so the rows of a bucket are contiguous.
+struct RNNBatchBucket
+{
+    int first_time = 0; // first time step of the bucket
+    int steps      = 0; // number of time steps in the bucket
+    int batch      = 0; // batch size of every step in the bucket
+    int row        = 0; // packed row of the first step
+};
+
+std::vector<RNNBatchBucket> RNNBatchBuckets(const std::vector<int>& in_n);
+
+struct RNNRowRange
+{
+    int row  = 0; // first packed row
+    int rows = 0; // number of rows
+};
+
+// Rows that get the reverse-direction hidden bias when there is no hx: every row whose
+// sequence goes on at the next time step. One range per bucket, empty ranges are skipped.
+std::vector<RNNRowRange> RNNReverseBiasRows(const std::vector<int>& in_n);
+
+// Buffers bound to an RNN plan at execution time.
+struct RNNPlanArgs
+{
+    ConstData_t x    = nullptr;
+    ConstData_t hx   = nullptr;
+    ConstData_t cx   = nullptr;
+    ConstData_t w    = nullptr;
+    Data_t y         = nullptr;
+    Data_t hy        = nullptr;
+    Data_t cy        = nullptr;
+    Data_t workSpace = nullptr;
+};
+
+// Everything that the launch sequence of an RNN call depends on apart from the buffers
+// themselves. Two calls with equal shapes on the same descriptor issue identical launches.
+struct RNNPlanShape
+{
+    int seqLen = 0;
+    std::vector<int> in_n;
+    int in_h                  = 0;
+    int hy_d                  = 0;
+    int hy_n                  = 0;
+    int hy_h                  = 0;
+    int out_h                 = 0;
+    miopenDataType_t xType    = miopenFloat;
+    miopenDataType_t wType    = miopenFloat;
+    std::size_t workSpaceSize = 0;
+    bool has_hx               = false;
+    bool has_cx               = false;
+    bool has_hy               = false;
+    bool has_cy               = false;
+    // Run the recurrent GEMMs of both directions as one strided batched GEMM where the
+    // batches of a step allow it.
+    bool pack_directions      = true;
+
+    bool operator<(const RNNPlanShape& other) const;
+};
+
+// Pre-resolved sequence of launches: descriptors, offsets and GEMM geometries are computed
+// once, so replaying a plan only binds buffers and enqueues kernels.
+struct RNNPlan
+{
+    using Step = std::function<void(Handle&, const RNNPlanArgs&)>;
+    std::vector<Step> steps;
+    // GEMM calls issued per replay; a packed GEMM counts once.
+    std::size_t gemm_submissions = 0;
+
+    void Run(Handle& handle, const RNNPlanArgs& args) const;
+};
+
+class RNNPlanCache
+{
+    public:
+    // Number of shape profiles kept before the cache is flushed.
+    static const std::size_t max_size = 64;
+
+    std::shared_ptr<const RNNPlan> Find(const RNNPlanShape& shape) const;
+    void Add(const RNNPlanShape& shape, std::shared_ptr<const RNNPlan> plan);
+
+    private:
+    mutable std::mutex mutex;
+    std::map<RNNPlanShape, std::shared_ptr<const RNNPlan>> plans;
+};
+
 struct RNNDescriptor : miopenRNNDescriptor
 {
 
@@ -88,6 +178,10 @@ struct RNNDescriptor : miopenRNNDescriptor
     miopenDataType_t dataType;
     std::size_t typeSize;
 
+    // Compiled plans are owned by the descriptor: miopenSetRNNDescriptor replaces the
+    // descriptor and with it every plan that depends on its configuration.
+    std::shared_ptr<RNNPlanCache> planCache = std::make_shared<RNNPlanCache>();
+
     size_t biasOffsetCalculation(const TensorDescriptor& xDesc, int layer, int biasID);
 
     size_t paramsOffsetCalculation(const TensorDescriptor& xDesc, int layer, int paramID);
@@ -210,6 +304,8 @@ struct RNNDescriptor : miopenRNNDescriptor
                              Data_t workSpace,
                              size_t workSpaceSize) const;
 
+    RNNPlan CompileForwardInferencePlan(const RNNPlanShape& shape) const;
+
     void RNNBackwardData(Handle& handle,
                          int seqLen,
                          c_array_view<const miopenTensorDescriptor_t> yDesc,
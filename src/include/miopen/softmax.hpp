@@ -34,16 +34,43 @@ namespace miopen {
 struct Handle;
 struct TensorDescriptor;
 
-miopenStatus_t SoftmaxForward(
-    Handle& handle, const void* alpha, const void* beta, const TensorDescriptor& yDesc, Data_t y);
+/// Out-of-place softmax over the channels: y = alpha * softmax(x) + beta * y.
+/// x and y may be the same buffer.
+miopenStatus_t SoftmaxForward(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate);
 
+/// As SoftmaxForward, but on scale * x + mask. The mask is optional (nullptr) and may broadcast
+/// over any dimension in which its length is 1.
+miopenStatus_t ScaledMaskedSoftmaxForward(Handle& handle,
+                                          const void* alpha,
+                                          const void* beta,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          float scale,
+                                          const TensorDescriptor& maskDesc,
+                                          ConstData_t mask,
+                                          const TensorDescriptor& yDesc,
+                                          Data_t y,
+                                          miopenSoftmaxAlgorithm_t algorithm);
+
+/// dx = alpha * gradient + beta * dx, from the forward output y and its gradient dy.
+/// dy and dx may be the same buffer.
 miopenStatus_t SoftmaxBackward(Handle& handle,
                                const void* alpha,
                                const TensorDescriptor& yDesc,
                                ConstData_t y,
+                               const TensorDescriptor& dyDesc,
+                               ConstData_t dy,
                                const void* beta,
                                const TensorDescriptor& dxDesc,
-                               Data_t dx);
+                               Data_t dx,
+                               miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate);
 
 } // namespace miopen
 #endif // _MIOPEN_SOFTMAX_HPP_
@@ -29,14 +29,18 @@
 
 #include <miopen/config.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <ostream>
 
 #include <miopen/logger.hpp>
+#include <miopen/conv_cost_model.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/mlo_internal.hpp>
+#include <miopen/perf_space.hpp>
+#include <miopen/solver_cache.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/env.hpp>
 #include <miopen/type_name.hpp>
@@ -243,6 +247,22 @@ auto SearchForSolution(const Context& search_params, Db db) ->
 {
     using Solution =
         typename std::common_type<decltype(FindSolution(Solvers{}, search_params, db))...>::type;
+
+    static SolverCache<Solution> cache;
+    const FindEnforce enforce;
+    const bool use_cache = IsSolverCacheEnabled() && !enforce.IsDbClean(search_params);
+    const bool searching = search_params.do_search || enforce.IsSearch(search_params);
+    const auto key       = use_cache ? GetSolverCacheKey(search_params) : std::string{};
+    if(use_cache && !searching)
+    {
+        const auto cached = cache.Find(key);
+        if(cached)
+        {
+            MIOPEN_LOG_I2("Solver cache hit: " << cached->solver_id);
+            return *cached;
+        }
+    }
+
     Solution solution{miopenStatusUnknownError};
 
 // Using const here causes gcc to ICE
@@ -253,7 +273,7 @@ auto SearchForSolution(const Context& search_params, Db db) ->
 
     miopen::each_args(
         [&](auto solver) {
-            if(solver.IsApplicable(search_params) &&
+            if(solver.IsLayoutSupported(search_params) && solver.IsApplicable(search_params) &&
                (no_perf_filtering || solver.IsFast(search_params)))
             {
                 if(!solution.Succeeded())
@@ -277,6 +297,8 @@ auto SearchForSolution(const Context& search_params, Db db) ->
         },
         Solvers{}...);
 
+    if(use_cache)
+        cache.Insert(key, solution);
     return solution;
 }
 
@@ -288,12 +310,30 @@ static inline bool IsPureOpenCLSolution(const Solution& s)
                        [](const auto& k) { return miopen::EndsWith(k.kernel_file, ".cl"); });
 }
 
-// Search for all applicable solutions among many solvers
-template <class... Solvers, class Context, class Db, class Solution = miopen::solver::ConvSolution>
-std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
+// Whether a found solution ends the search for all solutions: always in "find first" mode, and
+// for pure OpenCL solutions when the workaround of the direction is enabled.
+template <class Context, class Solution>
+bool IsLastSearchedSolution(const Context& search_params, const Solution& s)
 {
-    std::vector<Solution> ss;
+    if(miopen::IsEnabled(MIOPEN_DEBUG_FIND_FIRST_CONV{}))
+        return true;
+    if(!IsPureOpenCLSolution(s))
+        return false;
+    /// \todo (algorithm == Direct) is not checked here.
+    /// This is ok so far, as SearchForAllSolutions() is used only for direct
+    /// convolutions (for now).
+    return (search_params.direction.IsForward() &&
+            miopen::IsEnabled(MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_FWD{})) ||
+           (search_params.direction.IsBackwardData() &&
+            miopen::IsEnabled(MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_BWD{})) ||
+           (search_params.direction.IsBackwardWrW() &&
+            miopen::IsEnabled(MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_WRW{}));
+}
 
+// Applicable solvers as (estimated time, index into Solvers), fastest first.
+template <class... Solvers, class Context>
+std::vector<std::pair<float, std::size_t>> RankApplicableSolvers(const Context& search_params)
+{
 // Using const here causes gcc to ICE
 #if(!defined(__GNUC__) || defined(__clang__))
     const
@@ -302,40 +342,89 @@ std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
             miopen::IsDisabled(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING{}) ||
             !miopen::IsEnabled(MIOPEN_DEBUG_FIND_FIRST_CONV{});
 
-    bool skip_the_rest = false;
-    miopen::each_args( // clang-format off
-        [&](auto solver) { // cppcheck-suppress knownConditionTrueFalse
-            if(!skip_the_rest
+    const auto features = ConvCostFeatures::From(search_params, &search_params.GetStream());
+    const auto model    = GetConvCostModel();
+    std::vector<std::pair<float, std::size_t>> ranked;
+    miopen::each_args_i( // clang-format off
+        [&](auto i, auto solver) {
+            if(solver.IsLayoutSupported(search_params)
                && solver.IsApplicable(search_params)
                && (no_perf_filtering || solver.IsFast(search_params)))
             { // clang-format on
+                const auto cost = model->Estimate(features, SolverDbId(solver));
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Estimated " << cost << " ms");
+                ranked.emplace_back(cost, i);
+            }
+            else
+            {
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
+            }
+        },
+        Solvers{}...);
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto& l, const auto& r) {
+        return l.first < r.first;
+    });
+    const auto top_k = GetConvFindTopK();
+    if(top_k != 0 && ranked.size() > top_k)
+    {
+        MIOPEN_LOG_I2("Trying the " << top_k << " best ranked of " << ranked.size()
+                                    << " applicable solvers");
+        ranked.resize(top_k);
+    }
+    return ranked;
+}
+
+// Search for all applicable solutions among many solvers.
+// Applicable solvers are tried in the order of their estimated time (see GetConvCostModel()),
+// and only the GetConvFindTopK() best ranked ones are tried at all.
+// Both the ranking and the solutions are memoized per problem (see SolverCache). Searching
+// bypasses the memoized solutions and replaces them with what it finds.
+template <class... Solvers, class Context, class Db, class Solution = miopen::solver::ConvSolution>
+std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
+{
+    struct Cached
+    {
+        std::vector<std::pair<float, std::size_t>> ranked;
+        std::vector<Solution> solutions;
+    };
+    static SolverCache<Cached> cache;
+
+    const FindEnforce enforce;
+    const bool use_cache = IsSolverCacheEnabled() && !enforce.IsDbClean(search_params);
+    const bool searching = search_params.do_search || enforce.IsSearch(search_params);
+    const auto key       = use_cache ? GetSolverCacheKey(search_params) : std::string{};
+    const auto cached    = use_cache ? cache.Find(key) : boost::none;
+    if(cached && !searching)
+    {
+        MIOPEN_LOG_I2("Solver cache hit: " << cached->solutions.size() << " solutions");
+        return cached->solutions;
+    }
+
+    std::vector<Solution> ss;
+    std::vector<std::pair<float, std::size_t>> ranked;
+    if(cached)
+        ranked = cached->ranked;
+    else
+        ranked = RankApplicableSolvers<Solvers...>(search_params);
+
+    bool skip_the_rest = false;
+    for(const auto& r : ranked)
+    {
+        miopen::each_args_i(
+            [&](auto i, auto solver) { // cppcheck-suppress knownConditionTrueFalse
+                if(i != r.second)
+                    return;
+                if(skip_the_rest)
+                {
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped");
+                    return;
+                }
                 const Solution s = FindSolution(solver, search_params, db);
                 if(s.Succeeded())
                 {
                     ss.push_back(s);
                     MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
-
-                    if(miopen::IsEnabled(MIOPEN_DEBUG_FIND_FIRST_CONV{}))
-                    {
-                        skip_the_rest = true;
-                    }
-                    else if(IsPureOpenCLSolution(s))
-                    {
-                        /// \todo (algorithm == Direct) is not checked here.
-                        /// This is ok so far, as SearchForAllSolutions() is used only for direct
-                        /// convolutions (for now).
-                        if((search_params.direction.IsForward() &&
-                            miopen::IsEnabled(
-                                MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_FWD{})) ||
-                           (search_params.direction.IsBackwardData() &&
-                            miopen::IsEnabled(
-                                MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_BWD{})) ||
-                           (search_params.direction.IsBackwardWrW() &&
-                            miopen::IsEnabled(MIOPEN_OPENCL_WORKAROUND_FIND_ALL_CONV_DIRECT_WRW{})))
-                        {
-                            skip_the_rest = true;
-                        }
-                    }
+                    skip_the_rest = IsLastSearchedSolution(search_params, s);
                 }
                 else
                 {
@@ -347,17 +436,56 @@ std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
                     MIOPEN_LOG_I(SolverDbId(solver)
                                  << ": [Warning] Applicable Solver not succeeded.");
                 }
-            }
-            else
-            {
-                MIOPEN_LOG_I2(SolverDbId(solver) << ": "
-                                                 << (skip_the_rest ? "Skipped" : "Not applicable"));
-            }
-        },
-        Solvers{}...);
+            },
+            Solvers{}...);
+    }
+    if(use_cache)
+        cache.Insert(key, {ranked, ss});
     return ss;
 }
 
+/// An applicable solver whose search only runs when find is called, so that the caller decides
+/// per solver whether searching and tuning it is worth the time.
+template <class Solution>
+struct DeferredSolution
+{
+    std::string solver_id;
+    float estimate; // ms, as predicted by the cost model
+    std::function<Solution()> find;
+};
+
+// Same solvers in the same order as SearchForAllSolutions() tries, none of them searched yet.
+// Once a solver's find succeeds in a way that ends SearchForAllSolutions() early, the finds of
+// the solvers after it fail. The solver cache is bypassed.
+template <class... Solvers, class Context, class Db, class Solution = miopen::solver::ConvSolution>
+std::vector<DeferredSolution<Solution>> DeferAllSolutions(const Context& search_params, Db db)
+{
+    const auto skip_the_rest = std::make_shared<bool>(false);
+    std::vector<DeferredSolution<Solution>> deferred;
+    for(const auto& r : RankApplicableSolvers<Solvers...>(search_params))
+    {
+        miopen::each_args_i(
+            [&](auto i, auto solver) { // cppcheck-suppress knownConditionTrueFalse
+                if(i != r.second)
+                    return;
+                auto find = [=]() mutable {
+                    if(*skip_the_rest)
+                    {
+                        MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped");
+                        return Solution{miopenStatusUnknownError};
+                    }
+                    Solution s = FindSolution(solver, search_params, db);
+                    if(s.Succeeded())
+                        *skip_the_rest = IsLastSearchedSolution(search_params, s);
+                    return s;
+                };
+                deferred.push_back({SolverDbId(solver), r.first, find});
+            },
+            Solvers{}...);
+    }
+    return deferred;
+}
+
 /// Base class for problem solvers.
 ///
 /// Solvers are to be instantiated as const objects and shall not have any variable
@@ -396,6 +524,11 @@ struct SolverBase
     /// says "I'm suitable" for a problem, it agrees to solve that problem correctly.
     bool IsApplicable(const Context&) const { return true; }
 
+    /// Returns true if the solver handles the memory layouts of the problem's tensors.
+    /// Solvers take the default layouts only, unless they override this. Problems that no
+    /// solver takes natively are solved in the default layout on transposed copies.
+    bool IsLayoutSupported(const Context& ctx) const { return ctx.IsLayoutDefault(); }
+
     /// Legacy euristic method which shall return false when a solution
     /// is known to be slower than some another solution for the same problem config.
     /// Intended to be used for performance optimization.
@@ -518,6 +651,8 @@ struct PerformanceConfigConvAsm1x1U : Serializable<PerformanceConfigConvAsm1x1U>
     bool IsValidValue() const;
     bool SetNextValue();
     bool IsValid(const ConvolutionContext& config) const;
+    static PerfSpace<PerformanceConfigConvAsm1x1U> Space(const ConvolutionContext& config,
+                                                         bool spare);
     bool operator==(const PerformanceConfigConvAsm1x1U& other) const;
     std::string ToString() const;
 };
@@ -1013,7 +1148,7 @@ struct AnySolver
         AnySolver_tmpl(T obj) : value(std::move(obj)){};
         bool IsApplicable(const ConvolutionContext& ctx) const override
         {
-            return value.IsApplicable(ctx);
+            return value.IsLayoutSupported(ctx) && value.IsApplicable(ctx);
         };
         bool IsFast(const ConvolutionContext& ctx) const override { return value.IsFast(ctx); };
         ConvSolution FindSolution(const ConvolutionContext& ctx, MultiFileDb& db) const override
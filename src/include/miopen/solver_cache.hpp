@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SOLVER_CACHE_HPP_
+#define GUARD_MIOPEN_SOLVER_CACHE_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+struct ConvolutionContext;
+
+/// Identifies everything solver applicability and the resulting solutions depend on: the device,
+/// the problem, including the parts its perf-db key leaves out (strides, output layout), and the
+/// context flags that select kernel flavours.
+std::string GetSolverCacheKey(const ConvolutionContext& context);
+
+/// Generation of the cached entries. Everything else they depend on, like the find-enforce
+/// settings, is fixed for the life of the process.
+std::size_t GetSolverCacheEpoch();
+
+/// Drops the entries of all solver caches, e.g. when SetConvCostModel() changes the ranking.
+void InvalidateSolverCaches();
+
+/// MIOPEN_DEBUG_SOLVER_CACHE=0 disables the caches.
+bool IsSolverCacheEnabled();
+
+/// In-process memo of what a solver search computed for a problem, so that Find for a layer seen
+/// before does not run the applicability checks and perf-db lookups again. There is one instance
+/// per list of solvers, and a few for fusion plans. InvalidateSolverCaches() drops the entries.
+template <class Value>
+class SolverCache
+{
+    public:
+    static constexpr std::size_t max_entries = 4096;
+
+    boost::optional<Value> Find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Validate();
+        const auto it = entries.find(key);
+        if(it == entries.end())
+            return boost::none;
+        return it->second;
+    }
+
+    void Insert(const std::string& key, Value value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Validate();
+        if(entries.size() >= max_entries)
+            entries.clear();
+        entries[key] = std::move(value);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+
+    private:
+    void Validate()
+    {
+        const auto current = GetSolverCacheEpoch();
+        if(current == epoch)
+            return;
+        entries.clear();
+        epoch = current;
+    }
+
+    std::mutex mutex;
+    std::size_t epoch = 0;
+    std::unordered_map<std::string, Value> entries;
+};
+
+template <class Value>
+constexpr std::size_t SolverCache<Value>::max_entries;
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_CACHE_HPP_
@@ -32,8 +32,10 @@
 #include <miopen/each_args.hpp>
 #include <miopen/returns.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/inline_vector.hpp>
 
 #include <cassert>
+#include <string>
 #include <vector>
 
 namespace miopen {
@@ -113,6 +115,12 @@ std::ptrdiff_t integer_division_ceil(X x, Y y)
     return (tx + ty - 1) / ty;
 }
 
+/// Most dimensions a tensor can have. Lengths and strides are stored inline up to this bound, so
+/// that descriptors can be created and copied without allocating.
+static constexpr std::size_t max_tensor_dims = 6;
+
+using TensorLengths = inline_vector<std::size_t, max_tensor_dims>;
+
 struct TensorDescriptor : miopenTensorDescriptor
 {
     TensorDescriptor();
@@ -127,9 +135,14 @@ struct TensorDescriptor : miopenTensorDescriptor
                      std::vector<std::size_t> lens_in,
                      std::vector<std::size_t> strides_in);
 
+    // Packed tensor in the given memory layout; lens_in is in NCHW (NCDHW) order
+    TensorDescriptor(miopenDataType_t t,
+                     miopenTensorLayout_t layout,
+                     std::vector<std::size_t> lens_in);
+
     template <class Range>
     TensorDescriptor(miopenDataType_t t, const Range& plens)
-        : lens(plens.begin(), plens.end()), packed(true), type(t)
+        : lens(plens.begin(), plens.end()), type(t)
     {
         this->CalculateStrides();
     }
@@ -138,20 +151,20 @@ struct TensorDescriptor : miopenTensorDescriptor
     TensorDescriptor(miopenDataType_t t, const Range1& plens, const Range2& pstrides)
         : lens(plens.begin(), plens.end()), strides(pstrides.begin(), pstrides.end()), type(t)
     {
-        packed = (this->GetElementSize() == this->GetElementSpace());
+        this->UpdateDerived();
     }
 
     void CalculateStrides();
 
-    const std::vector<std::size_t>& GetLengths() const;
-    const std::vector<std::size_t>& GetStrides() const;
+    const TensorLengths& GetLengths() const { return lens; }
+    const TensorLengths& GetStrides() const { return strides; }
     int GetSize() const;
 
-    miopenDataType_t GetType() const;
+    miopenDataType_t GetType() const { return type; }
 
-    std::size_t GetElementSize() const;
+    std::size_t GetElementSize() const { return element_size; }
 
-    std::size_t GetElementSpace() const;
+    std::size_t GetElementSpace() const { return element_space; }
 
     std::size_t GetNumBytes() const;
 
@@ -163,7 +176,15 @@ struct TensorDescriptor : miopenTensorDescriptor
         return this->GetIndex({static_cast<int>(is)...});
     }
 
-    bool IsPacked() const;
+    bool IsPacked() const { return packed; }
+
+    // Returns the permutation of labels (named in logical order, e.g. "NCHW") that the strides
+    // describe: labels itself or its channels-last form ("NHWC"). Strides that fit neither, such
+    // as padded or sliced tensors, report labels unchanged.
+    std::string GetLayout(std::string labels) const;
+
+    // True unless the tensor is a 4-D or 5-D tensor laid out channels-last
+    bool IsDefaultLayout() const;
 
     bool operator==(const TensorDescriptor& rhs) const;
     bool operator!=(const TensorDescriptor& rhs) const;
@@ -175,16 +196,42 @@ struct TensorDescriptor : miopenTensorDescriptor
     friend std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t);
 
     private:
-    std::vector<std::size_t> lens;
-    std::vector<std::size_t> strides;
+    // Recomputes the cached properties below from lens and strides
+    void UpdateDerived();
+
+    TensorLengths lens;
+    TensorLengths strides;
 
-    bool packed;
+    std::size_t element_size  = 1;
+    std::size_t element_space = 1;
+    bool packed               = true;
 
     miopenDataType_t type = miopenFloat;
 };
 
 } // namespace miopen
 
+namespace std {
+
+template <>
+struct hash<miopen::TensorDescriptor>
+{
+    std::size_t operator()(const miopen::TensorDescriptor& x) const
+    {
+        std::size_t seed = x.GetType();
+        const auto combine = [&](std::size_t v) {
+            seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        for(auto l : x.GetLengths())
+            combine(l);
+        for(auto s : x.GetStrides())
+            combine(s);
+        return seed;
+    }
+};
+
+} // namespace std
+
 MIOPEN_DEFINE_OBJECT(miopenTensorDescriptor, miopen::TensorDescriptor)
 
 #endif // GUARD_MIOPEN_TENSOR_HPP_
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TENSOR_EXPR_HPP_
+#define GUARD_MIOPEN_TENSOR_EXPR_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/tensor.hpp>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+// The first four values match miopenTensorOp_t. The numeric values are also the step codes
+// understood by MIOpenTensorExpr.cl, so do not reorder.
+enum class TensorExprOp
+{
+    Add   = miopenTensorOpAdd,
+    Mul   = miopenTensorOpMul,
+    Min   = miopenTensorOpMin,
+    Max   = miopenTensorOpMax,
+    Scale = 4,
+    Set   = 5,
+    Cast  = 6,
+};
+
+struct TensorExprStep
+{
+    TensorExprOp op;
+    int dst;
+    int a;
+    int b;
+    float alpha0;
+    float alpha1;
+    float beta;
+};
+
+// Broadcast shape of an expression after dropping unit dimensions and merging dimensions that
+// are contiguous in every operand. Broadcast dimensions of an operand have stride 0.
+struct TensorExprShape
+{
+    TensorLengths lens;
+    std::vector<TensorLengths> strides;
+};
+
+// A chain of OpTensor/ScaleTensor/SetTensor/CastTensor steps over up to max_tensors operands
+// which is executed as a single kernel with one memory pass. Every operand is loaded at most
+// once per element, intermediate values stay in registers and are rounded to the type of the
+// tensor they are assigned to, so the result matches running the steps one at a time.
+// Operands may broadcast (length 1) in any dimension unless a step writes to them.
+struct TensorExpression : miopenTensorExpression
+{
+    static constexpr std::size_t max_tensors   = 4;
+    static constexpr std::size_t max_steps     = 6;
+    static constexpr std::size_t max_flat_dims = 5;
+
+    int AddTensor(const TensorDescriptor& desc);
+
+    // c = op(alpha0 * a, alpha1 * b) + beta * c
+    void
+    AddOp(miopenTensorOp_t tensorOp, float alpha0, int a, float alpha1, int b, float beta, int c);
+    // y = alpha * y
+    void AddScale(int y, float alpha);
+    // y = alpha
+    void AddSet(int y, float alpha);
+    // y = alpha * x, converted and saturated to the type of y
+    void AddCast(float alpha, int x, int y);
+
+    const std::vector<TensorDescriptor>& GetTensors() const { return tensors; }
+    const std::vector<TensorExprStep>& GetSteps() const { return steps; }
+    const TensorLengths& GetLengths() const { return lens; }
+
+    // Whether the kernel has to load the operand before the first step that assigns to it
+    bool IsLoaded(int i) const;
+    bool IsStored(int i) const;
+
+    TensorExprShape GetFlattenedShape() const;
+    std::string GetNetworkConfig() const;
+    std::string GetCompileParms() const;
+
+    // Host reference. Each pointer refers to host memory holding the matching operand.
+    void Evaluate(const std::vector<void*>& buffers) const;
+
+    void Run(Handle& handle, const std::vector<Data_t>& buffers) const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const TensorExpression& x);
+
+    private:
+    void AddStep(const TensorExprStep& step);
+    void CheckIndex(int i) const;
+    void Validate() const;
+
+    std::vector<TensorDescriptor> tensors;
+    std::vector<TensorExprStep> steps;
+    TensorLengths lens;
+};
+
+} // namespace miopen
+MIOPEN_DEFINE_OBJECT(miopenTensorExpression, miopen::TensorExpression);
+#endif // GUARD_MIOPEN_TENSOR_EXPR_HPP_
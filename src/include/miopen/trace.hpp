@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP
+#define GUARD_MIOPEN_TRACE_HPP
+
+#include <miopen/logger.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <type_traits>
+
+namespace miopen {
+namespace trace {
+
+/// Tracing is opt-in (MIOPEN_ENABLE_TRACE). When disabled, a trace scope costs one
+/// branch on a cached flag.
+bool IsTracing();
+
+/// Monotonic time in nanoseconds.
+std::uint64_t Now();
+
+/// Returns a pointer to a copy of name that lives until the end of the process.
+const char* Intern(const std::string& name);
+
+/// Appends a complete event to the ring buffer of the calling thread and adds its duration
+/// to the latency histogram of (category, name). Takes no lock unless (category, name) is new
+/// to the thread. Category and name must outlive the process,
+/// i.e. be literals or come from Intern().
+void Record(const char* category, const char* name, std::uint64_t begin, std::uint64_t end);
+
+/// Latencies in power-of-two buckets: bucket i counts durations in [2^i, 2^(i+1)) ns.
+struct Histogram
+{
+    std::size_t count       = 0;
+    std::uint64_t total     = 0;
+    std::uint64_t min       = 0;
+    std::uint64_t max       = 0;
+    std::array<std::size_t, 64> buckets{};
+
+    void Add(std::uint64_t duration);
+    void Merge(const Histogram& other);
+    /// Upper bound in ns of the bucket that holds the given fraction of the samples.
+    std::uint64_t Percentile(double fraction) const;
+};
+
+/// Histograms of all threads, keyed by "category/name".
+std::map<std::string, Histogram> GetHistograms();
+
+/// Writes the events currently held in the ring buffers in Chrome trace format, which both
+/// chrome://tracing and Perfetto load. Safe to call while other threads are tracing: each
+/// ring is copied first, and events overwritten during the copy are dropped. Recording never
+/// waits for a snapshot.
+void WriteChromeTrace(std::ostream& os);
+
+class Scope
+{
+    public:
+    Scope(const char* category_, const char* name_)
+    {
+        if(IsTracing())
+            Start(category_, name_);
+    }
+
+    /// For names that are expensive to build: the callable runs only when tracing is on.
+    template <class F,
+              typename std::enable_if<(not std::is_convertible<F, const char*>{}), int>::type = 0>
+    Scope(const char* category_, F make_name)
+    {
+        if(IsTracing())
+            Start(category_, Intern(make_name()));
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ~Scope()
+    {
+        if(category != nullptr)
+            Record(category, name, begin, Now());
+    }
+
+    private:
+    void Start(const char* category_, const char* name_)
+    {
+        category = category_;
+        name     = name_;
+        begin    = Now();
+    }
+
+    const char* category = nullptr;
+    const char* name     = nullptr;
+    std::uint64_t begin  = 0;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_SCOPE(category, ...) \
+    miopen::trace::Scope MIOPEN_PP_CAT(miopen_trace_scope_, __LINE__)(category, __VA_ARGS__)
+
+#define MIOPEN_TRACE_API() MIOPEN_TRACE_SCOPE("api", __func__)
+
+#endif // GUARD_MIOPEN_TRACE_HPP
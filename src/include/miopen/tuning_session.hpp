@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_SESSION_HPP_
+#define GUARD_MIOPEN_TUNING_SESSION_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/handle.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace miopen {
+
+/// Counter-based generator: the sequence depends only on the seed, so chunks of a buffer can be
+/// generated independently and in any order.
+struct RandomStream
+{
+    std::uint64_t state;
+
+    std::uint64_t NextBits()
+    {
+        // splitmix64
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z               = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Uniform in [0, 1).
+    float Next() { return static_cast<float>(NextBits() >> 40) * (1.0f / (1 << 24)); }
+};
+
+/// Splits [0, count) into fixed-size chunks and calls fill(begin, end, chunk_seed) for each of
+/// them on all hardware threads. The chunking does not depend on the number of threads.
+void ParallelFill(std::size_t count,
+                  std::uint64_t seed,
+                  const std::function<void(std::size_t, std::size_t, std::uint64_t)>& fill);
+
+/// data[i] = (uniform[0, 1) + offset) * factor
+template <class T>
+void FillRandomly(T* data,
+                  std::size_t count,
+                  std::uint64_t seed,
+                  const float offset = 0.0f,
+                  const float factor = 1.0f)
+{
+    ParallelFill(count, seed, [&](std::size_t begin, std::size_t end, std::uint64_t chunk_seed) {
+        RandomStream rng{chunk_seed};
+        for(auto i = begin; i < end; ++i)
+            data[i] = static_cast<T>((rng.Next() + offset) * factor);
+    });
+}
+
+/// Resources shared by all the auto-tuning searches run while a session is open: one profiling
+/// handle, and one device buffer per convolution operand. Each search used to create its own
+/// handle and allocate and fill its own buffers; with a session only the first search pays for
+/// that, later ones get the same objects back.
+///
+/// A buffer is reused if it is large enough and still holds what the search asks for. Inputs
+/// hold random values that are the same for every search, and only need refilling after a
+/// search used the buffer as its output or with another element type. Outputs are never
+/// refilled, because searches run many kernels into the same output anyway.
+///
+/// Sessions are per host thread. The Find calls open one, any code may open an enclosing one to
+/// share the buffers across several Find calls, e.g. across the three directions.
+class TuningSession
+{
+    public:
+    enum class Operand
+    {
+        Bot,
+        Top,
+        Weights,
+        Bias,
+    };
+
+    enum class Contents
+    {
+        Output,  // whatever the last kernel left there
+        Uniform, // uniform[0, 1)
+        Weights, // (uniform[0, 1) - 0.5) * 0.001
+    };
+
+    struct Stats
+    {
+        std::size_t searches    = 0;
+        std::size_t reused      = 0; // buffers handed out without any setup
+        std::size_t setup_bytes = 0; // written to the device
+        float setup_ms          = 0; // spent creating the handle and filling buffers
+        float saved_ms          = 0; // estimated setup time avoided by reuse
+    };
+
+    /// Opens the session of the calling thread, creating it if none is open. Scopes nest, the
+    /// session is released together with its handle and buffers when the outermost one closes.
+    class Scope
+    {
+        public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        TuningSession& Get() const;
+    };
+
+    ~TuningSession();
+
+    /// The profiling handle. Every call is counted as a search.
+    Handle& GetHandle();
+
+    /// A device buffer of at least `count` elements of T.
+    template <class T>
+    Data_t GetBuffer(Operand operand, std::size_t count, Contents contents)
+    {
+        return GetBuffer(operand, count * sizeof(T), sizeof(T), contents, [&](void* host) {
+            const auto data = static_cast<T*>(host);
+            const auto seed = static_cast<std::uint64_t>(operand);
+            switch(contents)
+            {
+            case Contents::Output: break;
+            case Contents::Uniform: FillRandomly(data, count, seed); break;
+            case Contents::Weights: FillRandomly(data, count, seed, -0.5f, 0.001f); break;
+            }
+        });
+    }
+
+    const Stats& GetStats() const { return stats; }
+
+    private:
+    struct Slot
+    {
+        Allocator::ManageDataPtr buffer = nullptr;
+        std::size_t capacity            = 0;
+        std::size_t valid               = 0; // bytes holding `contents`
+        std::size_t element_size        = 0;
+        Contents contents               = Contents::Output;
+    };
+
+    Data_t GetBuffer(Operand operand,
+                     std::size_t bytes,
+                     std::size_t element_size,
+                     Contents contents,
+                     const std::function<void(void*)>& fill);
+
+    // Declared before the slots so that the buffers are released before the handle.
+    std::unique_ptr<Handle> handle;
+    float handle_ms = 0;
+    float fill_ms   = 0;
+    std::array<Slot, 4> slots;
+    Stats stats;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_SESSION_HPP_
@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <iterator>
+#include <mutex>
 
 namespace miopen {
 
@@ -143,6 +144,7 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 }
 
 Kernel KernelCache::AddKernel(Handle& h,
+                              std::mutex& cache_mutex,
                               const std::string& algorithm,
                               const std::string& network_config,
                               const std::string& program_name,
@@ -166,14 +168,20 @@ Kernel KernelCache::AddKernel(Handle& h,
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
+    const auto program_key = std::make_pair(program_name, params);
     Program program;
-
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    bool cached = false;
     {
-        program = program_it->second;
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto program_it = program_map.find(program_key);
+        if(program_it != program_map.end())
+        {
+            program = program_it->second;
+            cached  = true;
+        }
     }
-    else
+
+    if(!cached)
     {
         const bool is_kernel_str = algorithm.find("GEMM") != std::string::npos;
         if(miopen::IsLogging(miopen::LoggingLevel::Info2))
@@ -185,12 +193,18 @@ Kernel KernelCache::AddKernel(Handle& h,
                                       vgd,
                                       params);
         }
-        program = h.LoadProgram(program_name, params, is_kernel_str);
-        program_map[std::make_pair(program_name, params)] = program;
+        auto built = h.LoadProgram(program_name, params, is_kernel_str);
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        // Another thread may have built the same program meanwhile. The first one stays cached
+        // and this copy is dropped.
+        program = program_map.emplace(program_key, std::move(built)).first->second;
     }
+
     Kernel kernel{program, kernel_name, vld, vgd};
     if(!network_config.empty() && !algorithm.empty())
     {
+        std::lock_guard<std::mutex> lock(cache_mutex);
         this->AddKernel(key, kernel, cache_index);
     }
     return kernel;
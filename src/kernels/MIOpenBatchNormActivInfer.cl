@@ -88,6 +88,16 @@ void BatchNormFunctionSpatial(const uint n,
     }
 }
 
+#ifdef MIOPEN_RESIDUAL_ADD
+void AddResidual(const uint n, _FLOAT_PREC* out, const __global _FLOAT* residual)
+{
+    for(uint i = 0; i < n; ++i)
+    {
+        out[i] += (_FLOAT_PREC)residual[i];
+    }
+}
+#endif
+
 __attribute__((reqd_work_group_size(MIO_BN_GRP0, MIO_BN_GRP1, MIO_BN_GRP2))) __kernel void
 MIOpenBatchNormActivInferSpatialEst(const _FLOAT alpha,
                                     const _FLOAT beta,
@@ -98,7 +108,12 @@ MIOpenBatchNormActivInferSpatialEst(const _FLOAT alpha,
                                     const __global _FLOAT_PREC* __restrict bias,
                                     const __global _FLOAT_PREC* __restrict scale,
                                     const __global _FLOAT_PREC* __restrict estimatedMean,
-                                    const __global _FLOAT_PREC* __restrict estimatedVariance)
+                                    const __global _FLOAT_PREC* __restrict estimatedVariance
+#ifdef MIOPEN_RESIDUAL_ADD
+                                    ,
+                                    const __global _FLOAT* __restrict residual
+#endif
+                                    )
 {
     int gid0 = get_global_id(0);
     int gid1 = get_global_id(1);
@@ -139,6 +154,9 @@ MIOpenBatchNormActivInferSpatialEst(const _FLOAT alpha,
         _FLOAT_PREC bnRes[MIOPEN_READ_UNIT];
         _FLOAT_PREC actRes[MIOPEN_READ_UNIT];
         BatchNormFunctionSpatial(MIOPEN_READ_UNIT, bnRes, data, pmean, invVariance, pscale, pbias);
+#ifdef MIOPEN_RESIDUAL_ADD
+        AddResidual(MIOPEN_READ_UNIT, bnRes, residual + index);
+#endif
         ActivationFunction(MIOPEN_READ_UNIT, actRes, bnRes, gamma, beta, alpha);
         for(int i = 0; i < MIOPEN_READ_UNIT; i++)
         {
@@ -171,7 +189,12 @@ MIOpenBatchNormActivInferPerActEst(const _FLOAT alpha,
                                    const __global _FLOAT_PREC* __restrict bias,
                                    const __global _FLOAT_PREC* __restrict scale,
                                    const __global _FLOAT_PREC* __restrict estimatedMean,
-                                   const __global _FLOAT_PREC* __restrict estimatedVariance)
+                                   const __global _FLOAT_PREC* __restrict estimatedVariance
+#ifdef MIOPEN_RESIDUAL_ADD
+                                   ,
+                                   const __global _FLOAT* __restrict residual
+#endif
+                                   )
 {
     int gid0  = get_global_id(0);
     int chw_i = gid0 * MIOPEN_READ_UNIT;
@@ -206,6 +229,9 @@ MIOpenBatchNormActivInferPerActEst(const _FLOAT alpha,
         _FLOAT_PREC bnRes[MIOPEN_READ_UNIT];
         _FLOAT_PREC actRes[MIOPEN_READ_UNIT];
         BatchNormFunctionPerAct(MIOPEN_READ_UNIT, bnRes, data, pmean, invVariance, pscale, pbias);
+#ifdef MIOPEN_RESIDUAL_ADD
+        AddResidual(MIOPEN_READ_UNIT, bnRes, residual + index);
+#endif
         ActivationFunction(MIOPEN_READ_UNIT, actRes, bnRes, gamma, beta, alpha);
         for(int i = 0; i < MIOPEN_READ_UNIT; i++)
         {
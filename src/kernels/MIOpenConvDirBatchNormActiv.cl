@@ -369,6 +369,10 @@ MIOpenConvUniBatchNormActiv(
     const __global _FLOAT* __restrict scale,
     const __global _FLOAT* __restrict estimatedMean,
     const __global _FLOAT* __restrict estimatedVariance
+#endif
+#ifdef MIOPEN_RESIDUAL_ADD
+    ,
+    const __global _FLOAT* __restrict residual
 #endif
     )
 {
@@ -779,6 +783,10 @@ MIOpenConvUniBatchNormActiv(
                                 bn_res = pscale * (conv_res - pmean) * pinvVariance + pbias;
 // bn_res  = mad(pscale, (conv_res - pmean) * pinvVariance, pbias);
 #endif
+#ifdef MIOPEN_RESIDUAL_ADD
+                            // the residual has the layout of the output
+                            bn_res += residual[out_off2 + i];
+#endif
 #ifdef MIOPEN_NRN_OP_ID
 #ifdef MIOPEN_YES_ACTIV
                             ActivationFunction(
@@ -93,9 +93,9 @@ MIOpenLRNWithinChannelBwd(const __global _FLOAT* top,
     int y          = get_group_id(1) * MLO_LRN_GROUP_SZ1 * MLO_LRN_N_VERT_OUT_PIX;
     int lcl_id0    = get_local_id(0);
     int lcl_id1    = get_local_id(1);
-    int ob         = get_global_id(2); // output * batch_sz
-    int o          = ob / MLO_LRN_BATCH_SZ;
-    int b          = ob - o * MLO_LRN_BATCH_SZ;
+    int ob         = get_global_id(2); // batch_sz * output, so that batch_sz is not compiled in
+    int b          = ob / MLO_LRN_N_OUTPUTS;
+    int o          = ob - b * MLO_LRN_N_OUTPUTS;
     int top_x      = x;
     int top_y      = y;
     int top_df_off = b * MLO_LRN_TOPDF_BATCH_STRIDE + o * MLO_LRN_TOPDF_CHANNEL_STRIDE;
@@ -130,7 +130,7 @@ MIOpenLRNWithinChannelBwd(const __global _FLOAT* top,
             top_x_act = (invisibleX) ? 0 : top_x_act;
 #if DBG_RANGE
             if(top_df_off + top_df_y_off + top_x_act >=
-               MLO_LRN_BATCH_SZ * MLO_LRN_TOPDF_BATCH_STRIDE)
+               (b + 1) * MLO_LRN_TOPDF_BATCH_STRIDE)
             {
                 printf("K:err:topdf-off_range\n");
             }
@@ -185,7 +185,7 @@ MIOpenLRNWithinChannelBwd(const __global _FLOAT* top,
             top_x_act = (invisibleX) ? 0 : top_x_act;
 #if DBG_RANGE
 
-            if(top_off + top_y_off + top_x_act >= MLO_LRN_BATCH_SZ * MLO_LRN_TOP_BATCH_STRIDE)
+            if(top_off + top_y_off + top_x_act >= (b + 1) * MLO_LRN_TOP_BATCH_STRIDE)
             {
                 printf("K:err:top-off_range\n");
             }
@@ -250,19 +250,19 @@ MIOpenLRNWithinChannelBwd(const __global _FLOAT* top,
             uint bot_off0 = MLO_LRN_BOT_BATCH_STRIDE * b + MLO_LRN_BOT_CHANNEL_STRIDE * o +
                             MLO_LRN_BOT_STRIDE * (y + v_off_v) + x + v_off_h;
 
-            uint bot_off = (bot_off0 < MLO_LRN_BATCH_SZ * MLO_LRN_BOT_BATCH_STRIDE)
+            uint bot_off = (bot_off0 < (b + 1) * MLO_LRN_BOT_BATCH_STRIDE)
                                ? bot_off0
-                               : MLO_LRN_BATCH_SZ * MLO_LRN_BOT_BATCH_STRIDE - 1;
+                               : (b + 1) * MLO_LRN_BOT_BATCH_STRIDE - 1;
 #if DBG_RANGE
 
-            if(bot_off >= MLO_LRN_BATCH_SZ * MLO_LRN_BOT_BATCH_STRIDE)
+            if(bot_off >= (b + 1) * MLO_LRN_BOT_BATCH_STRIDE)
             {
                 printf("K:err:bot-off_range\n");
             }
 #endif
             _FLOAT bot_dta = bot[bot_off];
 
-            bot_dta = (bot_off0 < MLO_LRN_BATCH_SZ * MLO_LRN_BOT_BATCH_STRIDE) ? bot_dta : 0;
+            bot_dta = (bot_off0 < (b + 1) * MLO_LRN_BOT_BATCH_STRIDE) ? bot_dta : 0;
 
             _FLOAT adj_ratio       = (_FLOAT)2.f * alpha * beta / adj_area_size;
             _FLOAT prv_accum_ratio = adj_ratio * bot_dta * prv_ratio_accum;
@@ -280,7 +280,7 @@ MIOpenLRNWithinChannelBwd(const __global _FLOAT* top,
 
                 if(MLO_LRN_BOTDF_BATCH_STRIDE * b + MLO_LRN_BOTDF_CHANNEL_STRIDE * o +
                        MLO_LRN_BOTDF_STRIDE * (bot_y + j) + bot_x + i >=
-                   MLO_LRN_BATCH_SZ * MLO_LRN_BOTDF_BATCH_STRIDE)
+                   (b + 1) * MLO_LRN_BOTDF_BATCH_STRIDE)
                 {
                     printf("K:err:botdf-off_range\n");
                 }
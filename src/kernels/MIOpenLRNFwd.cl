@@ -88,9 +88,9 @@ MIOpenLRNWithinChannel_PS(const __global _FLOAT* bot,
     int y       = get_group_id(1) * MLO_LRN_GROUP_SZ1 * MLO_LRN_N_VERT_OUT_PIX;
     int lcl_id0 = get_local_id(0);
     int lcl_id1 = get_local_id(1);
-    int ob      = get_global_id(2); // output * batch_sz
-    int o       = iDiv_legacy(ob, MLO_LRN_BATCH_SZ);
-    int b       = iMod(ob, o, MLO_LRN_BATCH_SZ);
+    int ob      = get_global_id(2); // batch_sz * output, so that batch_sz is not compiled in
+    int b       = ob / MLO_LRN_N_OUTPUTS;
+    int o       = ob - b * MLO_LRN_N_OUTPUTS;
     int bot_x   = x;
     int bot_y   = y;
     int bot_off = b * MLO_LRN_BOT_BATCH_STRIDE + o * MLO_LRN_BOT_CHANNEL_STRIDE;
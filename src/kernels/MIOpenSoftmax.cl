@@ -51,6 +51,18 @@
 #define _FLOAT4 PPCAT(_FLOAT, FOUR)
 #define _FLOAT8 PPCAT(_FLOAT, EIGHT)
 
+#define MIOPEN_SOFTMAX_FAST 0
+#define MIOPEN_SOFTMAX_ACCURATE 1
+#define MIOPEN_SOFTMAX_LOG 2
+
+#ifndef MIOPEN_SOFTMAX_ALGO
+#define MIOPEN_SOFTMAX_ALGO MIOPEN_SOFTMAX_ACCURATE
+#endif
+
+#ifndef MIOPEN_SOFTMAX_USE_MASK
+#define MIOPEN_SOFTMAX_USE_MASK 0
+#endif
+
 typedef union GPtr
 {
     _FLOAT* f;
@@ -64,6 +76,10 @@ typedef union GPtr
  * 4. Compute the sum of the vales per channel.
  * 5. Normalize based on the sum.
  *
+ * MIOPEN_SOFTMAX_FAST skips steps 1 and 2; MIOPEN_SOFTMAX_LOG replaces step 5 with
+ * (value - max) - log(sum). The input of step 1 is scale * x + mask, the output is
+ * blended into y as alpha * softmax + beta * y.
+ *
  * We use CSR-{Vector / Stream} approach to pick an algorithm depending on the
  * number of channels each workgroup has to work with.
  * J. L. Greathouse, M. Daga, Efficient sparse matrix-vector multiplication
@@ -71,9 +87,87 @@ typedef union GPtr
  * Computing, Networking, Storage and Analysis (SC'14)
 */
 
-__kernel void
-SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spatial_dim)
+// Loads scale * x + mask for channel ch of pixel s in image n. The mask is indexed through its own
+// strides so that broadcast dimensions can have a stride of 0.
+inline _FLOAT LoadInput(const global _FLOAT* x,
+                        const global _FLOAT* mask,
+                        const int n,
+                        const int ch,
+                        const int s,
+                        const int c,
+                        const int spatial_dim,
+                        const float scale,
+                        const int mask_n_stride,
+                        const int mask_c_stride,
+                        const int mask_h_stride,
+                        const int mask_w_stride,
+                        const int w_len)
 {
+    _FLOAT value = (_FLOAT)scale * x[mad24(n, c, ch) * spatial_dim + s];
+#if MIOPEN_SOFTMAX_USE_MASK == 1
+    value += mask[n * mask_n_stride + ch * mask_c_stride + (s / w_len) * mask_h_stride +
+                  (s % w_len) * mask_w_stride];
+#else
+    (void)mask;
+    (void)mask_n_stride;
+    (void)mask_c_stride;
+    (void)mask_h_stride;
+    (void)mask_w_stride;
+    (void)w_len;
+#endif
+    return value;
+}
+
+// Reads the old value only when it contributes, so that an uninitialized y cannot leak NaNs.
+inline void StoreOutput(
+    global _FLOAT* y, const int idx, const _FLOAT value, const float alpha, const float beta)
+{
+    _FLOAT out = (_FLOAT)alpha * value;
+    if(beta != 0)
+        out += (_FLOAT)beta * y[idx];
+    y[idx] = out;
+}
+
+// Maps (value - max) of one channel and the channel sum of exponents to the output.
+inline _FLOAT Normalize(const _FLOAT shifted, const _FLOAT channel_sum)
+{
+#if MIOPEN_SOFTMAX_ALGO == MIOPEN_SOFTMAX_LOG
+    return shifted - log(channel_sum);
+#else
+    return exp(shifted) / channel_sum;
+#endif
+}
+
+__kernel void SoftmaxForward(const global _FLOAT* x,
+                             global _FLOAT* y,
+                             const global _FLOAT* mask,
+                             const int c,
+                             const int grid_size,
+                             const int spatial_dim,
+                             const float alpha,
+                             const float beta,
+                             const float scale,
+                             const int mask_n_stride,
+                             const int mask_c_stride,
+                             const int mask_h_stride,
+                             const int mask_w_stride,
+                             const int w_len)
+{
+#define LOAD_INPUT(n, ch, s)  \
+    LoadInput(x,              \
+              mask,           \
+              n,              \
+              ch,             \
+              s,              \
+              c,              \
+              spatial_dim,    \
+              scale,          \
+              mask_n_stride,  \
+              mask_c_stride,  \
+              mask_h_stride,  \
+              mask_w_stride,  \
+              w_len)
+
 #if NUM_BATCH == 1 // CSR-Vector like appraoch
 
     /* Entire workgroup works on one spatial_dim.
@@ -96,16 +190,21 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
         int n = gid / spatial_dim; // nth image
         int s = gid % spatial_dim; // spatial dimension (h*w)
 
+        _FLOAT t_helper; // thread_local helper var
+
+#if MIOPEN_SOFTMAX_ALGO == MIOPEN_SOFTMAX_FAST
+        _FLOAT channel_max = (_FLOAT)0;
+#else
         l_helper[lid] = (_FLOAT)-MAX_VAL;
 
-        _FLOAT t_helper = (_FLOAT)-MAX_VAL; // thread_local helper var
+        t_helper = (_FLOAT)-MAX_VAL;
 
         // Compute max per channel
         // Iterate over all the channels one thread is supposed to loop over
         // and compute max
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            t_helper = max(y[mad24(n, c, i) * spatial_dim + s], t_helper);
+            t_helper = max(LOAD_INPUT(n, i, s), t_helper);
         }
 
         // Now we have to compute the max from 256 values (one per each thread)
@@ -123,12 +222,15 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
         }
 
         _FLOAT channel_max = l_helper[0];
-        t_helper           = 0.;
+        // All threads must have read the max before l_helper is reused for the sum
+        barrier(CLK_LOCAL_MEM_FENCE);
+#endif
+        t_helper = 0.;
 
         // Subtract channel_max from each value
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            _FLOAT value = y[mad24(n, c, i) * spatial_dim + s];
+            _FLOAT value = LOAD_INPUT(n, i, s);
 
             // Compute exponent of each value
             // Then sum all the values touched by this thread
@@ -154,15 +256,16 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
         // Normalize each value in the channel by the channel_sum
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            _FLOAT value = y[mad24(n, c, i) * spatial_dim + s];
-
             // Subtracting max again because we do not write the output of
             // value-max to DRAM above. Doing a subtraction again is much
             // faster than writing uncoalesced to DRAM
-            value = exp(value - channel_max);
+            _FLOAT value = LOAD_INPUT(n, i, s) - channel_max;
 
-            y[mad24(n, c, i) * spatial_dim + s] = value / channel_sum;
+            StoreOutput(
+                y, mad24(n, c, i) * spatial_dim + s, Normalize(value, channel_sum), alpha, beta);
         }
+        // l_helper is reused by the next pixel of this workgroup
+        barrier(CLK_LOCAL_MEM_FENCE);
     }
 
 #else // CSR-Stream like approach
@@ -200,13 +303,15 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
 // in rocm2.0 in SWDEV-175176 JIRA ticket
 #if MIOPEN_USE_FP16 == 1
     local _FLOAT values[U_BATCH_SIZE * 256];
+#define VALUE(index) values[lid * U_BATCH_SIZE + (index)]
 #else
     _FLOAT values[U_BATCH_SIZE];
+#define VALUE(index) values[(index)]
+#endif
     for(int i = 0; i < U_BATCH_SIZE; i++)
     {
-        values[i] = (_FLOAT)(-MAX_VAL);
+        VALUE(i) = (_FLOAT)(-MAX_VAL);
     }
-#endif
 
     // Compute max per channel
     // BATCH_SIZE threads iterate over the channels
@@ -216,18 +321,14 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
     {
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
         {
-
-#if MIOPEN_USE_FP16 == 1 // Refer to Comment1 above for different fp16 and fp32 impl
-            _FLOAT tmp                         = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            t_helper                           = max(tmp, t_helper);
-            values[lid * U_BATCH_SIZE + index] = tmp;
-#else
-            values[index] = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            t_helper      = max(values[index], t_helper);
-#endif
+            VALUE(index) = LOAD_INPUT(batch_n, i, batch_s);
+            t_helper     = max(VALUE(index), t_helper);
         }
     }
 
+#if MIOPEN_SOFTMAX_ALGO == MIOPEN_SOFTMAX_FAST
+    _FLOAT channel_max = (_FLOAT)0;
+#else
     // Now we have to compute the max from 256 values (one per each thread)
     l_helper[lid] = t_helper;
     barrier(CLK_LOCAL_MEM_FENCE);
@@ -243,23 +344,20 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
     }
 
     _FLOAT channel_max = l_helper[batch * BATCH_SIZE];
-    t_helper           = (_FLOAT)0.;
+    // All threads must have read the max before l_helper is reused for the sum
+    barrier(CLK_LOCAL_MEM_FENCE);
+#endif
+    t_helper = (_FLOAT)0.;
 
     // Subtract channel_max from each value
     index = index0;
     for(int i = batch_lid; i < c; i += BATCH_SIZE, index++)
     {
-// Compute exponent of each value
-// Then sum all the values touched by this thread
-#if MIOPEN_USE_FP16 == 1
-        _FLOAT tmp = exp(values[lid * U_BATCH_SIZE + index] - channel_max);
-        t_helper += tmp;
-        values[lid * U_BATCH_SIZE + index] = tmp;
-#else
-        _FLOAT tmp        = exp(values[index] - channel_max);
-        t_helper += tmp;
-        values[index] = tmp;
-#endif
+        // Compute exponent of each value
+        // Then sum all the values touched by this thread
+        _FLOAT shifted = VALUE(index) - channel_max;
+        t_helper += exp(shifted);
+        VALUE(index) = shifted;
     }
 
     l_helper[lid] = t_helper;
@@ -284,21 +382,40 @@ SoftmaxForward(global _FLOAT* y, const int c, const int grid_size, const int spa
     {
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
         {
-#if MIOPEN_USE_FP16 == 1
-            y[mad24(batch_n, c, i) * spatial_dim + batch_s] =
-                values[lid * U_BATCH_SIZE + index] / channel_sum;
-#else
-            y[mad24(batch_n, c, i) * spatial_dim + batch_s] = values[index] / channel_sum;
-#endif
+            StoreOutput(y,
+                        mad24(batch_n, c, i) * spatial_dim + batch_s,
+                        Normalize(VALUE(index), channel_sum),
+                        alpha,
+                        beta);
         }
     }
+#undef VALUE
 
 #endif // CSR-Vector vs CSR-Stream
+#undef LOAD_INPUT
 }
 
-__kernel void SoftmaxBackward(
-    global _FLOAT* y, global _FLOAT* dx, const int c, const int grid_size, const int spatial_dim)
+/* Gradients with respect to the softmax input, given the forward output y:
+ *   softmax:     dx = y * (dy - sum(y * dy))
+ *   log-softmax: dx = dy - exp(y) * sum(dy)
+ * The result is blended into dx as alpha * gradient + beta * dx.
+ */
+__kernel void SoftmaxBackward(const global _FLOAT* y,
+                              const global _FLOAT* dy,
+                              global _FLOAT* dx,
+                              const int c,
+                              const int grid_size,
+                              const int spatial_dim,
+                              const float alpha,
+                              const float beta)
 {
+#if MIOPEN_SOFTMAX_ALGO == MIOPEN_SOFTMAX_LOG
+#define DOT_TERM(y_val, dy_val) (dy_val)
+#define GRADIENT(y_val, dy_val, dot) ((dy_val)-exp(y_val) * (dot))
+#else
+#define DOT_TERM(y_val, dy_val) ((y_val) * (dy_val))
+#define GRADIENT(y_val, dy_val, dot) ((y_val) * ((dy_val) - (dot)))
+#endif
 
 #if NUM_BATCH == 1 // CSR-Vector like appraoch
     local _FLOAT l_helper[256];
@@ -320,8 +437,8 @@ __kernel void SoftmaxBackward(
         // and compute dot-product
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            channel_dot +=
-                (y[mad24(n, c, i) * spatial_dim + s] * dx[mad24(n, c, i) * spatial_dim + s]);
+            int idx = mad24(n, c, i) * spatial_dim + s;
+            channel_dot += DOT_TERM(y[idx], dy[idx]);
         }
 
         // Now we have to compute the sum from 256 values (one per each thread)
@@ -343,10 +460,11 @@ __kernel void SoftmaxBackward(
         // Subtract and element-wise multiplication
         for(int i = lid; i < c; i += get_local_size(0))
         {
-            _FLOAT value = dx[mad24(n, c, i) * spatial_dim + s] - channel_dot;
-
-            dx[mad24(n, c, i) * spatial_dim + s] = y[mad24(n, c, i) * spatial_dim + s] * value;
+            int idx = mad24(n, c, i) * spatial_dim + s;
+            StoreOutput(dx, idx, GRADIENT(y[idx], dy[idx], channel_dot), alpha, beta);
         }
+        // l_helper is reused by the next pixel of this workgroup
+        barrier(CLK_LOCAL_MEM_FENCE);
     }
 
 #else
@@ -368,23 +486,22 @@ __kernel void SoftmaxBackward(
 
 // stores all the values touched by one thread so that we do not have load
 // again as the CSR-Vector approach
-#if MIOPEN_USE_FP16 == 1
+#if MIOPEN_USE_FP16 == 1 // Refer to Comment1 above for different fp16 and fp32 impl
     local _FLOAT y_value[U_BATCH_SIZE * 256];
-    local _FLOAT dx_value[U_BATCH_SIZE * 256];
+    local _FLOAT dy_value[U_BATCH_SIZE * 256];
+#define Y_VALUE(index) y_value[lid * U_BATCH_SIZE + (index)]
+#define DY_VALUE(index) dy_value[lid * U_BATCH_SIZE + (index)]
 #else
     _FLOAT y_value[U_BATCH_SIZE];
-    _FLOAT dx_value[U_BATCH_SIZE];
+    _FLOAT dy_value[U_BATCH_SIZE];
+#define Y_VALUE(index) y_value[(index)]
+#define DY_VALUE(index) dy_value[(index)]
 #endif
 
     for(int i = 0; i < U_BATCH_SIZE; i++)
     {
-#if MIOPEN_USE_FP16 == 1 // Refer to Comment1 above for different fp16 and fp32 impl
-        y_value[lid * U_BATCH_SIZE + i] = 0;
-        dx_value[lid * U_BATCH_SIZE + i] = 0;
-#else
-        y_value[i]          = 0;
-        dx_value[i]         = 0;
-#endif
+        Y_VALUE(i)  = 0;
+        DY_VALUE(i) = 0;
     }
 
     // Compute dot product per channel
@@ -395,17 +512,9 @@ __kernel void SoftmaxBackward(
     {
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
         {
-#if MIOPEN_USE_FP16 == 1
-            _FLOAT tmp1                          = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            y_value[lid * U_BATCH_SIZE + index]  = tmp1;
-            _FLOAT tmp2                          = dx[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            dx_value[lid * U_BATCH_SIZE + index] = tmp2;
-            channel_dot += tmp1 * tmp2;
-#else
-            y_value[index]  = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            dx_value[index] = dx[mad24(batch_n, c, i) * spatial_dim + batch_s];
-            channel_dot += y_value[index] * dx_value[index];
-#endif
+            Y_VALUE(index)  = y[mad24(batch_n, c, i) * spatial_dim + batch_s];
+            DY_VALUE(index) = dy[mad24(batch_n, c, i) * spatial_dim + batch_s];
+            channel_dot += DOT_TERM(Y_VALUE(index), DY_VALUE(index));
         }
     }
 
@@ -429,17 +538,17 @@ __kernel void SoftmaxBackward(
     index = index0;
     for(int i = batch_lid; i < c; i += BATCH_SIZE, index++)
     {
-#if MIOPEN_USE_FP16 == 1
-        dx_value[lid * U_BATCH_SIZE + index] -= channel_dot;
         if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
-            dx[mad24(batch_n, c, i) * spatial_dim + batch_s] =
-                y_value[lid * U_BATCH_SIZE + index] * dx_value[lid * U_BATCH_SIZE + index];
-#else
-        dx_value[index] -= channel_dot;
-        if(mad24(batch_n, c, i) * spatial_dim + batch_s < c * grid_size)
-            dx[mad24(batch_n, c, i) * spatial_dim + batch_s] = y_value[index] * dx_value[index];
-#endif
+            StoreOutput(dx,
+                        mad24(batch_n, c, i) * spatial_dim + batch_s,
+                        GRADIENT(Y_VALUE(index), DY_VALUE(index), channel_dot),
+                        alpha,
+                        beta);
     }
+#undef Y_VALUE
+#undef DY_VALUE
 
 #endif // CSR-Vector vs CSR-Stream
+#undef DOT_TERM
+#undef GRADIENT
 }
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/* Fused elementwise tensor expression, see miopen::TensorExpression.
+ *
+ * Every operand is loaded into a register once per element, the steps are applied in order and
+ * the operands assigned by a step are stored back. The host passes the flattened shape
+ * right-aligned in len0..len4, leading unused dimensions have length 1. Broadcast dimensions have
+ * stride 0.
+ *
+ * MIOPEN_EXPR_NTENSORS    number of operands, 1..4
+ * MIOPEN_EXPR_NSTEPS      number of steps, 1..6
+ * MIOPEN_EXPR_T<i>        element type of operand i
+ * MIOPEN_EXPR_LOAD_<i>    operand i is read before it is assigned
+ * MIOPEN_EXPR_STORE_<i>   operand i is assigned by some step
+ * MIOPEN_EXPR_OP_<k>      step code of miopen::TensorExprOp
+ * MIOPEN_EXPR_DST_<k>, MIOPEN_EXPR_A_<k>, MIOPEN_EXPR_B_<k>    operands of step k
+ * MIOPEN_EXPR_DST_TYPE_<k>    type code of the assigned operand (0 int8, 1 int32, 2 half, 3 float)
+ */
+
+#if MIOPEN_EXPR_USE_FP16 == 1
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+#endif
+
+#define EXPR_OP_ADD 0
+#define EXPR_OP_MUL 1
+#define EXPR_OP_MIN 2
+#define EXPR_OP_MAX 3
+#define EXPR_OP_SCALE 4
+#define EXPR_OP_SET 5
+#define EXPR_OP_CAST 6
+
+#define EXPR_TYPE_INT8 0
+#define EXPR_TYPE_INT32 1
+#define EXPR_TYPE_HALF 2
+#define EXPR_TYPE_FLOAT 3
+
+#ifndef FLT_MAX
+#define FLT_MAX 3.402823466e+38F
+#endif
+
+// Value read back after storing v into an operand of the given type
+inline float ExprRound(const int type, const float v)
+{
+    switch(type)
+    {
+    case EXPR_TYPE_INT8: return (float)convert_char_sat_rtz(v);
+    case EXPR_TYPE_INT32: return (float)convert_int_sat_rtz(v);
+#if MIOPEN_EXPR_USE_FP16 == 1
+    case EXPR_TYPE_HALF: return (float)(half)v;
+#endif
+    default: return v;
+    }
+}
+
+// Same upper clamp as SubTensorOpWithCastTensor
+inline float ExprSaturate(const int type, const float v)
+{
+    const float max_val = type == EXPR_TYPE_INT8
+                              ? 127.0f
+                              : type == EXPR_TYPE_INT32 ? 2147483647.0f
+                                                        : type == EXPR_TYPE_HALF ? 65504.0f
+                                                                                 : FLT_MAX;
+    return v >= max_val ? max_val : v;
+}
+
+inline float ExprApply(const int op,
+                       const int type,
+                       const float a,
+                       const float b,
+                       const float c,
+                       const float alpha0,
+                       const float alpha1,
+                       const float beta)
+{
+    float v;
+    switch(op)
+    {
+    case EXPR_OP_ADD: v = alpha0 * a + alpha1 * b + beta * c; break;
+    case EXPR_OP_MUL: v = (alpha0 * a) * (alpha1 * b) + beta * c; break;
+    case EXPR_OP_MIN: v = fmin(alpha0 * a, alpha1 * b) + beta * c; break;
+    case EXPR_OP_MAX: v = fmax(alpha0 * a, alpha1 * b) + beta * c; break;
+    case EXPR_OP_SCALE: v = alpha0 * c; break;
+    case EXPR_OP_SET: v = alpha0; break;
+    default: v = ExprSaturate(type, alpha0 * a); break;
+    }
+    return ExprRound(type, v);
+}
+
+#define EXPR_STEP(k)                                                             \
+    r[MIOPEN_EXPR_DST_##k] = ExprApply(MIOPEN_EXPR_OP_##k,                       \
+                                       MIOPEN_EXPR_DST_TYPE_##k,                 \
+                                       r[MIOPEN_EXPR_A_##k],                     \
+                                       r[MIOPEN_EXPR_B_##k],                     \
+                                       r[MIOPEN_EXPR_DST_##k],                   \
+                                       alpha0_##k,                               \
+                                       alpha1_##k,                               \
+                                       beta_##k)
+
+#define EXPR_TENSOR_ARGS(i)                                                       \
+    global MIOPEN_EXPR_T##i* __restrict t##i, const uint t##i##_stride0,          \
+        const uint t##i##_stride1, const uint t##i##_stride2,                     \
+        const uint t##i##_stride3, const uint t##i##_stride4
+
+#define EXPR_STEP_ARGS(k) const float alpha0_##k, const float alpha1_##k, const float beta_##k
+
+#define EXPR_INDEX(i)                                                                         \
+    (i0 * t##i##_stride0 + i1 * t##i##_stride1 + i2 * t##i##_stride2 + i3 * t##i##_stride3 + \
+     i4 * t##i##_stride4)
+
+#define EXPR_LOAD(i)                 \
+    if(MIOPEN_EXPR_LOAD_##i)         \
+        r[i] = (float)t##i[idx##i];
+
+// Values are already rounded to the operand type, so the conversion is exact
+#define EXPR_STORE(i)                \
+    if(MIOPEN_EXPR_STORE_##i)        \
+        t##i[idx##i] = (MIOPEN_EXPR_T##i)r[i];
+
+__kernel void TensorExpr(EXPR_TENSOR_ARGS(0),
+#if MIOPEN_EXPR_NTENSORS > 1
+                         EXPR_TENSOR_ARGS(1),
+#endif
+#if MIOPEN_EXPR_NTENSORS > 2
+                         EXPR_TENSOR_ARGS(2),
+#endif
+#if MIOPEN_EXPR_NTENSORS > 3
+                         EXPR_TENSOR_ARGS(3),
+#endif
+                         EXPR_STEP_ARGS(0),
+#if MIOPEN_EXPR_NSTEPS > 1
+                         EXPR_STEP_ARGS(1),
+#endif
+#if MIOPEN_EXPR_NSTEPS > 2
+                         EXPR_STEP_ARGS(2),
+#endif
+#if MIOPEN_EXPR_NSTEPS > 3
+                         EXPR_STEP_ARGS(3),
+#endif
+#if MIOPEN_EXPR_NSTEPS > 4
+                         EXPR_STEP_ARGS(4),
+#endif
+#if MIOPEN_EXPR_NSTEPS > 5
+                         EXPR_STEP_ARGS(5),
+#endif
+                         const uint len0,
+                         const uint len1,
+                         const uint len2,
+                         const uint len3,
+                         const uint len4)
+{
+    const uint total = len0 * len1 * len2 * len3 * len4;
+
+    for(uint gid = get_global_id(0); gid < total; gid += get_global_size(0))
+    {
+        uint rem      = gid;
+        const uint i4 = rem % len4;
+        rem /= len4;
+        const uint i3 = rem % len3;
+        rem /= len3;
+        const uint i2 = rem % len2;
+        rem /= len2;
+        const uint i1 = rem % len1;
+        const uint i0 = rem / len1;
+
+        float r[MIOPEN_EXPR_NTENSORS] = {0};
+
+        const uint idx0 = EXPR_INDEX(0);
+        EXPR_LOAD(0)
+#if MIOPEN_EXPR_NTENSORS > 1
+        const uint idx1 = EXPR_INDEX(1);
+        EXPR_LOAD(1)
+#endif
+#if MIOPEN_EXPR_NTENSORS > 2
+        const uint idx2 = EXPR_INDEX(2);
+        EXPR_LOAD(2)
+#endif
+#if MIOPEN_EXPR_NTENSORS > 3
+        const uint idx3 = EXPR_INDEX(3);
+        EXPR_LOAD(3)
+#endif
+
+        EXPR_STEP(0);
+#if MIOPEN_EXPR_NSTEPS > 1
+        EXPR_STEP(1);
+#endif
+#if MIOPEN_EXPR_NSTEPS > 2
+        EXPR_STEP(2);
+#endif
+#if MIOPEN_EXPR_NSTEPS > 3
+        EXPR_STEP(3);
+#endif
+#if MIOPEN_EXPR_NSTEPS > 4
+        EXPR_STEP(4);
+#endif
+#if MIOPEN_EXPR_NSTEPS > 5
+        EXPR_STEP(5);
+#endif
+
+        EXPR_STORE(0)
+#if MIOPEN_EXPR_NTENSORS > 1
+        EXPR_STORE(1)
+#endif
+#if MIOPEN_EXPR_NTENSORS > 2
+        EXPR_STORE(2)
+#endif
+#if MIOPEN_EXPR_NTENSORS > 3
+        EXPR_STORE(3)
+#endif
+    }
+}
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/layout_staging.hpp>
+#include <miopen/tensor_ops.hpp>
+
+namespace miopen {
+
+// Staged copies are bound as sub-buffers, whose origins must honour the device base address
+// alignment; a page is a safe upper bound for it.
+static constexpr std::size_t staging_alignment = 4096;
+
+static std::size_t AlignStaging(std::size_t x)
+{
+    return (x + staging_alignment - 1) / staging_alignment * staging_alignment;
+}
+
+LayoutStaging::LayoutStaging(const std::vector<TensorDescriptor>& descs)
+{
+    entries.reserve(descs.size());
+    for(const auto& desc : descs)
+    {
+        Entry e{desc, desc, !desc.IsDefaultLayout(), size, 0, nullptr};
+        if(e.is_staged)
+        {
+            e.staged = TensorDescriptor{desc.GetType(), desc.GetLengths()};
+            e.bytes  = e.staged.GetNumBytes();
+            size += AlignStaging(e.bytes);
+        }
+        entries.push_back(std::move(e));
+    }
+}
+
+const TensorDescriptor& LayoutStaging::Desc(std::size_t i) const { return entries.at(i).staged; }
+
+Data_t LayoutStaging::Bind(Handle& handle, Entry& e, Data_t workSpace)
+{
+    if(workSpace == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Workspace is required for channels-last tensors");
+    if(e.buffer == nullptr)
+        e.buffer = handle.CreateSubBuffer(workSpace, e.offset, e.bytes);
+    return e.buffer.get();
+}
+
+ConstData_t LayoutStaging::In(Handle& handle, std::size_t i, ConstData_t src, Data_t workSpace)
+{
+    auto& e = entries.at(i);
+    if(!e.is_staged)
+        return src;
+    const float one  = 1.0f;
+    const float zero = 0.0f;
+    const auto dst   = Bind(handle, e, workSpace);
+    TransformTensor(handle, &one, e.original, src, &zero, e.staged, dst);
+    time += handle.GetKernelTime();
+    return dst;
+}
+
+Data_t LayoutStaging::Out(Handle& handle, std::size_t i, Data_t dst, Data_t workSpace)
+{
+    auto& e = entries.at(i);
+    return e.is_staged ? Bind(handle, e, workSpace) : dst;
+}
+
+void LayoutStaging::Commit(Handle& handle, std::size_t i, Data_t dst)
+{
+    auto& e = entries.at(i);
+    if(!e.is_staged)
+        return;
+    const float one  = 1.0f;
+    const float zero = 0.0f;
+    TransformTensor(handle, &one, e.staged, e.buffer.get(), &zero, e.original, dst);
+    time += handle.GetKernelTime();
+}
+
+std::size_t LayoutStaging::RestSize(std::size_t workSpaceSize) const
+{
+    return workSpaceSize > size ? workSpaceSize - size : 0;
+}
+
+Data_t LayoutStaging::Rest(Handle& handle, Data_t workSpace, std::size_t workSpaceSize)
+{
+    if(workSpace == nullptr || RestSize(workSpaceSize) == 0)
+        return nullptr;
+    if(rest == nullptr)
+        rest = handle.CreateSubBuffer(workSpace, size, RestSize(workSpaceSize));
+    return rest.get();
+}
+
+} // namespace miopen
@@ -52,18 +52,29 @@ inline bool operator>=(const int& lhs, const LoggingLevel& rhs)
 
 bool IsLoggingTraceDetailed() { return miopen::IsEnabled(MIOPEN_ENABLE_LOGGING{}); }
 
-bool IsLogging(const LoggingLevel level)
+namespace detail {
+
+std::atomic<int> logging_level{static_cast<int>(LoggingLevel::Trace) + 1};
+
+bool IsLoggingResolve(const LoggingLevel level)
 {
-    const auto enabled_level = miopen::Value(MIOPEN_LOG_LEVEL{});
-    if(enabled_level != LoggingLevel::Default)
-        return enabled_level >= level;
+    static const int enabled_level = [] {
+        const int value = miopen::Value(MIOPEN_LOG_LEVEL{});
 #ifdef NDEBUG // Simplest way.
-    return LoggingLevel::Warning >= level;
+        const int result =
+            value != LoggingLevel::Default ? value : static_cast<int>(LoggingLevel::Warning);
 #else
-    return LoggingLevel::Info >= level;
+        const int result =
+            value != LoggingLevel::Default ? value : static_cast<int>(LoggingLevel::Info);
 #endif
+        logging_level.store(result, std::memory_order_relaxed);
+        return result;
+    }();
+    return enabled_level >= level;
 }
 
+} // namespace detail
+
 const char* LoggingLevelToCString(const LoggingLevel level)
 {
     // Intentionally straightforward.
@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/lrn.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 
 extern "C" miopenStatus_t miopenCreateLRNDescriptor(miopenLRNDescriptor_t* lrnDesc)
 {
@@ -89,6 +90,7 @@ extern "C" miopenStatus_t miopenLRNForward(miopenHandle_t handle,
                                            bool do_backward,
                                            void* workSpace)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(lrnDesc, alpha, xDesc, x, beta, yDesc, y, do_backward, workSpace);
     return miopen::try_([&] {
@@ -118,6 +120,7 @@ extern "C" miopenStatus_t miopenLRNBackward(miopenHandle_t handle,
                                             void* dx,
                                             const void* workSpace)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         lrnDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx, workSpace);
@@ -224,9 +224,11 @@ void FusionMDGraph::Init(FusionMDGraph& g, miopenFusionOp_t op)
     case miopenFusionOpActivForward:
     case miopenFusionOpActivBackward:
     case miopenFusionOpBiasForward:
+    case miopenFusionOpTensorAdd:
         MIOPEN_THROW(
             miopenStatusNotImplemented,
-            "Operators Activ and Bias are not supported as first ops in a Fusion Plan (yet)");
+            "Operators Activ, Bias and TensorAdd are not supported as first ops in a Fusion Plan "
+            "(yet)");
     }
 }
 
@@ -406,6 +408,26 @@ void FusionMDGraph::InitBNBwd(FusionMDGraph& g)
     }
 }
 
+/// Adds the residual add, optionally followed by an activation, after the batch norm vertex
+/// of a kernel.
+static void AddResidualAdd(FusionMDGraph& g,
+                           const MDGraph_vertex_ptr& bn_v,
+                           const std::string& program,
+                           const std::string& kernel,
+                           const std::string& algo)
+{
+    FusionMDGraph_Edge_Map empty_map;
+    empty_map["constraints"] = {"weight === 0"};
+    FusionMDGraph_Edge_Map edg_add;
+    edg_add["constraints"] = {"add_matches_input == 1", "weight === 0"};
+
+    auto add_v = std::make_shared<MDGraph_vertex>(miopenFusionOpTensorAdd, program, kernel, algo);
+    g.AddEdge(bn_v, add_v, edg_add);
+    auto activ_v =
+        std::make_shared<MDGraph_vertex>(miopenFusionOpActivForward, program, kernel, algo);
+    g.AddEdge(add_v, activ_v, empty_map);
+}
+
 void FusionMDGraph::InitBN(FusionMDGraph& g)
 {
     FusionMDGraph_Edge_Map empty_map;
@@ -425,6 +447,12 @@ void FusionMDGraph::InitBN(FusionMDGraph& g)
                                                         "MIOpenBatchNormActivInferPerActEst",
                                                         "MIOpenBatchNormActivInferPerActEst");
         g.AddEdge(bn_v, activ_v, empty_map);
+        // BatchNorm -> Add -> Activ
+        AddResidualAdd(g,
+                       bn_v,
+                       "MIOpenBatchNormActivInfer.cl",
+                       "MIOpenBatchNormActivInferPerActEst",
+                       "MIOpenBatchNormActivInferPerActEst");
     }
     {
         auto bn_v = std::make_shared<MDGraph_vertex>(miopenFusionOpBatchNormInference,
@@ -439,6 +467,12 @@ void FusionMDGraph::InitBN(FusionMDGraph& g)
                                                         "MIOpenBatchNormActivInferSpatialEst",
                                                         "MIOpenBatchNormActivInferSpatialEst");
         g.AddEdge(bn_v, activ_v, empty_map);
+        // BatchNorm -> Add -> Activ
+        AddResidualAdd(g,
+                       bn_v,
+                       "MIOpenBatchNormActivInfer.cl",
+                       "MIOpenBatchNormActivInferSpatialEst",
+                       "MIOpenBatchNormActivInferSpatialEst");
     }
 }
 
@@ -914,6 +948,13 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
                                                      "MIOpenConvUniBatchNormActiv",
                                                      "miopenConvDirectBatchNormBiasActiv");
                 g.AddEdge(bn_v, activ_v, empty_map);
+
+                // Conv -> Bias -> BatchNorm -> Add -> Activ
+                AddResidualAdd(g,
+                               bn_v,
+                               "MIOpenConvDirBatchNormActiv.cl",
+                               "MIOpenConvUniBatchNormActiv",
+                               "miopenConvDirectBatchNormBiasActiv");
             }
         }
 
@@ -935,6 +976,13 @@ void FusionMDGraph::InitConv(FusionMDGraph& g)
                                                             "MIOpenConvUniBatchNormActiv",
                                                             "miopenConvDirectBatchNormBiasActiv");
             g.AddEdge(bn_v, activ_v, empty_map);
+
+            // Conv -> BN -> Add -> Activ
+            AddResidualAdd(g,
+                           bn_v,
+                           "MIOpenConvDirBatchNormActiv.cl",
+                           "MIOpenConvUniBatchNormActiv",
+                           "miopenConvDirectBatchNormBiasActiv");
         }
     }
 }
@@ -943,13 +991,14 @@ void FusionMDGraph::AddEdge(MDGraph_vertex_ptr src,
                             MDGraph_vertex_ptr dst,
                             FusionMDGraph_Edge_Map& map)
 {
-    if(edge_list[src][dst].empty())
+    auto& edges = (*edge_list)[src][dst];
+    if(edges.empty())
     {
-        edge_list[src][dst] = {map};
+        edges = {map};
     }
     else
     {
-        edge_list[src][dst].emplace_back(map);
+        edges.emplace_back(map);
     }
 }
 
@@ -1018,9 +1067,11 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
             MIOPEN_LOG_I2("Current vertex: " << *cur_vertex_ptr);
         }
         // get the children of the cur_vertex
-        auto& ch = edge_list[cur_vertex_ptr];
+        const auto children = edge_list->find(cur_vertex_ptr);
+        if(children == edge_list->end())
+            continue;
         // if op is in the children and the edge key satisfies update cur_vertex
-        for(auto& ch_it : ch)
+        for(auto& ch_it : children->second)
         {
             auto cur_map = kinder.second;
             MIOPEN_LOG_I2("Current path weight: " << boost::any_cast<int>(cur_map["weight"]));
@@ -1160,7 +1211,8 @@ void FusionMDGraph::WriteToFile(std::string filename)
     const auto op_enum = enum_map(MIOPEN_ENUM_ARR(miopenFusionOpConvForward,
                                                   miopenFusionOpActivForward,
                                                   miopenFusionOpBatchNormInference,
-                                                  miopenFusionOpBiasForward));
+                                                  miopenFusionOpBiasForward,
+                                                  miopenFusionOpTensorAdd));
 
     if(filename.empty())
     {
@@ -1171,7 +1223,7 @@ void FusionMDGraph::WriteToFile(std::string filename)
     std::stringstream dot_graph;
     dot_file.open(filename);
 
-    for(auto& edge : edge_list)
+    for(auto& edge : *edge_list)
     {
         nodes.insert(edge.first);
         for(auto& edge2 : edge.second)
@@ -1196,7 +1248,7 @@ void FusionMDGraph::WriteToFile(std::string filename)
 
     int src_id, dst_id;
 
-    for(auto& edge : edge_list)
+    for(auto& edge : *edge_list)
     {
         if(edge.first != nullptr)
             src_id = edge.first->id;
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/measure_time.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace miopen {
+
+float Median(std::vector<float>& samples)
+{
+    if(samples.empty())
+        return 0;
+    const auto mid = samples.begin() + samples.size() / 2;
+    std::nth_element(samples.begin(), mid, samples.end());
+    if(samples.size() % 2 != 0)
+        return *mid;
+    const auto lower = *std::max_element(samples.begin(), mid);
+    return (lower + *mid) / 2;
+}
+
+float CoefficientOfVariation(const std::vector<float>& samples)
+{
+    if(samples.size() < 2)
+        return 0;
+    const auto n    = static_cast<double>(samples.size());
+    const auto mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    if(mean <= 0)
+        return 0;
+    double sq = 0;
+    for(auto s : samples)
+        sq += (s - mean) * (s - mean);
+    return static_cast<float>(std::sqrt(sq / (n - 1)) / mean);
+}
+
+TimingResult MeasureTime(const std::function<int(float&)>& run,
+                         const float best,
+                         const TimingPolicy& policy)
+{
+    TimingResult result;
+    float time = 0;
+    for(int i = 0; i < policy.warmup; ++i)
+    {
+        result.status = run(time);
+        if(result.status != 0)
+            return result;
+    }
+
+    std::vector<float> samples;
+    auto fastest = std::numeric_limits<float>::max();
+    while(static_cast<int>(samples.size()) < std::max(policy.max_samples, 1))
+    {
+        result.status = run(time);
+        if(result.status != 0)
+            return result;
+        samples.push_back(time);
+        fastest = std::min(fastest, time);
+
+        if(best != std::numeric_limits<float>::max() && fastest > best * policy.reject_ratio)
+        {
+            result.rejected = true;
+            break;
+        }
+        // Only the latest samples count, so that the clocks ramping up during the first
+        // ones do not keep the measurement going
+        const auto window = std::max(policy.min_samples, 1);
+        if(static_cast<int>(samples.size()) >= window &&
+           CoefficientOfVariation({samples.end() - window, samples.end()}) <= policy.cv_target)
+            break;
+    }
+
+    result.samples = static_cast<int>(samples.size());
+    result.time    = Median(samples);
+    MIOPEN_LOG_I2("Measured " << result.time << " ms, " << result.samples << " samples"
+                              << (result.rejected ? ", rejected" : ""));
+    return result;
+}
+
+} // namespace miopen
@@ -79,24 +79,43 @@ mlo_construct_direct2D_fusion::FindSolution(std::vector<miopen::solver::AnySolve
     return solution;
 }
 
-std::vector<miopen::solver::ConvSolution> mlo_construct_direct2D::FindAllSolutions()
+// Calls f with an instance of every direct solver, so that searching them all at once and
+// deferring their searches share one list.
+template <class F>
+static auto WithDirect2DSolvers(F f)
 {
     // clang-format off
-    return miopen::solver::SearchForAllSolutions<
-        miopen::solver::ConvAsm3x3U,
-        miopen::solver::ConvAsm1x1U,
-        miopen::solver::ConvAsm5x10u2v2f1,
-        miopen::solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1,
-        miopen::solver::ConvAsm5x10u2v2b1,
-        miopen::solver::ConvOclDirectFwd11x11,
-        miopen::solver::ConvOclDirectFwdGen,
-        miopen::solver::ConvOclDirectFwd3x3,
-        miopen::solver::ConvOclDirectFwd1x1,
-        miopen::solver::ConvOclDirectFwd
-    >(_search_params, this->GetDb());
+    return f(
+        miopen::solver::ConvAsm3x3U{},
+        miopen::solver::ConvAsm1x1U{},
+        miopen::solver::ConvAsm5x10u2v2f1{},
+        miopen::solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1{},
+        miopen::solver::ConvAsm5x10u2v2b1{},
+        miopen::solver::ConvOclDirectFwd11x11{},
+        miopen::solver::ConvOclDirectFwdGen{},
+        miopen::solver::ConvOclDirectFwd3x3{},
+        miopen::solver::ConvOclDirectFwd1x1{},
+        miopen::solver::ConvOclDirectFwd{});
     // clang-format on
 }
 
+std::vector<miopen::solver::ConvSolution> mlo_construct_direct2D::FindAllSolutions()
+{
+    return WithDirect2DSolvers([&](auto... solvers) {
+        return miopen::solver::SearchForAllSolutions<decltype(solvers)...>(_search_params,
+                                                                           this->GetDb());
+    });
+}
+
+std::vector<miopen::solver::DeferredSolution<miopen::solver::ConvSolution>>
+mlo_construct_direct2D::DeferAllSolutions()
+{
+    return WithDirect2DSolvers([&](auto... solvers) {
+        return miopen::solver::DeferAllSolutions<decltype(solvers)...>(_search_params,
+                                                                       this->GetDb());
+    });
+}
+
 miopen::solver::ConvSolution mlo_construct_winograd::FindSolution()
 {
     // clang-format off
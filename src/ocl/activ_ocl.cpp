@@ -39,7 +39,7 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                              const TensorDescriptor& yDesc,
                                              Data_t y,
                                              size_t xOffset,
-                                             size_t yOffset)
+                                             size_t yOffset) const
 {
     if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
        !float_equal(*(static_cast<const float*>(beta)), 0))
@@ -118,12 +118,14 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
             const std::string READ_TYPE =
                 (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(read_unit);
 
+            // MAP_RD and height only set the launch size, so they are left out of the key and
+            // the kernel is reused for all batch sizes.
             network_config = ((packed) ? "11" : "10") // + lite bit
                              + std::to_string(xDesc.GetType()) + std::to_string(mode) +
-                             std::to_string(read_unit) + std::to_string(MAP_RD) +
-                             std::to_string(height);
+                             std::to_string(read_unit);
+            const std::vector<size_t> vgd{MAP_RD, (packed) ? 1 : height, 1};
 
-            auto&& kernels = handle.GetKernels("miopenActivationForward", network_config);
+            auto&& kernels = handle.GetKernels("miopenActivationForward", network_config, vgd);
             if(!kernels.empty())
             {
                 auto kernel = kernels.front();
@@ -167,22 +169,16 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                                    std::to_string(mode) + type_opt;
 
                 std::vector<size_t> vld;
-                std::vector<size_t> vgd;
 
                 vld.push_back(256);
                 vld.push_back(1);
                 vld.push_back(1);
 
-                vgd.push_back(MAP_RD);
-
                 std::string program_name = "MIOpenNeuron.cl";
                 std::string kernel_name =
                     (packed) ? "MIOpenActiveFwdLite" : "MIOpenActiveFwd2DLite";
                 if(packed)
                 {
-                    vgd.push_back(1);
-                    vgd.push_back(1);
-
                     handle.AddKernel("miopenActivationForward",
                                      network_config,
                                      program_name,
@@ -199,10 +195,6 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
                 }
                 else
                 {
-
-                    vgd.push_back(height);
-                    vgd.push_back(1);
-
                     handle.AddKernel("miopenActivationForward",
                                      network_config,
                                      program_name,
@@ -399,7 +391,7 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                                               size_t yOffset,
                                               size_t dyOffset,
                                               size_t xOffset,
-                                              size_t dxOffset)
+                                              size_t dxOffset) const
 {
     if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
        !float_equal(*(static_cast<const float*>(beta)), 0))
@@ -519,10 +511,10 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
 
             network_config = ((packed) ? "11" : "10") // + lite bit
                              + std::to_string(xDesc.GetType()) + std::to_string(mode) +
-                             std::to_string(read_unit) + std::to_string(MAP_RD) +
-                             std::to_string(height);
+                             std::to_string(read_unit);
+            const std::vector<size_t> vgd{MAP_RD, (packed) ? 1 : height, 1};
 
-            auto&& kernels = handle.GetKernels("miopenActivationBackward", network_config);
+            auto&& kernels = handle.GetKernels("miopenActivationBackward", network_config, vgd);
             if(!kernels.empty())
             {
                 auto kernel = kernels.front();
@@ -579,24 +571,16 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                                    std::to_string(mode) + type_opt;
 
                 std::vector<size_t> vld;
-                std::vector<size_t> vgd;
 
                 vld.push_back(256);
                 vld.push_back(1);
                 vld.push_back(1);
-                // first dimension looks similar but for the packed it is a full image for the
-                // non-packaed
-                // 2D it's width
-                vgd.push_back(MAP_RD);
 
                 std::string program_name = "MIOpenNeuron.cl";
                 std::string kernel_name =
                     (packed) ? "MIOpenActiveBwdLite" : "MIOpenActiveBwd2DLite";
                 if(packed)
                 {
-                    vgd.push_back(1);
-                    vgd.push_back(1);
-
                     handle.AddKernel("miopenActivationBackward",
                                      network_config,
                                      program_name,
@@ -618,12 +602,6 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
                 }
                 else
                 {
-
-                    // second dim is height
-
-                    vgd.push_back(height);
-                    vgd.push_back(1);
-
                     handle.AddKernel("miopenActivationBackward",
                                      network_config,
                                      program_name,
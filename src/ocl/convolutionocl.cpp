@@ -28,22 +28,29 @@
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
 #include <miopen/env.hpp>
+#include <miopen/find_budget.hpp>
 #include <miopen/find_db.hpp>
 #include <miopen/float_equal.hpp>
+#include <miopen/layout_staging.hpp>
+#include <miopen/simple_hash.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/tuning_session.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/algorithm.hpp>
+#include <miopen/trace.hpp>
 
 #if MIOPEN_USE_GEMM
 #include <miopen/gemm_v2.hpp>
 #endif
 
 #include <cassert>
+#include <shared_mutex>
 #include <type_traits>
+#include <unordered_map>
 
 #include <boost/range/adaptors.hpp>
 
@@ -51,6 +58,7 @@ namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_FFT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING)
 
 struct AutoEnableProfiling
@@ -127,6 +135,101 @@ static inline void ValidateGroupCount(const TensorDescriptor& xDesc,
     }
 }
 
+// Upper bound on the algorithms a Find reports for one direction
+static constexpr int max_conv_algos = 4;
+
+// Searches a channels-last problem as its default-layout equivalent on staged copies of the
+// tensors. The transposes are charged to every result and the staging area to its workspace.
+template <class Find>
+static std::vector<miopenConvAlgoPerf_t> FindStaged(
+    Handle& handle, LayoutStaging& staging, ConstData_t a, ConstData_t b, ConstData_t c, Find find)
+{
+    AutoEnableProfiling enableProfiling{handle};
+    auto staging_buf = handle.Create(staging.Size());
+    const auto a_s   = staging.In(handle, 0, a, staging_buf.get());
+    const auto b_s   = staging.In(handle, 1, b, staging_buf.get());
+    // Staging the output like an input stands in for copying it back after the run
+    const auto c_s = staging.In(handle, 2, c, staging_buf.get());
+
+    std::vector<miopenConvAlgoPerf_t> perf(max_conv_algos);
+    int count = 0;
+    find(a_s, b_s, c_s, max_conv_algos, &count, perf.data());
+    perf.resize(count);
+    for(auto& p : perf)
+    {
+        p.time += staging.Time();
+        p.memory += staging.Size();
+    }
+    return perf;
+}
+
+static void ReturnPerfResults(std::vector<miopenConvAlgoPerf_t> perf,
+                              int requestAlgoCount,
+                              int* returnedAlgoCount,
+                              miopenConvAlgoPerf_t* perfResults)
+{
+    std::sort(perf.begin(), perf.end(), [](const auto& l, const auto& r) {
+        return l.time < r.time;
+    });
+    *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf.size()));
+    std::copy_n(perf.begin(), *returnedAlgoCount, perfResults);
+}
+
+#if MIOPEN_USE_GEMM
+// The forward GEMM path of a problem. DirConvFindCore(), ConvolutionForward() and the immediate
+// mode workspace query all select it here, so they cannot disagree.
+enum class FwdGemmPath
+{
+    Transpose1x1, // 1x1, input ht and width <= 14 and stride 1, or stride 2
+    Plain1x1,     // 1x1, stride 1, no workspace
+    Im2Col,
+};
+
+static FwdGemmPath GetFwdGemmPath(const ConvolutionDescriptor& conv,
+                                  const TensorDescriptor& xDesc,
+                                  const TensorDescriptor& wDesc)
+{
+    const auto spatial_dim = conv.GetSpatialDimension();
+    auto in_spatial        = boost::adaptors::slice(xDesc.GetLengths(), 2, 2 + spatial_dim);
+    auto wei_spatial       = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
+
+    const auto is_1x1 = miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
+                        miopen::all_of(conv.GetConvPads(), [](auto v) { return v == 0; });
+    if(spatial_dim == 2 && is_1x1 &&
+       ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
+         miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; })) ||
+        miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 2; })))
+        return FwdGemmPath::Transpose1x1;
+    if(is_1x1 && miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; }))
+        return FwdGemmPath::Plain1x1;
+    return FwdGemmPath::Im2Col;
+}
+
+// Layout-native forward path: an unpadded 1x1 stride 1 convolution of packed channels-last x and
+// y is a single GEMM over all pixels of the batch, with no transposes. Find and
+// ConvolutionForward both use it only when GEMM is enabled and the GEMM call succeeds.
+static bool IsChannelsLast1x1GemmApplicable(const ConvolutionDescriptor& conv,
+                                            const TensorDescriptor& xDesc,
+                                            const TensorDescriptor& wDesc,
+                                            const TensorDescriptor& yDesc)
+{
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
+        return false;
+    if(xDesc.IsDefaultLayout() || yDesc.IsDefaultLayout() || !xDesc.IsPacked() ||
+       !yDesc.IsPacked() || !wDesc.IsPacked())
+        return false;
+    if(conv.group_count != 1 || xDesc.GetType() != wDesc.GetType() ||
+       xDesc.GetType() != yDesc.GetType() ||
+       (xDesc.GetType() != miopenFloat && xDesc.GetType() != miopenHalf))
+        return false;
+
+    auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, wDesc.GetSize());
+    return miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
+           miopen::all_of(conv.GetConvPads(), [](auto v) { return v == 0; }) &&
+           miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; });
+}
+#endif
+
 template <typename T>
 inline int EvaluateDataDirectSolution(Handle& handle,
                                       const miopen::solver::ConvSolution& solution,
@@ -287,28 +390,31 @@ int ConvolutionDescriptor::FindWinogradKernel(Handle& handle,
     }
 }
 
-std::vector<miopen::solver::ConvSolution>
-ConvolutionDescriptor::FindDataDirectSolutions(Handle& handle,
-                                               const TensorDescriptor& xDesc,
-                                               const TensorDescriptor& wDesc,
-                                               const TensorDescriptor& yDesc,
-                                               bool exhaustiveSearch,
-                                               bool isForward,
-                                               std::string& network_config,
-                                               ExtraKernelArgs& extraArgs) const
+/// Sets up the direct solver context of a data convolution and returns f(context), or nothing
+/// when the direct solvers do not apply to the problem.
+template <class F>
+static auto WithDataDirectContext(Handle& handle,
+                                  const TensorDescriptor& xDesc,
+                                  const TensorDescriptor& wDesc,
+                                  const TensorDescriptor& yDesc,
+                                  const ConvolutionDescriptor& conv,
+                                  bool exhaustiveSearch,
+                                  bool isForward,
+                                  std::string& network_config,
+                                  ExtraKernelArgs& extraArgs,
+                                  F f) -> decltype(f(std::declval<mlo_construct_direct2D&>()))
 {
-
-    if(GetSpatialDimension() != 2 || miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
+    if(conv.GetSpatialDimension() != 2 || miopen::IsDisabled(MIOPEN_DEBUG_CONV_DIRECT{}))
         return {};
 
-    mlo_construct_direct2D construct_params(xDesc, wDesc, yDesc, *this, isForward ? 1 : 0);
+    mlo_construct_direct2D construct_params(xDesc, wDesc, yDesc, conv, isForward ? 1 : 0);
     construct_params.setDoSearch(exhaustiveSearch);
     construct_params.saveSearchRequest(true);
     construct_params.setGeneralCompOptions("");
     construct_params.setStream(&handle);
     construct_params.detectRocm();
 
-    if(IsWinograd3x3Supported(handle, isForward, wDesc, (isForward ? xDesc : yDesc)) &&
+    if(conv.IsWinograd3x3Supported(handle, isForward, wDesc, (isForward ? xDesc : yDesc)) &&
        construct_params.mloIsFastBinaryWinograd3x3U() && construct_params.usesBinaryKernel())
         return {};
 
@@ -318,7 +424,7 @@ ConvolutionDescriptor::FindDataDirectSolutions(Handle& handle,
         construct_params.getCompiledInParameters(&N, &C, &H, &W, &K, &n_groups, &out_H, &out_W);
         extraArgs = std::make_tuple(N, C, H, W, K, n_groups, out_H, out_W);
         construct_params.mloBuildConf_Key(network_config);
-        return FindAllSolutions(construct_params);
+        return f(construct_params);
     }
     catch(miopen::Exception&)
     {
@@ -326,17 +432,66 @@ ConvolutionDescriptor::FindDataDirectSolutions(Handle& handle,
     }
 }
 
-static void DirConvFindCore(Handle& handle,
-                            const TensorDescriptor& xDesc,
-                            ConstData_t x,
-                            const TensorDescriptor& wDesc,
-                            ConstData_t w,
-                            const TensorDescriptor& yDesc,
-                            Data_t workSpace,
-                            size_t workSpaceSize,
-                            const ConvolutionDescriptor& conv,
-                            bool exhaustiveSearch,
-                            DbRecord& record)
+std::vector<miopen::solver::ConvSolution>
+ConvolutionDescriptor::FindDataDirectSolutions(Handle& handle,
+                                               const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& wDesc,
+                                               const TensorDescriptor& yDesc,
+                                               bool exhaustiveSearch,
+                                               bool isForward,
+                                               std::string& network_config,
+                                               ExtraKernelArgs& extraArgs) const
+{
+    return WithDataDirectContext(handle,
+                                 xDesc,
+                                 wDesc,
+                                 yDesc,
+                                 *this,
+                                 exhaustiveSearch,
+                                 isForward,
+                                 network_config,
+                                 extraArgs,
+                                 [](auto& construct_params) {
+                                     return FindAllSolutions(construct_params);
+                                 });
+}
+
+std::vector<miopen::solver::DeferredSolution<miopen::solver::ConvSolution>>
+ConvolutionDescriptor::DeferDataDirectSolutions(Handle& handle,
+                                                const TensorDescriptor& xDesc,
+                                                const TensorDescriptor& wDesc,
+                                                const TensorDescriptor& yDesc,
+                                                bool exhaustiveSearch,
+                                                bool isForward,
+                                                std::string& network_config,
+                                                ExtraKernelArgs& extraArgs) const
+{
+    return WithDataDirectContext(handle,
+                                 xDesc,
+                                 wDesc,
+                                 yDesc,
+                                 *this,
+                                 exhaustiveSearch,
+                                 isForward,
+                                 network_config,
+                                 extraArgs,
+                                 [](auto& construct_params) {
+                                     return construct_params.DeferAllSolutions();
+                                 });
+}
+
+/// Returns the candidates that the time budget left out.
+static std::vector<FindSkipped> DirConvFindCore(Handle& handle,
+                                                const TensorDescriptor& xDesc,
+                                                ConstData_t x,
+                                                const TensorDescriptor& wDesc,
+                                                ConstData_t w,
+                                                const TensorDescriptor& yDesc,
+                                                Data_t workSpace,
+                                                size_t workSpaceSize,
+                                                const ConvolutionDescriptor& conv,
+                                                bool exhaustiveSearch,
+                                                DbRecord& record)
 {
     AutoEnableProfiling enableProfiling{handle};
 
@@ -347,94 +502,326 @@ static void DirConvFindCore(Handle& handle,
     {
         ValidateGroupCount(xDesc, wDesc, conv);
 
+        // Candidates are timed in the order of their estimated cost when a budget is set
+        FindBudget budget{conv.find_time_budget};
+        const auto features =
+            ConvCostFeatures::From(ProblemDescription{xDesc, wDesc, yDesc, conv, 1}, &handle);
+        const auto model    = GetConvCostModel();
+        const auto estimate = [&](const std::string& solver_id) {
+            return model->Estimate(features, solver_id);
+        };
+
 #if MIOPEN_USE_GEMM
         if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
-        { // GEMM algo
-            std::size_t in_n, in_c;
-            std::tie(in_n, in_c) = tie_pick<0, 1>()(xDesc.GetLengths());
+        {
+            budget.Add("miopenConvolutionFwdAlgoGEMM", "gemm", estimate("gemm"), [&]() {
+                std::size_t in_n, in_c;
+                std::tie(in_n, in_c) = tie_pick<0, 1>()(xDesc.GetLengths());
 
-            std::size_t wei_k = wDesc.GetLengths()[0];
+                std::size_t wei_k = wDesc.GetLengths()[0];
 
-            std::size_t spatial_dim = conv.GetSpatialDimension();
+                std::size_t spatial_dim = conv.GetSpatialDimension();
 
-            auto in_spatial  = boost::adaptors::slice(xDesc.GetLengths(), 2, 2 + spatial_dim);
-            auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
-            auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 2, 2 + spatial_dim);
+                auto in_spatial  = boost::adaptors::slice(xDesc.GetLengths(), 2, 2 + spatial_dim);
+                auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
+                auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 2, 2 + spatial_dim);
 
-            float time_gemm           = 0;
-            const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
-            // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR
-            // for 1x1_stride=2
-            if(conv.GetSpatialDimension() == 2 &&
-               (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-                miopen::all_of(conv.GetConvPads(), [](auto v) { return v == 0; })) &&
-               ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-                 miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; })) ||
-                miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 2; })))
-            {
-                size_t workspace_req = conv.ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
-                if(workSpace != nullptr && workSpaceSize >= workspace_req)
+                float time_gemm           = 0;
+                const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
+                const auto gemm_path      = GetFwdGemmPath(conv, xDesc, wDesc);
+                if(gemm_path == FwdGemmPath::Transpose1x1)
+                {
+                    size_t workspace_req = conv.ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
+                    if(workSpace != nullptr && workSpaceSize >= workspace_req)
+                    {
+                        if(conv.group_count > 1)
+                        {
+                            MIOPEN_LOG_FUNCTION("groupconv, 1x1, h14xw14 || u2xv2");
+                        }
+                        else
+                        {
+                            MIOPEN_LOG_FUNCTION("convolution, 1x1, h14xw14 || u2xv2");
+                        }
+
+                        // y = CNHW2NCHW(w * NCHW2CNHW(x))
+                        transpose_NCHW2CNHW(handle,
+                                            in_n,
+                                            in_c,
+                                            in_spatial[0],
+                                            in_spatial[1],
+                                            out_spatial[0],
+                                            out_spatial[1],
+                                            x,
+                                            workSpace,
+                                            0,
+                                            0,
+                                            conv.GetConvStrides()[0],
+                                            conv.GetConvStrides()[1],
+                                            xDesc.GetType());
+                        time_gemm = handle.GetKernelTime();
+
+                        std::size_t out_spatial_size =
+                            std::accumulate(out_spatial.begin(),
+                                            out_spatial.end(),
+                                            std::size_t(1),
+                                            std::multiplies<std::size_t>());
+
+                        std::size_t x_t_size = in_n * in_c * out_spatial_size;
+
+                        std::size_t wksp_offset = 0;
+                        if(wDesc.GetType() == miopenInt8)
+                        {
+                            wksp_offset = x_t_size;
+                            transpose_packed_MN2NM(handle,
+                                                   in_c,
+                                                   static_cast<int>(in_n * out_spatial_size),
+                                                   0,
+                                                   wksp_offset,
+                                                   workSpace,
+                                                   workSpace,
+                                                   xDesc.GetType());
+
+                            time_gemm += handle.GetKernelTime();
+
+                            x_t_size *= 2;
+                        }
+                        if((wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4) &&
+                           (yDesc.GetType() == miopenInt32 || yDesc.GetType() == miopenFloat))
+                            x_t_size /= 4;
+
+                        std::string kcache_key;
+
+                        GemmDescriptor gemm_desc =
+                            conv.group_count > 1
+                                ? CreateGemmDescriptorGroupConvCNHWFwd(
+                                      wDesc, xDesc, yDesc, conv.group_count)
+                                : CreateGemmDescriptorConvCNHWFwd(wDesc, xDesc, yDesc);
+
+                        miopenStatus_t gemm_status = CallGemmTimeMeasure(
+                            handle,
+                            gemm_desc,
+                            w,
+                            0,
+                            workSpace,
+                            wksp_offset,
+                            workSpace,
+                            x_t_size,
+                            &kcache_key,
+                            time_precision,
+                            conv.group_count > 1 ? callGemmStridedBatched : callGemm);
+
+                        time_gemm += handle.GetKernelTime();
+
+                        transpose_CNHW2NCHW(handle,
+                                            in_n,
+                                            wei_k,
+                                            out_spatial[0],
+                                            out_spatial[1],
+                                            out_spatial[0],
+                                            out_spatial[1],
+                                            workSpace,
+                                            tmp_y.get(),
+                                            x_t_size,
+                                            0,
+                                            1,
+                                            1,
+                                            yDesc.GetType());
+                        time_gemm += handle.GetKernelTime();
+
+                        if(wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
+                        {
+                            TensorDescriptor ygemmDesc(
+                                miopenInt32, yDesc.GetLengths(), yDesc.GetStrides());
+
+                            CastTensor(handle,
+                                       &conv.lowp_quant,
+                                       ygemmDesc,
+                                       tmp_y.get(),
+                                       yDesc,
+                                       tmp_y.get(),
+                                       0,
+                                       0);
+                            time_gemm += handle.GetKernelTime();
+                        }
+
+                        if(gemm_status == miopenStatusSuccess)
+                        {
+                            record.SetValues("miopenConvolutionFwdAlgoGEMM",
+                                             FindDbData{"gemm",
+                                                        time_gemm,
+                                                        workspace_req,
+                                                        kcache_key}); // Todo: gemm solver id?
+                            return time_gemm;
+                        }
+                    }
+                }
+                // 1x1_stride=1 with GEMM and zero workspace
+                else if(gemm_path == FwdGemmPath::Plain1x1)
                 {
                     if(conv.group_count > 1)
                     {
-                        MIOPEN_LOG_FUNCTION("groupconv, 1x1, h14xw14 || u2xv2");
+                        MIOPEN_LOG_FUNCTION("groupconv, 1x1");
                     }
                     else
                     {
-                        MIOPEN_LOG_FUNCTION("convolution, 1x1, h14xw14 || u2xv2");
+                        MIOPEN_LOG_FUNCTION("convolution, 1x1");
                     }
 
-                    // y = CNHW2NCHW(w * NCHW2CNHW(x))
-                    transpose_NCHW2CNHW(handle,
-                                        in_n,
-                                        in_c,
-                                        in_spatial[0],
-                                        in_spatial[1],
-                                        out_spatial[0],
-                                        out_spatial[1],
-                                        x,
-                                        workSpace,
-                                        0,
-                                        0,
-                                        conv.GetConvStrides()[0],
-                                        conv.GetConvStrides()[1],
-                                        xDesc.GetType());
-                    time_gemm = handle.GetKernelTime();
+                    // y = w * x
+                    std::string kcache_key;
+                    miopenStatus_t gemm_status = miopenStatusNotInitialized;
 
-                    std::size_t out_spatial_size = std::accumulate(out_spatial.begin(),
-                                                                   out_spatial.end(),
-                                                                   std::size_t(1),
-                                                                   std::multiplies<std::size_t>());
+                    if(wDesc.GetType() == miopenInt8)
+                    {
+                        GemmDescriptor gemm_desc = CreateGemmDescriptorConvFwd(wDesc, xDesc, yDesc);
 
-                    std::size_t x_t_size = in_n * in_c * out_spatial_size;
+                        std::size_t out_offset      = 0;
+                        std::size_t in_offset       = 0;
+                        std::size_t in_spatial_size =
+                            std::accumulate(in_spatial.begin(),
+                                            in_spatial.end(),
+                                            std::size_t(1),
+                                            std::multiplies<std::size_t>());
+                        transpose_packed_MN2NM(handle,
+                                               in_c,
+                                               in_spatial_size,
+                                               in_offset,
+                                               0,
+                                               x,
+                                               workSpace,
+                                               xDesc.GetType());
+
+                        time_gemm += (in_n * handle.GetKernelTime());
+
+                        gemm_status = CallGemmTimeMeasure(handle,
+                                                          gemm_desc,
+                                                          w,
+                                                          0,
+                                                          workSpace,
+                                                          0,
+                                                          tmp_y.get(),
+                                                          out_offset,
+                                                          &kcache_key,
+                                                          time_precision,
+                                                          callGemm);
+
+                        time_gemm += (in_n * handle.GetKernelTime());
+                    }
+                    else
+                    {
+                        GemmDescriptor gemm_desc =
+                            conv.group_count > 1
+                                ? CreateGemmDescriptorGroupConvFwd(
+                                      wDesc, xDesc, yDesc, conv.group_count)
+                                : CreateGemmStridedBatchedDescriptorConv1x1Fwd(wDesc, xDesc, yDesc);
+
+                        gemm_status = CallGemmTimeMeasure(handle,
+                                                          gemm_desc,
+                                                          w,
+                                                          0,
+                                                          x,
+                                                          0,
+                                                          tmp_y.get(),
+                                                          0,
+                                                          &kcache_key,
+                                                          time_precision,
+                                                          callGemmStridedBatched);
+
+                        time_gemm = handle.GetKernelTime();
+                        if(conv.group_count > 1)
+                            time_gemm *= in_n;
+                    }
+
+                    if(wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
+                    {
+                        TensorDescriptor ygemmDesc(
+                            miopenInt32, yDesc.GetLengths(), yDesc.GetStrides());
+
+                        CastTensor(handle,
+                                   &conv.lowp_quant,
+                                   ygemmDesc,
+                                   tmp_y.get(),
+                                   yDesc,
+                                   tmp_y.get(),
+                                   0,
+                                   0);
+                        time_gemm += handle.GetKernelTime();
+                    }
+
+                    if(gemm_status == miopenStatusSuccess)
+                    {
+                        record.SetValues(
+                            "miopenConvolutionFwdAlgoGEMM",
+                            FindDbData{"gemm", time_gemm, 0, kcache_key}); // Todo: gemm solver id?
+                        return time_gemm;
+                    }
+                }
+                // if not 1x1
+                else if(workSpace != nullptr &&
+                        workSpaceSize >=
+                            (conv.ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * conv.group_count))
+                {
+                    if(conv.group_count > 1)
+                    {
+                        MIOPEN_LOG_FUNCTION("groupconv, non 1x1");
+                    }
+                    else
+                    {
+                        MIOPEN_LOG_FUNCTION("convolution, non 1x1");
+                    }
+
+                    // y = w * Im2Col(x)
+                    float time_im2col = 0;
+                    int in_offset     = 0;
+                    time_im2col       = Im2ColGPU(handle,
+                                            conv.GetSpatialDimension(),
+                                            x,
+                                            in_offset,
+                                            in_c,
+                                            in_spatial,
+                                            wei_spatial,
+                                            out_spatial,
+                                            conv.GetConvPads(),
+                                            conv.GetConvStrides(),
+                                            conv.GetConvDilations(),
+                                            workSpace,
+                                            xDesc.GetType());
 
                     std::size_t wksp_offset = 0;
                     if(wDesc.GetType() == miopenInt8)
                     {
-                        wksp_offset = x_t_size;
+                        std::size_t wei_spatial_size =
+                            std::accumulate(wei_spatial.begin(),
+                                            wei_spatial.end(),
+                                            std::size_t(1),
+                                            std::multiplies<std::size_t>());
+
+                        std::size_t out_spatial_size =
+                            std::accumulate(out_spatial.begin(),
+                                            out_spatial.end(),
+                                            std::size_t(1),
+                                            std::multiplies<std::size_t>());
+
+                        wksp_offset = in_c * wei_spatial_size * out_spatial_size;
+
                         transpose_packed_MN2NM(handle,
-                                               in_c,
-                                               static_cast<int>(in_n * out_spatial_size),
+                                               static_cast<int>(in_c * wei_spatial_size),
+                                               out_spatial_size,
                                                0,
                                                wksp_offset,
                                                workSpace,
                                                workSpace,
                                                xDesc.GetType());
-
-                        time_gemm += handle.GetKernelTime();
-
-                        x_t_size *= 2;
+                        time_gemm += (in_n * handle.GetKernelTime());
                     }
-                    if((wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4) &&
-                       (yDesc.GetType() == miopenInt32 || yDesc.GetType() == miopenFloat))
-                        x_t_size /= 4;
 
                     std::string kcache_key;
 
                     GemmDescriptor gemm_desc =
-                        conv.group_count > 1 ? CreateGemmDescriptorGroupConvCNHWFwd(
-                                                   wDesc, xDesc, yDesc, conv.group_count)
-                                             : CreateGemmDescriptorConvCNHWFwd(wDesc, xDesc, yDesc);
+                        conv.group_count > 1
+                            ? CreateGemmDescriptorGroupConvFwd(
+                                  wDesc, xDesc, yDesc, conv.group_count)
+                            : CreateGemmDescriptorConvFwd(wDesc, xDesc, yDesc);
 
                     miopenStatus_t gemm_status = CallGemmTimeMeasure(
                         handle,
@@ -443,29 +830,17 @@ static void DirConvFindCore(Handle& handle,
                         0,
                         workSpace,
                         wksp_offset,
-                        workSpace,
-                        x_t_size,
+                        tmp_y.get(),
+                        0,
                         &kcache_key,
                         time_precision,
-                        conv.group_count > 1 ? callGemmStridedBatched : callGemm);
+                        conv.group_count > 1 ? callGemmStridedBatched : callGemm,
+                        (conv.group_count > 1 || wDesc.GetType() == miopenInt8 ||
+                         wDesc.GetType() == miopenInt8x4)
+                            ? GemmBackend_t::rocblas
+                            : GemmBackend_t::miopengemm);
 
-                    time_gemm += handle.GetKernelTime();
-
-                    transpose_CNHW2NCHW(handle,
-                                        in_n,
-                                        wei_k,
-                                        out_spatial[0],
-                                        out_spatial[1],
-                                        out_spatial[0],
-                                        out_spatial[1],
-                                        workSpace,
-                                        tmp_y.get(),
-                                        x_t_size,
-                                        0,
-                                        1,
-                                        1,
-                                        yDesc.GetType());
-                    time_gemm += handle.GetKernelTime();
+                    time_gemm += (in_n * (time_im2col + handle.GetKernelTime()));
 
                     if(wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
                     {
@@ -484,199 +859,19 @@ static void DirConvFindCore(Handle& handle,
                     }
 
                     if(gemm_status == miopenStatusSuccess)
-                        record.SetValues("miopenConvolutionFwdAlgoGEMM",
-                                         FindDbData{"gemm",
-                                                    time_gemm,
-                                                    workspace_req,
-                                                    kcache_key}); // Todo: gemm solver id?
-                }
-            }
-            // 1x1_stride=1 with GEMM and zero workspace
-            else if(miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-                    miopen::all_of(conv.GetConvPads(), [](auto v) { return v == 0; }) &&
-                    miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; }))
-            {
-                if(conv.group_count > 1)
-                {
-                    MIOPEN_LOG_FUNCTION("groupconv, 1x1");
-                }
-                else
-                {
-                    MIOPEN_LOG_FUNCTION("convolution, 1x1");
-                }
-
-                // y = w * x
-                std::string kcache_key;
-                miopenStatus_t gemm_status = miopenStatusNotInitialized;
-
-                if(wDesc.GetType() == miopenInt8)
-                {
-                    GemmDescriptor gemm_desc = CreateGemmDescriptorConvFwd(wDesc, xDesc, yDesc);
-
-                    std::size_t out_offset      = 0;
-                    std::size_t in_offset       = 0;
-                    std::size_t in_spatial_size = std::accumulate(in_spatial.begin(),
-                                                                  in_spatial.end(),
-                                                                  std::size_t(1),
-                                                                  std::multiplies<std::size_t>());
-                    transpose_packed_MN2NM(
-                        handle, in_c, in_spatial_size, in_offset, 0, x, workSpace, xDesc.GetType());
-
-                    time_gemm += (in_n * handle.GetKernelTime());
-
-                    gemm_status = CallGemmTimeMeasure(handle,
-                                                      gemm_desc,
-                                                      w,
-                                                      0,
-                                                      workSpace,
-                                                      0,
-                                                      tmp_y.get(),
-                                                      out_offset,
-                                                      &kcache_key,
-                                                      time_precision,
-                                                      callGemm);
-
-                    time_gemm += (in_n * handle.GetKernelTime());
-                }
-                else
-                {
-                    GemmDescriptor gemm_desc =
-                        conv.group_count > 1
-                            ? CreateGemmDescriptorGroupConvFwd(
-                                  wDesc, xDesc, yDesc, conv.group_count)
-                            : CreateGemmStridedBatchedDescriptorConv1x1Fwd(wDesc, xDesc, yDesc);
-
-                    gemm_status = CallGemmTimeMeasure(handle,
-                                                      gemm_desc,
-                                                      w,
-                                                      0,
-                                                      x,
-                                                      0,
-                                                      tmp_y.get(),
-                                                      0,
-                                                      &kcache_key,
-                                                      time_precision,
-                                                      callGemmStridedBatched);
-
-                    time_gemm = handle.GetKernelTime();
-                    if(conv.group_count > 1)
-                        time_gemm *= in_n;
-                }
-
-                if(wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
-                {
-                    TensorDescriptor ygemmDesc(miopenInt32, yDesc.GetLengths(), yDesc.GetStrides());
-
-                    CastTensor(
-                        handle, &conv.lowp_quant, ygemmDesc, tmp_y.get(), yDesc, tmp_y.get(), 0, 0);
-                    time_gemm += handle.GetKernelTime();
-                }
-
-                if(gemm_status == miopenStatusSuccess)
-                    record.SetValues(
-                        "miopenConvolutionFwdAlgoGEMM",
-                        FindDbData{"gemm", time_gemm, 0, kcache_key}); // Todo: gemm solver id?
-            }
-            // if not 1x1
-            else if(workSpace != nullptr &&
-                    workSpaceSize >=
-                        (conv.ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * conv.group_count))
-            {
-                if(conv.group_count > 1)
-                {
-                    MIOPEN_LOG_FUNCTION("groupconv, non 1x1");
-                }
-                else
-                {
-                    MIOPEN_LOG_FUNCTION("convolution, non 1x1");
-                }
-
-                // y = w * Im2Col(x)
-                float time_im2col = 0;
-                int in_offset     = 0;
-                time_im2col       = Im2ColGPU(handle,
-                                        conv.GetSpatialDimension(),
-                                        x,
-                                        in_offset,
-                                        in_c,
-                                        in_spatial,
-                                        wei_spatial,
-                                        out_spatial,
-                                        conv.GetConvPads(),
-                                        conv.GetConvStrides(),
-                                        conv.GetConvDilations(),
-                                        workSpace,
-                                        xDesc.GetType());
-
-                std::size_t wksp_offset = 0;
-                if(wDesc.GetType() == miopenInt8)
-                {
-                    std::size_t wei_spatial_size = std::accumulate(wei_spatial.begin(),
-                                                                   wei_spatial.end(),
-                                                                   std::size_t(1),
-                                                                   std::multiplies<std::size_t>());
-
-                    std::size_t out_spatial_size = std::accumulate(out_spatial.begin(),
-                                                                   out_spatial.end(),
-                                                                   std::size_t(1),
-                                                                   std::multiplies<std::size_t>());
-
-                    wksp_offset = in_c * wei_spatial_size * out_spatial_size;
-
-                    transpose_packed_MN2NM(handle,
-                                           static_cast<int>(in_c * wei_spatial_size),
-                                           out_spatial_size,
-                                           0,
-                                           wksp_offset,
-                                           workSpace,
-                                           workSpace,
-                                           xDesc.GetType());
-                    time_gemm += (in_n * handle.GetKernelTime());
-                }
-
-                std::string kcache_key;
-
-                GemmDescriptor gemm_desc =
-                    conv.group_count > 1
-                        ? CreateGemmDescriptorGroupConvFwd(wDesc, xDesc, yDesc, conv.group_count)
-                        : CreateGemmDescriptorConvFwd(wDesc, xDesc, yDesc);
-
-                miopenStatus_t gemm_status =
-                    CallGemmTimeMeasure(handle,
-                                        gemm_desc,
-                                        w,
-                                        0,
-                                        workSpace,
-                                        wksp_offset,
-                                        tmp_y.get(),
-                                        0,
-                                        &kcache_key,
-                                        time_precision,
-                                        conv.group_count > 1 ? callGemmStridedBatched : callGemm,
-                                        (conv.group_count > 1 || wDesc.GetType() == miopenInt8 ||
-                                         wDesc.GetType() == miopenInt8x4)
-                                            ? GemmBackend_t::rocblas
-                                            : GemmBackend_t::miopengemm);
-
-                time_gemm += (in_n * (time_im2col + handle.GetKernelTime()));
-
-                if(wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
-                {
-                    TensorDescriptor ygemmDesc(miopenInt32, yDesc.GetLengths(), yDesc.GetStrides());
-
-                    CastTensor(
-                        handle, &conv.lowp_quant, ygemmDesc, tmp_y.get(), yDesc, tmp_y.get(), 0, 0);
-                    time_gemm += handle.GetKernelTime();
+                    {
+                        record.SetValues(
+                            "miopenConvolutionFwdAlgoGEMM",
+                            FindDbData{"gemm",
+                                       time_gemm,
+                                       (conv.ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) *
+                                        conv.group_count),
+                                       kcache_key}); // Todo: gemm solver id?
+                        return time_gemm;
+                    }
                 }
-
-                if(gemm_status == miopenStatusSuccess)
-                    record.SetValues("miopenConvolutionFwdAlgoGEMM",
-                                     FindDbData{"gemm",
-                                                time_gemm,
-                                                (conv.ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) *
-                                                 conv.group_count),
-                                                kcache_key}); // Todo: gemm solver id?
-            }
+                return -1.0f;
+            });
         }
 #else
         (void)workSpace;     // Suppress warning
@@ -686,105 +881,132 @@ static void DirConvFindCore(Handle& handle,
         if(conv.GetSpatialDimension() == 2)
         {
             // Winograd algo
-            WinogradKernelParams k_p;
-            KernelInvoke kernel_wino;
-            std::string network_config;
-            std::string solver_id;
-            if(conv.FindWinogradKernel<mlo_construct_winograd>(
-                   handle, xDesc, wDesc, yDesc, k_p, kernel_wino, solver_id, 1, &network_config) ==
-               0)
-            { // TODO: be more graceful
-                // Execute the winograd kernel
-                // Invocation of winograd does not depend on input bitness (FP32 or FP16)
-                float time_wino  = 0;
-                int flags        = 0;
-                int reserved     = 0;
-                int* return_addr = nullptr;
-                bool isRxS;
-                int N, C, H, W, K, n_groups, out_H, out_W, R, S, unused;
-                std::tie(N, C, H, W, K, n_groups, out_H, out_W, R, S, unused, unused, isRxS) = k_p;
-                // clang-format off
-                MIOPEN_LOG_I2(" N=" << N << " C=" << C << " H=" << H << " W=" << W << " K=" << K
-                    << " n_groups=" << n_groups << " flags=" << flags << " R=" << R << " S=" << S
-                    << " pad_h=" << conv.GetConvPads()[0] << " pad_w=" << conv.GetConvPads()[1] << " out_H=" << out_H << " out_W=" << out_W); // clang-format on
-                if(isRxS)
-                {
-                    kernel_wino(N,
-                                C,
-                                H,
-                                W,
-                                K,
-                                n_groups,
-                                flags,
-                                reserved,
-                                x,
-                                w,
-                                tmp_y.get(),
-                                return_addr,
-                                R,
-                                S,
-                                conv.GetConvPads()[0],
-                                conv.GetConvPads()[1],
-                                out_H,
-                                out_W);
-                }
-                else
-                {
-                    kernel_wino(
-                        N, C, H, W, K, n_groups, flags, reserved, x, w, tmp_y.get(), return_addr);
-                }
-                time_wino = handle.GetKernelTime();
-                record.SetValues("miopenConvolutionFwdAlgoWinograd",
-                                 FindDbData{solver_id, time_wino, 0, network_config});
-            }
-
-            // Direct algo
-            ExtraKernelArgs eka;
-            const auto all = conv.FindDataDirectSolutions(
-                handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, network_config, eka);
-            miopen::solver::ConvSolution selected{miopenStatusUnknownError};
-            float best = std::numeric_limits<float>::max();
-            visit_float(xDesc.GetType(), [&](auto as_float) {
-                for(const auto& sol : all)
-                {
-                    float elapsed = 0.0f;
-                    const int rc  = EvaluateDataDirectSolution(handle,
-                                                              sol,
-                                                              eka,
-                                                              x,
-                                                              w,
-                                                              tmp_y.get(),
-                                                              yDesc,
-                                                              workSpace,
-                                                              workSpaceSize,
-                                                              as_float(0.0f),
-                                                              elapsed);
-                    if(rc != 0)
+            budget.Add(
+                "miopenConvolutionFwdAlgoWinograd",
+                "ConvBinWinogradRxS",
+                std::min(estimate("ConvBinWinograd3x3U"), estimate("ConvBinWinogradRxS")),
+                [&]() {
+                    WinogradKernelParams k_p;
+                    KernelInvoke kernel_wino;
+                    std::string wino_network_config;
+                    std::string solver_id;
+                    if(conv.FindWinogradKernel<mlo_construct_winograd>(handle,
+                                                                        xDesc,
+                                                                        wDesc,
+                                                                        yDesc,
+                                                                        k_p,
+                                                                        kernel_wino,
+                                                                        solver_id,
+                                                                        1,
+                                                                        &wino_network_config) != 0)
+                        return -1.0f; // TODO: be more graceful
+                    // Execute the winograd kernel
+                    // Invocation of winograd does not depend on input bitness (FP32 or FP16)
+                    float time_wino  = 0;
+                    int flags        = 0;
+                    int reserved     = 0;
+                    int* return_addr = nullptr;
+                    bool isRxS;
+                    int N, C, H, W, K, n_groups, out_H, out_W, R, S, unused;
+                    std::tie(N, C, H, W, K, n_groups, out_H, out_W, R, S, unused, unused, isRxS) =
+                        k_p;
+                    // clang-format off
+                    MIOPEN_LOG_I2(" N=" << N << " C=" << C << " H=" << H << " W=" << W << " K=" << K
+                        << " n_groups=" << n_groups << " flags=" << flags << " R=" << R << " S=" << S
+                        << " pad_h=" << conv.GetConvPads()[0] << " pad_w=" << conv.GetConvPads()[1] << " out_H=" << out_H << " out_W=" << out_W); // clang-format on
+                    if(isRxS)
                     {
-                        MIOPEN_LOG_E(sol << " returns " << rc);
+                        kernel_wino(N,
+                                    C,
+                                    H,
+                                    W,
+                                    K,
+                                    n_groups,
+                                    flags,
+                                    reserved,
+                                    x,
+                                    w,
+                                    tmp_y.get(),
+                                    return_addr,
+                                    R,
+                                    S,
+                                    conv.GetConvPads()[0],
+                                    conv.GetConvPads()[1],
+                                    out_H,
+                                    out_W);
                     }
                     else
                     {
-                        MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ")
-                                         << best);
-                        if(elapsed < best)
-                        {
-                            best     = elapsed;
-                            selected = sol;
-                        }
+                        kernel_wino(N,
+                                    C,
+                                    H,
+                                    W,
+                                    K,
+                                    n_groups,
+                                    flags,
+                                    reserved,
+                                    x,
+                                    w,
+                                    tmp_y.get(),
+                                    return_addr);
                     }
+                    time_wino = handle.GetKernelTime();
+                    record.SetValues("miopenConvolutionFwdAlgoWinograd",
+                                     FindDbData{solver_id, time_wino, 0, wino_network_config});
+                    return time_wino;
+                });
+        }
+
+        // Direct algo, every applicable solver is a candidate of its own. Its search and tuning
+        // run inside the candidate, so that they count against the budget.
+        ExtraKernelArgs eka;
+        std::string network_config;
+        const auto deferred = conv.DeferDataDirectSolutions(
+            handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, network_config, eka);
+        miopen::solver::ConvSolution selected{miopenStatusUnknownError};
+        float best = std::numeric_limits<float>::max();
+        for(const auto& d : deferred)
+        {
+            budget.Add("miopenConvolutionFwdAlgoDirect", d.solver_id, d.estimate, [&]() {
+                miopen::solver::ConvSolution sol{miopenStatusUnknownError};
+                try
+                {
+                    sol = d.find();
+                }
+                catch(miopen::Exception&)
+                {
+                    return -1.0f;
                 }
+                if(!sol.Succeeded())
+                    return -1.0f;
+                float elapsed = 0.0f;
+                int rc        = 0;
+                visit_float(xDesc.GetType(), [&](auto as_float) {
+                    rc = EvaluateDataDirectSolution(handle,
+                                                    sol,
+                                                    eka,
+                                                    x,
+                                                    w,
+                                                    tmp_y.get(),
+                                                    yDesc,
+                                                    workSpace,
+                                                    workSpaceSize,
+                                                    as_float(0.0f),
+                                                    elapsed);
+                });
+                if(rc != 0)
+                {
+                    MIOPEN_LOG_E(sol << " returns " << rc);
+                    return -1.0f;
+                }
+                MIOPEN_LOG_I(sol << ": " << elapsed << (elapsed < best ? " < " : " >= ") << best);
+                if(elapsed < best)
+                {
+                    best     = elapsed;
+                    selected = sol;
+                }
+                return elapsed;
             });
-            if(selected.Succeeded())
-            {
-                const std::string algorithm_name = "miopenConvolutionFwdAlgoDirect";
-                AddKernels(handle, algorithm_name, network_config, selected, nullptr);
-                MIOPEN_LOG_I("Selected: " << selected << ": " << best << ", workspce_sz = "
-                                          << selected.workspce_sz);
-                record.SetValues(
-                    algorithm_name,
-                    FindDbData{selected.solver_id, best, selected.workspce_sz, network_config});
-            }
         }
 
         // FFT algo
@@ -793,33 +1015,53 @@ static void DirConvFindCore(Handle& handle,
            conv.group_count == 1 && wDesc.GetType() != miopenInt8 &&
            wDesc.GetType() != miopenInt8x4)
         {
-            std::string network_config;
-            std::vector<KernelInvoke> kernels_fft;
-            size_t workspace_fft = conv.ForwardGetWorkSpaceSizeFFT(wDesc, xDesc, yDesc);
-            if(conv.FindFwdFFTKernel(
-                   handle, xDesc, wDesc, yDesc, workspace_fft, kernels_fft, network_config) == 0)
-            {
+            budget.Add("miopenConvolutionFwdAlgoFFT", "fft", estimate("fft"), [&]() {
+                std::string fft_network_config;
+                std::vector<KernelInvoke> kernels_fft;
+                size_t workspace_fft = conv.ForwardGetWorkSpaceSizeFFT(wDesc, xDesc, yDesc);
+                if(conv.FindFwdFFTKernel(handle,
+                                         xDesc,
+                                         wDesc,
+                                         yDesc,
+                                         workspace_fft,
+                                         kernels_fft,
+                                         fft_network_config) != 0)
+                    return -1.0f;
                 (void)kernels_fft; // not used now, but needed as fft coverage widens
-                if(workSpace != nullptr && workSpaceSize >= workspace_fft)
-                {
-                    float time_fft = conv.ExecuteFwdFFTKernel(handle,
-                                                              xDesc,
-                                                              x,
-                                                              wDesc,
-                                                              w,
-                                                              yDesc,
-                                                              tmp_y.get(),
-                                                              workSpace,
-                                                              workSpaceSize,
-                                                              true);
-                    record.SetValues("miopenConvolutionFwdAlgoFFT",
-                                     FindDbData{"fft",
-                                                time_fft,
-                                                workspace_fft,
-                                                network_config}); // Todo: fft solver id?
-                }
-            }
+                if(workSpace == nullptr || workSpaceSize < workspace_fft)
+                    return -1.0f;
+                float time_fft = conv.ExecuteFwdFFTKernel(handle,
+                                                          xDesc,
+                                                          x,
+                                                          wDesc,
+                                                          w,
+                                                          yDesc,
+                                                          tmp_y.get(),
+                                                          workSpace,
+                                                          workSpaceSize,
+                                                          true);
+                record.SetValues("miopenConvolutionFwdAlgoFFT",
+                                 FindDbData{"fft",
+                                            time_fft,
+                                            workspace_fft,
+                                            fft_network_config}); // Todo: fft solver id?
+                return time_fft;
+            });
         }
+
+        budget.Run();
+
+        if(selected.Succeeded())
+        {
+            const std::string algorithm_name = "miopenConvolutionFwdAlgoDirect";
+            AddKernels(handle, algorithm_name, network_config, selected, nullptr);
+            MIOPEN_LOG_I("Selected: " << selected << ": " << best << ", workspce_sz = "
+                                      << selected.workspce_sz);
+            record.SetValues(
+                algorithm_name,
+                FindDbData{selected.solver_id, best, selected.workspce_sz, network_config});
+        }
+        return budget.GetSkipped();
     }
 }
 
@@ -837,7 +1079,10 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  size_t workSpaceSize,
                                                  bool exhaustiveSearch) const
 {
+    MIOPEN_TRACE_SCOPE("find", "ConvolutionDescriptor::FindConvFwdAlgorithm");
     MIOPEN_LOG_I2("");
+    // Auto-tuning searches of all the solvers share one profiling handle and buffers.
+    const TuningSession::Scope tuning_session;
     if(x == nullptr || w == nullptr || y == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
     if(returnedAlgoCount == nullptr)
@@ -848,21 +1093,89 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
 
     *returnedAlgoCount = 0;
+    handle.SetFindSkipped({});
+
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(staging.Any())
+    {
+        auto perf = FindStaged(
+            handle, staging, x, w, y, [&](auto xs, auto ws, auto ys, int n, int* count, auto res) {
+                FindConvFwdAlgorithm(handle,
+                                     staging.Desc(0),
+                                     xs,
+                                     staging.Desc(1),
+                                     ws,
+                                     staging.Desc(2),
+                                     ys,
+                                     n,
+                                     count,
+                                     res,
+                                     workSpace,
+                                     staging.RestSize(workSpaceSize),
+                                     exhaustiveSearch);
+            });
+#if MIOPEN_USE_GEMM
+        if(IsChannelsLast1x1GemmApplicable(*this, xDesc, wDesc, yDesc))
+        {
+            AutoEnableProfiling enableProfiling{handle};
+            auto tmp_y = handle.Create(yDesc.GetElementSpace() * GetTypeSize(yDesc.GetType()));
+            std::string kcache_key;
+            const auto gemm_status =
+                CallGemmTimeMeasure(handle,
+                                    CreateGemmDescriptorConvChannelsLast1x1Fwd(wDesc, xDesc, yDesc),
+                                    x,
+                                    0,
+                                    w,
+                                    0,
+                                    tmp_y.get(),
+                                    0,
+                                    &kcache_key,
+                                    !IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}),
+                                    callGemm);
+            if(gemm_status == miopenStatusSuccess)
+            {
+                // The native GEMM supersedes the one run on staged copies
+                perf.erase(std::remove_if(perf.begin(),
+                                          perf.end(),
+                                          [](const auto& p) {
+                                              return p.fwd_algo == miopenConvolutionFwdAlgoGEMM;
+                                          }),
+                           perf.end());
+                miopenConvAlgoPerf_t native;
+                native.fwd_algo = miopenConvolutionFwdAlgoGEMM;
+                native.time     = handle.GetKernelTime();
+                native.memory   = 0;
+                perf.push_back(native);
+            }
+        }
+#endif
+        if(perf.empty())
+            MIOPEN_THROW("Fwd Convolution cannot be executed due to incorrect params");
+        ReturnPerfResults(perf, requestAlgoCount, returnedAlgoCount, perfResults);
+        MIOPEN_LOG_I("FW Chosen Algorithm for channels-last tensors: " << perfResults[0].fwd_algo
+                                                                         << ", "
+                                                                         << perfResults[0].time);
+        return;
+    }
 
     ProblemDescription problem(xDesc, wDesc, yDesc, *this, 1);
 
     std::vector<PerfField> perf_db = FindDb::TryLoad(handle, problem, [&](DbRecord& record) {
-        DirConvFindCore(handle,
-                        xDesc,
-                        x,
-                        wDesc,
-                        w,
-                        yDesc,
-                        workSpace,
-                        workSpaceSize,
-                        *this,
-                        exhaustiveSearch,
-                        record);
+        auto skipped = DirConvFindCore(handle,
+                                       xDesc,
+                                       x,
+                                       wDesc,
+                                       w,
+                                       yDesc,
+                                       workSpace,
+                                       workSpaceSize,
+                                       *this,
+                                       exhaustiveSearch,
+                                       record);
+        // A record missing skipped candidates must not stand in for a full Find later
+        const bool complete = skipped.empty();
+        handle.SetFindSkipped(std::move(skipped));
+        return complete;
     });
 
     if(perf_db.empty())
@@ -888,6 +1201,86 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                          << perf_db[0].time);
 }
 
+/// Runs the kernels of a forward direct solution, as cached by Find or immediate mode.
+template <class Kernels>
+static void RunFwdDirectKernels(Handle& handle,
+                                mlo_construct_direct2D& construct_params,
+                                Kernels&& kernels,
+                                miopenDataType_t type,
+                                ConstData_t x,
+                                ConstData_t w,
+                                Data_t y,
+                                Data_t workSpace,
+                                std::size_t workSpaceSize)
+{
+#if(!defined(__GNUC__) || defined(__clang__)) // w/a for segfault in gcc 5.4.0
+    const
+#endif
+        auto num_kernels = kernels.size();
+    auto kernel          = kernels[0];
+
+    visit_float(type, [&](auto as_float) {
+        // Miminum checks. Only check what is required to select
+        // proper invocation procedure & workspace sanity.
+        float padding_val = 0;
+        float elapsed     = 0;
+        if((kernel.GetName() == "MIOpenCvFwd11x11") && num_kernels == 2)
+        {
+            kernel(x, w, y, as_float(padding_val));
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            kernels[1](x, w, y, as_float(padding_val));
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+        }
+        else if(num_kernels == 2 && workSpace != nullptr && workSpaceSize != 0)
+        {
+            assert(kernel.GetName() == "SubSample");
+            kernel(x, workSpace);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+
+            assert(kernels[1].GetName() == "gcnAsmConv1x1U");
+            int unused       = 0;
+            int* return_addr = nullptr;
+            int N, C, H, W, K, n_groups, out_H, out_W;
+            construct_params.getCompiledInParameters(
+                &N, &C, &H, &W, &K, &n_groups, &out_H, &out_W);
+            kernels[1](
+                N, C, out_H, out_W, K, n_groups, unused, unused, workSpace, w, y, return_addr);
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+        }
+        else if(num_kernels == 1)
+        {
+            if(kernel.GetName() == "gcnAsmConv1x1U")
+            {
+                int unused       = 0;
+                int* return_addr = nullptr;
+                int N, C, H, W, K, n_groups;
+                construct_params.getCompiledInParameters(&N, &C, &H, &W, &K, &n_groups);
+                kernel(N, C, H, W, K, n_groups, unused, unused, x, w, y, return_addr);
+            }
+            else
+            {
+                kernel(x, w, y, as_float(padding_val));
+            }
+            if(handle.IsProfilingEnabled())
+                elapsed += handle.GetKernelTime();
+        }
+        else
+        {
+            MIOPEN_THROW("Error running Direct Forward convolution (none workspace?)");
+        }
+        if(handle.IsProfilingEnabled())
+        {
+            handle.ResetKernelTime();
+            handle.AccumKernelTime(elapsed);
+        }
+    });
+}
+
 void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                                                const void* alpha,
                                                const TensorDescriptor& xDesc,
@@ -934,6 +1327,53 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         MIOPEN_THROW(miopenStatusNotImplemented, "Only alpha=1 and beta=0 is supported");
     }
 
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(staging.Any())
+    {
+#if MIOPEN_USE_GEMM
+        if(algo == miopenConvolutionFwdAlgoGEMM &&
+           IsChannelsLast1x1GemmApplicable(*this, xDesc, wDesc, yDesc))
+        {
+            MIOPEN_LOG_FUNCTION("convolution, 1x1, channels-last");
+            ValidateGroupCount(xDesc, wDesc, *this);
+            const auto gemm_status =
+                CallGemm(handle,
+                         CreateGemmDescriptorConvChannelsLast1x1Fwd(wDesc, xDesc, yDesc),
+                         x,
+                         0,
+                         w,
+                         0,
+                         y,
+                         0,
+                         nullptr,
+                         false);
+            if(gemm_status == miopenStatusSuccess)
+                return;
+            // As in Find, a failed native GEMM falls back to the GEMM on staged copies
+            MIOPEN_LOG_W("Channels-last 1x1 GEMM failed, using staged NCHW copies");
+        }
+#endif
+        if(workSpaceSize < staging.Size())
+            MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for channels-last tensors");
+        const auto xs = staging.In(handle, 0, x, workSpace);
+        const auto ws = staging.In(handle, 1, w, workSpace);
+        const auto ys = staging.Out(handle, 2, y, workSpace);
+        ConvolutionForward(handle,
+                           alpha,
+                           staging.Desc(0),
+                           xs,
+                           staging.Desc(1),
+                           ws,
+                           algo,
+                           beta,
+                           staging.Desc(2),
+                           ys,
+                           staging.Rest(handle, workSpace, workSpaceSize),
+                           staging.RestSize(workSpaceSize));
+        staging.Commit(handle, 2, y);
+        return;
+    }
+
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsInput(handle, xDesc, x);
@@ -955,86 +1395,19 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             construct_params.mloBuildConf_Key(network_config);
 
             auto&& kernels = handle.GetKernels("miopenConvolutionFwdAlgoDirect", network_config);
-#if(!defined(__GNUC__) || defined(__clang__)) // w/a for segfault in gcc 5.4.0
-            const
-#endif
-                auto num_kernels = kernels.size();
             if(kernels.empty())
                 MIOPEN_THROW(
                     "Error running Direct Forward convolution. Was Find() executed previously?");
 
-            auto kernel = kernels[0];
-
-            visit_float(xDesc.GetType(), [&](auto as_float) {
-                // Miminum checks. Only check what is required to select
-                // proper invocation procedure & workspace sanity.
-                float padding_val = 0;
-                float elapsed     = 0;
-                if((kernel.GetName() == "MIOpenCvFwd11x11") && num_kernels == 2)
-                {
-                    kernel(x, w, y, as_float(padding_val));
-                    if(handle.IsProfilingEnabled())
-                        elapsed += handle.GetKernelTime();
-
-                    kernels[1](x, w, y, as_float(padding_val));
-                    if(handle.IsProfilingEnabled())
-                        elapsed += handle.GetKernelTime();
-                }
-                else if(num_kernels == 2 && workSpace != nullptr && workSpaceSize != 0)
-                {
-                    assert(kernel.GetName() == "SubSample");
-                    kernel(x, workSpace);
-                    if(handle.IsProfilingEnabled())
-                        elapsed += handle.GetKernelTime();
-
-                    assert(kernels[1].GetName() == "gcnAsmConv1x1U");
-                    int unused       = 0;
-                    int* return_addr = nullptr;
-                    int N, C, H, W, K, n_groups, out_H, out_W;
-                    construct_params.getCompiledInParameters(
-                        &N, &C, &H, &W, &K, &n_groups, &out_H, &out_W);
-                    kernels[1](N,
-                               C,
-                               out_H,
-                               out_W,
-                               K,
-                               n_groups,
-                               unused,
-                               unused,
-                               workSpace,
-                               w,
-                               y,
-                               return_addr);
-                    if(handle.IsProfilingEnabled())
-                        elapsed += handle.GetKernelTime();
-                }
-                else if(num_kernels == 1)
-                {
-                    if(kernel.GetName() == "gcnAsmConv1x1U")
-                    {
-                        int unused       = 0;
-                        int* return_addr = nullptr;
-                        int N, C, H, W, K, n_groups;
-                        construct_params.getCompiledInParameters(&N, &C, &H, &W, &K, &n_groups);
-                        kernel(N, C, H, W, K, n_groups, unused, unused, x, w, y, return_addr);
-                    }
-                    else
-                    {
-                        kernel(x, w, y, as_float(padding_val));
-                    }
-                    if(handle.IsProfilingEnabled())
-                        elapsed += handle.GetKernelTime();
-                }
-                else
-                {
-                    MIOPEN_THROW("Error running Direct Forward convolution (none workspace?)");
-                }
-                if(handle.IsProfilingEnabled())
-                {
-                    handle.ResetKernelTime();
-                    handle.AccumKernelTime(elapsed);
-                }
-            });
+            RunFwdDirectKernels(handle,
+                                construct_params,
+                                kernels,
+                                xDesc.GetType(),
+                                x,
+                                w,
+                                y,
+                                workSpace,
+                                workSpaceSize);
         }
         break;
 
@@ -1109,14 +1482,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
             auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
             auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 2, 2 + spatial_dim);
 
-            // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR for
-            // 1x1_stride=2
-            if(GetSpatialDimension() == 2 &&
-               (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-                miopen::all_of(GetConvPads(), [](auto v) { return v == 0; })) &&
-               ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-                 miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; })) ||
-                miopen::all_of(GetConvStrides(), [](auto v) { return v == 2; })))
+            const auto gemm_path = GetFwdGemmPath(*this, xDesc, wDesc);
+            if(gemm_path == FwdGemmPath::Transpose1x1)
             {
                 if(group_count > 1)
                 {
@@ -1238,9 +1605,7 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                     handle.AccumKernelTime(t1);
                 }
             }
-            else if(miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-                    miopen::all_of(GetConvPads(), [](auto v) { return v == 0; }) &&
-                    miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; }))
+            else if(gemm_path == FwdGemmPath::Plain1x1)
             {
                 if(group_count > 1)
                 {
@@ -1248,7 +1613,6 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
 
                     GemmDescriptor gemm_desc =
                         CreateGemmDescriptorGroupConvFwd(wDesc, xDesc, yDesc, group_count);
-                    float time_0 = 0;
 
                     std::size_t out_spatial_size = std::accumulate(out_spatial.begin(),
                                                                    out_spatial.end(),
@@ -1260,21 +1624,40 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
                                                                   std::size_t(1),
                                                                   std::multiplies<std::size_t>());
 
-                    for(std::size_t i = 0; i < in_n; i++)
+                    // One GEMM per (image, group). Ordering them so that the longer dimension
+                    // is innermost lets CallGemmGrouped submit min(in_n, group_count)
+                    // strided batched calls.
+                    GemmDescriptor single_desc = gemm_desc;
+                    single_desc.batch_count    = 1;
+
+                    std::vector<GemmGroupMember> members;
+                    members.reserve(in_n * group_count);
+                    const bool images_inner = in_n > static_cast<std::size_t>(group_count);
+                    for(std::size_t outer = 0; outer < (images_inner ? group_count : in_n);
+                        outer++)
                     {
-                        std::size_t out_offset = i * wei_k * out_spatial_size;
-
-                        std::size_t in_offset = i * in_c * in_spatial_size;
-
-                        CallGemmStridedBatched(
-                            handle, gemm_desc, w, 0, x, in_offset, y, out_offset, nullptr, false);
-                        if(handle.IsProfilingEnabled())
+                        for(std::size_t inner = 0; inner < (images_inner ? in_n : group_count);
+                            inner++)
                         {
-                            if(i == in_n - 1)
-                                handle.AccumKernelTime(time_0);
-                            time_0 += handle.GetKernelTime();
+                            const std::size_t i = images_inner ? inner : outer;
+                            const std::size_t g = images_inner ? outer : inner;
+
+                            const std::size_t out_offset =
+                                i * wei_k * out_spatial_size + g * gemm_desc.strideC;
+                            const std::size_t in_offset =
+                                i * in_c * in_spatial_size + g * gemm_desc.strideB;
+
+                            members.push_back({single_desc,
+                                               w,
+                                               static_cast<int>(g * gemm_desc.strideA),
+                                               x,
+                                               static_cast<int>(in_offset),
+                                               y,
+                                               static_cast<int>(out_offset)});
                         }
                     }
+
+                    CallGemmGrouped(handle, members, false);
                 }
                 else
                 {
@@ -1512,6 +1895,424 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
     }
 }
 
+// Solution ids of immediate mode are 1-based indices into this list. Append only, so that ids
+// stay valid across versions.
+static const std::vector<std::string>& FwdSolverIds()
+{
+    static const std::vector<std::string> ids = {
+        "gemm",
+        "fft",
+        solver::SolverDbId(solver::ConvBinWinograd3x3U{}),
+        solver::SolverDbId(solver::ConvBinWinogradRxS{}),
+        solver::SolverDbId(solver::ConvAsm3x3U{}),
+        solver::SolverDbId(solver::ConvAsm1x1U{}),
+        solver::SolverDbId(solver::ConvAsm5x10u2v2f1{}),
+        solver::SolverDbId(solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1{}),
+        solver::SolverDbId(solver::ConvAsm5x10u2v2b1{}),
+        solver::SolverDbId(solver::ConvOclDirectFwd11x11{}),
+        solver::SolverDbId(solver::ConvOclDirectFwdGen{}),
+        solver::SolverDbId(solver::ConvOclDirectFwd3x3{}),
+        solver::SolverDbId(solver::ConvOclDirectFwd1x1{}),
+        solver::SolverDbId(solver::ConvOclDirectFwd{}),
+    };
+    return ids;
+}
+
+static std::uint64_t FwdSolutionId(const std::string& solver_id)
+{
+    const auto& ids = FwdSolverIds();
+    const auto it   = std::find(ids.begin(), ids.end(), solver_id);
+    if(it == ids.end())
+        MIOPEN_THROW("Solver has no solution id: " + solver_id);
+    return std::distance(ids.begin(), it) + 1;
+}
+
+static const std::string& FwdSolverId(std::uint64_t solution_id)
+{
+    const auto& ids = FwdSolverIds();
+    if(solution_id == 0 || solution_id > ids.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid solution id: " + std::to_string(solution_id));
+    return ids[solution_id - 1];
+}
+
+static miopenConvFwdAlgorithm_t FwdSolutionAlgorithm(const std::string& solver_id)
+{
+    if(solver_id == "gemm")
+        return miopenConvolutionFwdAlgoGEMM;
+    if(solver_id == "fft")
+        return miopenConvolutionFwdAlgoFFT;
+    if(solver_id == solver::SolverDbId(solver::ConvBinWinograd3x3U{}) ||
+       solver_id == solver::SolverDbId(solver::ConvBinWinogradRxS{}))
+        return miopenConvolutionFwdAlgoWinograd;
+    return miopenConvolutionFwdAlgoDirect;
+}
+
+// Immediate mode caches the kernels of each direct solver separately, since Find keeps only the
+// fastest one under the algorithm's key.
+static std::string FwdImmediateDirectKey(const std::string& solver_id)
+{
+    return "miopenConvolutionFwdAlgoDirect:" + solver_id;
+}
+
+// Workspace sizes of the solutions whose kernels immediate mode has compiled, so that a call
+// served from the kernel cache does not have to search the solvers again.
+struct ImmediateWorkspaceKey
+{
+    std::size_t device;
+    std::string algorithm_name;
+    std::string network_config;
+
+    bool operator==(const ImmediateWorkspaceKey& other) const
+    {
+        return device == other.device && algorithm_name == other.algorithm_name &&
+               network_config == other.network_config;
+    }
+};
+
+struct ImmediateWorkspaceKeyHash
+{
+    std::size_t operator()(const ImmediateWorkspaceKey& key) const
+    {
+        return key.device ^ SimpleHash{}(std::make_pair(key.algorithm_name, key.network_config));
+    }
+};
+
+struct ImmediateWorkspaces
+{
+    std::shared_timed_mutex mutex;
+    std::unordered_map<ImmediateWorkspaceKey, std::size_t, ImmediateWorkspaceKeyHash> sizes;
+};
+
+static ImmediateWorkspaces& immediate_workspaces()
+{
+    static ImmediateWorkspaces workspaces;
+    return workspaces;
+}
+
+static bool GetImmediateWorkspace(const ImmediateWorkspaceKey& key, std::size_t& size)
+{
+    auto& workspaces = immediate_workspaces();
+    std::shared_lock<std::shared_timed_mutex> lock(workspaces.mutex);
+    const auto it = workspaces.sizes.find(key);
+    if(it == workspaces.sizes.end())
+        return false;
+    size = it->second;
+    return true;
+}
+
+static void SetImmediateWorkspace(const ImmediateWorkspaceKey& key, std::size_t size)
+{
+    auto& workspaces = immediate_workspaces();
+    std::unique_lock<std::shared_timed_mutex> lock(workspaces.mutex);
+    workspaces.sizes[key] = size;
+}
+
+#if MIOPEN_USE_GEMM
+static std::size_t FwdGemmWorkSpaceSize(const ConvolutionDescriptor& conv,
+                                        const TensorDescriptor& xDesc,
+                                        const TensorDescriptor& wDesc,
+                                        const TensorDescriptor& yDesc)
+{
+    switch(GetFwdGemmPath(conv, xDesc, wDesc))
+    {
+    case FwdGemmPath::Transpose1x1: return conv.ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
+    case FwdGemmPath::Plain1x1: return 0;
+    case FwdGemmPath::Im2Col: break;
+    }
+    return conv.ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * conv.group_count;
+}
+#endif
+
+std::vector<miopenConvSolution_t>
+ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
+                                           const TensorDescriptor& wDesc,
+                                           const TensorDescriptor& xDesc,
+                                           const TensorDescriptor& yDesc) const
+{
+    MIOPEN_LOG_I2("");
+    if(mode == miopenTranspose)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Immediate mode does not support transpose convolutions");
+
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(staging.Any())
+    {
+        auto solutions =
+            GetForwardSolutions(handle, staging.Desc(1), staging.Desc(0), staging.Desc(2));
+        for(auto&& solution : solutions)
+            solution.workspace_size += staging.Size();
+        return solutions;
+    }
+
+    ValidateGroupCount(xDesc, wDesc, *this);
+
+    const ProblemDescription problem(xDesc, wDesc, yDesc, *this, 1);
+    const auto measured = FindDb::Peek(handle, problem);
+    const auto features = ConvCostFeatures::From(problem, &handle);
+    const auto model    = GetConvCostModel();
+
+    std::vector<miopenConvSolution_t> solutions;
+    const auto add = [&](miopenConvFwdAlgorithm_t algorithm,
+                         const std::string& solver_id,
+                         std::size_t workspace) {
+        const auto record = std::find_if(measured.begin(), measured.end(), [&](const auto& m) {
+            return m.solver_id == solver_id;
+        });
+        miopenConvSolution_t solution;
+        solution.time           = record != measured.end() ? record->time
+                                                           : model->Estimate(features, solver_id);
+        solution.workspace_size = workspace;
+        solution.solution_id    = FwdSolutionId(solver_id);
+        solution.algorithm      = algorithm;
+        solutions.push_back(solution);
+    };
+
+#if MIOPEN_USE_GEMM
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
+        add(miopenConvolutionFwdAlgoGEMM, "gemm", FwdGemmWorkSpaceSize(*this, xDesc, wDesc, yDesc));
+#endif
+
+    const bool is_int8 = xDesc.GetType() == miopenInt8 || xDesc.GetType() == miopenInt8x4;
+    if(!is_int8 && GetSpatialDimension() == 2)
+    {
+        if(group_count == 1)
+        {
+            try
+            {
+                mlo_construct_winograd construct_params(xDesc, wDesc, yDesc, *this, 1);
+                construct_params.setStream(&handle);
+                const auto solution = FindFirstSolution(construct_params);
+                if(solution.Succeeded())
+                    add(miopenConvolutionFwdAlgoWinograd, solution.solver_id, 0);
+            }
+            catch(miopen::Exception&)
+            {
+            }
+        }
+
+        std::string network_config;
+        ExtraKernelArgs eka;
+        for(const auto& solution : FindDataDirectSolutions(
+                handle, xDesc, wDesc, yDesc, false, true, network_config, eka))
+            add(miopenConvolutionFwdAlgoDirect, solution.solver_id, solution.workspce_sz);
+
+        const auto workspace_fft = ForwardGetWorkSpaceSizeFFT(wDesc, xDesc, yDesc);
+        if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_FFT{}) && workspace_fft != 0 &&
+           group_count == 1 && miopen::all_of(GetConvDilations(), [](auto v) { return v == 1; }))
+            add(miopenConvolutionFwdAlgoFFT, "fft", workspace_fft);
+    }
+
+    std::sort(solutions.begin(), solutions.end(), [](const auto& l, const auto& r) {
+        return l.time < r.time;
+    });
+    return solutions;
+}
+
+std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handle,
+                                                                   const TensorDescriptor& wDesc,
+                                                                   const TensorDescriptor& xDesc,
+                                                                   const TensorDescriptor& yDesc,
+                                                                   std::uint64_t solution_id) const
+{
+    MIOPEN_LOG_I2("solution_id = " << solution_id);
+    for(const auto& solution : GetForwardSolutions(handle, wDesc, xDesc, yDesc))
+        if(solution.solution_id == solution_id)
+            return solution.workspace_size;
+    MIOPEN_THROW(miopenStatusBadParm,
+                 "Solution is not applicable: " + FwdSolverId(solution_id));
+}
+
+void ConvolutionDescriptor::CompileForwardSolution(Handle& handle,
+                                                   const TensorDescriptor& wDesc,
+                                                   const TensorDescriptor& xDesc,
+                                                   const TensorDescriptor& yDesc,
+                                                   std::uint64_t solution_id) const
+{
+    MIOPEN_LOG_I2("solution_id = " << solution_id);
+    if(mode == miopenTranspose)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Immediate mode does not support transpose convolutions");
+
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(staging.Any())
+    {
+        CompileForwardSolution(
+            handle, staging.Desc(1), staging.Desc(0), staging.Desc(2), solution_id);
+        return;
+    }
+
+    const auto& solver_id = FwdSolverId(solution_id);
+    switch(FwdSolutionAlgorithm(solver_id))
+    {
+    case miopenConvolutionFwdAlgoGEMM:
+        // GEMM kernels are built by the GEMM backend on first use
+        break;
+
+    case miopenConvolutionFwdAlgoDirect:
+    {
+        std::string network_config;
+        ExtraKernelArgs eka;
+        const auto all = FindDataDirectSolutions(
+            handle, xDesc, wDesc, yDesc, false, true, network_config, eka);
+        const auto solution = std::find_if(
+            all.begin(), all.end(), [&](const auto& s) { return s.solver_id == solver_id; });
+        if(solution == all.end())
+            MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+        const auto algorithm_name = FwdImmediateDirectKey(solver_id);
+        AddKernels(handle, algorithm_name, network_config, *solution, nullptr);
+        SetImmediateWorkspace({handle.GetDbPathHash(), algorithm_name, network_config},
+                              solution->workspce_sz);
+    }
+    break;
+
+    case miopenConvolutionFwdAlgoWinograd:
+    {
+        WinogradKernelParams k_p;
+        KernelInvoke kernel;
+        std::string found;
+        if(FindWinogradKernel<mlo_construct_winograd>(
+               handle, xDesc, wDesc, yDesc, k_p, kernel, found, 1) != 0 ||
+           found != solver_id)
+            MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+    }
+    break;
+
+    case miopenConvolutionFwdAlgoFFT:
+    {
+        std::vector<KernelInvoke> kernels;
+        std::string kcache_key;
+        const auto workspace_fft = ForwardGetWorkSpaceSizeFFT(wDesc, xDesc, yDesc);
+        if(FindFwdFFTKernel(handle, xDesc, wDesc, yDesc, workspace_fft, kernels, kcache_key) != 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+    }
+    break;
+    }
+}
+
+void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
+                                                        const TensorDescriptor& wDesc,
+                                                        ConstData_t w,
+                                                        const TensorDescriptor& xDesc,
+                                                        ConstData_t x,
+                                                        const TensorDescriptor& yDesc,
+                                                        Data_t y,
+                                                        Data_t workSpace,
+                                                        std::size_t workSpaceSize,
+                                                        std::uint64_t solution_id) const
+{
+    MIOPEN_LOG_I2("solution_id = " << solution_id << ", workspace = " << workSpaceSize);
+    if(x == nullptr || w == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
+    if(mode == miopenTranspose)
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Immediate mode does not support transpose convolutions");
+
+    const auto& solver_id = FwdSolverId(solution_id);
+    const auto algo       = FwdSolutionAlgorithm(solver_id);
+    LayoutStaging staging{{xDesc, wDesc, yDesc}};
+    if(algo != miopenConvolutionFwdAlgoDirect)
+    {
+        // ConvolutionForward() finds these kernels under the keys Find uses
+        if(algo == miopenConvolutionFwdAlgoWinograd && !staging.Any())
+        {
+            mlo_construct_winograd construct_params(xDesc, wDesc, yDesc, *this, 1);
+            construct_params.setStream(&handle);
+            std::string network_config;
+            construct_params.mloBuildConf_Key(network_config);
+            if(!handle.HasKernel("miopenConvolutionFwdAlgoWinograd", network_config))
+                CompileForwardSolution(handle, wDesc, xDesc, yDesc, solution_id);
+        }
+        else if(algo != miopenConvolutionFwdAlgoGEMM)
+        {
+            // Programs are cached, so this only recreates the kernel objects
+            CompileForwardSolution(handle, wDesc, xDesc, yDesc, solution_id);
+        }
+        const float alpha = 1;
+        const float beta  = 0;
+        ConvolutionForward(
+            handle, &alpha, xDesc, x, wDesc, w, algo, &beta, yDesc, y, workSpace, workSpaceSize);
+        return;
+    }
+
+    if(staging.Any())
+    {
+        if(workSpaceSize < staging.Size())
+            MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for channels-last tensors");
+        const auto xs = staging.In(handle, 0, x, workSpace);
+        const auto ws = staging.In(handle, 1, w, workSpace);
+        const auto ys = staging.Out(handle, 2, y, workSpace);
+        ConvolutionForwardImmediate(handle,
+                                    staging.Desc(1),
+                                    ws,
+                                    staging.Desc(0),
+                                    xs,
+                                    staging.Desc(2),
+                                    ys,
+                                    staging.Rest(handle, workSpace, workSpaceSize),
+                                    staging.RestSize(workSpaceSize),
+                                    solution_id);
+        staging.Commit(handle, 2, y);
+        return;
+    }
+
+    if(xDesc.GetType() == miopenInt8 || xDesc.GetType() == miopenInt8x4)
+        MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+
+    if(miopen::CheckNumericsEnabled() != 0)
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        miopen::checkNumericsInput(handle, wDesc, w);
+    }
+
+    ValidateGroupCount(xDesc, wDesc, *this);
+    if(GetSpatialDimension() != 2)
+        MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+
+    mlo_construct_direct2D construct_params(xDesc, wDesc, yDesc, *this, 1);
+    construct_params.setStream(&handle);
+
+    std::string network_config;
+    construct_params.mloBuildConf_Key(network_config);
+    const auto algorithm_name = FwdImmediateDirectKey(solver_id);
+    const ImmediateWorkspaceKey workspace_key{
+        handle.GetDbPathHash(), algorithm_name, network_config};
+
+    // The solvers are searched only until the solution has been compiled
+    std::size_t workspace_req = 0;
+    if(!handle.HasKernel(algorithm_name, network_config) ||
+       !GetImmediateWorkspace(workspace_key, workspace_req))
+    {
+        ExtraKernelArgs eka;
+        const auto all =
+            FindDataDirectSolutions(handle, xDesc, wDesc, yDesc, false, true, network_config, eka);
+        const auto solution = std::find_if(
+            all.begin(), all.end(), [&](const auto& s) { return s.solver_id == solver_id; });
+        if(solution == all.end())
+            MIOPEN_THROW(miopenStatusBadParm, "Solution is not applicable: " + solver_id);
+        if(!handle.HasKernel(algorithm_name, network_config))
+            AddKernels(handle, algorithm_name, network_config, *solution, nullptr);
+        workspace_req = solution->workspce_sz;
+        SetImmediateWorkspace(workspace_key, workspace_req);
+    }
+    if(workspace_req != 0 && (workSpace == nullptr || workSpaceSize < workspace_req))
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Workspace is too small for " + solver_id + ", it requires " +
+                         std::to_string(workspace_req) + " bytes");
+
+    RunFwdDirectKernels(handle,
+                        construct_params,
+                        handle.GetKernels(algorithm_name, network_config),
+                        xDesc.GetType(),
+                        x,
+                        w,
+                        y,
+                        workSpace,
+                        workSpaceSize);
+
+    if(miopen::CheckNumericsEnabled() != 0)
+        miopen::checkNumericsOutput(handle, yDesc, y);
+}
+
 // FindBackwardDataAlgorithm()
 //
 void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
@@ -1528,7 +2329,9 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
                                                      size_t workSpaceSize,
                                                      bool exhaustiveSearch) const
 {
+    MIOPEN_TRACE_SCOPE("find", "ConvolutionDescriptor::FindConvBwdDataAlgorithm");
     MIOPEN_LOG_I2("");
+    const TuningSession::Scope tuning_session;
     if(dx == nullptr || w == nullptr || dy == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
     if(returnedAlgoCount == nullptr)
@@ -1542,6 +2345,34 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
     *returnedAlgoCount = 0;
 
+    LayoutStaging staging{{dyDesc, wDesc, dxDesc}};
+    if(staging.Any())
+    {
+        const auto perf = FindStaged(
+            handle,
+            staging,
+            dy,
+            w,
+            dx,
+            [&](auto s0, auto s1, auto s2, int n, int* count, auto res) {
+                FindConvBwdDataAlgorithm(handle,
+                                         staging.Desc(0),
+                                         s0,
+                                         staging.Desc(1),
+                                         s1,
+                                         staging.Desc(2),
+                                         s2,
+                                         n,
+                                         count,
+                                         res,
+                                         workSpace,
+                                         staging.RestSize(workSpaceSize),
+                                         exhaustiveSearch);
+            });
+        ReturnPerfResults(perf, requestAlgoCount, returnedAlgoCount, perfResults);
+        return;
+    }
+
     // create a dummy buffer for use as output for the kernel calls
     // because kernels are called purely for timing purposes
     auto tmp_dx = handle.Create(dxDesc.GetElementSize() * GetTypeSize(dxDesc.GetType()));
@@ -1982,6 +2813,30 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
 
+    LayoutStaging staging{{dyDesc, wDesc, dxDesc}};
+    if(staging.Any())
+    {
+        if(workSpaceSize < staging.Size())
+            MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for channels-last tensors");
+        const auto s0 = staging.In(handle, 0, dy, workSpace);
+        const auto s1 = staging.In(handle, 1, w, workSpace);
+        const auto s2 = staging.Out(handle, 2, dx, workSpace);
+        ConvolutionBackwardData(handle,
+                                alpha,
+                                staging.Desc(0),
+                                s0,
+                                staging.Desc(1),
+                                s1,
+                                algo,
+                                beta,
+                                staging.Desc(2),
+                                s2,
+                                staging.Rest(handle, workSpace, workSpaceSize),
+                                staging.RestSize(workSpaceSize));
+        staging.Commit(handle, 2, dx);
+        return;
+    }
+
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsInput(handle, dyDesc, dy);
@@ -2513,7 +3368,9 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                                                         size_t workSpaceSize,
                                                         bool exhaustiveSearch) const
 {
+    MIOPEN_TRACE_SCOPE("find", "ConvolutionDescriptor::FindConvBwdWeightsAlgorithm");
     MIOPEN_LOG_I2("");
+    const TuningSession::Scope tuning_session;
     if(x == nullptr || dw == nullptr || dy == nullptr)
         MIOPEN_THROW(miopenStatusBadParm, "Buffers cannot be NULL");
     if(returnedAlgoCount == nullptr)
@@ -2527,6 +3384,34 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
 
     *returnedAlgoCount = 0;
 
+    LayoutStaging staging{{dyDesc, xDesc, dwDesc}};
+    if(staging.Any())
+    {
+        const auto perf = FindStaged(
+            handle,
+            staging,
+            dy,
+            x,
+            dw,
+            [&](auto s0, auto s1, auto s2, int n, int* count, auto res) {
+                FindConvBwdWeightsAlgorithm(handle,
+                                            staging.Desc(0),
+                                            s0,
+                                            staging.Desc(1),
+                                            s1,
+                                            staging.Desc(2),
+                                            s2,
+                                            n,
+                                            count,
+                                            res,
+                                            workSpace,
+                                            staging.RestSize(workSpaceSize),
+                                            exhaustiveSearch);
+            });
+        ReturnPerfResults(perf, requestAlgoCount, returnedAlgoCount, perfResults);
+        return;
+    }
+
     // create a dummy buffer for use as output for the kernel calls
     // because kernels are called purely for timing purposes
     auto tmp_dw = handle.Create(dwDesc.GetElementSize() * GetTypeSize(dwDesc.GetType()));
@@ -2863,6 +3748,30 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
         MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
     }
 
+    LayoutStaging staging{{dyDesc, xDesc, dwDesc}};
+    if(staging.Any())
+    {
+        if(workSpaceSize < staging.Size())
+            MIOPEN_THROW(miopenStatusBadParm, "Workspace is too small for channels-last tensors");
+        const auto s0 = staging.In(handle, 0, dy, workSpace);
+        const auto s1 = staging.In(handle, 1, x, workSpace);
+        const auto s2 = staging.Out(handle, 2, dw, workSpace);
+        ConvolutionBackwardWeights(handle,
+                                   alpha,
+                                   staging.Desc(0),
+                                   s0,
+                                   staging.Desc(1),
+                                   s1,
+                                   algo,
+                                   beta,
+                                   staging.Desc(2),
+                                   s2,
+                                   staging.Rest(handle, workSpace, workSpaceSize),
+                                   staging.RestSize(workSpaceSize));
+        staging.Commit(handle, 2, dw);
+        return;
+    }
+
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsInput(handle, dyDesc, dy);
@@ -66,6 +66,41 @@ std::vector<size_t> BiasFusionOpDescriptor::GetGlobalWGSz(Handle& /*handle*/,
     MIOPEN_THROW("Op does not support global workgroup size");
 }
 
+miopenStatus_t TensorAddFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
+                                                             Handle& /*handle*/)
+{
+    network_config += "addOn";
+    return miopenStatusSuccess;
+}
+
+miopenStatus_t
+TensorAddFusionOpDescriptor::GetCompileParms(std::string& compile_config,
+                                             Handle& /*handle*/,
+                                             FusionKernelSourceType source,
+                                             const std::vector<solver::AnySolver>& /*solvers*/)
+{
+    if(source != OpenclText)
+    {
+        MIOPEN_THROW("Invalid source file type");
+    }
+    std::string add = " -DMIOPEN_RESIDUAL_ADD=1";
+    MIOPEN_LOG_I2(add);
+    compile_config += add;
+    return miopenStatusSuccess;
+}
+
+std::vector<size_t> TensorAddFusionOpDescriptor::GetLocalWGSz(Handle& /*handle*/,
+                                                              std::string /*algorithm_name*/)
+{
+    MIOPEN_THROW("Op does not support local workgroup size");
+}
+
+std::vector<size_t> TensorAddFusionOpDescriptor::GetGlobalWGSz(Handle& /*handle*/,
+                                                               std::string /*algorithm_name*/)
+{
+    MIOPEN_THROW("Op does not support global workgroup size");
+}
+
 miopenStatus_t ActivFwdFusionOpDescriptor::GetNetworkConfig(std::string& network_config,
                                                             Handle& /*handle*/)
 {
@@ -34,9 +34,12 @@
 #include <miopen/load_file.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm_geometry.hpp>
 #endif
+#include <cassert>
+#include <mutex>
 #include <string>
 
 #ifndef _WIN32
@@ -261,11 +264,47 @@ struct HandleImpl
                                           &clReleaseContext>;
 
     ContextPtr context;
-    AqPtr queue;
+    // AddStream may grow queues while other threads launch work, so every access to it after
+    // construction holds streams_mutex
+    std::vector<AqPtr> queues;
+    std::mutex streams_mutex;
     Allocator allocator{};
     KernelCache cache;
-    bool enable_profiling  = false;
-    float profiling_result = 0.0;
+    std::mutex cache_mutex;
+    std::once_flag db_path_hash_once;
+    std::size_t db_path_hash = 0;
+    const std::size_t id = detail::NewHandleId();
+    const std::shared_ptr<const void> alive = std::make_shared<char>();
+
+    detail::ThreadHandleState& thread_state() const
+    {
+        return detail::GetThreadHandleState(id, alive);
+    }
+
+    // Callers hold streams_mutex
+    std::size_t active_stream() const
+    {
+        return queues.size() == 1 ? 0 : thread_state().active_stream;
+    }
+
+    AqPtr create_queue(cl_device_id device) const
+    {
+        cl_int status = 0;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+        AqPtr result{
+            clCreateCommandQueue(context.get(), device, CL_QUEUE_PROFILING_ENABLE, &status)};
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if(status != CL_SUCCESS)
+        {
+            MIOPEN_THROW("Creating Command Queue. (clCreateCommandQueue)");
+        }
+        return result;
+    }
 
     ContextPtr create_context()
     {
@@ -322,8 +361,8 @@ struct HandleImpl
         // do we need anything special to handle multiple GPUs
         cl_context ctx;
         cl_int status = 0;
-        status =
-            clGetCommandQueueInfo(queue.get(), CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, nullptr);
+        status = clGetCommandQueueInfo(
+            queues.front().get(), CL_QUEUE_CONTEXT, sizeof(cl_context), &ctx, nullptr);
         if(status != CL_SUCCESS)
         {
             MIOPEN_THROW_CL_STATUS(status,
@@ -332,17 +371,18 @@ struct HandleImpl
         clRetainContext(ctx);
         return ContextPtr{ctx};
     }
-    void ResetProfilingResult() { profiling_result = 0.0; }
-    void AccumProfilingResult(float curr_res) { profiling_result += curr_res; }
+    void ResetProfilingResult() { thread_state().profiling_result = 0.0; }
+    void AccumProfilingResult(float curr_res) { thread_state().profiling_result += curr_res; }
 
     void SetProfilingResult(cl_event& e)
     {
-        if(this->enable_profiling)
+        auto& state = thread_state();
+        if(state.enable_profiling)
         {
             size_t st, end;
             clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_START, sizeof(size_t), &st, nullptr);
             clGetEventProfilingInfo(e, CL_PROFILING_COMMAND_END, sizeof(size_t), &end, nullptr);
-            profiling_result = static_cast<float>(end - st) * 1.0e-6; // NOLINT
+            state.profiling_result = static_cast<float>(end - st) * 1.0e-6; // NOLINT
         }
     }
 };
@@ -350,7 +390,7 @@ struct HandleImpl
 Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
 {
     clRetainCommandQueue(stream);
-    impl->queue   = HandleImpl::AqPtr{stream};
+    impl->queues.emplace_back(stream);
     impl->context = impl->create_context_from_queue();
 
     this->SetAllocator(nullptr, nullptr, nullptr);
@@ -414,25 +454,17 @@ Handle::Handle() : impl(new HandleImpl())
     /////////////////////////////////////////////////////////////////
     // Create an OpenCL command queue
     /////////////////////////////////////////////////////////////////
-    cl_int status = 0;
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wdeprecated-declarations"
-#endif
-    impl->queue = HandleImpl::AqPtr{
-        clCreateCommandQueue(impl->context.get(), device, CL_QUEUE_PROFILING_ENABLE, &status)};
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
-    if(status != CL_SUCCESS)
-    {
-        MIOPEN_THROW("Creating Command Queue. (clCreateCommandQueue)");
-    }
+    impl->queues.push_back(impl->create_queue(device));
     this->SetAllocator(nullptr, nullptr, nullptr);
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+
+Handle::~Handle()
+{
+    if(impl != nullptr)
+        detail::EraseThreadHandleState(impl->id);
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -442,10 +474,87 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
     }
 
     clRetainCommandQueue(streamID);
-    impl->queue = HandleImpl::AqPtr{streamID};
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    impl->queues[impl->active_stream()] = HandleImpl::AqPtr{streamID};
+}
+
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->queues[impl->active_stream()].get();
+}
+
+std::size_t Handle::AddStream()
+{
+    cl_device_id device = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->streams_mutex);
+        device = miopen::GetDevice(impl->queues.front().get());
+    }
+    auto queue = impl->create_queue(device);
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    impl->queues.push_back(std::move(queue));
+    return impl->queues.size() - 1;
+}
+
+std::size_t Handle::AddStream(miopenAcceleratorQueue_t stream)
+{
+    if(stream == nullptr)
+        return this->AddStream();
+    if(miopen::GetContext(stream) != impl->context.get())
+        MIOPEN_THROW(miopenStatusBadParm, "Stream belongs to a different context");
+
+    clRetainCommandQueue(stream);
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    impl->queues.emplace_back(stream);
+    return impl->queues.size() - 1;
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
+std::size_t Handle::GetStreamCount() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->queues.size();
+}
+
+void Handle::SetActiveStream(std::size_t index) const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    if(index >= impl->queues.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Stream index out of range: " + std::to_string(index));
+    impl->thread_state().active_stream = index;
+}
+
+std::size_t Handle::GetActiveStream() const
+{
+    std::lock_guard<std::mutex> lock(impl->streams_mutex);
+    return impl->active_stream();
+}
+
+void Handle::StreamWaitStream(std::size_t waiting, std::size_t signalling) const
+{
+    cl_command_queue waiting_queue    = nullptr;
+    cl_command_queue signalling_queue = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->streams_mutex);
+        if(waiting >= impl->queues.size() || signalling >= impl->queues.size())
+            MIOPEN_THROW(miopenStatusBadParm, "Stream index out of range");
+        waiting_queue    = impl->queues[waiting].get();
+        signalling_queue = impl->queues[signalling].get();
+    }
+    if(waiting == signalling)
+        return;
+
+    cl_event ev   = nullptr;
+    cl_int status = clEnqueueMarkerWithWaitList(signalling_queue, 0, nullptr, &ev);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Recording stream marker failed");
+    status = clEnqueueBarrierWithWaitList(waiting_queue, 1, &ev, nullptr);
+    clReleaseEvent(ev);
+    if(status != CL_SUCCESS)
+        MIOPEN_THROW_CL_STATUS(status, "Waiting for stream marker failed");
+    // The marker has to reach the device before the barrier can observe it
+    clFlush(signalling_queue);
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
@@ -462,12 +571,25 @@ void Handle::SetAllocator(miopenAllocatorFunction allocator,
         allocatorContext == nullptr ? this->impl->context.get() : allocatorContext;
 }
 
-void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
+void Handle::EnableProfiling(bool enable)
+{
+    this->impl->thread_state().enable_profiling = enable;
+}
 
 void Handle::ResetKernelTime() { this->impl->ResetProfilingResult(); }
 void Handle::AccumKernelTime(float curr_time) { this->impl->AccumProfilingResult(curr_time); }
 
-float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+float Handle::GetKernelTime() const { return this->impl->thread_state().profiling_result; }
+
+const std::vector<FindSkipped>& Handle::GetFindSkipped() const
+{
+    return this->impl->thread_state().find_skipped;
+}
+
+void Handle::SetFindSkipped(std::vector<FindSkipped> skipped) const
+{
+    this->impl->thread_state().find_skipped = std::move(skipped);
+}
 
 KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& network_config,
@@ -478,33 +600,42 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
                                const std::string& params,
                                std::size_t cache_index)
 {
-
-    auto obj = this->impl->cache.AddKernel(
-        *this, algorithm, network_config, program_name, kernel_name, vld, vgd, params, cache_index);
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           this->impl->cache_mutex,
+                                           algorithm,
+                                           network_config,
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index);
     return this->Run(obj);
 }
 
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     return this->impl->cache.HasKernels(algorithm, network_config);
 }
 
 void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
-
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+std::vector<Kernel> Handle::GetKernelsImpl(const std::string& algorithm,
+                                           const std::string& network_config)
 {
+    std::lock_guard<std::mutex> lock(this->impl->cache_mutex);
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
 KernelInvoke Handle::Run(Kernel k)
 {
     auto q = this->GetStream();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
+    if(this->impl->thread_state().enable_profiling || MIOPEN_GPU_SYNC)
     {
         return k.Invoke(q,
                         std::bind(&HandleImpl::SetProfilingResult,
@@ -517,12 +648,22 @@ KernelInvoke Handle::Run(Kernel k)
     }
 }
 
+KernelInvoke Handle::Run(Kernel k, const std::vector<size_t>& vgd)
+{
+    assert(vgd.size() == k.GetGlobalDims().size());
+    auto invoke = this->Run(std::move(k));
+    std::copy(vgd.begin(), vgd.end(), invoke.global_work_dim.begin());
+    return invoke;
+}
+
 Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
 {
+    MIOPEN_TRACE_SCOPE("compile", [&] { return program_name; });
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
     if(cache_file.empty())
     {
+        MIOPEN_TRACE_SCOPE("build", [&] { return program_name; });
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
                                      program_name,
@@ -549,7 +690,10 @@ void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
-bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+bool Handle::IsProfilingEnabled() const
+{
+    return this->impl->thread_state().enable_profiling;
+}
 
 std::size_t Handle::GetLocalMemorySize()
 {
@@ -570,6 +714,14 @@ std::size_t Handle::GetMaxMemoryAllocSize()
     return m_MaxMemoryAllocSizeCached;
 }
 
+std::size_t Handle::GetDbPathHash()
+{
+    std::call_once(impl->db_path_hash_once, [&] {
+        impl->db_path_hash = std::hash<std::string>{}(this->GetDbPathFilename());
+    });
+    return impl->db_path_hash;
+}
+
 std::size_t Handle::GetMaxComputeUnits()
 {
     return miopen::GetDeviceInfo<CL_DEVICE_MAX_COMPUTE_UNITS>(miopen::GetDevice(this->GetStream()));
@@ -104,17 +104,14 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         MIOPEN_THROW("Expect non-zero bias/K");
 
     std::string algo_name = "miopenLRNForward";
-    std::string network_config =
-        std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) + std::to_string(f_norm_K) +
-        std::to_string(f_norm_alphaoverarea) + std::to_string(local_ar) +
-        std::to_string(norm_region) + std::to_string(static_cast<int>(do_backward)) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut);
-
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    // The build options do not depend on the batch size, which only affects vgd.
+    std::string network_config = std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) +
+                                 std::to_string(f_norm_K) + std::to_string(f_norm_alphaoverarea) +
+                                 construct_params.getKernelName() +
+                                 construct_params.getCompilerOptions();
+    const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config, vgd);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -146,7 +143,6 @@ miopenStatus_t LRNDescriptor::Forward(Handle& handle,
         const std::string& compiler_parms =
             construct_params.getCompilerOptions(); // kernel parameters
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
-        const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         KernelInvoke obj = handle.AddKernel(
             algo_name, network_config, program_name, kernel_name, vld, vgd, compiler_parms);
@@ -280,17 +276,12 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
         MIOPEN_THROW("Expect non-zero bias/K");
 
     std::string algo_name = "miopenLRNBackward";
-    std::string network_config =
-        std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) + std::to_string(norm_K) +
-        std::to_string(norm_alphaoverarea) + std::to_string(local_ar) +
-        std::to_string(norm_region) + std::to_string(f_norm_ratio) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut);
-
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    std::string network_config = std::to_string(f_norm_alpha) + std::to_string(f_norm_beta) +
+                                 std::to_string(f_norm_ratio) + construct_params.getKernelName() +
+                                 construct_params.getCompilerOptions();
+    const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config, vgd);
     if(!kernels.empty())
     {
         visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -312,7 +303,6 @@ miopenStatus_t LRNDescriptor::Backward(Handle& handle,
             construct_params.getCompilerOptions(); // kernel parameters
 
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
-        const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         visit_float(xDesc.GetType(), [&](auto as_float) {
             handle.AddKernel(
@@ -235,8 +235,6 @@ int mlo_construct_norm::mloConstructFwd()
         std::to_string(static_cast<long long>(bot_df_channel_stride)) +
         std::string(" -DMLO_LRN_BOTDF_STRIDE=") +
         std::to_string(static_cast<long long>(bot_df_stride)) +
-        std::string(" -DMLO_LRN_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(_search_params.batch_sz)) +
         std::string(" -DMLO_LRN_N_INPUTS=") +
         std::to_string(static_cast<long long>(_search_params.n_inputs)) +
         std::string(" -DMLO_LRN_N_OUTPUTS=") +
@@ -363,8 +361,6 @@ int mlo_construct_norm::mloConstructBwd()
         std::to_string(static_cast<long long>(_in_df_channel_stride)) +
         std::string(" -DMLO_LRN_BOTDF_STRIDE=") +
         std::to_string(static_cast<long long>(_in_df_stride)) +
-        std::string(" -DMLO_LRN_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(_search_params.batch_sz)) +
         std::string(" -DMLO_LRN_N_INPUTS=") +
         std::to_string(static_cast<long long>(_search_params.n_inputs)) +
         std::string(" -DMLO_LRN_N_OUTPUTS=") +
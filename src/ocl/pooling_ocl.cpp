@@ -111,34 +111,33 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     construct_params.setPoolingDescr(
         pooling_method, GetIndexType(), lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
+    // The batch size only affects the global work size, which is passed on each launch.
     std::string network_config =
         std::to_string(pooling_method) + std::to_string(static_cast<int>(save_index)) +
         std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut) + std::to_string(hInStride) + std::to_string(hOutStride) +
-        std::to_string(lens[0]) + std::to_string(lens[1]) + std::to_string(strides[0]) +
-        std::to_string(strides[1]) + std::to_string(pads[0]) + std::to_string(pads[1]) +
-        std::to_string(GetIndexType());
+        std::to_string(cIn) + std::to_string(cOut) + std::to_string(cInStride) +
+        std::to_string(cOutStride) + std::to_string(hIn) + std::to_string(hOut) +
+        std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(lens[0]) +
+        std::to_string(lens[1]) + std::to_string(strides[0]) + std::to_string(strides[1]) +
+        std::to_string(pads[0]) + std::to_string(pads[1]) + std::to_string(GetIndexType());
 
     std::string algo_name = "miopenPooling2dForward";
     // printf("Pooling forward network_config: %s\n", network_config.c_str());
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    construct_params.doBackward(save_index);
+    mloConstruct(construct_params);
+    const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config, vgd);
     if(!kernels.empty())
     {
         kernels.front()(x, y, workSpace);
     }
     else
     {
-        construct_params.doBackward(save_index);
-
-        mloConstruct(construct_params);
         std::string parms              = construct_params.getCompilerOptions(); // kernel parameters
         std::string program_name       = construct_params.getKernelFile(); // CL kernel filename
         std::string kernel_name        = construct_params.getKernelName(); // kernel name
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
-        const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
         handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
             x, y, workSpace);
@@ -264,17 +263,18 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
 
     std::string network_config =
         std::to_string(pooling_method) + std::to_string(xDesc.GetType()) +
-        std::to_string(nInStride) + std::to_string(nOutStride) + std::to_string(nIn) +
-        std::to_string(nOut) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(cIn) + std::to_string(cOut) + std::to_string(cInStride) +
-        std::to_string(cOutStride) + std::to_string(hIn) + std::to_string(hOut) +
-        std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(lens[0]) +
-        std::to_string(lens[1]) + std::to_string(strides[0]) + std::to_string(strides[1]) +
-        std::to_string(pads[0]) + std::to_string(pads[1]) + std::to_string(GetIndexType());
+        std::to_string(nInStride) + std::to_string(nOutStride) + std::to_string(cIn) +
+        std::to_string(cOut) + std::to_string(cInStride) + std::to_string(cOutStride) +
+        std::to_string(hIn) + std::to_string(hOut) + std::to_string(hInStride) +
+        std::to_string(hOutStride) + std::to_string(lens[0]) + std::to_string(lens[1]) +
+        std::to_string(strides[0]) + std::to_string(strides[1]) + std::to_string(pads[0]) +
+        std::to_string(pads[1]) + std::to_string(GetIndexType());
     // printf("Pooling backward network_config: %s\n", network_config.c_str());
     std::string algo_name = "miopenPooling2dBackward";
+    mloConstruct(construct_params);
+    const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
 
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
+    auto&& kernels = handle.GetKernels(algo_name, network_config, vgd);
     if(!kernels.empty())
     {
         if(mode == miopenPoolingMax)
@@ -288,10 +288,7 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     }
     else
     {
-
-        mloConstruct(construct_params);
         const std::vector<size_t>& vld = construct_params.getLocalWkSize();
-        const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
         std::string program_name       = construct_params.getKernelFile(); // CL kernel filename
         std::string kernel_name        = construct_params.getKernelName(); // kernel name
         std::string parms              = construct_params.getCompilerOptions(); // kernel parameters
@@ -40,6 +40,11 @@
 #include <numeric>
 #include <algorithm>
 
+#include <boost/optional.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_PLAN_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_PACKED_GEMM)
+
 namespace miopen {
 
 // Assuming sequence length is set to > 0 otherwise throw exception.
@@ -77,7 +82,6 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         MIOPEN_THROW("Workspace is required");
     }
 
-    std::string network_config;
     std::vector<int> in_n;
     int in_h  = xDesc[0].GetLengths()[1]; // input vector size
     int hy_d  = hyDesc.GetLengths()[0];   // biNumLayers
@@ -90,7 +94,6 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
-    int batch_n = 0;
     for(int i = 0; i < seqLen; i++)
     {
         int batchval, inputvec, batchvalout, outputvec;
@@ -119,16 +122,74 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             }
         }
         in_n.push_back(batchval);
-        batch_n += batchval;
     }
 
+    RNNPlanShape shape;
+    shape.seqLen          = seqLen;
+    shape.in_n            = in_n;
+    shape.in_h            = in_h;
+    shape.hy_d            = hy_d;
+    shape.hy_n            = hy_n;
+    shape.hy_h            = hy_h;
+    shape.out_h           = out_h;
+    shape.xType           = xDesc[0].GetType();
+    shape.wType           = wDesc.GetType();
+    shape.workSpaceSize   = workSpaceSize;
+    shape.has_hx          = hx != nullptr;
+    shape.has_cx          = cx != nullptr;
+    shape.has_hy          = hy != nullptr;
+    shape.has_cy          = cy != nullptr;
+    shape.pack_directions = !miopen::IsDisabled(MIOPEN_DEBUG_RNN_PACKED_GEMM{});
+
+    std::shared_ptr<const RNNPlan> plan;
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_RNN_PLAN_CACHE{}))
+        plan = planCache->Find(shape);
+    if(plan == nullptr)
+    {
+        MIOPEN_LOG_I2("Compiling RNN forward inference plan, seqLen = " << seqLen << ", batch = "
+                                                                         << in_n[0]);
+        plan = std::make_shared<const RNNPlan>(CompileForwardInferencePlan(shape));
+        if(!miopen::IsDisabled(MIOPEN_DEBUG_RNN_PLAN_CACHE{}))
+            planCache->Add(shape, plan);
+    }
+
+    RNNPlanArgs args;
+    args.x         = x;
+    args.hx        = hx;
+    args.cx        = cx;
+    args.w         = w;
+    args.y         = y;
+    args.hy        = hy;
+    args.cy        = cy;
+    args.workSpace = workSpace;
+    plan->Run(handle, args);
+}
+
+RNNPlan RNNDescriptor::CompileForwardInferencePlan(const RNNPlanShape& shape) const
+{
+    const int seqLen             = shape.seqLen;
+    const std::vector<int>& in_n = shape.in_n;
+    int in_h                     = shape.in_h;
+    const int hy_d               = shape.hy_d;
+    const int hy_n               = shape.hy_n;
+    const int hy_h               = shape.hy_h;
+    const int out_h              = shape.out_h;
+    const miopenDataType_t xType = shape.xType;
+    const miopenDataType_t wType = shape.wType;
+    const size_t workSpaceSize   = shape.workSpaceSize;
+    const bool has_hx            = shape.has_hx;
+    const bool has_cx            = shape.has_cx;
+    const bool has_hy            = shape.has_hy;
+    const bool has_cy            = shape.has_cy;
+    const int batch_n            = std::accumulate(in_n.begin(), in_n.end(), 0);
+    RNNPlan plan;
+
     int bi = dirMode != 0u ? 2 : 1;
     if(out_h != (bi * hy_h))
     {
         MIOPEN_THROW(miopenStatusBadParm, "Output size doesn't match hidden state size!");
     }
 
-    float ctime    = 0.;
     int in_stride  = in_h;
     int hy_stride  = hy_h * bi * static_cast<int>(workspaceScale);
     int out_stride = out_h;
@@ -156,13 +217,13 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         x_stride(3, 1), y_size(3, 1), y_stride(3, 1), hx_size(3, 1), hx_stride(3, 1);
     miopen::TensorDescriptor sp_desc, w_desc, x_desc, y_desc, hx_desc;
 
-    sp_size[2]   = workSpaceSize / GetTypeSize(wDesc.GetType());
+    sp_size[2]   = workSpaceSize / GetTypeSize(wType);
     sp_stride[0] = sp_size[2];
     sp_stride[1] = sp_size[2];
-    sp_desc      = miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-    SetTensor(handle, sp_desc, workSpace, &beta);
-    // Update time
-    profileRNNkernels(handle, 0, ctime);
+    sp_desc      = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
+    plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+        SetTensor(handle, sp_desc, args.workSpace, &beta);
+    });
     sp_stride[0] = batch_n * hy_stride;
     sp_stride[1] = hy_stride;
     sp_size[2]   = 1;
@@ -172,23 +233,23 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     x_stride[1]  = in_stride;
     y_stride[0]  = batch_n * out_stride;
     y_stride[1]  = out_stride;
-    if(hy != nullptr || (rnnMode == miopenLSTM && cy != nullptr))
+    if(has_hy || (rnnMode == miopenLSTM && has_cy))
     {
         hx_size[2]   = hy_d * hy_n * hy_h;
         hx_stride[0] = hx_size[2];
         hx_stride[1] = hx_size[2];
-        hx_desc = miopen::TensorDescriptor(wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
-        if(hy != nullptr)
+        hx_desc      = miopen::TensorDescriptor(wType, hx_size.data(), hx_stride.data(), 3);
+        if(has_hy)
         {
-            SetTensor(handle, hx_desc, hy, &beta);
-            // Update time
-            profileRNNkernels(handle, 1, ctime);
+            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                SetTensor(handle, hx_desc, args.hy, &beta);
+            });
         }
-        if(rnnMode == miopenLSTM && cy != nullptr)
+        if(rnnMode == miopenLSTM && has_cy)
         {
-            SetTensor(handle, hx_desc, cy, &beta);
-            // Update time
-            profileRNNkernels(handle, 1, ctime);
+            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                SetTensor(handle, hx_desc, args.cy, &beta);
+            });
         }
     }
     hx_stride[0] = in_n.at(0) * uni_stride;
@@ -232,6 +293,49 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         activDesc = {miopenActivationTANH, 1, 1, 1};
     }
 
+    // Recurrent GEMM reading either hx or the hidden state of the previous step.
+    const auto add_recurrent_gemm = [&plan](const GemmGroupMember& gemm, bool from_hx) {
+        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+            const ConstData_t A        = from_hx ? args.hx : args.workSpace;
+            miopenStatus_t gemm_status = gemm.gemm_desc.batch_count == 1
+                                             ? CallGemm(handle,
+                                                        gemm.gemm_desc,
+                                                        A,
+                                                        gemm.a_offset,
+                                                        args.w,
+                                                        gemm.b_offset,
+                                                        args.workSpace,
+                                                        gemm.c_offset,
+                                                        nullptr,
+                                                        false,
+                                                        GemmBackend_t::miopengemm)
+                                             : CallGemmStridedBatched(handle,
+                                                                      gemm.gemm_desc,
+                                                                      A,
+                                                                      gemm.a_offset,
+                                                                      args.w,
+                                                                      gemm.b_offset,
+                                                                      args.workSpace,
+                                                                      gemm.c_offset,
+                                                                      nullptr,
+                                                                      false,
+                                                                      GemmBackend_t::miopengemm);
+
+            if(gemm_status != miopenStatusSuccess)
+            {
+                if(gemm_status == miopenStatusNotImplemented)
+                {
+                    MIOPEN_LOG_E("GEMM not implemented");
+                }
+                else
+                {
+                    MIOPEN_LOG_E("GEMM failed");
+                }
+            }
+        });
+        plan.gemm_submissions++;
+    };
+
     for(int li = 0; li < nLayers; li++)
     {
         int hid_shift           = li * batch_n * hy_stride;
@@ -247,16 +351,14 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                 x_size[2]  = hy_h;
                 sp_size[1] = batch_n;
                 sp_size[2] = hy_h;
-                x_desc =
-                    miopen::TensorDescriptor(wDesc.GetType(), x_size.data(), x_stride.data(), 3);
-                sp_desc =
-                    miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                x_desc     = miopen::TensorDescriptor(wType, x_size.data(), x_stride.data(), 3);
+                sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
 
                 for(int gi = 0; gi < nHiddenTensorsPerLayer * bi; gi++)
                 {
-                    CopyTensor(handle, x_desc, x, sp_desc, workSpace, 0, gi * hy_h);
-                    // Update time
-                    profileRNNkernels(handle, 1, ctime);
+                    plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                        CopyTensor(handle, x_desc, args.x, sp_desc, args.workSpace, 0, gi * hy_h);
+                    });
                 }
             }
             else
@@ -276,33 +378,34 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                                   0, // Stride C
                                                                   1, // alpha
                                                                   1, // beta
-                                                                  xDesc[0].GetType()};
+                                                                  xType};
 
-                miopenStatus_t gemm_status = CallGemm(handle,
-                                                      gemm_desc,
-                                                      x,
-                                                      0,
-                                                      w,
-                                                      0,
-                                                      workSpace,
-                                                      hid_shift,
-                                                      nullptr,
-                                                      false,
-                                                      GemmBackend_t::miopengemm);
+                plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                    miopenStatus_t gemm_status = CallGemm(handle,
+                                                          gemm_desc,
+                                                          args.x,
+                                                          0,
+                                                          args.w,
+                                                          0,
+                                                          args.workSpace,
+                                                          hid_shift,
+                                                          nullptr,
+                                                          false,
+                                                          GemmBackend_t::miopengemm);
 
-                if(gemm_status != miopenStatusSuccess)
-                {
-                    if(gemm_status == miopenStatusNotImplemented)
-                    {
-                        MIOPEN_LOG_E("GEMM not implemented");
-                    }
-                    else
+                    if(gemm_status != miopenStatusSuccess)
                     {
-                        MIOPEN_LOG_E("GEMM failed");
+                        if(gemm_status == miopenStatusNotImplemented)
+                        {
+                            MIOPEN_LOG_E("GEMM not implemented");
+                        }
+                        else
+                        {
+                            MIOPEN_LOG_E("GEMM failed");
+                        }
                     }
-                }
-                // Update time
-                profileRNNkernels(handle, 1, ctime);
+                });
+                plan.gemm_submissions++;
             }
         }
         else
@@ -325,32 +428,33 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                               0, // Stride C
                                                               1, // alpha
                                                               1, // beta
-                                                              xDesc[0].GetType()};
-            miopenStatus_t gemm_status = CallGemm(handle,
-                                                  gemm_desc,
-                                                  workSpace,
-                                                  prelayer_shift,
-                                                  w,
-                                                  wei_shift,
-                                                  workSpace,
-                                                  hid_shift,
-                                                  nullptr,
-                                                  false,
-                                                  GemmBackend_t::miopengemm);
+                                                              xType};
+            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                miopenStatus_t gemm_status = CallGemm(handle,
+                                                      gemm_desc,
+                                                      args.workSpace,
+                                                      prelayer_shift,
+                                                      args.w,
+                                                      wei_shift,
+                                                      args.workSpace,
+                                                      hid_shift,
+                                                      nullptr,
+                                                      false,
+                                                      GemmBackend_t::miopengemm);
 
-            if(gemm_status != miopenStatusSuccess)
-            {
-                if(gemm_status == miopenStatusNotImplemented)
-                {
-                    MIOPEN_LOG_E("GEMM not implemented");
-                }
-                else
+                if(gemm_status != miopenStatusSuccess)
                 {
-                    MIOPEN_LOG_E("GEMM failed");
+                    if(gemm_status == miopenStatusNotImplemented)
+                    {
+                        MIOPEN_LOG_E("GEMM not implemented");
+                    }
+                    else
+                    {
+                        MIOPEN_LOG_E("GEMM failed");
+                    }
                 }
-            }
-            // Update time
-            profileRNNkernels(handle, 1, ctime);
+            });
+            plan.gemm_submissions++;
         }
 
         if(biasMode != 0u)
@@ -363,66 +467,64 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             w_size[2]  = wei_stride;
             sp_size[1] = batch_n;
             sp_size[2] = wei_stride;
-            w_desc = miopen::TensorDescriptor(wDesc.GetType(), w_size.data(), w_stride.data(), 3);
-            sp_desc =
-                miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+            w_desc     = miopen::TensorDescriptor(wType, w_size.data(), w_stride.data(), 3);
+            sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
 
-            OpTensor(handle,
-                     miopenTensorOpAdd,
-                     &alpha0,
-                     sp_desc,
-                     workSpace,
-                     &alpha1,
-                     w_desc,
-                     w,
-                     &beta_t,
-                     sp_desc,
-                     workSpace,
-                     hid_shift,
-                     wei_shift_bias_temp,
-                     hid_shift);
-            // Update time
-            profileRNNkernels(handle, 1, ctime);
+            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                OpTensor(handle,
+                         miopenTensorOpAdd,
+                         &alpha0,
+                         sp_desc,
+                         args.workSpace,
+                         &alpha1,
+                         w_desc,
+                         args.w,
+                         &beta_t,
+                         sp_desc,
+                         args.workSpace,
+                         hid_shift,
+                         wei_shift_bias_temp,
+                         hid_shift);
+            });
         }
 
         if(rnnMode == miopenGRU)
         {
             sp_size[1] = batch_n;
             sp_size[2] = hy_h;
-            sp_desc =
-                miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+            sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
 
             alpha0 = 0;
             alpha1 = 0;
             beta_t = 0;
             for(int bs = 0; bs < bi; bs++)
             {
-                CopyTensor(handle,
-                           sp_desc,
-                           workSpace,
-                           sp_desc,
-                           workSpace,
-                           hid_shift + bs * wei_len + 2 * hy_h,
-                           hid_shift + hid_off + bs * hy_h);
-                // Update time
-                profileRNNkernels(handle, 1, ctime);
-
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         sp_desc,
-                         workSpace,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift + bs * wei_len + 2 * hy_h,
-                         hid_shift + bs * wei_len + 2 * hy_h,
-                         hid_shift + bs * wei_len + 2 * hy_h);
-                // Update time
-                profileRNNkernels(handle, 1, ctime);
+                plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                    CopyTensor(handle,
+                               sp_desc,
+                               args.workSpace,
+                               sp_desc,
+                               args.workSpace,
+                               hid_shift + bs * wei_len + 2 * hy_h,
+                               hid_shift + hid_off + bs * hy_h);
+                });
+
+                plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha0,
+                             sp_desc,
+                             args.workSpace,
+                             &alpha1,
+                             sp_desc,
+                             args.workSpace,
+                             &beta_t,
+                             sp_desc,
+                             args.workSpace,
+                             hid_shift + bs * wei_len + 2 * hy_h,
+                             hid_shift + bs * wei_len + 2 * hy_h,
+                             hid_shift + bs * wei_len + 2 * hy_h);
+                });
             }
         }
 
@@ -434,112 +536,87 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             alpha1 = 1;
             beta_t = 0;
 
-            if(hx != nullptr)
+            if(has_hx)
             {
                 sp_size[1] = batch_n;
                 sp_size[2] = wei_stride;
-                sp_desc =
-                    miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         w_desc,
-                         w,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift,
-                         wei_shift_bias_temp,
-                         hid_shift);
-                // Update time
-                profileRNNkernels(handle, 1, ctime);
+                sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
+
+                plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha0,
+                             sp_desc,
+                             args.workSpace,
+                             &alpha1,
+                             w_desc,
+                             args.w,
+                             &beta_t,
+                             sp_desc,
+                             args.workSpace,
+                             hid_shift,
+                             wei_shift_bias_temp,
+                             hid_shift);
+                });
             }
             else
             {
                 sp_size[1] = batch_n - in_n.at(0);
                 sp_size[2] = wei_len;
-                sp_desc =
-                    miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-                w_size[1] = 1;
-                w_size[2] = wei_len;
-                w_desc =
-                    miopen::TensorDescriptor(wDesc.GetType(), w_size.data(), w_stride.data(), 3);
-
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         w_desc,
-                         w,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift + in_n.at(0) * hy_stride,
-                         wei_shift_bias_temp,
-                         hid_shift + in_n.at(0) * hy_stride);
-                // Update time
-                profileRNNkernels(handle, 1, ctime);
+                sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
+                w_size[1]  = 1;
+                w_size[2]  = wei_len;
+                w_desc     = miopen::TensorDescriptor(wType, w_size.data(), w_stride.data(), 3);
+
+                const int bias_shift = hid_shift + in_n.at(0) * hy_stride;
+                plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                    OpTensor(handle,
+                             miopenTensorOpAdd,
+                             &alpha0,
+                             sp_desc,
+                             args.workSpace,
+                             &alpha1,
+                             w_desc,
+                             args.w,
+                             &beta_t,
+                             sp_desc,
+                             args.workSpace,
+                             bias_shift,
+                             wei_shift_bias_temp,
+                             bias_shift);
+                });
 
                 if(dirMode != 0u)
                 {
-                    if(in_n.at(0) == in_n.at(seqLen - 1))
-                    {
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 w_desc,
-                                 w,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 hid_shift + wei_len,
-                                 wei_shift_bias_temp + wei_len,
-                                 hid_shift + wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
-                    }
-                    else
+                    // The reverse direction has no hidden-state term at the first step
+                    // of each sequence. The rows that take the bias are contiguous within
+                    // a batch bucket, which allows one launch per bucket instead of one
+                    // per time step.
+                    for(const auto& range : RNNReverseBiasRows(in_n))
                     {
-                        int cur_batch = 0;
-                        for(int ti = 0; ti < seqLen; ti++)
-                        {
-                            if(ti != (seqLen - 1))
-                            {
-                                offset = hid_shift + cur_batch * hy_stride;
+                        offset = hid_shift + range.row * hy_stride;
 
-                                sp_size[1] = in_n.at(ti + 1);
-                                sp_size[2] = wei_len;
-                                sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                        sp_size[1] = range.rows;
+                        sp_size[2] = wei_len;
+                        sp_desc    = miopen::TensorDescriptor(
+                            wType, sp_size.data(), sp_stride.data(), 3);
 
-                                OpTensor(handle,
-                                         miopenTensorOpAdd,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         w_desc,
-                                         w,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + wei_len,
-                                         wei_shift_bias_temp + wei_len,
-                                         offset + wei_len);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
-                            }
-                            cur_batch += in_n.at(ti);
-                        }
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpAdd,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     w_desc,
+                                     args.w,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + wei_len,
+                                     wei_shift_bias_temp + wei_len,
+                                     offset + wei_len);
+                        });
                     }
                 }
             }
@@ -555,6 +632,91 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             int pretime_shift = 0;
             int use_time      = 0;
 
+            // The recurrent GEMMs only read the hidden state of the previous step, so the two
+            // directions do not depend on each other. When their batches are equal they are
+            // packed into one strided batched GEMM, issued before the per-direction updates.
+            std::vector<boost::optional<GemmGroupMember>> recurrent(bi);
+            for(int ri = 0; ri < bi; ri++)
+            {
+                const int cur_time = ri == 0 ? ti : seqLen - 1 - ti;
+                const int cur_row  = hid_shift + (ri == 0 ? bacc : baccbi) * hy_stride;
+                if(in_n.at(cur_time) == 0)
+                    continue;
+
+                if(ti == 0)
+                {
+                    if(has_hx)
+                    {
+                        recurrent[ri] = GemmGroupMember{GemmDescriptor{false,
+                                                                       false,
+                                                                       true,
+                                                                       in_n.at(cur_time),
+                                                                       wei_len,
+                                                                       hy_h,
+                                                                       uni_stride,
+                                                                       uni_stride,
+                                                                       hy_stride,
+                                                                       1, // batch count
+                                                                       0, // Stride A
+                                                                       0, // Stride B
+                                                                       0, // Stride C
+                                                                       1, // alpha
+                                                                       1, // beta
+                                                                       xType},
+                                                        nullptr,
+                                                        hx_shift + ri * hy_n * hy_h,
+                                                        nullptr,
+                                                        wei_shift + ri * wei_len * uni_stride,
+                                                        nullptr,
+                                                        cur_row + ri * wei_len};
+                    }
+                    continue;
+                }
+
+                // rows of the step that continue a sequence of the previous step
+                const int pre_time = ri == 0 ? ti - 1 : seqLen - ti;
+                const int rows     = in_n.at(ri == 0 ? cur_time : pre_time);
+                const int pre_row  = ri == 0 ? hid_shift + (bacc - in_n.at(pre_time)) * hy_stride
+                                            : hid_shift + (baccbi + in_n.at(cur_time)) * hy_stride;
+                if(rows > 0)
+                {
+                    recurrent[ri] = GemmGroupMember{GemmDescriptor{false,
+                                                                   false,
+                                                                   true,
+                                                                   rows,
+                                                                   wei_len,
+                                                                   hy_h,
+                                                                   hy_stride,
+                                                                   uni_stride,
+                                                                   hy_stride,
+                                                                   1, // batch count
+                                                                   0, // Stride A
+                                                                   0, // Stride B
+                                                                   0, // Stride C
+                                                                   1, // alpha
+                                                                   1, // beta
+                                                                   xType},
+                                                    nullptr,
+                                                    pre_row + hid_off + ri * hy_h,
+                                                    nullptr,
+                                                    wei_shift + ri * wei_len * uni_stride,
+                                                    nullptr,
+                                                    cur_row + ri * wei_len};
+                }
+            }
+
+            bool packed = false;
+            if(shape.pack_directions && bi == 2 && recurrent[0] && recurrent[1])
+            {
+                // Both members use the same buffers, which are bound at execution time.
+                const auto runs = CoalesceGemmGroup({*recurrent[0], *recurrent[1]});
+                if(runs.size() == 1)
+                {
+                    add_recurrent_gemm(runs.front(), ti == 0);
+                    packed = true;
+                }
+            }
+
             for(int ri = 0; ri < bi; ri++)
             {
                 int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
@@ -570,133 +732,40 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                 if(in_n.at(cur_time) > 0)
                 {
-                    if(ti == 0)
-                    {
-                        if(hx != nullptr)
-                        {
-                            miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
-                                                                              false,
-                                                                              true,
-                                                                              in_n.at(cur_time),
-                                                                              wei_len,
-                                                                              hy_h,
-                                                                              uni_stride,
-                                                                              uni_stride,
-                                                                              hy_stride,
-                                                                              1, // batch count
-                                                                              0, // Stride A
-                                                                              0, // Stride B
-                                                                              0, // Stride C
-                                                                              1, // alpha
-                                                                              1, // beta
-                                                                              xDesc[0].GetType()};
+                    if(recurrent[ri] && !packed)
+                        add_recurrent_gemm(*recurrent[ri], ti == 0);
 
-                            miopenStatus_t gemm_status =
-                                CallGemm(handle,
-                                         gemm_desc,
-                                         hx,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         w,
-                                         wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
-                                         static_cast<int>(offset) + ri * wei_len,
-                                         nullptr,
-                                         false,
-                                         GemmBackend_t::miopengemm);
-
-                            if(gemm_status != miopenStatusSuccess)
-                            {
-                                if(gemm_status == miopenStatusNotImplemented)
-                                {
-                                    MIOPEN_LOG_E("GEMM not implemented");
-                                }
-                                else
-                                {
-                                    MIOPEN_LOG_E("GEMM failed");
-                                }
-                            }
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
-                    }
-                    else
+                    if(ti > 0 && ri == 1 && has_hx && in_n.at(cur_time) > in_n.at(use_time))
                     {
-                        if(ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
-                        {
-                            miopen::GemmDescriptor gemm_desc =
-                                GemmDescriptor{false,
-                                               false,
-                                               true,
-                                               (in_n.at(cur_time) - in_n.at(use_time)),
-                                               wei_len,
-                                               hy_h,
-                                               uni_stride,
-                                               uni_stride,
-                                               hy_stride,
-                                               1, // batch count
-                                               0, // Stride A
-                                               0, // Stride B
-                                               0, // Stride C
-                                               1, // alpha
-                                               1, // beta
-                                               xDesc[0].GetType()};
+                        miopen::GemmDescriptor gemm_desc =
+                            GemmDescriptor{false,
+                                           false,
+                                           true,
+                                           (in_n.at(cur_time) - in_n.at(use_time)),
+                                           wei_len,
+                                           hy_h,
+                                           uni_stride,
+                                           uni_stride,
+                                           hy_stride,
+                                           1, // batch count
+                                           0, // Stride A
+                                           0, // Stride B
+                                           0, // Stride C
+                                           1, // alpha
+                                           1, // beta
+                                           xType};
+                        const int use_batch = in_n.at(use_time);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
                             miopenStatus_t gemm_status =
                                 CallGemm(handle,
                                          gemm_desc,
-                                         hx,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         w,
+                                         args.hx,
+                                         hx_shift + ri * hy_n * hy_h + use_batch * hy_h,
+                                         args.w,
                                          wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
+                                         args.workSpace,
                                          static_cast<int>(offset) + ri * wei_len +
-                                             in_n.at(use_time) * hy_stride,
-                                         nullptr,
-                                         false,
-                                         GemmBackend_t::miopengemm);
-
-                            if(gemm_status != miopenStatusSuccess)
-                            {
-                                if(gemm_status == miopenStatusNotImplemented)
-                                {
-                                    MIOPEN_LOG_E("GEMM not implemented");
-                                }
-                                else
-                                {
-                                    MIOPEN_LOG_E("GEMM failed");
-                                }
-                            }
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
-
-                        if(in_n.at(use_time) > 0)
-                        {
-                            miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
-                                                                              false,
-                                                                              true,
-                                                                              in_n.at(use_time),
-                                                                              wei_len,
-                                                                              hy_h,
-                                                                              hy_stride,
-                                                                              uni_stride,
-                                                                              hy_stride,
-                                                                              1, // batch count
-                                                                              0, // Stride A
-                                                                              0, // Stride B
-                                                                              0, // Stride C
-                                                                              1, // alpha
-                                                                              1, // beta
-                                                                              xDesc[0].GetType()};
-
-                            miopenStatus_t gemm_status =
-                                CallGemm(handle,
-                                         gemm_desc,
-                                         workSpace,
-                                         pretime_shift + hid_off + ri * hy_h,
-                                         w,
-                                         wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
-                                         static_cast<int>(offset) + ri * wei_len,
+                                             use_batch * hy_stride,
                                          nullptr,
                                          false,
                                          GemmBackend_t::miopengemm);
@@ -712,9 +781,8 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                     MIOPEN_LOG_E("GEMM failed");
                                 }
                             }
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
+                        });
+                        plan.gemm_submissions++;
                     }
 
                     // update hidden status
@@ -723,390 +791,400 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                     {
                         sp_size[2] = hy_h;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                        activDesc.Forward(handle,
-                                          &alpha,
-                                          sp_desc,
-                                          workSpace,
-                                          &beta,
-                                          sp_desc,
-                                          workSpace,
-                                          offset + ri * wei_len,
-                                          offset + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                            wType, sp_size.data(), sp_stride.data(), 3);
+
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            activDesc.Forward(handle,
+                                              &alpha,
+                                              sp_desc,
+                                              args.workSpace,
+                                              &beta,
+                                              sp_desc,
+                                              args.workSpace,
+                                              offset + ri * wei_len,
+                                              offset + ri * wei_len);
+                        });
                     }
                     else if(rnnMode == miopenLSTM)
                     {
                         // active gate i, f, o
                         sp_size[2] = hy_h * 3;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                        sigDesc.Forward(handle,
-                                        &alpha,
-                                        sp_desc,
-                                        workSpace,
-                                        &beta,
-                                        sp_desc,
-                                        workSpace,
-                                        offset + ri * wei_len,
-                                        offset + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                            wType, sp_size.data(), sp_stride.data(), 3);
+
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            sigDesc.Forward(handle,
+                                            &alpha,
+                                            sp_desc,
+                                            args.workSpace,
+                                            &beta,
+                                            sp_desc,
+                                            args.workSpace,
+                                            offset + ri * wei_len,
+                                            offset + ri * wei_len);
+                        });
 
                         // active gate c
                         sp_size[2] = hy_h;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + 3 * hy_h + ri * wei_len,
-                                         offset + 3 * hy_h + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                            wType, sp_size.data(), sp_stride.data(), 3);
+
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            tanhDesc.Forward(handle,
+                                             &alpha,
+                                             sp_desc,
+                                             args.workSpace,
+                                             &beta,
+                                             sp_desc,
+                                             args.workSpace,
+                                             offset + 3 * hy_h + ri * wei_len,
+                                             offset + 3 * hy_h + ri * wei_len);
+                        });
 
                         // update cell state
                         alpha0 = 1;
                         alpha1 = 1;
                         beta_t = 1;
 
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + ri * wei_len,
-                                 offset + 3 * hy_h + ri * wei_len,
-                                 offset + bi * wei_len + ri * hy_h);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpMul,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + ri * wei_len,
+                                     offset + 3 * hy_h + ri * wei_len,
+                                     offset + bi * wei_len + ri * hy_h);
+                        });
 
                         if(ti == 0)
                         {
-                            if(cx != nullptr)
+                            if(has_cx)
                             {
                                 hx_size[1] = in_n.at(cur_time);
                                 hx_size[2] = hy_h;
                                 hx_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
-
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         cx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + ri * wei_len,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         offset + bi * wei_len + ri * hy_h);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                    wType, hx_size.data(), hx_stride.data(), 3);
+
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 hx_desc,
+                                                 args.cx,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + hy_h + ri * wei_len,
+                                                 hx_shift + ri * hy_n * hy_h,
+                                                 offset + bi * wei_len + ri * hy_h);
+                                    });
                             }
                         }
                         else
                         {
-                            if(ri == 1 && cx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
+                            if(ri == 1 && has_cx && in_n.at(cur_time) > in_n.at(use_time))
                             {
                                 hx_size[1] = in_n.at(cur_time) - in_n.at(use_time);
                                 hx_size[2] = hy_h;
                                 hx_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
+                                    wType, hx_size.data(), hx_stride.data(), 3);
 
                                 sp_size[1] = in_n.at(cur_time) - in_n.at(use_time);
-                                sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         cx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + ri * wei_len +
-                                             in_n.at(use_time) * hy_stride,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         offset + bi * wei_len + ri * hy_h +
-                                             in_n.at(use_time) * hy_stride);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
-
-                                sp_size[1] = in_n.at(cur_time);
-                                sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-                            }
-
-                            if(in_n.at(use_time) > 0)
-                            {
-                                if(in_n.at(use_time) != in_n.at(cur_time))
-                                {
-                                    sp_size[1] = in_n.at(use_time);
-                                    sp_desc    = miopen::TensorDescriptor(
-                                        wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-                                }
-
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + ri * wei_len,
-                                         pretime_shift + bi * wei_len + ri * hy_h,
-                                         offset + bi * wei_len + ri * hy_h);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                sp_desc    = miopen::TensorDescriptor(
+                                    wType, sp_size.data(), sp_stride.data(), 3);
+
+                                const int use_batch = in_n.at(use_time);
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 hx_desc,
+                                                 args.cx,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + hy_h + ri * wei_len +
+                                                     use_batch * hy_stride,
+                                                 hx_shift + ri * hy_n * hy_h +
+                                                     use_batch * hy_h,
+                                                 offset + bi * wei_len + ri * hy_h +
+                                                     use_batch * hy_stride);
+                                    });
+
+                                sp_size[1] = in_n.at(cur_time);
+                                sp_desc    = miopen::TensorDescriptor(
+                                    wType, sp_size.data(), sp_stride.data(), 3);
+                            }
+
+                            if(in_n.at(use_time) > 0)
+                            {
+                                if(in_n.at(use_time) != in_n.at(cur_time))
+                                {
+                                    sp_size[1] = in_n.at(use_time);
+                                    sp_desc    = miopen::TensorDescriptor(
+                                        wType, sp_size.data(), sp_stride.data(), 3);
+                                }
+
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + hy_h + ri * wei_len,
+                                                 pretime_shift + bi * wei_len + ri * hy_h,
+                                                 offset + bi * wei_len + ri * hy_h);
+                                    });
 
                                 if(in_n.at(use_time) != in_n.at(cur_time))
                                 {
                                     sp_size[1] = in_n.at(cur_time);
                                     sp_desc    = miopen::TensorDescriptor(
-                                        wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                                        wType, sp_size.data(), sp_stride.data(), 3);
                                 }
                             }
                         }
 
                         // active cell state
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + bi * wei_len + ri * hy_h,
-                                         offset + hid_off + ri * hy_h);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            tanhDesc.Forward(handle,
+                                             &alpha,
+                                             sp_desc,
+                                             args.workSpace,
+                                             &beta,
+                                             sp_desc,
+                                             args.workSpace,
+                                             offset + bi * wei_len + ri * hy_h,
+                                             offset + hid_off + ri * hy_h);
+                        });
 
                         // update hidden state
                         beta_t = 0;
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * hy_h + ri * wei_len,
-                                 offset + hid_off + ri * hy_h,
-                                 offset + hid_off + ri * hy_h);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpMul,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + 2 * hy_h + ri * wei_len,
+                                     offset + hid_off + ri * hy_h,
+                                     offset + hid_off + ri * hy_h);
+                        });
                     }
                     else if(rnnMode == miopenGRU)
                     {
                         // active z, r gate
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                        sigDesc.Forward(handle,
-                                        &alpha,
-                                        sp_desc,
-                                        workSpace,
-                                        &beta,
-                                        sp_desc,
-                                        workSpace,
-                                        offset + ri * wei_len,
-                                        offset + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                            wType, sp_size.data(), sp_stride.data(), 3);
+
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            sigDesc.Forward(handle,
+                                            &alpha,
+                                            sp_desc,
+                                            args.workSpace,
+                                            &beta,
+                                            sp_desc,
+                                            args.workSpace,
+                                            offset + ri * wei_len,
+                                            offset + ri * wei_len);
+                        });
 
                         // calculate c gate
                         sp_size[2] = hy_h;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                            wType, sp_size.data(), sp_stride.data(), 3);
 
                         alpha0 = 1;
                         alpha1 = 1;
                         beta_t = 0;
 
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + hy_h + ri * wei_len,
-                                 offset + 2 * hy_h + ri * wei_len,
-                                 offset + 2 * hy_h + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpMul,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + hy_h + ri * wei_len,
+                                     offset + 2 * hy_h + ri * wei_len,
+                                     offset + 2 * hy_h + ri * wei_len);
+                        });
 
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * hy_h + ri * wei_len,
-                                 offset + hid_off + ri * hy_h,
-                                 offset + 2 * hy_h + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpAdd,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + 2 * hy_h + ri * wei_len,
+                                     offset + hid_off + ri * hy_h,
+                                     offset + 2 * hy_h + ri * wei_len);
+                        });
 
                         // active c gate
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + 2 * hy_h + ri * wei_len,
-                                         offset + 2 * hy_h + ri * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            tanhDesc.Forward(handle,
+                                             &alpha,
+                                             sp_desc,
+                                             args.workSpace,
+                                             &beta,
+                                             sp_desc,
+                                             args.workSpace,
+                                             offset + 2 * hy_h + ri * wei_len,
+                                             offset + 2 * hy_h + ri * wei_len);
+                        });
 
                         // calculate hidden state
                         alpha0 = -1;
                         alpha1 = 1;
                         beta_t = 0;
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + ri * wei_len,
-                                 offset + 2 * hy_h + ri * wei_len,
-                                 offset + hid_off + ri * hy_h);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpMul,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + ri * wei_len,
+                                     offset + 2 * hy_h + ri * wei_len,
+                                     offset + hid_off + ri * hy_h);
+                        });
 
                         alpha0 = 1;
                         alpha1 = 1;
                         beta_t = 0;
 
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * hy_h + ri * wei_len,
-                                 offset + hid_off + ri * hy_h,
-                                 offset + hid_off + ri * hy_h);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
+                        plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                            OpTensor(handle,
+                                     miopenTensorOpAdd,
+                                     &alpha0,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &alpha1,
+                                     sp_desc,
+                                     args.workSpace,
+                                     &beta_t,
+                                     sp_desc,
+                                     args.workSpace,
+                                     offset + 2 * hy_h + ri * wei_len,
+                                     offset + hid_off + ri * hy_h,
+                                     offset + hid_off + ri * hy_h);
+                        });
 
                         alpha0 = 1;
                         alpha1 = 1;
                         beta_t = 1;
                         if(ti == 0)
                         {
-                            if(hx != nullptr)
+                            if(has_hx)
                             {
                                 hx_size[1] = in_n.at(cur_time);
                                 hx_size[2] = hy_h;
                                 hx_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
-
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         hx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + ri * wei_len,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         offset + hid_off + ri * hy_h);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                    wType, hx_size.data(), hx_stride.data(), 3);
+
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 hx_desc,
+                                                 args.hx,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + ri * wei_len,
+                                                 hx_shift + ri * hy_n * hy_h,
+                                                 offset + hid_off + ri * hy_h);
+                                    });
                             }
                         }
                         else
                         {
-                            if(ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
+                            if(ri == 1 && has_hx && in_n.at(cur_time) > in_n.at(use_time))
                             {
                                 hx_size[1] = in_n.at(cur_time) - in_n.at(use_time);
                                 hx_size[2] = hy_h;
                                 hx_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
+                                    wType, hx_size.data(), hx_stride.data(), 3);
 
                                 sp_size[1] = in_n.at(cur_time) - in_n.at(use_time);
                                 sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
-
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         hx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + ri * wei_len + in_n.at(use_time) * hy_stride,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         offset + hid_off + ri * hy_h +
-                                             in_n.at(use_time) * hy_stride);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                    wType, sp_size.data(), sp_stride.data(), 3);
+
+                                const int use_batch = in_n.at(use_time);
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 hx_desc,
+                                                 args.hx,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + ri * wei_len +
+                                                     use_batch * hy_stride,
+                                                 hx_shift + ri * hy_n * hy_h +
+                                                     use_batch * hy_h,
+                                                 offset + hid_off + ri * hy_h +
+                                                     use_batch * hy_stride);
+                                    });
 
                                 sp_size[1] = in_n.at(cur_time);
                                 sp_desc    = miopen::TensorDescriptor(
-                                    wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                                    wType, sp_size.data(), sp_stride.data(), 3);
                             }
 
                             if(in_n.at(use_time) > 0)
@@ -1115,25 +1193,26 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 {
                                     sp_size[1] = in_n.at(use_time);
                                     sp_desc    = miopen::TensorDescriptor(
-                                        wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                                        wType, sp_size.data(), sp_stride.data(), 3);
                                 }
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + ri * wei_len,
-                                         pretime_shift + hid_off + ri * hy_h,
-                                         offset + hid_off + ri * hy_h);
-                                // Update time
-                                profileRNNkernels(handle, 1, ctime);
+                                plan.steps.emplace_back(
+                                    [=](Handle& handle, const RNNPlanArgs& args) {
+                                        OpTensor(handle,
+                                                 miopenTensorOpMul,
+                                                 &alpha0,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &alpha1,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 &beta_t,
+                                                 sp_desc,
+                                                 args.workSpace,
+                                                 offset + ri * wei_len,
+                                                 pretime_shift + hid_off + ri * hy_h,
+                                                 offset + hid_off + ri * hy_h);
+                                    });
                             }
                         }
                     }
@@ -1144,7 +1223,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         }
 
         // update hy, cy
-        if(hy != nullptr || (rnnMode == miopenLSTM && cy != nullptr))
+        if(has_hy || (rnnMode == miopenLSTM && has_cy))
         {
             hx_size[2] = hy_h;
             sp_size[2] = hy_h;
@@ -1172,38 +1251,38 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                         sp_size[1] = in_n.at(cur_time) - use_batch;
                         sp_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+                            wType, sp_size.data(), sp_stride.data(), 3);
 
                         hx_size[1] = sp_size[1];
                         hx_desc    = miopen::TensorDescriptor(
-                            wDesc.GetType(), hx_size.data(), hx_stride.data(), 3);
+                            wType, hx_size.data(), hx_stride.data(), 3);
 
-                        if(hy != nullptr)
+                        if(has_hy)
                         {
-                            CopyTensor(handle,
-                                       sp_desc,
-                                       workSpace,
-                                       hx_desc,
-                                       hy,
-                                       static_cast<int>(offset) + hid_off + ri * hy_h +
-                                           use_batch * hy_stride,
-                                       hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
+                            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                                CopyTensor(handle,
+                                           sp_desc,
+                                           args.workSpace,
+                                           hx_desc,
+                                           args.hy,
+                                           static_cast<int>(offset) + hid_off + ri * hy_h +
+                                               use_batch * hy_stride,
+                                           hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
+                            });
                         }
 
-                        if(rnnMode == miopenLSTM && cy != nullptr)
+                        if(rnnMode == miopenLSTM && has_cy)
                         {
-                            CopyTensor(handle,
-                                       sp_desc,
-                                       workSpace,
-                                       hx_desc,
-                                       cy,
-                                       static_cast<int>(offset) + bi * wei_len + ri * hy_h +
-                                           use_batch * hy_stride,
-                                       hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
+                            plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+                                CopyTensor(handle,
+                                           sp_desc,
+                                           args.workSpace,
+                                           hx_desc,
+                                           args.cy,
+                                           static_cast<int>(offset) + bi * wei_len + ri * hy_h +
+                                               use_batch * hy_stride,
+                                           hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
+                            });
                         }
                     }
                 }
@@ -1219,16 +1298,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     sp_size[2] = hy_h * bi;
     y_size[1]  = batch_n;
     y_size[2]  = out_h;
-    y_desc     = miopen::TensorDescriptor(wDesc.GetType(), y_size.data(), y_stride.data(), 3);
-    sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size.data(), sp_stride.data(), 3);
+    y_desc     = miopen::TensorDescriptor(wType, y_size.data(), y_stride.data(), 3);
+    sp_desc    = miopen::TensorDescriptor(wType, sp_size.data(), sp_stride.data(), 3);
 
-    CopyTensor(handle, sp_desc, workSpace, y_desc, y, prelayer_shift, 0);
-    // Update time
-    profileRNNkernels(handle, 2, ctime);
+    plan.steps.emplace_back([=](Handle& handle, const RNNPlanArgs& args) {
+        CopyTensor(handle, sp_desc, args.workSpace, y_desc, args.y, prelayer_shift, 0);
+    });
 
+    return plan;
 #else
-    (void)hx;
-    (void)cx;
+    (void)has_hx;
+    (void)has_cx;
+    (void)has_hy;
+    (void)has_cy;
+    (void)workSpaceSize;
     (void)offset;
     (void)alpha0;
     (void)alpha1;
@@ -29,6 +29,8 @@
 #include <miopen/check_numerics.hpp>
 #include <miopen/tensor.hpp>
 
+#include <array>
+
 namespace miopen {
 
 int nextPow2(int v)
@@ -51,16 +53,27 @@ int nextPow2(int v)
     }
 }
 
-miopenStatus_t SoftmaxForward(
-    Handle& handle, const void* alpha, const void* beta, const TensorDescriptor& yDesc, Data_t y)
+namespace {
+
+struct SoftmaxKernel
+{
+    KernelInvoke kernel;
+    int c;
+    int grid_size;
+    int spatial_dim;
+};
+
+} // namespace
+
+// See Kernels/MIOpenSoftmax.cl for description of the CSR-Vector and CSR-Stream approaches.
+static SoftmaxKernel GetSoftmaxKernel(Handle& handle,
+                                      const std::string& kernel_name,
+                                      const TensorDescriptor& desc,
+                                      miopenSoftmaxAlgorithm_t algorithm,
+                                      bool use_mask)
 {
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
-    {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
-    }
     int n, c, h, w;
-    std::tie(n, c, h, w) = tien<4>(yDesc.GetLengths());
+    std::tie(n, c, h, w) = tien<4>(desc.GetLengths());
     // using workgroup size of 256 by default
     int grid_size   = n * h * w;
     int spatial_dim = h * w;
@@ -71,47 +84,28 @@ miopenStatus_t SoftmaxForward(
 
     bool usefp16 = false;
     bool usefp32 = true;
-    if(yDesc.GetType() == miopenHalf)
+    if(desc.GetType() == miopenHalf)
     {
         usefp16 = true;
         usefp32 = false;
     }
 
-    // See Kernels/MIOpenSoftmax.cl for description
+    std::string algo_name = kernel_name;
+    // Only the build options are part of the key: vgd is passed on each launch, so the
+    // kernel is reused for all batch sizes.
+    std::string network_config =
+        std::to_string(num_batch) + std::to_string(static_cast<int>(usefp16)) +
+        std::to_string(static_cast<int>(usefp32)) + std::to_string(vld[0]) + std::to_string(c);
+    std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch);
+    size_t workgroups = 0;
+
     if(num_batch == 1)
     { // CSR-Vector like approach
 
         // Control the max. number of workgroups launched so that we do not
         // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        std::string algo_name = "SoftmaxForwardOneBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(static_cast<int>(usefp16)) +
-            std::to_string(static_cast<int>(usefp32)) + std::to_string(vgd[0]) +
-            std::to_string(vld[0]) + std::to_string(spatial_dim) + std::to_string(grid_size) +
-            std::to_string(workgroups) + std::to_string(c);
-
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
-
-        if(!kernels.empty())
-        {
-            // auto kernel = kernels.front();
-            kernels.front()(y, c, grid_size, spatial_dim);
-        }
-        else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxForward";
-
-            // compile parameters
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, c, grid_size, spatial_dim);
-        }
+        workgroups = std::min(grid_size, 64 * 40 * 8);
+        algo_name += "OneBatch";
     }
     else
     { // CSR-Stream like approach
@@ -121,40 +115,135 @@ miopenStatus_t SoftmaxForward(
         // num_channels each threads iterates over to cover all the channels
         int u_batch_size = (c > batch_size) ? nextPow2(c / batch_size) : 1;
 
-        // size_t workgroups =
-        //    grid_size % num_batch == 0 ? grid_size / num_batch : grid_size / num_batch + 1;
-        size_t workgroups =
+        workgroups =
             (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+        algo_name += "MultiBatch";
+        network_config += std::to_string(u_batch_size) + std::to_string(batch_size);
+        parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
+                 std::to_string(u_batch_size);
+    }
+    const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+
+    // Always two digits, so the key stays unambiguous
+    network_config += std::to_string(static_cast<int>(algorithm)) +
+                      std::to_string(static_cast<int>(use_mask));
+    parms += " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(usefp16)) +
+             " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(usefp32)) +
+             " -DMIOPEN_SOFTMAX_ALGO=" + std::to_string(static_cast<int>(algorithm)) +
+             " -DMIOPEN_SOFTMAX_USE_MASK=" + std::to_string(static_cast<int>(use_mask));
+
+    auto&& kernels = handle.GetKernels(algo_name, network_config, vgd);
+    if(!kernels.empty())
+        return {kernels.front(), c, grid_size, spatial_dim};
+
+    return {handle.AddKernel(
+                algo_name, network_config, "MIOpenSoftmax.cl", kernel_name, vld, vgd, parms),
+            c,
+            grid_size,
+            spatial_dim};
+}
 
-        std::string algo_name = "SoftmaxForwardMultiBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(static_cast<int>(usefp16)) +
-            std::to_string(static_cast<int>(usefp32)) + std::to_string(vgd[0]) +
-            std::to_string(vld[0]) + std::to_string(spatial_dim) + std::to_string(grid_size) +
-            std::to_string(workgroups) + std::to_string(c) + std::to_string(u_batch_size) +
-            std::to_string(batch_size);
+static void ValidateSoftmaxTensors(const TensorDescriptor& inDesc,
+                                   const TensorDescriptor& outDesc,
+                                   miopenSoftmaxAlgorithm_t algorithm)
+{
+    if(inDesc.GetLengths() != outDesc.GetLengths() || inDesc.GetType() != outDesc.GetType())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Softmax tensors must have the same lengths and type");
+    }
+    if(inDesc.GetSize() != 4)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Softmax requires 4-D tensors");
+    }
+    if(!inDesc.IsPacked() || !outDesc.IsPacked())
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Softmax requires packed tensors");
+    }
+    if(algorithm != miopenSoftmaxFast && algorithm != miopenSoftmaxAccurate &&
+       algorithm != miopenSoftmaxLog)
+    {
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown softmax algorithm");
+    }
+}
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+miopenStatus_t SoftmaxForward(Handle& handle,
+                              const void* alpha,
+                              const void* beta,
+                              const TensorDescriptor& xDesc,
+                              ConstData_t x,
+                              const TensorDescriptor& yDesc,
+                              Data_t y,
+                              miopenSoftmaxAlgorithm_t algorithm)
+{
+    return ScaledMaskedSoftmaxForward(
+        handle, alpha, beta, xDesc, x, 1.0f, xDesc, nullptr, yDesc, y, algorithm);
+}
+
+miopenStatus_t ScaledMaskedSoftmaxForward(Handle& handle,
+                                          const void* alpha,
+                                          const void* beta,
+                                          const TensorDescriptor& xDesc,
+                                          ConstData_t x,
+                                          float scale,
+                                          const TensorDescriptor& maskDesc,
+                                          ConstData_t mask,
+                                          const TensorDescriptor& yDesc,
+                                          Data_t y,
+                                          miopenSoftmaxAlgorithm_t algorithm)
+{
+    if(x == nullptr || y == nullptr)
+    {
+        MIOPEN_THROW(miopenStatusBadParm);
+    }
+    ValidateSoftmaxTensors(xDesc, yDesc, algorithm);
 
-        if(!kernels.empty())
+    // Strides of the mask as seen from x: dimensions the mask broadcasts over get a stride of 0.
+    std::array<int, 4> mask_strides{};
+    const bool use_mask = mask != nullptr;
+    if(use_mask)
+    {
+        if(maskDesc.GetSize() != 4 || maskDesc.GetType() != xDesc.GetType())
         {
-            kernels.front()(y, c, grid_size, spatial_dim);
+            MIOPEN_THROW(miopenStatusBadParm, "Softmax mask must be 4-D and of the input type");
         }
-        else
+        for(std::size_t i = 0; i < 4; i++)
         {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxForward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DBATCH_SIZE=" +
-                                std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                                std::to_string(u_batch_size) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
+            const auto len = maskDesc.GetLengths()[i];
+            if(len != 1 && len != xDesc.GetLengths()[i])
+            {
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "Softmax mask lengths must match the input or be 1");
+            }
+            mask_strides[i] = len == 1 ? 0 : static_cast<int>(maskDesc.GetStrides()[i]);
+        }
+    }
 
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, c, grid_size, spatial_dim);
+    if(miopen::CheckNumericsEnabled() != 0)
+    {
+        miopen::checkNumericsInput(handle, xDesc, x);
+        if(!float_equal(*(static_cast<const float*>(beta)), 0))
+        {
+            miopen::checkNumericsInput(handle, yDesc, y);
         }
     }
+
+    const auto k = GetSoftmaxKernel(handle, "SoftmaxForward", yDesc, algorithm, use_mask);
+    // The mask argument must be a valid buffer even if the kernel never reads it
+    k.kernel(x,
+             y,
+             use_mask ? mask : x,
+             k.c,
+             k.grid_size,
+             k.spatial_dim,
+             *(static_cast<const float*>(alpha)),
+             *(static_cast<const float*>(beta)),
+             scale,
+             mask_strides[0],
+             mask_strides[1],
+             mask_strides[2],
+             mask_strides[3],
+             static_cast<int>(xDesc.GetLengths()[3]));
+
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsOutput(handle, yDesc, y);
@@ -166,110 +255,40 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
                                const void* alpha,
                                const TensorDescriptor& yDesc,
                                ConstData_t y,
+                               const TensorDescriptor& dyDesc,
+                               ConstData_t dy,
                                const void* beta,
                                const TensorDescriptor& dxDesc,
-                               Data_t dx)
+                               Data_t dx,
+                               miopenSoftmaxAlgorithm_t algorithm)
 {
-    if(yDesc != dxDesc)
+    if(y == nullptr || dy == nullptr || dx == nullptr)
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
-    if(!float_equal(*(static_cast<const float*>(alpha)), 1.0) ||
-       !float_equal(*(static_cast<const float*>(beta)), 0))
-    {
-        MIOPEN_THROW("Only alpha=1 and beta=0 is supported");
-    }
+    ValidateSoftmaxTensors(yDesc, dxDesc, algorithm);
+    ValidateSoftmaxTensors(dyDesc, dxDesc, algorithm);
+
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsInput(handle, yDesc, y);
-    }
-
-    int n, c, h, w;
-    std::tie(n, c, h, w) = tien<4>(dxDesc.GetLengths());
-
-    // using workgroup size of 256 by default
-    int grid_size   = n * h * w;
-    int spatial_dim = h * w;
-    int num_batch   = (c < 256) ? nextPow2(256 / c) : 1;
-
-    const std::vector<size_t> vld{256, 1, 1};
-
-    bool usefp16 = false;
-    bool usefp32 = true;
-    if(yDesc.GetType() == miopenHalf)
-    {
-        usefp16 = true;
-        usefp32 = false;
-    }
-
-    // See Kernels/MIOpenSoftmax.cl for description
-    if(num_batch == 1)
-    { // CSR-Vector like approach
-
-        // Control the max. number of workgroups launched so that we do not
-        // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        std::string algo_name = "SoftmaxBackwardOneBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(static_cast<int>(usefp16)) +
-            std::to_string(static_cast<int>(usefp32)) + std::to_string(vgd[0]) +
-            std::to_string(vld[0]) + std::to_string(spatial_dim) + std::to_string(grid_size) +
-            std::to_string(workgroups) + std::to_string(c);
-
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
-
-        if(!kernels.empty())
-        {
-            kernels.front()(y, dx, c, grid_size, spatial_dim);
-        }
-        else
+        miopen::checkNumericsInput(handle, dyDesc, dy);
+        if(!float_equal(*(static_cast<const float*>(beta)), 0))
         {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxBackward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, dx, c, grid_size, spatial_dim);
+            miopen::checkNumericsInput(handle, dxDesc, dx);
         }
     }
-    else
-    { // CSR-Stream like approach
-        int batch_size   = 256 / num_batch;
-        int u_batch_size = (c > batch_size) ? nextPow2(c / batch_size) : 1;
-        size_t workgroups =
-            (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
-
-        std::string algo_name = "SoftmaxBackwardMultiBatch";
-        std::string network_config =
-            std::to_string(num_batch) + std::to_string(static_cast<int>(usefp16)) +
-            std::to_string(static_cast<int>(usefp32)) + std::to_string(vgd[0]) +
-            std::to_string(vld[0]) + std::to_string(spatial_dim) + std::to_string(grid_size) +
-            std::to_string(workgroups) + std::to_string(c) + std::to_string(u_batch_size) +
-            std::to_string(batch_size);
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+    const auto k = GetSoftmaxKernel(handle, "SoftmaxBackward", dxDesc, algorithm, false);
+    k.kernel(y,
+             dy,
+             dx,
+             k.c,
+             k.grid_size,
+             k.spatial_dim,
+             *(static_cast<const float*>(alpha)),
+             *(static_cast<const float*>(beta)));
 
-        if(!kernels.empty())
-        {
-            kernels.front()(y, dx, c, grid_size, spatial_dim);
-        }
-        else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxBackward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DBATCH_SIZE=" +
-                                std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                                std::to_string(u_batch_size) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, dx, c, grid_size, spatial_dim);
-        }
-    }
     if(miopen::CheckNumericsEnabled() != 0)
     {
         miopen::checkNumericsOutput(handle, dxDesc, dx);
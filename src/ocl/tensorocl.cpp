@@ -28,11 +28,13 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/tensor_expr.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/util.hpp>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <numeric>
 #include <boost/range/combine.hpp>
 
@@ -47,8 +49,8 @@ TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
         return {desc.GetType(), {desc.GetElementSize()}, {1}};
 
     // start flattening tensor
-    std::vector<std::size_t> flat_lengths;
-    std::vector<std::size_t> flat_strides;
+    TensorLengths flat_lengths;
+    TensorLengths flat_strides;
 
     auto non1_length_strides = boost::combine(desc.GetLengths(), desc.GetStrides()) |
                                boost::adaptors::filtered(f_length_is_not_1_t());
@@ -80,13 +82,13 @@ TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
     flat_lengths.push_back(flat_len);
     flat_strides.push_back(boost::get<1>(*i_previous));
 
-    return {desc.GetType(), std::move(flat_lengths), std::move(flat_strides)};
+    return {desc.GetType(), flat_lengths, flat_strides};
 }
 
 // Free Tensor Functions
 static void CreateBitmapAndGrid(unsigned int& bitmap,
-                                std::vector<std::size_t>& a_lens,
-                                std::vector<std::size_t>& c_lens,
+                                const TensorLengths& a_lens,
+                                const TensorLengths& c_lens,
                                 int& num_wg,
                                 int& work,
                                 int d)
@@ -1576,7 +1578,7 @@ void ScaleTensor(
 
     std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
 
-    const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
+    const auto& lens = yDesc_flat.GetLengths();
 
     std::string network_config = "scale " + std::to_string(yDesc_flat.GetType());
     for(auto& len : lens)
@@ -1756,7 +1758,7 @@ void CopyTensor(Handle& handle,
     {
         std::string kernel_name = "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
 
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
+        const auto& lens = srcDesc_flat.GetLengths();
 
         std::string network_config = "copy " + std::to_string(srcDesc_flat.GetType());
         for(auto& len : lens)
@@ -1958,7 +1960,7 @@ void CastTensor(Handle& handle,
     {
         std::string kernel_name = "SubTensorOpWithCastTensor" + std::to_string(srcDim_flat) + "d";
 
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
+        const auto& lens = srcDesc_flat.GetLengths();
 
         std::string network_config = "cast " + std::to_string(dstDesc_flat.GetType());
         for(auto& len : lens)
@@ -2155,7 +2157,13 @@ void TransformTensor(Handle& handle,
         MIOPEN_THROW("Tensor x and y spatial sizes do not match");
     }
 
-    if(xDesc.GetType() == miopenInt8 && yDesc.GetType() == miopenInt8)
+    if(xDesc.GetType() == yDesc.GetType() && x_len == y_len &&
+       xDesc.GetStrides() != yDesc.GetStrides())
+    {
+        // Same elements in another memory layout, e.g. NHWC <-> NCHW
+        CopyTensor(handle, xDesc, x, yDesc, y);
+    }
+    else if(xDesc.GetType() == miopenInt8 && yDesc.GetType() == miopenInt8)
     {
         if(x_len[1] <= y_len[1])
         {
@@ -2221,4 +2229,62 @@ void TransformTensor(Handle& handle,
     (void)beta;
 }
 
+void TensorExpression::Run(Handle& handle, const std::vector<Data_t>& buffers) const
+{
+    if(buffers.size() != tensors.size() ||
+       std::any_of(buffers.begin(), buffers.end(), [](Data_t p) { return p == nullptr; }))
+        MIOPEN_THROW(miopenStatusBadParm, "Expected one buffer per tensor of the expression.");
+
+    const auto shape = GetFlattenedShape();
+    const auto total = std::accumulate(
+        shape.lens.begin(), shape.lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    if(total > std::numeric_limits<unsigned int>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor is too large for a fused expression.");
+
+    // The kernel loops over the elements, so the program only depends on the expression and one
+    // compiled kernel serves every shape. The grid is capped and sized per call.
+    const std::size_t wld = 256;
+    const std::size_t wgd = std::min((total + wld - 1) / wld, std::size_t{1024}) * wld;
+
+    const auto network_config = GetNetworkConfig();
+    auto&& kernels            = handle.GetKernels("TensorExpr", network_config, {wgd, 1, 1});
+
+    KernelInvoke kernel;
+    if(!kernels.empty())
+    {
+        kernel = kernels.front();
+    }
+    else
+    {
+        kernel = handle.AddKernel("TensorExpr",
+                                  network_config,
+                                  "MIOpenTensorExpr.cl",
+                                  "TensorExpr",
+                                  {wld, 1, 1},
+                                  {wgd, 1, 1},
+                                  GetCompileParms());
+    }
+
+    // Right-align the flattened shape in the kernel's five dimensions
+    const std::size_t pad = max_flat_dims - shape.lens.size();
+
+    std::vector<OpKernelArg> args;
+    for(std::size_t t = 0; t < tensors.size(); ++t)
+    {
+        args.emplace_back(buffers[t]);
+        for(std::size_t d = 0; d < max_flat_dims; ++d)
+            args.emplace_back(static_cast<unsigned int>(d < pad ? 0 : shape.strides[t][d - pad]));
+    }
+    for(auto&& step : steps)
+    {
+        args.emplace_back(step.alpha0);
+        args.emplace_back(step.alpha1);
+        args.emplace_back(step.beta);
+    }
+    for(std::size_t d = 0; d < max_flat_dims; ++d)
+        args.emplace_back(static_cast<unsigned int>(d < pad ? 1 : shape.lens[d - pad]));
+
+    kernel(args);
+}
+
 } // namespace miopen
@@ -26,6 +26,7 @@
 #include <miopen/oclkernel.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 
 namespace miopen {
 
@@ -47,8 +48,10 @@ static std::string DimToFormattedString(const size_t* dims, size_t count)
 }
 #endif // !NDEBUG
 
-void OCLKernelInvoke::run() const
+void OCLKernelInvoke::run(std::unique_lock<std::mutex>& lock) const
 {
+    MIOPEN_TRACE_SCOPE("launch", trace_name);
+
 #ifndef NDEBUG
     MIOPEN_LOG_I2("kernel_name = " << GetName() << ", work_dim = " << work_dim
                                    << ", global_work_offset = "
@@ -75,6 +78,8 @@ void OCLKernelInvoke::run() const
                                0,
                                nullptr,
                                callback ? &ev : nullptr);
+    if(lock.owns_lock())
+        lock.unlock();
 
     if(status != CL_SUCCESS)
     {
@@ -106,7 +111,7 @@ OCLKernelInvoke OCLKernel::Invoke(cl_command_queue q, std::function<void(cl_even
 #ifndef NDEBUG
     MIOPEN_LOG_I(GetName());
 #endif
-    OCLKernelInvoke result{q, kernel, gdims.size(), {}, {}, {}, callback};
+    OCLKernelInvoke result{q, kernel, gdims.size(), {}, {}, {}, callback, args_mutex, trace_name};
     std::copy(gdims.begin(), gdims.end(), result.global_work_dim.begin());
     std::copy(ldims.begin(), ldims.end(), result.local_work_dim.begin());
     return result;
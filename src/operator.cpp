@@ -38,7 +38,8 @@ std::ostream& operator<<(std::ostream& stream, const FusionOpDescriptor& x)
                     miopenFusionOpBiasForward,
                     miopenFusionOpBatchNormFwdTrain,
                     miopenFusionOpBatchNormBwdTrain,
-                    miopenFusionOpActivBackward);
+                    miopenFusionOpActivBackward,
+                    miopenFusionOpTensorAdd);
     return stream;
 }
 
@@ -26,6 +26,7 @@
 #include <miopen/pooling.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor.hpp>
 
 #include <numeric>
@@ -208,6 +209,7 @@ extern "C" miopenStatus_t miopenPoolingForward(miopenHandle_t handle,
                                                void* workSpace,
                                                size_t workSpaceSize)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         poolDesc, alpha, xDesc, x, beta, yDesc, y, do_backward, workSpace, workSpaceSize);
@@ -270,6 +272,7 @@ extern "C" miopenStatus_t miopenPoolingBackward(miopenHandle_t handle,
                                                 void* dx,
                                                 const void* workSpace)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(
         poolDesc, alpha, yDesc, y, dyDesc, dy, xDesc, x, beta, dxDesc, dx, workSpace);
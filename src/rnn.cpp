@@ -36,6 +36,7 @@
 #include <cstddef>
 #include <numeric>
 #include <ostream>
+#include <tuple>
 
 // MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ROCM_PRECOMPILED_BINARIES)
 // MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING)
@@ -112,6 +113,106 @@ void profileRNNkernels(Handle& handle, unsigned char select, float& ctime)
     }
 }
 
+std::vector<RNNBatchBucket> RNNBatchBuckets(const std::vector<int>& in_n)
+{
+    std::vector<RNNBatchBucket> buckets;
+    int row = 0;
+    for(int ti = 0; ti < static_cast<int>(in_n.size()); ti++)
+    {
+        if(buckets.empty() || buckets.back().batch != in_n[ti])
+        {
+            RNNBatchBucket bucket;
+            bucket.first_time = ti;
+            bucket.batch      = in_n[ti];
+            bucket.row        = row;
+            buckets.push_back(bucket);
+        }
+        buckets.back().steps++;
+        row += in_n[ti];
+    }
+    return buckets;
+}
+
+std::vector<RNNRowRange> RNNReverseBiasRows(const std::vector<int>& in_n)
+{
+    std::vector<RNNRowRange> ranges;
+    const auto buckets = RNNBatchBuckets(in_n);
+    for(std::size_t bk = 0; bk < buckets.size(); bk++)
+    {
+        // all but the last step of the bucket, then as many rows as the next bucket continues
+        const int next_batch = bk + 1 < buckets.size() ? buckets[bk + 1].batch : 0;
+        RNNRowRange range;
+        range.row  = buckets[bk].row;
+        range.rows = (buckets[bk].steps - 1) * buckets[bk].batch + next_batch;
+        if(range.rows > 0)
+            ranges.push_back(range);
+    }
+    return ranges;
+}
+
+bool RNNPlanShape::operator<(const RNNPlanShape& other) const
+{
+    return std::tie(seqLen,
+                    in_n,
+                    in_h,
+                    hy_d,
+                    hy_n,
+                    hy_h,
+                    out_h,
+                    xType,
+                    wType,
+                    workSpaceSize,
+                    has_hx,
+                    has_cx,
+                    has_hy,
+                    has_cy,
+                    pack_directions) < std::tie(other.seqLen,
+                                                other.in_n,
+                                                other.in_h,
+                                                other.hy_d,
+                                                other.hy_n,
+                                                other.hy_h,
+                                                other.out_h,
+                                                other.xType,
+                                                other.wType,
+                                                other.workSpaceSize,
+                                                other.has_hx,
+                                                other.has_cx,
+                                                other.has_hy,
+                                                other.has_cy,
+                                                other.pack_directions);
+}
+
+void RNNPlan::Run(Handle& handle, const RNNPlanArgs& args) const
+{
+    float ctime = 0.;
+    for(std::size_t i = 0; i < steps.size(); i++)
+    {
+        steps[i](handle, args);
+        // Update time
+        profileRNNkernels(handle, i == 0 ? 0 : (i + 1 == steps.size() ? 2 : 1), ctime);
+    }
+}
+
+std::shared_ptr<const RNNPlan> RNNPlanCache::Find(const RNNPlanShape& shape) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = plans.find(shape);
+    if(it == plans.end())
+        return nullptr;
+    return it->second;
+}
+
+void RNNPlanCache::Add(const RNNPlanShape& shape, std::shared_ptr<const RNNPlan> plan)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    // Variable-length workloads can produce an unbounded number of batch profiles; start
+    // over instead of growing without limit.
+    if(plans.size() >= max_size)
+        plans.clear();
+    plans[shape] = std::move(plan);
+}
+
 size_t RNNDescriptor::biasOffsetCalculation(const TensorDescriptor& /*xDesc*/,
                                             const int layer,
                                             const int biasID)
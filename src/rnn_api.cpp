@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <vector>
 
@@ -114,6 +115,7 @@ extern "C" miopenStatus_t miopenGetRNNWorkspaceSize(miopenHandle_t handle,
                                                     const miopenTensorDescriptor_t* xDesc,
                                                     size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, sequenceLen, xDesc, numBytes);
     miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
     return miopen::try_([&] {
@@ -128,6 +130,7 @@ extern "C" miopenStatus_t miopenGetRNNTrainingReserveSize(miopenHandle_t handle,
                                                           const miopenTensorDescriptor_t* xDesc,
                                                           size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, sequenceLen, xDesc, numBytes);
     miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
     return miopen::try_([&] {
@@ -142,6 +145,7 @@ extern "C" miopenStatus_t miopenGetRNNParamsDescriptor(miopenHandle_t handle,
                                                        miopenTensorDescriptor_t wDesc,
                                                        miopenDataType_t dtype)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, wDesc, dtype);
     return miopen::try_([&] {
         miopen::deref(rnnDesc).GetParamsDescriptor(
@@ -155,6 +159,7 @@ extern "C" miopenStatus_t miopenGetRNNParamsSize(miopenHandle_t handle,
                                                  size_t* numBytes,
                                                  miopenDataType_t dtype)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, numBytes, dtype);
     return miopen::try_([&] {
         miopen::deref(numBytes) = miopen::deref(rnnDesc).GetParamsSize(
@@ -168,6 +173,7 @@ extern "C" miopenStatus_t miopenGetRNNInputTensorSize(miopenHandle_t handle,
                                                       miopenTensorDescriptor_t* xDesc,
                                                       size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, seqLen, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(seqLen)};
     return miopen::try_([&] {
@@ -182,6 +188,7 @@ extern "C" miopenStatus_t miopenGetRNNHiddenTensorSize(miopenHandle_t handle,
                                                        miopenTensorDescriptor_t* xDesc,
                                                        size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, xDesc, numBytes);
     miopen::c_array_view<miopenTensorDescriptor_t> xDescArray{xDesc, size_t(seqLen)};
     return miopen::try_([&] {
@@ -197,6 +204,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerParamSize(miopenHandle_t handle,
                                                      const int paramID,
                                                      size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, paramID, numBytes);
     return miopen::try_([&] {
         miopen::deref(numBytes) = miopen::deref(rnnDesc).GetLayerParamSize(
@@ -210,6 +218,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerBiasSize(miopenHandle_t handle,
                                                     const int biasID,
                                                     size_t* numBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, biasID, numBytes);
     return miopen::try_([&] {
         miopen::deref(numBytes) =
@@ -227,6 +236,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerParam(miopenHandle_t handle,
                                                  miopenTensorDescriptor_t paramDesc,
                                                  void* layerParam)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, paramID, paramDesc, layerParam);
     return miopen::try_([&] {
         miopen::deref(rnnDesc).GetLayerParam(miopen::deref(handle),
@@ -250,6 +260,7 @@ extern "C" miopenStatus_t miopenGetRNNLayerBias(miopenHandle_t handle,
                                                 miopenTensorDescriptor_t biasDesc,
                                                 void* layerBias)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, biasID, biasDesc, layerBias);
     return miopen::try_([&] {
         miopen::deref(rnnDesc).GetLayerBias(miopen::deref(handle),
@@ -301,6 +312,7 @@ extern "C" miopenStatus_t miopenSetRNNLayerParam(miopenHandle_t handle,
                                                  miopenTensorDescriptor_t paramDesc,
                                                  const void* layerParam)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, paramID, paramDesc, layerParam);
     return miopen::try_([&] {
         miopen::deref(rnnDesc).SetLayerParam(miopen::deref(handle),
@@ -324,6 +336,7 @@ extern "C" miopenStatus_t miopenSetRNNLayerBias(miopenHandle_t handle,
                                                 miopenTensorDescriptor_t biasDesc,
                                                 const void* layerBias)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc, layer, xDesc, wDesc, w, biasID, biasDesc, layerBias);
     return miopen::try_([&] {
         miopen::deref(rnnDesc).SetLayerBias(miopen::deref(handle),
@@ -359,6 +372,7 @@ extern "C" miopenStatus_t miopenRNNForwardTraining(miopenHandle_t handle,
                                                    void* reserveSpace,
                                                    size_t reserveSpaceNumBytes)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(rnnDesc,
                         sequenceLen,
@@ -435,6 +449,7 @@ extern "C" miopenStatus_t miopenRNNBackwardData(miopenHandle_t handle,
                                                 void* reserveSpace,
                                                 size_t reserveSpaceNumBytes)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(rnnDesc,
                         sequenceLen,
                         yDesc,
@@ -568,6 +583,7 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
                                                     void* workSpace,
                                                     size_t workSpaceNumBytes)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(rnnDesc,
                         sequenceLen,
@@ -25,8 +25,10 @@
  *******************************************************************************/
 #include <miopen/softmax.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/float_equal.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/tensor_ops.hpp>
 
@@ -38,16 +40,92 @@ extern "C" miopenStatus_t miopenSoftmaxForward(miopenHandle_t handle,
                                                const miopenTensorDescriptor_t yDesc,
                                                void* y)
 {
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y);
     return miopen::try_([&] {
+        // The kernel reads packed x directly; other inputs are first gathered into y.
+        if(miopen::deref(xDesc).IsPacked())
+        {
+            miopen::SoftmaxForward(miopen::deref(handle),
+                                   alpha,
+                                   beta,
+                                   miopen::deref(xDesc),
+                                   DataCast(x),
+                                   miopen::deref(yDesc),
+                                   DataCast(y));
+            return;
+        }
+        // Gathering x overwrites the y that beta would blend in
+        if(!miopen::float_equal(*(static_cast<const float*>(beta)), 0))
+            MIOPEN_THROW(miopenStatusNotImplemented, "beta must be 0 for non-packed x");
         CopyTensor(miopen::deref(handle),
                    miopen::deref(xDesc),
                    DataCast(x),
                    miopen::deref(yDesc),
                    DataCast(y));
 
-        miopen::SoftmaxForward(
-            miopen::deref(handle), alpha, beta, miopen::deref(yDesc), DataCast(y));
+        miopen::SoftmaxForward(miopen::deref(handle),
+                               alpha,
+                               beta,
+                               miopen::deref(yDesc),
+                               DataCast(y),
+                               miopen::deref(yDesc),
+                               DataCast(y));
+    });
+}
+
+extern "C" miopenStatus_t miopenSoftmaxForward_V2(miopenHandle_t handle,
+                                                  const void* alpha,
+                                                  const miopenTensorDescriptor_t xDesc,
+                                                  const void* x,
+                                                  const void* beta,
+                                                  const miopenTensorDescriptor_t yDesc,
+                                                  void* y,
+                                                  miopenSoftmaxAlgorithm_t algorithm)
+{
+    MIOPEN_TRACE_API();
+    MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y, algorithm);
+    return miopen::try_([&] {
+        miopen::SoftmaxForward(miopen::deref(handle),
+                               alpha,
+                               beta,
+                               miopen::deref(xDesc),
+                               DataCast(x),
+                               miopen::deref(yDesc),
+                               DataCast(y),
+                               algorithm);
+    });
+}
+
+extern "C" miopenStatus_t miopenScaledMaskedSoftmaxForward(miopenHandle_t handle,
+                                                           const void* alpha,
+                                                           const miopenTensorDescriptor_t xDesc,
+                                                           const void* x,
+                                                           float scale,
+                                                           const miopenTensorDescriptor_t maskDesc,
+                                                           const void* mask,
+                                                           const void* beta,
+                                                           const miopenTensorDescriptor_t yDesc,
+                                                           void* y,
+                                                           miopenSoftmaxAlgorithm_t algorithm)
+{
+    MIOPEN_TRACE_API();
+    MIOPEN_LOG_FUNCTION(alpha, xDesc, x, scale, maskDesc, mask, beta, yDesc, y, algorithm);
+    return miopen::try_([&] {
+        if((mask == nullptr) != (maskDesc == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "The mask and its descriptor must be given together");
+        miopen::ScaledMaskedSoftmaxForward(
+            miopen::deref(handle),
+            alpha,
+            beta,
+            miopen::deref(xDesc),
+            DataCast(x),
+            scale,
+            mask == nullptr ? miopen::deref(xDesc) : miopen::deref(maskDesc),
+            mask == nullptr ? nullptr : DataCast(mask),
+            miopen::deref(yDesc),
+            DataCast(y),
+            algorithm);
     });
 }
 
@@ -62,8 +140,26 @@ miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
                                      void* dx)
 {
 
+    MIOPEN_TRACE_API();
     MIOPEN_LOG_FUNCTION(alpha, yDesc, y, dyDesc, dy, beta, dxDesc, dx);
     return miopen::try_([&] {
+        // The kernel reads packed dy directly; other gradients are first gathered into dx.
+        if(miopen::deref(dyDesc).IsPacked())
+        {
+            miopen::SoftmaxBackward(miopen::deref(handle),
+                                    alpha,
+                                    miopen::deref(yDesc),
+                                    DataCast(y),
+                                    miopen::deref(dyDesc),
+                                    DataCast(dy),
+                                    beta,
+                                    miopen::deref(dxDesc),
+                                    DataCast(dx));
+            return;
+        }
+        // Gathering dy overwrites the dx that beta would blend in
+        if(!miopen::float_equal(*(static_cast<const float*>(beta)), 0))
+            MIOPEN_THROW(miopenStatusNotImplemented, "beta must be 0 for non-packed dy");
         CopyTensor(miopen::deref(handle),
                    miopen::deref(dyDesc),
                    DataCast(dy),
@@ -74,8 +170,37 @@ miopenStatus_t miopenSoftmaxBackward(miopenHandle_t handle,
                                 alpha,
                                 miopen::deref(yDesc),
                                 DataCast(y),
+                                miopen::deref(dxDesc),
+                                DataCast(dx),
                                 beta,
                                 miopen::deref(dxDesc),
                                 DataCast(dx));
     });
 }
+
+extern "C" miopenStatus_t miopenSoftmaxBackward_V2(miopenHandle_t handle,
+                                                   const void* alpha,
+                                                   const miopenTensorDescriptor_t yDesc,
+                                                   const void* y,
+                                                   const miopenTensorDescriptor_t dyDesc,
+                                                   const void* dy,
+                                                   const void* beta,
+                                                   const miopenTensorDescriptor_t dxDesc,
+                                                   void* dx,
+                                                   miopenSoftmaxAlgorithm_t algorithm)
+{
+    MIOPEN_TRACE_API();
+    MIOPEN_LOG_FUNCTION(alpha, yDesc, y, dyDesc, dy, beta, dxDesc, dx, algorithm);
+    return miopen::try_([&] {
+        miopen::SoftmaxBackward(miopen::deref(handle),
+                                alpha,
+                                miopen::deref(yDesc),
+                                DataCast(y),
+                                miopen::deref(dyDesc),
+                                DataCast(dy),
+                                beta,
+                                miopen::deref(dxDesc),
+                                DataCast(dx),
+                                algorithm);
+    });
+}
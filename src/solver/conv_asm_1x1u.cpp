@@ -248,57 +248,116 @@ bool PerformanceConfigConvAsm1x1U::IsValidValue() const
         && IsTwoPower<1,8>(waves_k_in_group); // clang-format on
 }
 
-bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) const
+// The constraints of a valid config, which IsValid() checks one config against and Space()
+// enumerates.
+static void AddConstraints(PerfSpace<PerformanceConfigConvAsm1x1U>& space,
+                           const ConvolutionContext& config)
 {
-    const auto elements_in_dword = 4 / GetTypeSize(config.in_data_type);
+    using Config = PerformanceConfigConvAsm1x1U;
+
+    const auto elements_in_dword = static_cast<int>(4 / GetTypeSize(config.in_data_type));
+    const auto n_inputs          = config.n_inputs;
+    const auto n_outputs         = config.n_outputs;
+    const auto img_hw            = config.out_height * config.out_width;
+    const auto batch_sz          = config.batch_sz;
+    const auto is_backward_data  = config.direction.IsBackwardData();
+
+    const auto vgprs = [=](const Config& c) {
+        const auto in_gprs =
+            (c.chunks_per_wave * c.n_mult * c.c_mult + elements_in_dword - 1) / elements_in_dword;
+        const auto acc_gprs = c.chunks_per_wave * c.n_mult * c.k_mult;
+        // TODO last vgpr only for old card.
+        // ADD if(option.machine_version_major == 9)
+        // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
+        // else
+        return 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1 : 0) + 1;
+    };
+
+    // clang-format off
+    space.Constraint({"read_size", "chunks_per_wave"}, [=](const Config& c) {
+            return c.read_size * elements_in_dword <= c.chunks_per_wave; })
+        .Constraint({"waves_c_in_group"}, [=](const Config& c) {
+            return c.waves_c_in_group <= n_inputs; })
+        .Constraint({"k_mult", "waves_k_in_group"}, [=](const Config& c) {
+            return c.k_mult * c.waves_k_in_group <= n_outputs; })
+        .Constraint({"waves_c_in_group", "waves_k_in_group"}, [](const Config& c) {
+            return c.waves_c_in_group * c.waves_k_in_group <= 16; })
+        .Constraint({"c_mult"}, [=](const Config& c) {
+            return c.c_mult % elements_in_dword == 0; })
+        .Constraint({"k_mult"}, [=](const Config& c) {
+            return c.k_mult % elements_in_dword == 0; })
+        .Constraint({"chunks_per_wave"}, [=](const Config& c) {
+            return c.chunks_per_wave % elements_in_dword == 0; })
+        .Constraint({"chunks_per_wave", "n_mult", "c_mult", "k_mult"}, [=](const Config& c) {
+            return vgprs(c) < 256; })
+        .Constraint({"chunks_per_wave", "n_mult", "c_mult", "k_mult",
+                     "waves_c_in_group", "waves_k_in_group"}, [=](const Config& c) {
+            const auto max_waves_per_CU = (256 / vgprs(c)) * 4;
+            return max_waves_per_CU >= c.waves_c_in_group * c.waves_k_in_group; })
+        .Constraint({"k_mult", "c_mult"}, [](const Config& c) {
+            /// \todo This is valid for Gfx8 and Gfx9. Check for newer parts.
+            return 25 + 2 * c.k_mult * c.c_mult < 102; })
+        .Constraint({"n_mult", "chunk_size"}, [=](const Config& c) {
+            const int total_n_blocks = (batch_sz + c.GetNPerGpr() - 1) / c.GetNPerGpr();
+            return c.n_mult <= total_n_blocks; })
+        .Constraint({"chunks_per_wave", "chunk_size"}, [=](const Config& c) {
+            const int total_chunks = (img_hw + c.chunk_size - 1) / c.chunk_size;
+            return c.chunks_per_wave <= total_chunks; })
+        .Constraint({"waves_c_in_group", "c_mult"}, [=](const Config& c) {
+            const int c_per_wave      = (n_inputs + c.waves_c_in_group - 1) / c.waves_c_in_group;
+            const int c_per_last_wave = n_inputs - (c_per_wave * (c.waves_c_in_group - 1));
+            return c_per_wave % c.c_mult == 0 && c_per_last_wave % c.c_mult == 0; })
+        .Constraint({"k_mult"}, [=](const Config& c) {
+            return !is_backward_data || n_outputs % c.k_mult == 0; });
+    // clang-format on
+}
 
+bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) const
+{
     if(!IsValidValue())
         return false;
-    if(!(read_size * elements_in_dword <= chunks_per_wave))
-        return false;
-    if(!(waves_c_in_group <= config.n_inputs))
-        return false;
-    if(!(k_mult * waves_k_in_group <= config.n_outputs))
-        return false;
-    if(!(waves_c_in_group * waves_k_in_group <= 16))
-        return false;
-    if((c_mult % elements_in_dword) != 0)
-        return false;
-    if((k_mult % elements_in_dword) != 0)
-        return false;
-    if(chunks_per_wave % elements_in_dword != 0)
-        return false;
-    const auto in_gprs =
-        (chunks_per_wave * n_mult * c_mult + elements_in_dword - 1) / elements_in_dword;
-    const auto acc_gprs = chunks_per_wave * n_mult * k_mult;
-    const auto img_hw   = config.out_height * config.out_width;
-    // TODO last vgpr only for old card.
-    // ADD if(option.machine_version_major == 9)
-    // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
-    // else
-    const auto vgprs = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1 : 0) + 1;
-    if(!(vgprs < 256))
-        return false;
-    const auto max_waves_per_CU = (256 / vgprs) * 4;
-    if(!(max_waves_per_CU >= waves_c_in_group * waves_k_in_group))
-        return false;
-    const auto sgprs = 25 + 2 * k_mult * c_mult;
-    if(!(sgprs < 102)) /// \todo This is valid for Gfx8 and Gfx9. Check for newer parts.
-        return false;
-    const int total_n_blocks = (config.batch_sz + GetNPerGpr() - 1) / GetNPerGpr();
-    if(!(n_mult <= total_n_blocks))
-        return false;
+    PerfSpace<PerformanceConfigConvAsm1x1U> constraints{*this};
+    AddConstraints(constraints, config);
+    return constraints.IsSatisfied(*this);
+}
 
-    const int total_chunks = (img_hw + chunk_size - 1) / chunk_size;
-    if(!(chunks_per_wave <= total_chunks))
-        return false;
+PerfSpace<PerformanceConfigConvAsm1x1U>
+PerformanceConfigConvAsm1x1U::Space(const ConvolutionContext& config, const bool spare)
+{
+    using Config = PerformanceConfigConvAsm1x1U;
+    PerfSpace<Config> space{Config{spare}};
 
-    const int c_per_wave      = (config.n_inputs + waves_c_in_group - 1) / waves_c_in_group;
-    const int c_per_last_wave = config.n_inputs - (c_per_wave * (waves_c_in_group - 1));
+    // Same sets and order as SetNextValue()
+    if(!miopen::IsDisabled(MIOPEN_DEBUG_GCN_ASM_DIRECT_1X1U_SEARCH_OPTIMIZED{}))
+    {
+        const std::vector<int> spare_values = {1, 4};
+        space.Domain("read_size", LinearDomain(1, 4))
+            .Domain("k_mult", spare ? spare_values : TwoPowerDomain(8, 32))
+            .Domain("chunks_per_wave", LinearDomain(1, 8))
+            .Domain("chunk_size", spare ? spare_values : TwoPowerDomain(16, 64))
+            .Domain("n_mult", LinearDomain(1, 4))
+            .Domain("c_mult", TwoPowerDomain(1, 4))
+            .Domain("waves_c_in_group", TwoPowerDomain(1, 4))
+            .Domain("waves_k_in_group", TwoPowerDomain(1, 8));
+    }
+    else
+    {
+        auto k_mult = LinearDomain(1, 8);
+        for(auto& v : k_mult)
+            v *= 4;
+        k_mult.insert(k_mult.begin(), 1);
+        space.Domain("read_size", LinearDomain(1, 4))
+            .Domain("k_mult", k_mult)
+            .Domain("chunks_per_wave", LinearDomain(1, 16))
+            .Domain("chunk_size", TwoPowerDomain(1, 64))
+            .Domain("n_mult", LinearDomain(1, 8))
+            .Domain("c_mult", TwoPowerDomain(1, 32))
+            .Domain("waves_c_in_group", LinearDomain(1, 8))
+            .Domain("waves_k_in_group", TwoPowerDomain(1, 8));
+    }
 
-    if(config.direction.IsBackwardData() && !(config.n_outputs % k_mult == 0))
-        return false;
-    return (c_per_wave % c_mult == 0) && (c_per_last_wave % c_mult == 0);
+    AddConstraints(space, config);
+    return space;
 }
 
 void PerformanceConfigConvAsm1x1U::EuristicInit(const ConvolutionContext& config)
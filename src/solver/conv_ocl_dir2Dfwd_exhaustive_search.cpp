@@ -30,8 +30,10 @@
 #include <miopen/db_path.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
+#include <miopen/measure_time.hpp>
 #include <miopen/mlo_utils.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/tuning_session.hpp>
 
 #include <half.hpp>
 
@@ -135,7 +137,8 @@ static int MeasurePerfConfig(Handle* profile_h,
                              Data_t bias_ocl_buf,
                              double& processing_time,
                              const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& result)
+                             const LegacyPerformanceConfig& result,
+                             const double best_time = std::numeric_limits<double>::max())
 {
     ConvSolution kernel_search_result{miopenStatusNotInitialized};
 
@@ -181,15 +184,22 @@ static int MeasurePerfConfig(Handle* profile_h,
                                           kernel_params.g_wk,
                                           compiler_options);
 
-            if(params.bias)
-            {
-                k(bot_ocl_buf, wei_ocl_buf, bias_ocl_buf, top_ocl_buf, padding_value);
-            }
-            else
-            {
-                k(bot_ocl_buf, wei_ocl_buf, top_ocl_buf, padding_value);
-            }
-            processing_time = profile_h->GetKernelTime();
+            const auto timing = MeasureTime(
+                [&](float& time) {
+                    if(params.bias)
+                    {
+                        k(bot_ocl_buf, wei_ocl_buf, bias_ocl_buf, top_ocl_buf, padding_value);
+                    }
+                    else
+                    {
+                        k(bot_ocl_buf, wei_ocl_buf, top_ocl_buf, padding_value);
+                    }
+                    time = profile_h->GetKernelTime();
+                    return 0;
+                },
+                best_time < std::numeric_limits<float>::max() ? static_cast<float>(best_time)
+                                                              : std::numeric_limits<float>::max());
+            processing_time = timing.time;
         }
         else
         {
@@ -262,7 +272,9 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     LegacyPerformanceConfig result;
     bool is_passed = false;
 
-    miopen::Handle profile_h;
+    const TuningSession::Scope session_scope;
+    auto& session          = session_scope.Get();
+    auto& profile_h        = session.GetHandle();
     double processing_time = std::numeric_limits<double>::max();
 
     LegacyPerformanceConfig candidate;
@@ -280,50 +292,18 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     profile_h.EnableProfiling();
 
     // allocate tem input/output buffers
-    size_t bot_sz = params.bot_sz / sizeof(Tgpu);
-    std::vector<Tgpu> bot_sys_buf(bot_sz);
-
-    for(size_t i = 0; i < bot_sz; i++)
-    {
-        bot_sys_buf[i] = static_cast<Tgpu>(rand() * (1.0 / RAND_MAX));
-    }
-
-    auto bot_ocl_buf = profile_h.Write(bot_sys_buf);
-
-    size_t top_sz = params.top_sz / sizeof(Tgpu);
-    std::vector<Tgpu> top_sys_buf(top_sz);
-
-    auto top_ocl_buf = profile_h.Write(top_sys_buf);
-
-    std::vector<Tgpu> random_top_sys_buf(top_sz);
-    for(size_t i = 0; i < top_sz; i++)
-    {
-        random_top_sys_buf[i] = static_cast<Tgpu>(rand() * (1.0 / RAND_MAX));
-    }
-
-    size_t weights_sz = params.weights_sz / sizeof(Tgpu);
-    std::vector<Tgpu> wei_sys_buf(weights_sz);
-    for(size_t i = 0; i < weights_sz; i++)
-    {
-        wei_sys_buf[i] = static_cast<Tgpu>((rand() * (1.0 / RAND_MAX) - 0.5) * 0.001);
-    }
-
-    auto wei_ocl_buf = profile_h.Write(wei_sys_buf);
-
-    std::vector<Tgpu> bias_sys_buf;
-    miopen::Allocator::ManageDataPtr bias_ocl_buf = nullptr;
-
-    if(params.bias != 0)
-    {
-        size_t bias_sz = params.bias_sz / sizeof(Tgpu);
-        bias_sys_buf   = std::vector<Tgpu>(bias_sz);
-        for(size_t i = 0; i < bias_sz; i++)
-        {
-            bias_sys_buf[i] = static_cast<Tgpu>(rand() * (1.0 / RAND_MAX));
-        }
-
-        bias_ocl_buf = profile_h.Write(bias_sys_buf);
-    }
+    using Contents = TuningSession::Contents;
+    using Operand  = TuningSession::Operand;
+    const auto bot_ocl_buf =
+        session.GetBuffer<Tgpu>(Operand::Bot, params.bot_sz / sizeof(Tgpu), Contents::Uniform);
+    const auto top_ocl_buf =
+        session.GetBuffer<Tgpu>(Operand::Top, params.top_sz / sizeof(Tgpu), Contents::Output);
+    const auto wei_ocl_buf = session.GetBuffer<Tgpu>(
+        Operand::Weights, params.weights_sz / sizeof(Tgpu), Contents::Weights);
+    const auto bias_ocl_buf =
+        params.bias == 0 ? nullptr : session.GetBuffer<Tgpu>(Operand::Bias,
+                                                             params.bias_sz / sizeof(Tgpu),
+                                                             Contents::Uniform);
 
     // search loop here
     int grp_tl_ln[4]       = {8, 16, 32};
@@ -480,13 +460,14 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
 
                         const auto ret =
                             MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(&profile_h,
-                                                                         bot_ocl_buf.get(),
-                                                                         top_ocl_buf.get(),
-                                                                         wei_ocl_buf.get(),
-                                                                         bias_ocl_buf.get(),
+                                                                         bot_ocl_buf,
+                                                                         top_ocl_buf,
+                                                                         wei_ocl_buf,
+                                                                         bias_ocl_buf,
                                                                          processing_time,
                                                                          params,
-                                                                         result);
+                                                                         result,
+                                                                         min_proc_time);
                         --runs_left;
                         if(ret != 0)
                         {
@@ -622,13 +603,14 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
 
                                     const auto ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(
                                         &profile_h,
-                                        bot_ocl_buf.get(),
-                                        top_ocl_buf.get(),
-                                        wei_ocl_buf.get(),
-                                        bias_ocl_buf.get(),
+                                        bot_ocl_buf,
+                                        top_ocl_buf,
+                                        wei_ocl_buf,
+                                        bias_ocl_buf,
                                         processing_time,
                                         params,
-                                        result);
+                                        result,
+                                        min_proc_time);
 
                                     --runs_left;
                                     if(ret != 0)
@@ -679,10 +661,10 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
                1) // Group conv: None 1x1 version yet, fallback to universal kernel.
         {
             ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(&profile_h,
-                                                               bot_ocl_buf.get(),
-                                                               top_ocl_buf.get(),
-                                                               wei_ocl_buf.get(),
-                                                               bias_ocl_buf.get(),
+                                                               bot_ocl_buf,
+                                                               top_ocl_buf,
+                                                               wei_ocl_buf,
+                                                               bias_ocl_buf,
                                                                default_time,
                                                                params,
                                                                default_config);
@@ -690,10 +672,10 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
         else
         {
             ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(&profile_h,
-                                                            bot_ocl_buf.get(),
-                                                            top_ocl_buf.get(),
-                                                            wei_ocl_buf.get(),
-                                                            bias_ocl_buf.get(),
+                                                            bot_ocl_buf,
+                                                            top_ocl_buf,
+                                                            wei_ocl_buf,
+                                                            bias_ocl_buf,
                                                             default_time,
                                                             params,
                                                             default_config);
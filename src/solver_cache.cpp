@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_cache.hpp>
+#include <miopen/env.hpp>
+#include <miopen/mlo_internal.hpp>
+
+#include <atomic>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SOLVER_CACHE)
+
+namespace miopen {
+
+std::string GetSolverCacheKey(const ConvolutionContext& context)
+{
+    const auto sep = '-';
+    std::ostringstream ss;
+    ss << context.GetStream().GetDbPathFilename() << sep;
+    context.Serialize(ss);
+    // clang-format off
+    ss << sep << context.out_layout << sep << context.weights_layout
+       << sep << context.in_stride << 'x' << context.in_channel_stride
+              << 'x' << context.in_batch_stride
+       << sep << context.out_stride << 'x' << context.out_channel_stride
+              << 'x' << context.out_batch_stride
+       << sep << context.bot_sz << 'x' << context.top_sz
+              << 'x' << context.weights_sz << 'x' << context.bias_sz
+       << sep << context.deconvolution
+       << sep << context.use_asm_kernels << context.use_binaries << static_cast<int>(context.rmv)
+              << context.workaround_disable_search_enforce
+       << sep << context.general_compile_options; // clang-format on
+    return ss.str();
+}
+
+static std::atomic<std::size_t>& solver_cache_epoch()
+{
+    static std::atomic<std::size_t> epoch{0};
+    return epoch;
+}
+
+std::size_t GetSolverCacheEpoch() { return solver_cache_epoch().load(); }
+
+void InvalidateSolverCaches() { ++solver_cache_epoch(); }
+
+bool IsSolverCacheEnabled() { return !IsDisabled(MIOPEN_DEBUG_SOLVER_CACHE{}); }
+
+} // namespace miopen
@@ -33,10 +33,10 @@
 
 namespace miopen {
 
-TensorDescriptor::TensorDescriptor() : packed(true) {}
+TensorDescriptor::TensorDescriptor() {}
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, std::initializer_list<std::size_t> plens)
-    : lens(plens), packed(true), type(t)
+    : lens(plens), type(t)
 {
     this->CalculateStrides();
 }
@@ -46,11 +46,11 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::initializer_list<std::size_t> pstrides)
     : lens(plens), strides(pstrides), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateDerived();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, const int* plens, int size)
-    : lens(plens, plens + size), packed(true), type(t)
+    : lens(plens, plens + size), type(t)
 {
     if(!std::all_of(plens, plens + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
@@ -66,15 +66,43 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
     if(!std::all_of(pstrides, pstrides + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid strides. Strides must be greater than 0.");
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateDerived();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::vector<std::size_t> lens_in,
                                    std::vector<std::size_t> strides_in)
-    : lens(std::move(lens_in)), strides(std::move(strides_in)), type(t)
+    : lens(lens_in), strides(strides_in), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateDerived();
+}
+
+TensorDescriptor::TensorDescriptor(miopenDataType_t t,
+                                   miopenTensorLayout_t layout,
+                                   std::vector<std::size_t> lens_in)
+    : lens(lens_in), type(t)
+{
+    const bool is_5d = (layout == miopenTensorNCDHW || layout == miopenTensorNDHWC);
+    if(lens.size() != (is_5d ? 5 : 4))
+        MIOPEN_THROW(miopenStatusBadParm, "Number of lengths does not match the tensor layout.");
+
+    if(layout == miopenTensorNCHW || layout == miopenTensorNCDHW)
+    {
+        this->CalculateStrides();
+        return;
+    }
+
+    // Channels-last: C is innermost, followed by the spatial dimensions from W outwards, then N
+    strides.resize(lens.size());
+    strides[1]         = 1;
+    std::size_t stride = lens[1];
+    for(std::size_t i = lens.size() - 1; i >= 2; --i)
+    {
+        strides[i] = stride;
+        stride *= lens[i];
+    }
+    strides[0] = stride;
+    this->UpdateDerived();
 }
 
 void TensorDescriptor::CalculateStrides()
@@ -86,22 +114,24 @@ void TensorDescriptor::CalculateStrides()
     strides.back() = 1;
     std::partial_sum(
         lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
+    this->UpdateDerived();
 }
 
-const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return lens; }
-const std::vector<std::size_t>& TensorDescriptor::GetStrides() const { return strides; }
-int TensorDescriptor::GetSize() const
-{
-    assert(lens.size() == strides.size());
-    return lens.size();
-}
-std::size_t TensorDescriptor::GetElementSize() const
+void TensorDescriptor::UpdateDerived()
 {
-    assert(lens.size() == strides.size());
-    return std::accumulate(
-        lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    if(lens.size() != strides.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Lengths and strides must have the same size.");
+    element_size  = 1;
+    element_space = 1;
+    for(std::size_t i = 0; i < lens.size(); i++)
+    {
+        element_size *= lens[i];
+        element_space += (lens[i] - 1) * strides[i];
+    }
+    packed = (element_size == element_space);
 }
-miopenDataType_t TensorDescriptor::GetType() const { return this->type; }
+
+int TensorDescriptor::GetSize() const { return lens.size(); }
 
 std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
 {
@@ -109,19 +139,6 @@ std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
     return std::inner_product(l.begin(), l.end(), strides.begin(), std::size_t{0});
 }
 
-std::size_t TensorDescriptor::GetElementSpace() const
-{
-    std::vector<std::size_t> maxIndices(lens.size());
-    std::transform(lens.begin(),
-                   lens.end(),
-                   std::vector<std::size_t>(lens.size(), 1).begin(),
-                   maxIndices.begin(),
-                   std::minus<std::size_t>());
-    return std::inner_product(
-               maxIndices.begin(), maxIndices.end(), strides.begin(), std::size_t{0}) +
-           1;
-}
-
 std::size_t TensorDescriptor::GetNumBytes() const
 {
     std::size_t typesize = 0;
@@ -136,11 +153,42 @@ std::size_t TensorDescriptor::GetNumBytes() const
     return typesize * this->GetElementSpace();
 }
 
-bool TensorDescriptor::IsPacked() const { return this->packed; }
+std::string TensorDescriptor::GetLayout(std::string labels) const
+{
+    if(labels.size() != lens.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Layout labels do not match the number of dimensions.");
+    if(labels.size() < 3)
+        return labels;
+
+    // A candidate fits if, walking its dimensions from outermost to innermost, every stride
+    // spans at least the full extent of the next dimension in.
+    const auto fits = [&](const std::string& layout) {
+        for(std::size_t i = 0; i + 1 < layout.size(); i++)
+        {
+            const auto outer = labels.find(layout[i]);
+            const auto inner = labels.find(layout[i + 1]);
+            if(strides[outer] < strides[inner] * lens[inner])
+                return false;
+        }
+        return true;
+    };
+
+    const std::string channels_last = labels.substr(0, 1) + labels.substr(2) + labels[1];
+    if(fits(labels) || !fits(channels_last))
+        return labels;
+    return channels_last;
+}
+
+bool TensorDescriptor::IsDefaultLayout() const
+{
+    if(lens.size() != 4 && lens.size() != 5)
+        return true;
+    const std::string labels = lens.size() == 4 ? "NCHW" : "NCDHW";
+    return this->GetLayout(labels) == labels;
+}
 
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
 {
-    assert(this->lens.size() == rhs.strides.size());
     return this->type == rhs.type && this->lens == rhs.lens && this->strides == rhs.strides;
 }
 
@@ -23,13 +23,16 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <array>
 #include <initializer_list>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/tensor_expr.hpp>
 
 extern "C" miopenStatus_t miopenCreateTensorDescriptor(miopenTensorDescriptor_t* tensorDesc)
 {
@@ -139,6 +142,25 @@ extern "C" miopenStatus_t miopenSetTensorDescriptor(miopenTensorDescriptor_t ten
     });
 }
 
+extern "C" miopenStatus_t
+miopenSetNdTensorDescriptorWithLayout(miopenTensorDescriptor_t tensorDesc,
+                                      miopenDataType_t dataType,
+                                      miopenTensorLayout_t tensorLayout,
+                                      int* lens,
+                                      int num_lens)
+{
+
+    MIOPEN_LOG_FUNCTION(tensorDesc, dataType, tensorLayout, lens, num_lens);
+    return miopen::try_([&] {
+        if(lens == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Lengths cannot be NULL");
+        if(!std::all_of(lens, lens + num_lens, [](int x) { return x > 0; }))
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid length. Length must be greater than 0.");
+        miopen::deref(tensorDesc) = miopen::TensorDescriptor(
+            dataType, tensorLayout, std::vector<std::size_t>(lens, lens + num_lens));
+    });
+}
+
 extern "C" miopenStatus_t miopenGetTensorNumBytes(miopenTensorDescriptor_t tensorDesc,
                                                   size_t* numBytes)
 {
@@ -205,6 +227,7 @@ extern "C" miopenStatus_t miopenOpTensor(miopenHandle_t handle,
                                          const miopenTensorDescriptor_t cDesc,
                                          void* C)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(tensorOp, alpha1, aDesc, A, alpha2, bDesc, B, beta, cDesc, C);
     return miopen::try_([&] {
@@ -227,6 +250,7 @@ extern "C" miopenStatus_t miopenSetTensor(miopenHandle_t handle,
                                           void* y,
                                           const void* alpha)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(yDesc, y, alpha);
     return miopen::try_(
@@ -238,6 +262,7 @@ extern "C" miopenStatus_t miopenScaleTensor(miopenHandle_t handle,
                                             void* y,
                                             const void* alpha)
 {
+    MIOPEN_TRACE_API();
 
     MIOPEN_LOG_FUNCTION(yDesc, y, alpha);
     return miopen::try_(
@@ -252,6 +277,7 @@ extern "C" miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
                                                 const miopenTensorDescriptor_t yDesc,
                                                 void* y)
 {
+    MIOPEN_TRACE_API();
     // dstValue = alpha[0]*srcValue + beta[0]*priorDstValue
     MIOPEN_LOG_FUNCTION(alpha, xDesc, x, beta, yDesc, y);
     return miopen::try_([&] {
@@ -264,3 +290,99 @@ extern "C" miopenStatus_t miopenTransformTensor(miopenHandle_t handle,
                         DataCast(y));
     });
 }
+
+static float GetExpressionScalar(const void* p)
+{
+    if(p == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Scaling factor cannot be NULL");
+    return *static_cast<const float*>(p);
+}
+
+extern "C" miopenStatus_t miopenCreateTensorExpression(miopenTensorExpression_t* expr)
+{
+    MIOPEN_LOG_FUNCTION(expr);
+    return miopen::try_([&] { miopen::deref(expr) = new miopen::TensorExpression(); });
+}
+
+extern "C" miopenStatus_t miopenTensorExpressionAddTensor(miopenTensorExpression_t expr,
+                                                          const miopenTensorDescriptor_t tensorDesc,
+                                                          int* index)
+{
+    MIOPEN_LOG_FUNCTION(expr, tensorDesc, index);
+    return miopen::try_([&] {
+        miopen::deref(index) = miopen::deref(expr).AddTensor(miopen::deref(tensorDesc));
+    });
+}
+
+extern "C" miopenStatus_t miopenTensorExpressionAddOp(miopenTensorExpression_t expr,
+                                                      miopenTensorOp_t tensorOp,
+                                                      const void* alpha1,
+                                                      int a,
+                                                      const void* alpha2,
+                                                      int b,
+                                                      const void* beta,
+                                                      int c)
+{
+    MIOPEN_LOG_FUNCTION(expr, tensorOp, alpha1, a, alpha2, b, beta, c);
+    return miopen::try_([&] {
+        miopen::deref(expr).AddOp(tensorOp,
+                                  GetExpressionScalar(alpha1),
+                                  a,
+                                  GetExpressionScalar(alpha2),
+                                  b,
+                                  GetExpressionScalar(beta),
+                                  c);
+    });
+}
+
+extern "C" miopenStatus_t
+miopenTensorExpressionAddScale(miopenTensorExpression_t expr, int y, const void* alpha)
+{
+    MIOPEN_LOG_FUNCTION(expr, y, alpha);
+    return miopen::try_([&] {
+        miopen::deref(expr).AddScale(y, GetExpressionScalar(alpha));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenTensorExpressionAddSet(miopenTensorExpression_t expr, int y, const void* alpha)
+{
+    MIOPEN_LOG_FUNCTION(expr, y, alpha);
+    return miopen::try_([&] {
+        miopen::deref(expr).AddSet(y, GetExpressionScalar(alpha));
+    });
+}
+
+extern "C" miopenStatus_t
+miopenTensorExpressionAddCast(miopenTensorExpression_t expr, const void* alpha, int x, int y)
+{
+    MIOPEN_LOG_FUNCTION(expr, alpha, x, y);
+    return miopen::try_([&] {
+        miopen::deref(expr).AddCast(GetExpressionScalar(alpha), x, y);
+    });
+}
+
+extern "C" miopenStatus_t miopenExecuteTensorExpression(miopenHandle_t handle,
+                                                        const miopenTensorExpression_t expr,
+                                                        void* const* buffers,
+                                                        int numBuffers)
+{
+    MIOPEN_TRACE_API();
+
+    MIOPEN_LOG_FUNCTION(expr, buffers, numBuffers);
+    return miopen::try_([&] {
+        if(buffers == nullptr || numBuffers < 0)
+            MIOPEN_THROW(miopenStatusBadParm, "Invalid tensor expression buffers.");
+        std::vector<Data_t> data;
+        std::transform(buffers, buffers + numBuffers, std::back_inserter(data), [](void* p) {
+            return DataCast(p);
+        });
+        miopen::deref(expr).Run(miopen::deref(handle), data);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyTensorExpression(miopenTensorExpression_t expr)
+{
+    MIOPEN_LOG_FUNCTION(expr);
+    return miopen::try_([&] { miopen_destroy_object(expr); });
+}
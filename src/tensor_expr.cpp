@@ -0,0 +1,412 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tensor_expr.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <half.hpp>
+
+namespace miopen {
+
+// Type codes shared with MIOpenTensorExpr.cl and the SubTensorOpWithCastTensor kernels
+static int GetTypeCode(miopenDataType_t type)
+{
+    switch(type)
+    {
+    case miopenInt8: return 0;
+    case miopenInt32: return 1;
+    case miopenHalf: return 2;
+    case miopenFloat: return 3;
+    case miopenInt8x4: break;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Tensor expressions do not support this data type.");
+}
+
+static float LoadValue(miopenDataType_t type, const void* p, std::size_t i)
+{
+    switch(type)
+    {
+    case miopenInt8: return static_cast<const int8_t*>(p)[i];
+    case miopenInt32: return static_cast<float>(static_cast<const int32_t*>(p)[i]);
+    case miopenHalf: return static_cast<const half_float::half*>(p)[i];
+    case miopenFloat: return static_cast<const float*>(p)[i];
+    case miopenInt8x4: break;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Tensor expressions do not support this data type.");
+}
+
+template <class T>
+static T Truncate(float v)
+{
+    const auto lo = static_cast<float>(std::numeric_limits<T>::lowest());
+    const auto hi = static_cast<float>(std::numeric_limits<T>::max());
+    return static_cast<T>(std::min(std::max(v, lo), hi));
+}
+
+static void StoreValue(miopenDataType_t type, void* p, std::size_t i, float v)
+{
+    switch(type)
+    {
+    case miopenInt8: static_cast<int8_t*>(p)[i] = Truncate<int8_t>(v); return;
+    case miopenInt32: static_cast<int32_t*>(p)[i] = Truncate<int32_t>(v); return;
+    case miopenHalf: static_cast<half_float::half*>(p)[i] = half_float::half(v); return;
+    case miopenFloat: static_cast<float*>(p)[i] = v; return;
+    case miopenInt8x4: break;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Tensor expressions do not support this data type.");
+}
+
+// Value the unfused sequence would read back after storing v into a tensor of this type
+static float RoundValue(miopenDataType_t type, float v)
+{
+    switch(type)
+    {
+    case miopenInt8: return Truncate<int8_t>(v);
+    case miopenInt32: return static_cast<float>(Truncate<int32_t>(v));
+    case miopenHalf: return half_float::half(v);
+    case miopenFloat:
+    case miopenInt8x4: break;
+    }
+    return v;
+}
+
+// CastTensor clamps the scaled value to the largest value of the destination type
+static float SaturateValue(miopenDataType_t type, float v)
+{
+    float max_val = std::numeric_limits<float>::max();
+    switch(type)
+    {
+    case miopenInt8: max_val = std::numeric_limits<int8_t>::max(); break;
+    case miopenInt32: max_val = static_cast<float>(std::numeric_limits<int32_t>::max()); break;
+    case miopenHalf: max_val = 65504.0f; break;
+    case miopenFloat:
+    case miopenInt8x4: break;
+    }
+    return v >= max_val ? max_val : v;
+}
+
+static float ApplyStep(const TensorExprStep& step, float a, float b, float c)
+{
+    switch(step.op)
+    {
+    case TensorExprOp::Add: return step.alpha0 * a + step.alpha1 * b + step.beta * c;
+    case TensorExprOp::Mul: return (step.alpha0 * a) * (step.alpha1 * b) + step.beta * c;
+    case TensorExprOp::Min: return std::min(step.alpha0 * a, step.alpha1 * b) + step.beta * c;
+    case TensorExprOp::Max: return std::max(step.alpha0 * a, step.alpha1 * b) + step.beta * c;
+    case TensorExprOp::Scale: return step.alpha0 * c;
+    case TensorExprOp::Set: return step.alpha0;
+    case TensorExprOp::Cast: return step.alpha0 * a;
+    }
+    MIOPEN_THROW("Unknown tensor expression step");
+}
+
+int TensorExpression::AddTensor(const TensorDescriptor& desc)
+{
+    if(tensors.size() >= max_tensors)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "At most " + std::to_string(max_tensors) +
+                         " tensors are supported in a tensor expression.");
+    GetTypeCode(desc.GetType());
+
+    const auto& desc_lens = desc.GetLengths();
+    if(tensors.empty())
+    {
+        lens = desc_lens;
+    }
+    else
+    {
+        if(desc_lens.size() != lens.size())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "All tensors of an expression must have the same number of dimensions.");
+        for(std::size_t i = 0; i < lens.size(); ++i)
+        {
+            if(desc_lens[i] != lens[i] && desc_lens[i] != 1 && lens[i] != 1)
+                MIOPEN_THROW(miopenStatusBadParm,
+                             "Tensor lengths must match or be 1 in every dimension.");
+            lens[i] = std::max(lens[i], desc_lens[i]);
+        }
+    }
+
+    tensors.push_back(desc);
+    return static_cast<int>(tensors.size() - 1);
+}
+
+void TensorExpression::AddOp(
+    miopenTensorOp_t tensorOp, float alpha0, int a, float alpha1, int b, float beta, int c)
+{
+    if(tensorOp < miopenTensorOpAdd || tensorOp > miopenTensorOpMax)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown tensor operation.");
+    AddStep({static_cast<TensorExprOp>(tensorOp), c, a, b, alpha0, alpha1, beta});
+}
+
+void TensorExpression::AddScale(int y, float alpha)
+{
+    AddStep({TensorExprOp::Scale, y, y, y, alpha, 0.0f, 0.0f});
+}
+
+void TensorExpression::AddSet(int y, float alpha)
+{
+    AddStep({TensorExprOp::Set, y, y, y, alpha, 0.0f, 0.0f});
+}
+
+void TensorExpression::AddCast(float alpha, int x, int y)
+{
+    AddStep({TensorExprOp::Cast, y, x, x, alpha, 0.0f, 0.0f});
+}
+
+void TensorExpression::AddStep(const TensorExprStep& step)
+{
+    if(steps.size() >= max_steps)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "At most " + std::to_string(max_steps) +
+                         " steps are supported in a tensor expression.");
+    CheckIndex(step.dst);
+    CheckIndex(step.a);
+    CheckIndex(step.b);
+    steps.push_back(step);
+}
+
+void TensorExpression::CheckIndex(int i) const
+{
+    if(i < 0 || i >= static_cast<int>(tensors.size()))
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor expression operand out of range.");
+}
+
+void TensorExpression::Validate() const
+{
+    if(steps.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "Tensor expression has no steps.");
+    for(std::size_t i = 0; i < tensors.size(); ++i)
+    {
+        // Several work-items would race on a broadcast element
+        if(IsStored(i) && tensors[i].GetLengths() != lens)
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Tensor " + std::to_string(i) +
+                             " is written by the expression and cannot be broadcast.");
+    }
+}
+
+bool TensorExpression::IsLoaded(int i) const
+{
+    for(auto&& step : steps)
+    {
+        const bool reads_dst = step.op != TensorExprOp::Set && step.op != TensorExprOp::Cast;
+        const bool reads_ab  = step.op != TensorExprOp::Scale && step.op != TensorExprOp::Set;
+        if((reads_ab && (step.a == i || step.b == i)) || (reads_dst && step.dst == i))
+            return true;
+        if(step.dst == i)
+            return false;
+    }
+    return false;
+}
+
+bool TensorExpression::IsStored(int i) const
+{
+    return std::any_of(
+        steps.begin(), steps.end(), [&](const TensorExprStep& step) { return step.dst == i; });
+}
+
+TensorExprShape TensorExpression::GetFlattenedShape() const
+{
+    Validate();
+
+    TensorExprShape shape;
+    shape.strides.resize(tensors.size());
+
+    for(std::size_t d = 0; d < lens.size(); ++d)
+    {
+        if(lens[d] == 1)
+            continue;
+
+        TensorLengths dim_strides(tensors.size());
+        for(std::size_t t = 0; t < tensors.size(); ++t)
+            dim_strides[t] = tensors[t].GetLengths()[d] == 1 ? 0 : tensors[t].GetStrides()[d];
+
+        // Merge into the previous dimension when every operand steps through both contiguously
+        // or broadcasts both
+        const bool merge = !shape.lens.empty() && [&] {
+            for(std::size_t t = 0; t < tensors.size(); ++t)
+            {
+                if(shape.strides[t].back() != dim_strides[t] * lens[d])
+                    return false;
+            }
+            return true;
+        }();
+
+        if(merge)
+        {
+            shape.lens.back() *= lens[d];
+            for(std::size_t t = 0; t < tensors.size(); ++t)
+                shape.strides[t].back() = dim_strides[t];
+        }
+        else
+        {
+            if(shape.lens.size() == max_flat_dims)
+                MIOPEN_THROW(miopenStatusBadParm, "Tensor dimension sizes unsupported.");
+            shape.lens.push_back(lens[d]);
+            for(std::size_t t = 0; t < tensors.size(); ++t)
+                shape.strides[t].push_back(dim_strides[t]);
+        }
+    }
+
+    if(shape.lens.empty())
+    {
+        shape.lens.push_back(1);
+        for(auto& s : shape.strides)
+            s.push_back(0);
+    }
+    return shape;
+}
+
+std::string TensorExpression::GetNetworkConfig() const
+{
+    Validate();
+
+    std::string network_config = "texpr";
+    for(std::size_t i = 0; i < tensors.size(); ++i)
+    {
+        network_config += " t" + std::to_string(GetTypeCode(tensors[i].GetType())) +
+                          (IsLoaded(i) ? "l" : "") + (IsStored(i) ? "s" : "");
+    }
+    for(auto&& step : steps)
+    {
+        network_config += " s" + std::to_string(static_cast<int>(step.op)) + "_" +
+                          std::to_string(step.dst) + std::to_string(step.a) +
+                          std::to_string(step.b);
+    }
+    return network_config;
+}
+
+std::string TensorExpression::GetCompileParms() const
+{
+    Validate();
+
+    std::string parms = "-DMIOPEN_EXPR_NTENSORS=" + std::to_string(tensors.size()) +
+                        " -DMIOPEN_EXPR_NSTEPS=" + std::to_string(steps.size());
+
+    const bool use_fp16 = std::any_of(tensors.begin(), tensors.end(), [](auto&& t) {
+        return t.GetType() == miopenHalf;
+    });
+    parms += " -DMIOPEN_EXPR_USE_FP16=" + std::to_string(static_cast<int>(use_fp16));
+
+    for(std::size_t i = 0; i < tensors.size(); ++i)
+    {
+        const auto id = std::to_string(i);
+        const auto& type = tensors[i].GetType();
+        parms += " -DMIOPEN_EXPR_T" + id + "=" + (type == miopenInt8 ? "char" : GetDataType(type));
+        parms += " -DMIOPEN_EXPR_LOAD_" + id + "=" + std::to_string(static_cast<int>(IsLoaded(i)));
+        parms += " -DMIOPEN_EXPR_STORE_" + id + "=" + std::to_string(static_cast<int>(IsStored(i)));
+    }
+
+    for(std::size_t k = 0; k < steps.size(); ++k)
+    {
+        const auto id    = std::to_string(k);
+        const auto& step = steps[k];
+        parms += " -DMIOPEN_EXPR_OP_" + id + "=" + std::to_string(static_cast<int>(step.op));
+        parms += " -DMIOPEN_EXPR_DST_" + id + "=" + std::to_string(step.dst);
+        parms += " -DMIOPEN_EXPR_A_" + id + "=" + std::to_string(step.a);
+        parms += " -DMIOPEN_EXPR_B_" + id + "=" + std::to_string(step.b);
+        parms += " -DMIOPEN_EXPR_DST_TYPE_" + id + "=" +
+                 std::to_string(GetTypeCode(tensors[step.dst].GetType()));
+    }
+    return parms;
+}
+
+void TensorExpression::Evaluate(const std::vector<void*>& buffers) const
+{
+    if(buffers.size() != tensors.size() ||
+       std::any_of(buffers.begin(), buffers.end(), [](void* p) { return p == nullptr; }))
+        MIOPEN_THROW(miopenStatusBadParm, "Expected one buffer per tensor of the expression.");
+
+    const auto shape = GetFlattenedShape();
+    const auto total = std::accumulate(
+        shape.lens.begin(), shape.lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+
+    std::array<bool, max_tensors> loaded{};
+    std::array<bool, max_tensors> stored{};
+    for(std::size_t t = 0; t < tensors.size(); ++t)
+    {
+        loaded[t] = IsLoaded(t);
+        stored[t] = IsStored(t);
+    }
+
+    for(std::size_t gid = 0; gid < total; ++gid)
+    {
+        std::array<std::size_t, max_tensors> index{};
+        auto rem = gid;
+        for(auto d = shape.lens.size(); d-- > 0;)
+        {
+            const auto i = rem % shape.lens[d];
+            rem /= shape.lens[d];
+            for(std::size_t t = 0; t < tensors.size(); ++t)
+                index[t] += i * shape.strides[t][d];
+        }
+
+        std::array<float, max_tensors> r{};
+        for(std::size_t t = 0; t < tensors.size(); ++t)
+        {
+            if(loaded[t])
+                r[t] = LoadValue(tensors[t].GetType(), buffers[t], index[t]);
+        }
+
+        for(auto&& step : steps)
+        {
+            const auto dst_type = tensors[step.dst].GetType();
+            auto v              = ApplyStep(step, r[step.a], r[step.b], r[step.dst]);
+            if(step.op == TensorExprOp::Cast)
+                v = SaturateValue(dst_type, v);
+            r[step.dst] = RoundValue(dst_type, v);
+        }
+
+        for(std::size_t t = 0; t < tensors.size(); ++t)
+        {
+            if(stored[t])
+                StoreValue(tensors[t].GetType(), buffers[t], index[t], r[t]);
+        }
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const TensorExpression& x)
+{
+    stream << "tensors: ";
+    for(auto&& t : x.tensors)
+        stream << "{" << t << "} ";
+    stream << "steps:";
+    for(auto&& step : x.steps)
+    {
+        stream << " " << static_cast<int>(step.op) << "(" << step.dst << ", " << step.a << ", "
+               << step.b << ")";
+    }
+    return stream;
+}
+
+} // namespace miopen
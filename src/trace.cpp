@@ -0,0 +1,361 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_TRACE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+namespace miopen {
+namespace trace {
+
+namespace {
+
+// Events kept per thread. Older events get overwritten; histograms keep counting.
+constexpr std::size_t RingSize = 1 << 16;
+
+struct Event
+{
+    const char* category;
+    const char* name;
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+struct EventKeyHash
+{
+    std::size_t operator()(const std::pair<const char*, const char*>& key) const
+    {
+        return std::hash<const void*>{}(key.first) ^ (std::hash<const void*>{}(key.second) << 1);
+    }
+};
+
+constexpr std::size_t BucketCount = std::tuple_size<decltype(Histogram::buckets)>::value;
+
+std::size_t BucketOf(std::uint64_t duration)
+{
+    std::size_t bucket = 0;
+    while(bucket + 1 < BucketCount && (duration >> (bucket + 1)) != 0)
+        ++bucket;
+    return bucket;
+}
+
+// Only the owning thread updates a histogram; other threads read it while taking a snapshot.
+// Updates are therefore plain loads and stores of relaxed atomics. A snapshot may miss the
+// sample being added, but never sees a torn value.
+struct AtomicHistogram
+{
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> min{0};
+    std::atomic<std::uint64_t> max{0};
+    std::array<std::atomic<std::size_t>, BucketCount> buckets{};
+
+    void Add(std::uint64_t duration)
+    {
+        const auto n = count.load(std::memory_order_relaxed);
+        if(n == 0 || duration < min.load(std::memory_order_relaxed))
+            min.store(duration, std::memory_order_relaxed);
+        if(duration > max.load(std::memory_order_relaxed))
+            max.store(duration, std::memory_order_relaxed);
+        total.store(total.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+        auto& bucket = buckets[BucketOf(duration)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count.store(n + 1, std::memory_order_relaxed);
+    }
+
+    Histogram Load() const
+    {
+        Histogram result;
+        result.count = count.load(std::memory_order_relaxed);
+        result.total = total.load(std::memory_order_relaxed);
+        result.min   = min.load(std::memory_order_relaxed);
+        result.max   = max.load(std::memory_order_relaxed);
+        for(std::size_t i = 0; i < buckets.size(); ++i)
+            result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+        return result;
+    }
+};
+
+struct Slot
+{
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::uint64_t> begin{0};
+    std::atomic<std::uint64_t> end{0};
+};
+
+// Recording takes no lock. The owning thread bumps `claimed` before it overwrites a slot and
+// `written` after, so a reader that copied the ring can tell from `claimed` which of the copied
+// events may have been overwritten meanwhile and drop them.
+struct ThreadTrace
+{
+    explicit ThreadTrace(std::size_t id_) : id(id_), events(new Slot[RingSize]) {}
+
+    std::size_t id;
+
+    std::unique_ptr<Slot[]> events;
+    std::atomic<std::size_t> claimed{0};
+    std::atomic<std::size_t> written{0};
+
+    // Held while a histogram is added to the map and while another thread reads the map. The
+    // owning thread looks existing histograms up without it, since it is the only writer.
+    std::mutex histograms_mutex;
+    std::unordered_map<std::pair<const char*, const char*>,
+                       std::unique_ptr<AtomicHistogram>,
+                       EventKeyHash>
+        histograms;
+
+    AtomicHistogram& GetHistogram(const char* category, const char* name)
+    {
+        const auto key = std::make_pair(category, name);
+        const auto it  = histograms.find(key);
+        if(it != histograms.end())
+            return *it->second;
+        std::lock_guard<std::mutex> lock(histograms_mutex);
+        return *histograms.emplace(key, make_unique<AtomicHistogram>()).first->second;
+    }
+
+    void Record(const Event& event)
+    {
+        const auto i = written.load(std::memory_order_relaxed);
+        claimed.store(i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& slot = events[i % RingSize];
+        slot.category.store(event.category, std::memory_order_relaxed);
+        slot.name.store(event.name, std::memory_order_relaxed);
+        slot.begin.store(event.begin, std::memory_order_relaxed);
+        slot.end.store(event.end, std::memory_order_relaxed);
+
+        written.store(i + 1, std::memory_order_release);
+        GetHistogram(event.category, event.name).Add(event.end - event.begin);
+    }
+
+    std::vector<Event> Snapshot() const
+    {
+        const auto end   = written.load(std::memory_order_acquire);
+        const auto count = std::min(end, RingSize);
+        std::vector<Event> result;
+        result.reserve(count);
+        for(auto i = end - count; i < end; ++i)
+        {
+            const auto& slot = events[i % RingSize];
+            result.push_back({slot.category.load(std::memory_order_relaxed),
+                              slot.name.load(std::memory_order_relaxed),
+                              slot.begin.load(std::memory_order_relaxed),
+                              slot.end.load(std::memory_order_relaxed)});
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto last = claimed.load(std::memory_order_relaxed);
+        // Events before `last - RingSize` may have been overwritten while they were copied
+        const auto first       = end - count;
+        const auto first_valid = last > RingSize ? last - RingSize : 0;
+        const auto overwritten = first_valid > first ? std::min(count, first_valid - first) : 0;
+        result.erase(result.begin(), result.begin() + overwritten);
+        return result;
+    }
+};
+
+void WriteEscaped(std::ostream& os, const char* str)
+{
+    for(; *str != '\0'; ++str)
+    {
+        if(*str == '"' || *str == '\\')
+            os << '\\';
+        os << *str;
+    }
+}
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadTrace>> threads;
+    std::unordered_set<std::string> names;
+
+    std::vector<std::shared_ptr<ThreadTrace>> Threads()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return threads;
+    }
+
+    std::map<std::string, Histogram> Histograms()
+    {
+        std::map<std::string, Histogram> result;
+        for(auto&& thread : Threads())
+        {
+            std::lock_guard<std::mutex> lock(thread->histograms_mutex);
+            for(auto&& entry : thread->histograms)
+            {
+                const auto key =
+                    std::string(entry.first.first) + "/" + std::string(entry.first.second);
+                result[key].Merge(entry.second->Load());
+            }
+        }
+        return result;
+    }
+
+    void WriteChromeTrace(std::ostream& os)
+    {
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for(auto&& thread : Threads())
+        {
+            for(auto&& event : thread->Snapshot())
+            {
+                os << (first ? "\n" : ",\n") << "{\"name\":\"";
+                WriteEscaped(os, event.name);
+                os << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                   << thread->id << std::fixed << std::setprecision(3)
+                   << ",\"ts\":" << event.begin / 1000.0
+                   << ",\"dur\":" << (event.end - event.begin) / 1000.0 << "}";
+                first = false;
+            }
+        }
+        os << "\n]}\n";
+    }
+
+    ~Registry()
+    {
+        if(!IsTracing())
+            return;
+
+        const auto file_name   = GetStringEnv(MIOPEN_TRACE_FILE{});
+        const std::string path = file_name != nullptr ? file_name : "miopen_trace.json";
+        std::ofstream file(path);
+        WriteChromeTrace(file);
+
+        std::cerr << "MIOpen trace written to " << path << std::endl;
+        for(auto&& entry : Histograms())
+        {
+            const auto& h = entry.second;
+            std::cerr << "MIOpen trace: " << entry.first << " count " << h.count << ", mean "
+                      << h.total / h.count / 1000.0 << " us, p50 <= " << h.Percentile(0.5) / 1000.0
+                      << " us, p99 <= " << h.Percentile(0.99) / 1000.0 << " us, max "
+                      << h.max / 1000.0 << " us" << std::endl;
+        }
+    }
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadTrace& GetThreadTrace()
+{
+    thread_local const std::shared_ptr<ThreadTrace> local = [] {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(std::make_shared<ThreadTrace>(registry.threads.size()));
+        return registry.threads.back();
+    }();
+    return *local;
+}
+
+} // namespace
+
+bool IsTracing() { return miopen::IsEnabled(MIOPEN_ENABLE_TRACE{}); }
+
+std::uint64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+const char* Intern(const std::string& name)
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names.insert(name).first->c_str();
+}
+
+void Record(const char* category, const char* name, std::uint64_t begin, std::uint64_t end)
+{
+    GetThreadTrace().Record({category, name, begin, end});
+}
+
+void Histogram::Add(std::uint64_t duration)
+{
+    if(count == 0 || duration < min)
+        min = duration;
+    if(duration > max)
+        max = duration;
+    ++count;
+    total += duration;
+
+    ++buckets[BucketOf(duration)];
+}
+
+void Histogram::Merge(const Histogram& other)
+{
+    if(other.count == 0)
+        return;
+    if(count == 0 || other.min < min)
+        min = other.min;
+    max = std::max(max, other.max);
+    count += other.count;
+    total += other.total;
+    for(std::size_t i = 0; i < buckets.size(); ++i)
+        buckets[i] += other.buckets[i];
+}
+
+std::uint64_t Histogram::Percentile(double fraction) const
+{
+    const auto target = static_cast<std::size_t>(fraction * count);
+    std::size_t seen  = 0;
+    for(std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        seen += buckets[i];
+        if(seen > target || seen == count)
+            return std::min(max, (std::uint64_t{2} << i) - 1);
+    }
+    return max;
+}
+
+std::map<std::string, Histogram> GetHistograms() { return GetRegistry().Histograms(); }
+
+void WriteChromeTrace(std::ostream& os) { GetRegistry().WriteChromeTrace(os); }
+
+} // namespace trace
+} // namespace miopen
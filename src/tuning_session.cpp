@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_session.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::size_t fill_chunk = 1 << 16;
+
+thread_local std::unique_ptr<TuningSession> current_session;
+thread_local int current_depth = 0;
+
+float MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+} // namespace
+
+void ParallelFill(std::size_t count,
+                  std::uint64_t seed,
+                  const std::function<void(std::size_t, std::size_t, std::uint64_t)>& fill)
+{
+    const auto chunks = (count + fill_chunk - 1) / fill_chunk;
+    const auto work   = [&](std::size_t first, std::size_t step) {
+        for(auto c = first; c < chunks; c += step)
+        {
+            RandomStream chunk_seed{seed ^ (c * 0xd1b54a32d192ed03ULL)};
+            fill(c * fill_chunk, std::min(count, (c + 1) * fill_chunk), chunk_seed.NextBits());
+        }
+    };
+
+    const auto n_threads = std::min<std::size_t>(
+        chunks, std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+    if(n_threads <= 1)
+    {
+        work(0, 1);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for(std::size_t t = 1; t < n_threads; ++t)
+        threads.emplace_back(work, t, n_threads);
+    work(0, n_threads);
+    for(auto& thread : threads)
+        thread.join();
+}
+
+TuningSession::Scope::Scope()
+{
+    if(current_depth == 0)
+        current_session = make_unique<TuningSession>();
+    ++current_depth;
+}
+
+TuningSession::Scope::~Scope()
+{
+    if(--current_depth == 0)
+        current_session.reset();
+}
+
+TuningSession& TuningSession::Scope::Get() const { return *current_session; }
+
+TuningSession::~TuningSession()
+{
+    if(stats.searches == 0)
+        return;
+    MIOPEN_LOG_I("Tuning session: " << stats.searches << " searches, setup " << stats.setup_ms
+                                    << " ms, "
+                                    << stats.reused
+                                    << " buffers reused, about "
+                                    << stats.saved_ms
+                                    << " ms of setup saved");
+}
+
+Handle& TuningSession::GetHandle()
+{
+    ++stats.searches;
+    if(handle)
+    {
+        stats.saved_ms += handle_ms;
+        return *handle;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    handle           = make_unique<Handle>();
+    handle_ms        = MillisecondsSince(start);
+    stats.setup_ms += handle_ms;
+    return *handle;
+}
+
+Data_t TuningSession::GetBuffer(const Operand operand,
+                                const std::size_t bytes,
+                                const std::size_t element_size,
+                                const Contents contents,
+                                const std::function<void(void*)>& fill)
+{
+    if(!handle)
+        MIOPEN_THROW("Tuning session buffers require GetHandle() to be called first");
+
+    auto& slot = slots.at(static_cast<std::size_t>(operand));
+
+    const bool holds_contents = contents == Contents::Output ||
+                                (slot.contents == contents && slot.element_size == element_size &&
+                                 slot.valid >= bytes);
+    if(slot.buffer != nullptr && slot.capacity >= bytes && holds_contents)
+    {
+        ++stats.reused;
+        if(stats.setup_bytes > 0)
+            stats.saved_ms += fill_ms * bytes / stats.setup_bytes;
+        slot.contents = contents;
+        return slot.buffer.get();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if(slot.buffer == nullptr || slot.capacity < bytes)
+    {
+        // Release first so that the old and the new buffer are never allocated together.
+        slot.buffer   = nullptr;
+        slot.buffer   = handle->Create(bytes);
+        slot.capacity = bytes;
+    }
+    // Outputs start zeroed, as the searches always had them.
+    std::vector<char> host(bytes);
+    fill(host.data());
+    handle->WriteTo(host.data(), slot.buffer, bytes);
+
+    slot.valid        = bytes;
+    slot.element_size = element_size;
+    slot.contents     = contents;
+    const auto ms = MillisecondsSince(start);
+    fill_ms += ms;
+    stats.setup_ms += ms;
+    stats.setup_bytes += bytes;
+    return slot.buffer.get();
+}
+
+} // namespace miopen
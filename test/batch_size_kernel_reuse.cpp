@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/activ.hpp>
+#include <miopen/lrn.hpp>
+#include <miopen/pooling.hpp>
+#include <miopen/softmax.hpp>
+#include <miopen/trace.hpp>
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// The launchers below must build their program once and reuse it for every batch size.
+const std::size_t max_batch = 64;
+// c * h * w is a multiple of 4, so that the activation read unit is the same for all batches.
+const std::size_t c = 4;
+const std::size_t h = 8;
+const std::size_t w = 8;
+
+using RunOp = std::function<std::vector<float>(miopen::Handle&, const std::vector<float>&, int)>;
+
+std::size_t builds(const std::string& program)
+{
+    const auto histograms = miopen::trace::GetHistograms();
+    const auto it         = histograms.find("compile/" + program);
+    return it == histograms.end() ? 0 : it->second.count;
+}
+
+miopen::TensorDescriptor input_desc(int n) { return {miopenFloat, {std::size_t(n), c, h, w}}; }
+
+// Uploads the leading images of input that desc covers.
+auto write_input(miopen::Handle& handle,
+                 const std::vector<float>& input,
+                 const miopen::TensorDescriptor& desc)
+{
+    return handle.Write(std::vector<float>(input.begin(), input.begin() + desc.GetElementSize()));
+}
+
+void check_single_build(miopen::Handle& handle,
+                        const std::string& program,
+                        const std::vector<float>& input,
+                        const RunOp& run)
+{
+    const auto before = builds(program);
+    const auto full   = run(handle, input, max_batch);
+    EXPECT_EQUAL(builds(program), before + 1);
+
+    // Every op works on images independently, so a smaller batch must reproduce the leading
+    // images of the full one. This also checks the launch size is recomputed on a cache hit.
+    const auto image_size = full.size() / max_batch;
+    for(int n = 1; n <= static_cast<int>(max_batch); n++)
+    {
+        const auto out = run(handle, input, n);
+        EXPECT_EQUAL(out.size(), n * image_size);
+        EXPECT(std::equal(out.begin(), out.end(), full.begin(), [](float x, float y) {
+            return std::fabs(x - y) <= 1e-5f * std::max(1.0f, std::fabs(y));
+        }));
+    }
+    EXPECT_EQUAL(builds(program), before + 1);
+}
+
+std::vector<float> softmax(miopen::Handle& handle, const std::vector<float>& input, int n)
+{
+    const auto desc = input_desc(n);
+    auto y          = write_input(handle, input, desc);
+    float alpha = 1, beta = 0;
+    miopen::SoftmaxForward(handle, &alpha, &beta, desc, y.get(), desc, y.get());
+    return handle.Read<float>(y, desc.GetElementSize());
+}
+
+std::vector<float> pooling(miopen::Handle& handle, const std::vector<float>& input, int n)
+{
+    const miopen::PoolingDescriptor pool{
+        miopenPoolingMax, miopenPaddingDefault, {2, 2}, {2, 2}, {0, 0}};
+    const auto x_desc = input_desc(n);
+    const auto y_desc = pool.GetForwardOutputTensor(x_desc);
+    auto x            = write_input(handle, input, x_desc);
+    auto y            = handle.Create<float>(y_desc.GetElementSize());
+    float alpha = 1, beta = 0;
+    pool.Forward(handle, &alpha, x_desc, x.get(), &beta, y_desc, y.get(), false, nullptr, 0);
+    return handle.Read<float>(y, y_desc.GetElementSize());
+}
+
+std::vector<float> activation(miopen::Handle& handle, const std::vector<float>& input, int n)
+{
+    miopen::ActivationDescriptor activ{miopenActivationRELU, 0, 0, 0};
+    const auto desc = input_desc(n);
+    auto x          = write_input(handle, input, desc);
+    auto y          = handle.Create<float>(desc.GetElementSize());
+    float alpha = 1, beta = 0;
+    activ.Forward(handle, &alpha, desc, x.get(), &beta, desc, y.get());
+    return handle.Read<float>(y, desc.GetElementSize());
+}
+
+std::vector<float>
+lrn(miopen::Handle& handle, const std::vector<float>& input, int n, miopenLRNMode_t mode)
+{
+    const miopen::LRNDescriptor norm{mode, 5, {1e-4, 0.75, 1.0}};
+    const auto desc = input_desc(n);
+    auto x          = write_input(handle, input, desc);
+    auto y          = handle.Create<float>(desc.GetElementSize());
+    float alpha = 1, beta = 0;
+    norm.Forward(handle, &alpha, desc, x.get(), &beta, desc, y.get(), false, nullptr);
+    return handle.Read<float>(y, desc.GetElementSize());
+}
+
+int main()
+{
+    // Program builds are counted through the "compile" trace events.
+    setenv("MIOPEN_ENABLE_TRACE", "1", 1);
+    setenv("MIOPEN_TRACE_FILE", "/dev/null", 1);
+
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> input(max_batch * c * h * w);
+    std::generate(input.begin(), input.end(), [&] { return dist(gen); });
+
+    auto&& handle = get_handle();
+    check_single_build(handle, "MIOpenSoftmax.cl", input, softmax);
+    check_single_build(handle, "MIOpenPooling.cl", input, pooling);
+    check_single_build(handle, "MIOpenNeuron.cl", input, activation);
+    for(auto mode : {miopenLRNCrossChannel, miopenLRNWithinChannel})
+    {
+        check_single_build(handle,
+                           "MIOpenLRNFwd.cl",
+                           input,
+                           [=](miopen::Handle& hnd, const std::vector<float>& in, int n) {
+                               return lrn(hnd, in, n, mode);
+                           });
+    }
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/logger.hpp>
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Cost of the disabled MIOPEN_LOG_I2 calls that FusionPlanDescriptor::Execute makes for every
+// kernel argument, compared to the out-of-line level check used before the level was cached.
+int main(int argc, const char* argv[])
+{
+    // Info2 is disabled at the default level
+    setenv("MIOPEN_LOG_LEVEL", "4", 1);
+    const int iterations = BenchIterations(argc, argv, 10000000);
+
+    const std::vector<std::string> keys = {
+        "conv0_weights", "bias1_bias", "bn2_scale", "bn2_bias", "activ3_alpha", "activ3_beta"};
+    std::size_t sink = 0;
+
+    const auto empty = NanosecondsPerCall(iterations, [&](int i) {
+        const auto& key = keys[i % keys.size()];
+        sink += key.size();
+    });
+    const auto out_of_line = NanosecondsPerCall(iterations, [&](int i) {
+        const auto& key = keys[i % keys.size()];
+        sink += key.size();
+        if(miopen::detail::IsLoggingResolve(miopen::LoggingLevel::Info2))
+            std::cerr << "Setting arg: " + key << std::endl;
+    });
+    const auto cached = NanosecondsPerCall(iterations, [&](int i) {
+        const auto& key = keys[i % keys.size()];
+        sink += key.size();
+        MIOPEN_LOG_I2("Setting arg: " + key);
+    });
+
+    std::cout << "Disabled MIOPEN_LOG_I2, ns per call over " << iterations
+              << " iterations: cached level " << cached - empty << ", out-of-line check "
+              << out_of_line - empty << " (" << sink % 2 << ")" << std::endl;
+}
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+#include "bench.hpp"
+
+#include <functional>
+#include <iostream>
+
+// Host-side cost of the descriptor operations every API call goes through
+int main(int argc, const char* argv[])
+{
+    const int iterations = BenchIterations(argc, argv, 1000000);
+
+    const miopen::ConvolutionDescriptor conv{{1, 1}, {1, 1}, {1, 1}};
+    const miopen::TensorDescriptor w{miopenFloat, {64, 32, 3, 3}};
+    const std::hash<miopen::TensorDescriptor> hash{};
+    std::size_t sink = 0;
+
+    const auto create = NanosecondsPerCall(iterations, [&](int i) {
+        const miopen::TensorDescriptor x{miopenFloat, {std::size_t(1 + i % 4), 32, 14, 14}};
+        sink += x.GetElementSpace();
+    });
+    const miopen::TensorDescriptor x{miopenFloat, {1, 32, 14, 14}};
+    const auto output = NanosecondsPerCall(iterations, [&](int) {
+        sink += conv.GetForwardOutputTensor(x, w).GetElementSize();
+    });
+    const auto x2      = x;
+    const auto compare = NanosecondsPerCall(iterations, [&](int) { sink += (x == x2) ? 1 : 0; });
+    const auto hashing = NanosecondsPerCall(iterations, [&](int) { sink += hash(x); });
+
+    std::cout << "TensorDescriptor, ns per call over " << iterations << " iterations:"
+              << " create " << create << ", conv output " << output << ", compare " << compare
+              << ", hash " << hashing << " (" << sink % 2 << ")" << std::endl;
+}
@@ -68,11 +68,13 @@ struct verify_forward_conv_bias_batchnorm_activ
     tensor<T> bnbias{};
     tensor<T> estMean{};
     tensor<T> estVariance{};
+    tensor<T> residual{};
     miopenFusionPlanDescriptor_t fusionplan;
 
     miopenBatchNormMode_t bnmode;
-    bool bias_mode = false;
-    bool doactive  = false;
+    bool bias_mode  = false;
+    bool doactive   = false;
+    bool doresidual = false;
     double epsilon;
 
     // using conv_base<T>::search; //DLOWELL not needed right now
@@ -88,7 +90,9 @@ struct verify_forward_conv_bias_batchnorm_activ
                                              tensor<T>& pbnbias,
                                              tensor<T>& pestMean,
                                              tensor<T>& pestVariance,
-                                             miopenBatchNormMode_t pbnmode)
+                                             miopenBatchNormMode_t pbnmode,
+                                             bool pdoresidual,
+                                             tensor<T>& presidual)
     {
         input           = pinput;
         inputDesc       = &pinput.desc;
@@ -106,6 +110,8 @@ struct verify_forward_conv_bias_batchnorm_activ
         estMean         = pestMean;
         estVariance     = pestVariance;
         bnmode          = pbnmode;
+        doresidual      = pdoresidual;
+        residual        = presidual;
         fusionplan      = pfusionplan;
         epsilon         = 1.0e-5;
     }
@@ -131,6 +137,10 @@ struct verify_forward_conv_bias_batchnorm_activ
             batchNormSpatialHostInference(
                 rout, bout, bnscale, bnbias, epsilon, estMean, estVariance);
         }
+        if(doresidual)
+        {
+            residualAddHostInference(bout, residual);
+        }
         if(doactive)
         {
             double activ_alpha, activ_beta, activ_gamma;
@@ -159,10 +169,12 @@ struct verify_forward_conv_bias_batchnorm_activ
         auto bnbias_dev      = handle.Write(bnbias.data);
         auto estMean_dev     = handle.Write(estMean.data);
         auto estVariance_dev = handle.Write(estVariance.data);
+        auto residual_dev    = handle.Write(residual.data);
 
         miopenFusionOpDescriptor_t convoOp = nullptr;
         miopenFusionOpDescriptor_t biasOp  = nullptr;
         miopenFusionOpDescriptor_t bNormOp = nullptr;
+        miopenFusionOpDescriptor_t addOp   = nullptr;
         miopenFusionOpDescriptor_t activOp = nullptr;
         auto ptr_fusionargs                = GetManageFusionPlanArgs();
 
@@ -190,6 +202,13 @@ struct verify_forward_conv_bias_batchnorm_activ
                                           estMean_dev.get(),
                                           estVariance_dev.get(),
                                           epsilon);
+        if(doresidual)
+        {
+            miopenError = miopenFusionPlanGetOp(fusionplan, opcounter++, &addOp);
+            EXPECT(miopenError == miopenStatusSuccess);
+            miopenSetOpArgsTensorAddForward(
+                ptr_fusionargs.get(), addOp, &alpha, &beta, residual_dev.get());
+        }
         if(doactive)
         {
             miopenError = miopenFusionPlanGetOp(fusionplan, opcounter, &activOp);
@@ -214,6 +233,8 @@ struct verify_forward_conv_bias_batchnorm_activ
 
     void fail(float = 0) const
     {
+        if(doresidual)
+            std::cerr << "With residual add" << std::endl;
         if(bias_mode)
             if(doactive)
             {
@@ -249,12 +270,14 @@ struct cbna_fusion_driver : test_driver
     tensor<T> estMean;
     tensor<T> estVariance;
     tensor<T> bias;
+    tensor<T> residual;
     miopen::ConvolutionDescriptor filter;
     std::vector<int> pads_strides_dilations;
     ptr_ActivationDesc ptr_activdesc  = nullptr;
     miopenActivationMode_t activ_mode = miopenActivationRELU;
     int amode                         = 3;
     bool tactiv{};
+    bool tresidual{};
     bool bias_mode = true;
     miopenBatchNormMode_t bnmode{};
     int batchnormMode = 0;
@@ -289,6 +312,7 @@ struct cbna_fusion_driver : test_driver
         add(bias_mode, "bmode", generate_data({true, false}));
         add(pad_mode, "pmode", generate_data({"default" /*, "same", "valid"*/}));
         add(tactiv, "test_activ", generate_data({false, true}));
+        add(tresidual, "test_residual", generate_data({false, true}));
         add(amode, "amode", generate_data({3}));
         add(batchnormMode, "batch-norm-mode", generate_data({0, 1}));
     }
@@ -335,6 +359,7 @@ struct cbna_fusion_driver : test_driver
         miopenFusionOpDescriptor_t convoOp = nullptr;
         miopenFusionOpDescriptor_t biasOp  = nullptr;
         miopenFusionOpDescriptor_t bNormOp = nullptr;
+        miopenFusionOpDescriptor_t addOp   = nullptr;
         miopenFusionOpDescriptor_t activOp = nullptr;
 
         auto&& handle       = get_handle();
@@ -430,6 +455,17 @@ struct cbna_fusion_driver : test_driver
 
         miopenCreateOpBatchNormInference(ptr_fusionplan.get(), &bNormOp, bnmode, &scale.desc);
 
+        if(tresidual)
+        {
+            residual = tensor<T>{output.desc.GetLengths()}.generate(
+                tensor_elem_gen_integer{max_value});
+            miopenCreateOpTensorAddForward(ptr_fusionplan.get(), &addOp, &residual.desc);
+        }
+        else
+        {
+            residual = tensor<T>{1, 1, 1, 1};
+        }
+
         ptr_activdesc = GetManagedActivDesc();
         if(tactiv)
         {
@@ -497,7 +533,9 @@ struct cbna_fusion_driver : test_driver
                                                                    shift,
                                                                    estMean,
                                                                    estVariance,
-                                                                   bnmode});
+                                                                   bnmode,
+                                                                   tresidual,
+                                                                   residual});
             }
         }
     }
@@ -190,18 +190,21 @@ struct verify_forward_conv : conv_base<T>
     using conv_base<T>::filter;
     using conv_base<T>::bias;
     using conv_base<T>::search;
+    bool immediate;
 
     verify_forward_conv(const tensor<T>& pinput,
                         const tensor<T>& pweights,
                         const miopen::ConvolutionDescriptor& pfilter,
-                        int pbias   = 0,
-                        int psearch = 0)
+                        int pbias       = 0,
+                        int psearch     = 0,
+                        bool pimmediate = false)
     {
-        input   = pinput;
-        weights = pweights;
-        filter  = pfilter;
-        bias    = pbias;
-        search  = psearch;
+        input     = pinput;
+        weights   = pweights;
+        filter    = pfilter;
+        bias      = pbias;
+        search    = psearch;
+        immediate = pimmediate;
     }
 
     tensor<T> cpu() const
@@ -289,6 +292,50 @@ struct verify_forward_conv : conv_base<T>
                                            workspace_dev.get(),
                                            workspace_size);
         }
+        else if(immediate)
+        {
+            // Run the solution ranked first, without Find
+            const auto solutions =
+                filter.GetForwardSolutions(handle, weights.desc, input.desc, rout.desc);
+            EXPECT(!solutions.empty());
+            const auto& solution = solutions.front();
+            EXPECT(solution.workspace_size ==
+                   filter.GetForwardSolutionWorkspaceSize(
+                       handle, weights.desc, input.desc, rout.desc, solution.solution_id));
+
+            std::vector<char> solution_workspace(solution.workspace_size);
+            auto solution_workspace_dev =
+                solution.workspace_size != 0 ? handle.Write(solution_workspace) : nullptr;
+
+            filter.CompileForwardSolution(
+                handle, weights.desc, input.desc, rout.desc, solution.solution_id);
+            if(solution.algorithm == miopenConvolutionFwdAlgoDirect && solution.workspace_size != 0)
+            {
+                // A workspace smaller than the solution requires is rejected
+                EXPECT(throws([&] {
+                    filter.ConvolutionForwardImmediate(handle,
+                                                       weights.desc,
+                                                       wei_dev.get(),
+                                                       input.desc,
+                                                       in_dev.get(),
+                                                       rout.desc,
+                                                       out_dev.get(),
+                                                       solution_workspace_dev.get(),
+                                                       solution.workspace_size - 1,
+                                                       solution.solution_id);
+                }));
+            }
+            filter.ConvolutionForwardImmediate(handle,
+                                               weights.desc,
+                                               wei_dev.get(),
+                                               input.desc,
+                                               in_dev.get(),
+                                               rout.desc,
+                                               out_dev.get(),
+                                               solution_workspace_dev.get(),
+                                               solution.workspace_size,
+                                               solution.solution_id);
+        }
         else
         {
             filter.FindConvFwdAlgorithm(handle,
@@ -326,7 +373,103 @@ struct verify_forward_conv : conv_base<T>
 
     void fail(float = 0) const
     {
-        std::cout << "Forward convolution: " << std::endl;
+        std::cout << (immediate ? "Forward convolution (immediate mode): "
+                                : "Forward convolution: ")
+                  << std::endl;
+        this->conv_base<T>::fail();
+    }
+};
+
+// Runs the forward convolution on channels-last copies of input and output, and returns the
+// output in NCHW (NCDHW) order so that it compares against the NCHW results.
+template <class T>
+struct verify_forward_conv_nhwc : verify_forward_conv<T>
+{
+    using conv_base<T>::input;
+    using conv_base<T>::weights;
+    using conv_base<T>::filter;
+    using conv_base<T>::search;
+
+    verify_forward_conv_nhwc(const tensor<T>& pinput,
+                             const tensor<T>& pweights,
+                             const miopen::ConvolutionDescriptor& pfilter,
+                             int psearch = 0)
+        : verify_forward_conv<T>(pinput, pweights, pfilter, 0, psearch)
+    {
+    }
+
+    static miopenTensorLayout_t ChannelsLast(const tensor<T>& t)
+    {
+        return t.desc.GetSize() == 5 ? miopenTensorNDHWC : miopenTensorNHWC;
+    }
+
+    static tensor<T> ToChannelsLast(const tensor<T>& t)
+    {
+        tensor<T> result{miopen::TensorDescriptor{
+            t.desc.GetType(),
+            ChannelsLast(t),
+            std::vector<std::size_t>(t.desc.GetLengths().begin(), t.desc.GetLengths().end())}};
+        t.par_for_each([&](auto... is) { result(is...) = t(is...); });
+        return result;
+    }
+
+    tensor<T> gpu() const
+    {
+        auto&& handle = get_handle();
+        const auto in = ToChannelsLast(input);
+        auto rout     = ToChannelsLast(get_output_tensor(filter, input, weights));
+        CHECK(!in.desc.IsDefaultLayout());
+
+        auto in_dev  = handle.Write(in.data);
+        auto wei_dev = handle.Write(weights.data);
+        auto out_dev = handle.Write(rout.data);
+
+        const auto workspace_size =
+            filter.ForwardGetWorkSpaceSize(handle, weights.desc, in.desc, rout.desc);
+        std::vector<char> workspace(workspace_size);
+        auto workspace_dev = workspace_size != 0 ? handle.Write(workspace) : nullptr;
+
+        int ret_algo_count;
+        miopenConvAlgoPerf_t perf;
+        float alpha = 1, beta = 0;
+
+        filter.FindConvFwdAlgorithm(handle,
+                                    in.desc,
+                                    in_dev.get(),
+                                    weights.desc,
+                                    wei_dev.get(),
+                                    rout.desc,
+                                    out_dev.get(),
+                                    1,
+                                    &ret_algo_count,
+                                    &perf,
+                                    workspace_dev.get(),
+                                    workspace_size,
+                                    search);
+
+        filter.ConvolutionForward(handle,
+                                  &alpha,
+                                  in.desc,
+                                  in_dev.get(),
+                                  weights.desc,
+                                  wei_dev.get(),
+                                  perf.fwd_algo,
+                                  &beta,
+                                  rout.desc,
+                                  out_dev.get(),
+                                  workspace_dev.get(),
+                                  workspace_size);
+
+        rout.data = handle.Read<T>(out_dev, rout.data.size());
+
+        auto result = get_output_tensor(filter, input, weights);
+        result.par_for_each([&](auto... is) { result(is...) = rout(is...); });
+        return result;
+    }
+
+    void fail(float = 0) const
+    {
+        std::cout << "Forward convolution (channels-last): " << std::endl;
         this->conv_base<T>::fail();
     }
 };
@@ -756,6 +899,8 @@ struct conv_driver : test_driver
     bool do_backward_weights = true;
     int search               = 0;
     bool gen_float           = false;
+    bool cpu_reference       = false;
+    bool channels_last       = false;
 
     std::unordered_map<std::string, std::size_t> conv_dim_lookup = {{"CONV2D", 2}, {"CONV3D", 3}};
 
@@ -780,10 +925,15 @@ struct conv_driver : test_driver
         add(do_backward_weights, "disable-backward-weights", set_value(false));
         add(search, "search", set_value(1));
         add(gen_float, "generate-float", set_value(true));
+        add(cpu_reference, "cpu-reference", set_value(true));
+        add(channels_last, "channels-last", set_value(true));
     }
 
     void run()
     {
+        selected_cpu_conv_engine() =
+            cpu_reference ? cpu_conv_engine::reference : cpu_conv_engine::fast;
+
         filter.spatialDim  = conv_dim_lookup[miopen::ToUpper(conv_dim_type)];
         filter.mode        = cmode_lookup[miopen::ToUpper(conv_mode)];
         filter.paddingMode = pmode_lookup[miopen::ToUpper(pad_mode)];
@@ -990,7 +1140,29 @@ struct conv_driver : test_driver
                     }
                     else
                     {
-                        verify(verify_forward_conv<T>{input, weights, filter, 0, search});
+                        const auto nchw =
+                            verify(verify_forward_conv<T>{input, weights, filter, 0, search});
+                        if(filter.mode != miopenTranspose)
+                        {
+                            verify(
+                                verify_forward_conv<T>{input, weights, filter, 0, search, true});
+                        }
+                        if(filter.mode != miopenTranspose && channels_last)
+                        {
+                            const auto nhwc = verify(
+                                verify_forward_conv_nhwc<T>{input, weights, filter, search});
+                            const double threshold =
+                                std::numeric_limits<T>::epsilon() * this->tolerance;
+                            const auto error = miopen::rms_range(nchw.second, nhwc.second);
+                            if(error > threshold)
+                            {
+                                std::cout << "FAILED: channels-last output differs from NCHW "
+                                             "output, rms "
+                                          << error << std::endl;
+                                this->show_command();
+                            }
+                            EXPECT(error <= threshold);
+                        }
                     }
                 }
 
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv_cost_model.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/temp_file.hpp>
+#include "test.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+miopen::ProblemDescription
+make_problem(int c, int hw, int k, int filter, int n, int stride = 1, int groups = 1)
+{
+    miopen::ProblemDescription p;
+    p.n_inputs          = c;
+    p.in_height         = hw;
+    p.in_width          = hw;
+    p.kernel_size_h     = filter;
+    p.kernel_size_w     = filter;
+    p.n_outputs         = k;
+    p.out_height        = (hw - 1) / stride + 1;
+    p.out_width         = (hw - 1) / stride + 1;
+    p.batch_sz          = n;
+    p.pad_h             = filter / 2;
+    p.pad_w             = filter / 2;
+    p.kernel_stride_h   = stride;
+    p.kernel_stride_w   = stride;
+    p.kernel_dilation_h = 1;
+    p.kernel_dilation_w = 1;
+    p.in_layout         = "NCHW";
+    p.out_layout        = "NCHW";
+    p.in_data_type      = miopenFloat;
+    p.weights_data_type = miopenFloat;
+    p.out_data_type     = miopenFloat;
+    p.group_counts      = groups;
+    p.direction.Set(1);
+    return p;
+}
+
+std::string key_of(const miopen::ProblemDescription& p)
+{
+    std::ostringstream ss;
+    p.Serialize(ss);
+    return ss.str();
+}
+
+void check_parse_key()
+{
+    for(auto&& p : {make_problem(64, 56, 128, 3, 16), make_problem(32, 7, 32, 1, 2, 2, 4)})
+    {
+        const auto key    = key_of(p);
+        const auto parsed = miopen::ParseConvProblemKey(key);
+        EXPECT(parsed);
+        EXPECT(key_of(*parsed) == key);
+    }
+    EXPECT(!miopen::ParseConvProblemKey("1-2-3"));
+    EXPECT(!miopen::ParseConvProblemKey("64-56-56-3x3-128-56-56-16-1x1-1x1-1x1-0-NCHW-FP64-F"));
+}
+
+void check_heuristic()
+{
+    const miopen::HeuristicConvCostModel model;
+    const auto big = miopen::ConvCostFeatures::From(make_problem(256, 56, 256, 3, 32));
+    EXPECT(model.Estimate(big, "ConvBinWinogradRxS") < model.Estimate(big, "ConvOclDirectFwd"));
+    EXPECT(model.Estimate(big, "ConvAsm3x3U") < model.Estimate(big, "ConvOclDirectFwdGen"));
+    // Deterministic and monotonic in the problem size
+    const auto small = miopen::ConvCostFeatures::From(make_problem(256, 14, 256, 3, 32));
+    EXPECT(model.Estimate(big, "gemm") == model.Estimate(big, "gemm"));
+    EXPECT(model.Estimate(small, "gemm") < model.Estimate(big, "gemm"));
+
+    std::vector<miopen::PerfField> perf = {
+        {"miopenConvolutionFwdAlgoDirect", "ConvOclDirectFwd", 0, 0},
+        {"miopenConvolutionFwdAlgoWinograd", "ConvBinWinogradRxS", 0, 0}};
+    miopen::SetConvCostModel(std::make_shared<miopen::HeuristicConvCostModel>());
+    miopen::RankByConvCost(make_problem(256, 56, 256, 3, 32), perf);
+    EXPECT(perf.front().solver_id == "ConvBinWinogradRxS");
+    miopen::SetConvCostModel(nullptr);
+}
+
+void check_fit()
+{
+    // Times that follow the linear model exactly must be recovered
+    const miopen::LinearConvCostModel::Weights truth = {{-18.0, 0.9, 0.1, 0.05, -0.02}};
+    std::vector<miopen::ConvCostSample> samples;
+    for(int c : {16, 64, 256})
+        for(int hw : {7, 28, 56})
+            for(int filter : {1, 3})
+                for(int n : {1, 16})
+                {
+                    const auto p = make_problem(c, hw, c * 2, filter, n);
+                    const auto v = miopen::ConvCostFeatures::From(p).AsVector();
+                    double log_ms = 0;
+                    for(std::size_t i = 0; i < v.size(); i++)
+                        log_ms += truth[i] * v[i];
+                    samples.push_back({p, "gemm", static_cast<float>(std::exp(log_ms))});
+                }
+    // Too few samples to fit
+    samples.push_back({make_problem(8, 8, 8, 3, 1), "fft", 1.0f});
+
+    miopen::LinearConvCostModel model;
+    model.Fit(samples);
+    EXPECT(model.GetWeights().size() == 1);
+    for(std::size_t i = 0; i < truth.size(); i++)
+        EXPECT(std::abs(model.GetWeights().at("gemm")[i] - truth[i]) < 1e-3);
+
+    const auto f = miopen::ConvCostFeatures::From(make_problem(128, 14, 64, 3, 8));
+    EXPECT(model.Estimate(f, "fft") == miopen::HeuristicConvCostModel{}.Estimate(f, "fft"));
+
+    std::stringstream ss;
+    model.Save(ss);
+    miopen::LinearConvCostModel loaded;
+    EXPECT(loaded.Load(ss));
+    EXPECT(loaded.Estimate(f, "gemm") == model.Estimate(f, "gemm"));
+
+    std::istringstream bad("gemm:1,2,3");
+    EXPECT(!loaded.Load(bad));
+}
+
+void check_find_db_samples()
+{
+    const miopen::TempFile file("miopen.tests.conv_cost_model");
+    const auto p = make_problem(64, 28, 64, 3, 4);
+    {
+        std::ofstream out(file.Path());
+        out << key_of(p) << "=miopenConvolutionFwdAlgoGEMM:gemm,0.5,1024,key;"
+            << "miopenConvolutionFwdAlgoDirect:ConvOclDirectFwd,1.25,0,key\n";
+        out << "garbage=miopenConvolutionFwdAlgoGEMM:gemm,0.5,0,key\n";
+    }
+    const auto samples = miopen::LoadConvCostSamples(file.Path());
+    EXPECT(samples.size() == 2);
+    for(auto&& s : samples)
+    {
+        EXPECT(key_of(s.problem) == key_of(p));
+        EXPECT(s.time == (s.solver_id == "gemm" ? 0.5f : 1.25f));
+    }
+}
+
+int main()
+{
+    check_parse_key();
+    check_heuristic();
+    check_fit();
+    check_find_db_samples();
+}
@@ -0,0 +1,415 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_BN_HPP
+#define GUARD_CPU_BN_HPP
+
+#include "ford.hpp"
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Host batch normalization shared by MIOpenDriver and the tests, on packed NCHW / NCDHW data
+// given as n x c x hw with hw the product of the spatial lengths. Spatial routines run one task
+// per channel and walk each image of the channel as one contiguous run; per-activation routines
+// keep a row of hw statistics and stream the batch through it. Statistics are computed in double
+// with two passes (mean, then squared deviations). Optional outputs and inputs are nullptr when
+// absent: without estimated or saved statistics the batch statistics are recomputed.
+
+namespace cpu_bn {
+
+// Keeps optional pointer arguments out of template argument deduction so that they accept nullptr.
+template <class T>
+using optional_ptr = typename std::enable_if<true, T*>::type;
+
+// Sum of f(0) ... f(n - 1). Eight independent partial sums let the loop vectorize without
+// reassociation and keep the rounding error growth well below that of a single accumulator.
+template <class F>
+double blocked_sum(std::size_t n, F f)
+{
+    double lanes[8] = {};
+    std::size_t i   = 0;
+    for(; i + 8 <= n; i += 8)
+        for(std::size_t j = 0; j < 8; ++j)
+            lanes[j] += f(i + j);
+    for(; i < n; ++i)
+        lanes[i % 8] += f(i);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+// Sums f(image, i) over every image of a channel.
+template <class F>
+double channel_sum(std::size_t n, std::size_t hw, F f)
+{
+    double sum = 0;
+    for(std::size_t b = 0; b < n; ++b)
+        sum += blocked_sum(hw, [&](std::size_t i) { return f(b, i); });
+    return sum;
+}
+
+template <class X>
+void spatial_stats(std::size_t n,
+                   std::size_t c,
+                   std::size_t hw,
+                   const X* x,
+                   std::size_t cidx,
+                   double& mean,
+                   double& variance)
+{
+    const double nhw = double(n) * hw;
+    auto at = [&](std::size_t b, std::size_t i) { return double(x[(b * c + cidx) * hw + i]); };
+
+    mean     = channel_sum(n, hw, at) / nhw;
+    variance = channel_sum(n,
+                           hw,
+                           [&](std::size_t b, std::size_t i) {
+                               const double d = at(b, i) - mean;
+                               return d * d;
+                           }) /
+               nhw;
+}
+
+template <class X>
+void per_activation_stats(std::size_t n,
+                          std::size_t c,
+                          std::size_t hw,
+                          const X* x,
+                          std::size_t cidx,
+                          std::vector<double>& mean,
+                          std::vector<double>& variance)
+{
+    mean.assign(hw, 0.0);
+    variance.assign(hw, 0.0);
+    for(std::size_t b = 0; b < n; ++b)
+    {
+        const X* row = x + (b * c + cidx) * hw;
+        for(std::size_t i = 0; i < hw; ++i)
+            mean[i] += double(row[i]);
+    }
+    for(std::size_t i = 0; i < hw; ++i)
+        mean[i] /= double(n);
+    for(std::size_t b = 0; b < n; ++b)
+    {
+        const X* row = x + (b * c + cidx) * hw;
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            const double d = double(row[i]) - mean[i];
+            variance[i] += d * d;
+        }
+    }
+    for(std::size_t i = 0; i < hw; ++i)
+        variance[i] /= double(n);
+}
+
+} // namespace cpu_bn
+
+template <class X, class Y, class P>
+void cpu_bn_spatial_fwd_train(std::size_t n,
+                              std::size_t c,
+                              std::size_t hw,
+                              const X* x,
+                              Y* y,
+                              const P* scale,
+                              const P* bias,
+                              double epsilon,
+                              double exp_avg_factor,
+                              cpu_bn::optional_ptr<P> save_mean,
+                              cpu_bn::optional_ptr<P> save_inv_var,
+                              cpu_bn::optional_ptr<P> run_mean,
+                              cpu_bn::optional_ptr<P> run_var)
+{
+    const double nhw = double(n) * hw;
+    par_for(c, 1, [&](std::size_t cidx) {
+        double mean, variance;
+        cpu_bn::spatial_stats(n, c, hw, x, cidx, mean, variance);
+        const double inv_var = 1.0 / std::sqrt(variance + epsilon);
+
+        if(save_mean != nullptr)
+            save_mean[cidx] = mean;
+        if(save_inv_var != nullptr)
+            save_inv_var[cidx] = inv_var;
+        if(run_mean != nullptr)
+            run_mean[cidx] = mean * exp_avg_factor + run_mean[cidx] * (1 - exp_avg_factor);
+        if(run_var != nullptr)
+        {
+            // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
+            const double adjust = (nhw == 1) ? variance : (nhw / (nhw - 1)) * variance;
+            run_var[cidx] = (1 - exp_avg_factor) * run_var[cidx] + exp_avg_factor * adjust;
+        }
+
+        const double gamma = scale[cidx] * inv_var;
+        const double beta  = bias[cidx];
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row = x + (b * c + cidx) * hw;
+            Y* y_row       = y + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+                y_row[i] = gamma * (double(x_row[i]) - mean) + beta;
+        }
+    });
+}
+
+template <class X, class Y, class P>
+void cpu_bn_spatial_fwd_infer(std::size_t n,
+                              std::size_t c,
+                              std::size_t hw,
+                              const X* x,
+                              Y* y,
+                              const P* scale,
+                              const P* bias,
+                              double epsilon,
+                              cpu_bn::optional_ptr<const P> est_mean,
+                              cpu_bn::optional_ptr<const P> est_var)
+{
+    par_for(c, 1, [&](std::size_t cidx) {
+        double mean, variance;
+        if(est_mean != nullptr && est_var != nullptr)
+        {
+            mean     = est_mean[cidx];
+            variance = est_var[cidx];
+        }
+        else
+        {
+            cpu_bn::spatial_stats(n, c, hw, x, cidx, mean, variance);
+        }
+
+        const double gamma = scale[cidx] / std::sqrt(variance + epsilon);
+        const double beta  = bias[cidx];
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row = x + (b * c + cidx) * hw;
+            Y* y_row       = y + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+                y_row[i] = gamma * (double(x_row[i]) - mean) + beta;
+        }
+    });
+}
+
+template <class X, class DX, class S, class P>
+void cpu_bn_spatial_bwd(std::size_t n,
+                        std::size_t c,
+                        std::size_t hw,
+                        const X* x,
+                        const X* dy,
+                        DX* dx,
+                        const S* scale,
+                        P* dscale,
+                        P* dbias,
+                        double epsilon,
+                        cpu_bn::optional_ptr<const P> saved_mean,
+                        cpu_bn::optional_ptr<const P> saved_inv_var)
+{
+    const double nhw = double(n) * hw;
+    par_for(c, 1, [&](std::size_t cidx) {
+        double mean, inv_var;
+        if(saved_mean != nullptr && saved_inv_var != nullptr)
+        {
+            mean    = saved_mean[cidx];
+            inv_var = saved_inv_var[cidx];
+        }
+        else
+        {
+            double variance;
+            cpu_bn::spatial_stats(n, c, hw, x, cidx, mean, variance);
+            inv_var = 1.0 / std::sqrt(variance + epsilon);
+        }
+
+        auto at = [&](const X* p, std::size_t b, std::size_t i) {
+            return double(p[(b * c + cidx) * hw + i]);
+        };
+        const double db = cpu_bn::channel_sum(
+            n, hw, [&](std::size_t b, std::size_t i) { return at(dy, b, i); });
+        const double ds = cpu_bn::channel_sum(n, hw, [&](std::size_t b, std::size_t i) {
+            return (at(x, b, i) - mean) * inv_var * at(dy, b, i);
+        });
+        dbias[cidx]  = db;
+        dscale[cidx] = ds;
+
+        const double k = double(scale[cidx]) * inv_var / nhw;
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row  = x + (b * c + cidx) * hw;
+            const X* dy_row = dy + (b * c + cidx) * hw;
+            DX* dx_row      = dx + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+            {
+                const double xhat = (double(x_row[i]) - mean) * inv_var;
+                dx_row[i]         = k * (nhw * double(dy_row[i]) - db - xhat * ds);
+            }
+        }
+    });
+}
+
+template <class X, class Y, class P>
+void cpu_bn_per_activation_fwd_train(std::size_t n,
+                                     std::size_t c,
+                                     std::size_t hw,
+                                     const X* x,
+                                     Y* y,
+                                     const P* scale,
+                                     const P* bias,
+                                     double epsilon,
+                                     double exp_avg_factor,
+                                     cpu_bn::optional_ptr<P> save_mean,
+                                     cpu_bn::optional_ptr<P> save_inv_var,
+                                     cpu_bn::optional_ptr<P> run_mean,
+                                     cpu_bn::optional_ptr<P> run_var)
+{
+    par_for(c, 1, [&](std::size_t cidx) {
+        std::vector<double> mean, variance;
+        cpu_bn::per_activation_stats(n, c, hw, x, cidx, mean, variance);
+
+        std::vector<double> inv_var(hw);
+        for(std::size_t i = 0; i < hw; ++i)
+        {
+            const std::size_t j = cidx * hw + i;
+            inv_var[i]          = 1.0 / std::sqrt(variance[i] + epsilon);
+            if(save_mean != nullptr)
+                save_mean[j] = mean[i];
+            if(save_inv_var != nullptr)
+                save_inv_var[j] = inv_var[i];
+            if(run_mean != nullptr)
+                run_mean[j] = mean[i] * exp_avg_factor + run_mean[j] * (1 - exp_avg_factor);
+            if(run_var != nullptr)
+            {
+                const double adjust = (n == 1) ? variance[i] : (double(n) / (n - 1)) * variance[i];
+                run_var[j] = (1 - exp_avg_factor) * run_var[j] + exp_avg_factor * adjust;
+            }
+        }
+
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row = x + (b * c + cidx) * hw;
+            Y* y_row       = y + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+                y_row[i] = double(scale[cidx * hw + i]) * inv_var[i] *
+                               (double(x_row[i]) - mean[i]) +
+                           double(bias[cidx * hw + i]);
+        }
+    });
+}
+
+template <class X, class Y, class P>
+void cpu_bn_per_activation_fwd_infer(std::size_t n,
+                                     std::size_t c,
+                                     std::size_t hw,
+                                     const X* x,
+                                     Y* y,
+                                     const P* scale,
+                                     const P* bias,
+                                     double epsilon,
+                                     cpu_bn::optional_ptr<const P> est_mean,
+                                     cpu_bn::optional_ptr<const P> est_var)
+{
+    par_for(c, 1, [&](std::size_t cidx) {
+        std::vector<double> mean(hw), variance(hw);
+        if(est_mean != nullptr && est_var != nullptr)
+        {
+            std::copy_n(est_mean + cidx * hw, hw, mean.begin());
+            std::copy_n(est_var + cidx * hw, hw, variance.begin());
+        }
+        else
+        {
+            cpu_bn::per_activation_stats(n, c, hw, x, cidx, mean, variance);
+        }
+
+        std::vector<double> gamma(hw);
+        for(std::size_t i = 0; i < hw; ++i)
+            gamma[i] = scale[cidx * hw + i] / std::sqrt(variance[i] + epsilon);
+
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row = x + (b * c + cidx) * hw;
+            Y* y_row       = y + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+                y_row[i] = gamma[i] * (double(x_row[i]) - mean[i]) + double(bias[cidx * hw + i]);
+        }
+    });
+}
+
+template <class X, class DX, class S, class P>
+void cpu_bn_per_activation_bwd(std::size_t n,
+                               std::size_t c,
+                               std::size_t hw,
+                               const X* x,
+                               const X* dy,
+                               DX* dx,
+                               const S* scale,
+                               P* dscale,
+                               P* dbias,
+                               double epsilon,
+                               cpu_bn::optional_ptr<const P> saved_mean,
+                               cpu_bn::optional_ptr<const P> saved_inv_var)
+{
+    par_for(c, 1, [&](std::size_t cidx) {
+        std::vector<double> mean(hw), inv_var(hw);
+        if(saved_mean != nullptr && saved_inv_var != nullptr)
+        {
+            std::copy_n(saved_mean + cidx * hw, hw, mean.begin());
+            std::copy_n(saved_inv_var + cidx * hw, hw, inv_var.begin());
+        }
+        else
+        {
+            std::vector<double> variance;
+            cpu_bn::per_activation_stats(n, c, hw, x, cidx, mean, variance);
+            for(std::size_t i = 0; i < hw; ++i)
+                inv_var[i] = 1.0 / std::sqrt(variance[i] + epsilon);
+        }
+
+        std::vector<double> db(hw, 0.0), ds(hw, 0.0), dxhat(hw, 0.0), dxhathat(hw, 0.0);
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row  = x + (b * c + cidx) * hw;
+            const X* dy_row = dy + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+            {
+                const double xhat = (double(x_row[i]) - mean[i]) * inv_var[i];
+                const double d    = dy_row[i];
+                const double sd   = double(scale[cidx * hw + i]) * d;
+                db[i] += d;
+                ds[i] += xhat * d;
+                dxhat[i] += sd;
+                dxhathat[i] += sd * xhat;
+            }
+        }
+        std::copy(db.begin(), db.end(), dbias + cidx * hw);
+        std::copy(ds.begin(), ds.end(), dscale + cidx * hw);
+
+        for(std::size_t b = 0; b < n; ++b)
+        {
+            const X* x_row = x + (b * c + cidx) * hw;
+            DX* dx_row     = dx + (b * c + cidx) * hw;
+            for(std::size_t i = 0; i < hw; ++i)
+            {
+                const double xhat = (double(x_row[i]) - mean[i]) * inv_var[i];
+                dx_row[i] = inv_var[i] / n * (n * dxhat[i] - (xhat * dxhathat[i] + dxhat[i]));
+            }
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "cpu_conv.hpp"
+#include "test.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+// The im2col/GEMM and direct engines must reproduce the element-wise reference exactly: the
+// data are small integers, so every sum is exact in double.
+struct conv_case
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t k;
+    std::size_t groups;
+    std::vector<std::size_t> in;
+    std::vector<std::size_t> wei;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+};
+
+template <std::size_t ConvDim>
+void check_case(const conv_case& cc)
+{
+    auto gen = [](auto...) { return std::rand() % 9 - 4; };
+
+    std::vector<std::size_t> in_lens{cc.n, cc.c};
+    std::vector<std::size_t> wei_lens{cc.k, cc.c / cc.groups};
+    std::vector<std::size_t> out_lens{cc.n, cc.k};
+    for(std::size_t i = 0; i < ConvDim; ++i)
+    {
+        in_lens.push_back(cc.in[i]);
+        wei_lens.push_back(cc.wei[i]);
+        out_lens.push_back((cc.in[i] + 2 * cc.pads[i] - cc.dilations[i] * (cc.wei[i] - 1) - 1) /
+                               cc.strides[i] +
+                           1);
+    }
+
+    const auto in  = tensor<float>{in_lens}.generate(gen);
+    const auto wei = tensor<float>{wei_lens}.generate(gen);
+    const auto out = tensor<float>{out_lens}.generate(gen);
+
+    auto out_ref  = tensor<float>{out_lens};
+    auto out_fast = tensor<float>{out_lens};
+    cpu_convolution_forward_impl<ConvDim>(
+        in, wei, out_ref, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_forward_fast(
+        ConvDim, in, wei, out_fast, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(out_ref.data == out_fast.data);
+
+    auto in_ref  = tensor<float>{in_lens};
+    auto in_fast = tensor<float>{in_lens};
+    cpu_convolution_backward_data_impl<ConvDim>(
+        in_ref, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_backward_data_fast(
+        ConvDim, in_fast, wei, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(in_ref.data == in_fast.data);
+
+    auto wei_ref  = tensor<float>{wei_lens};
+    auto wei_fast = tensor<float>{wei_lens};
+    cpu_convolution_backward_weight_impl<ConvDim>(
+        in, wei_ref, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    cpu_convolution_backward_weight_fast(
+        ConvDim, in, wei_fast, out, cc.pads, cc.strides, cc.dilations, cc.groups);
+    EXPECT(wei_ref.data == wei_fast.data);
+}
+
+int main()
+{
+    // 1x1, 3x3 with padding, strided, dilated, grouped, depthwise (direct path) and odd sizes
+    // that leave partial pixel and channel blocks.
+    const std::vector<conv_case> cases_2d = {
+        {2, 16, 16, 1, {7, 9}, {1, 1}, {0, 0}, {1, 1}, {1, 1}},
+        {2, 3, 20, 1, {13, 11}, {3, 3}, {1, 1}, {1, 1}, {1, 1}},
+        {1, 10, 12, 1, {15, 14}, {3, 5}, {2, 1}, {2, 3}, {1, 1}},
+        {2, 9, 8, 1, {12, 12}, {3, 3}, {2, 2}, {1, 1}, {2, 2}},
+        {2, 12, 18, 3, {9, 10}, {3, 3}, {1, 1}, {2, 1}, {1, 2}},
+        {3, 8, 8, 8, {11, 13}, {3, 3}, {1, 1}, {1, 1}, {1, 1}},
+        {1, 6, 12, 6, {10, 9}, {5, 3}, {2, 1}, {1, 2}, {1, 1}},
+        {1, 4, 4, 1, {5, 5}, {3, 3}, {3, 3}, {1, 1}, {1, 1}},
+    };
+    for(const auto& cc : cases_2d)
+        check_case<2>(cc);
+
+    check_case<1>({2, 6, 10, 2, {33}, {5}, {2}, {2}, {1}});
+    check_case<3>({2, 4, 8, 1, {5, 6, 7}, {3, 3, 3}, {1, 1, 1}, {1, 2, 1}, {1, 1, 2}});
+    check_case<3>({1, 6, 6, 6, {4, 5, 9}, {3, 1, 3}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}});
+}
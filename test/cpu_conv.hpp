@@ -36,6 +36,7 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_conv_fast.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -304,6 +305,13 @@ void cpu_convolution_forward(std::size_t spatial_dim,
                              const Range& dilations,
                              std::size_t group_count)
 {
+    if(cpu_convolution_fast_applicable(spatial_dim, in.desc, wei.desc, out.desc))
+    {
+        cpu_convolution_forward_fast(
+            spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -341,6 +349,13 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
                                    const Range& dilations,
                                    std::size_t group_count)
 {
+    if(cpu_convolution_fast_applicable(spatial_dim, in.desc, wei.desc, out.desc))
+    {
+        cpu_convolution_backward_data_fast(
+            spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -378,6 +393,13 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
                                      const Range& dilations,
                                      std::size_t group_count)
 {
+    if(cpu_convolution_fast_applicable(spatial_dim, in.desc, wei.desc, out.desc))
+    {
+        cpu_convolution_backward_weight_fast(
+            spatial_dim, in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
@@ -0,0 +1,594 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_CONV_FAST_HPP
+#define GUARD_CPU_CONV_FAST_HPP
+
+#include "ford.hpp"
+#include "tensor_holder.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Host convolution used to verify GPU results. Forward and backward-weights lower the
+// convolution to im2col followed by a register-blocked GEMM over blocks of output pixels;
+// backward-data runs the transposed GEMM and scatters the columns back (col2im). Forward
+// convolutions with few output channels per group (e.g. depthwise) take a direct path whose
+// inner loop runs along the innermost spatial dimension. Everything accumulates in double like
+// the element-wise reference in cpu_conv.hpp, which is kept as the oracle (see test/cpu_conv.cpp)
+// and handles tensors that are not packed NCHW.
+
+enum class cpu_conv_engine
+{
+    fast,
+    reference,
+};
+
+inline cpu_conv_engine& selected_cpu_conv_engine()
+{
+    static cpu_conv_engine engine = cpu_conv_engine::fast;
+    return engine;
+}
+
+namespace cpu_conv_fast {
+
+// Output pixels per im2col block, and reduction depth per GEMM pass.
+constexpr std::size_t pixel_block     = 64;
+constexpr std::size_t reduction_block = 256;
+// Input channels handled by one backward task.
+constexpr std::size_t channel_block = 8;
+// Below this many output channels per group im2col does not pay off.
+constexpr std::size_t direct_max_k = 8;
+
+inline bool is_packed_nchw(const miopen::TensorDescriptor& desc)
+{
+    const auto& lens    = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+    std::size_t stride  = 1;
+    for(std::size_t i = lens.size(); i-- > 0;)
+    {
+        if(lens[i] != 1 && strides[i] != stride)
+            return false;
+        stride *= lens[i];
+    }
+    return true;
+}
+
+template <class T>
+std::vector<double> to_double(const std::vector<T>& v)
+{
+    std::vector<double> r(v.size());
+    std::transform(v.begin(), v.end(), r.begin(), [](T x) { return double(x); });
+    return r;
+}
+
+// c[m x n] += a[m x k] * b[k x n], with a addressed through strides so that it can be read
+// transposed. Four rows of c share every load of b.
+inline void gemm_acc(std::size_t m,
+                     std::size_t n,
+                     std::size_t k,
+                     const double* a,
+                     std::size_t a_stride_m,
+                     std::size_t a_stride_k,
+                     const double* b,
+                     double* c)
+{
+    for(std::size_t l0 = 0; l0 < k; l0 += reduction_block)
+    {
+        const std::size_t l1 = std::min(l0 + reduction_block, k);
+        std::size_t i        = 0;
+        for(; i + 4 <= m; i += 4)
+        {
+            double* c0 = c + i * n;
+            double* c1 = c0 + n;
+            double* c2 = c1 + n;
+            double* c3 = c2 + n;
+            for(std::size_t l = l0; l < l1; ++l)
+            {
+                const double* a_l = a + i * a_stride_m + l * a_stride_k;
+                const double a0   = a_l[0];
+                const double a1   = a_l[a_stride_m];
+                const double a2   = a_l[2 * a_stride_m];
+                const double a3   = a_l[3 * a_stride_m];
+                const double* b_l = b + l * n;
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    const double bj = b_l[j];
+                    c0[j] += a0 * bj;
+                    c1[j] += a1 * bj;
+                    c2[j] += a2 * bj;
+                    c3[j] += a3 * bj;
+                }
+            }
+        }
+        for(; i < m; ++i)
+        {
+            double* c0 = c + i * n;
+            for(std::size_t l = l0; l < l1; ++l)
+            {
+                const double a0   = a[i * a_stride_m + l * a_stride_k];
+                const double* b_l = b + l * n;
+                for(std::size_t j = 0; j < n; ++j)
+                    c0[j] += a0 * b_l[j];
+            }
+        }
+    }
+}
+
+template <std::size_t ConvDim>
+struct geometry
+{
+    std::size_t batch       = 0;
+    std::size_t groups      = 0;
+    std::size_t c_per_group = 0;
+    std::size_t k_per_group = 0;
+    std::size_t in_pixels   = 1;
+    std::size_t out_pixels  = 1;
+    std::size_t taps        = 1;
+    std::array<std::ptrdiff_t, ConvDim> in_len{};
+    std::array<std::ptrdiff_t, ConvDim> out_len{};
+    std::array<std::ptrdiff_t, ConvDim> strides{};
+    std::array<std::ptrdiff_t, ConvDim> pads{};
+    // Input coordinate of each output pixel at filter tap 0, and offset of each tap.
+    std::vector<std::array<std::ptrdiff_t, ConvDim>> origin;
+    std::vector<std::array<std::ptrdiff_t, ConvDim>> tap_offset;
+
+    template <class Range>
+    geometry(const miopen::TensorDescriptor& in,
+             const miopen::TensorDescriptor& wei,
+             const miopen::TensorDescriptor& out,
+             const Range& pads_,
+             const Range& strides_,
+             const Range& dilations_,
+             std::size_t group_count)
+    {
+        batch       = in.GetLengths()[0];
+        groups      = group_count;
+        c_per_group = wei.GetLengths()[1];
+        k_per_group = wei.GetLengths()[0] / group_count;
+
+        std::array<std::size_t, ConvDim> wei_len{};
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            in_len[i]  = in.GetLengths()[2 + i];
+            out_len[i] = out.GetLengths()[2 + i];
+            wei_len[i] = wei.GetLengths()[2 + i];
+            strides[i] = strides_[i];
+            pads[i]    = pads_[i];
+            in_pixels *= in_len[i];
+            out_pixels *= out_len[i];
+            taps *= wei_len[i];
+        }
+
+        origin.resize(out_pixels);
+        for(std::size_t p = 0; p < out_pixels; ++p)
+        {
+            std::size_t rest = p;
+            for(std::size_t i = ConvDim; i-- > 0;)
+            {
+                origin[p][i] = std::ptrdiff_t(rest % out_len[i]) * strides[i] - pads[i];
+                rest /= out_len[i];
+            }
+        }
+
+        tap_offset.resize(taps);
+        for(std::size_t t = 0; t < taps; ++t)
+        {
+            std::size_t rest = t;
+            for(std::size_t i = ConvDim; i-- > 0;)
+            {
+                tap_offset[t][i] = std::ptrdiff_t(rest % wei_len[i]) * dilations_[i];
+                rest /= wei_len[i];
+            }
+        }
+    }
+
+    std::size_t rows() const { return c_per_group * taps; }
+
+    // Index of the input pixel read by output pixel p at filter tap t, or -1 in the padding.
+    std::ptrdiff_t input_index(std::size_t p, std::size_t t) const
+    {
+        std::ptrdiff_t index = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const std::ptrdiff_t x = origin[p][i] + tap_offset[t][i];
+            if(x < 0 || x >= in_len[i])
+                return -1;
+            index = index * in_len[i] + x;
+        }
+        return index;
+    }
+};
+
+// Column matrix of input channels [c0, c1) and output pixels [p0, p1): element (row, pixel) is
+// stored at col[row * row_stride + (pixel - p0) * pixel_stride].
+template <std::size_t ConvDim, class T>
+void im2col(const geometry<ConvDim>& geo,
+            const T* in,
+            std::size_t c0,
+            std::size_t c1,
+            std::size_t p0,
+            std::size_t p1,
+            double* col,
+            std::size_t row_stride,
+            std::size_t pixel_stride)
+{
+    for(std::size_t c = c0; c < c1; ++c)
+    {
+        const T* in_c = in + c * geo.in_pixels;
+        for(std::size_t t = 0; t < geo.taps; ++t)
+        {
+            double* row = col + ((c - c0) * geo.taps + t) * row_stride;
+            for(std::size_t p = p0; p < p1; ++p)
+            {
+                const auto index = geo.input_index(p, t);
+                row[(p - p0) * pixel_stride] = index < 0 ? 0.0 : double(in_c[index]);
+            }
+        }
+    }
+}
+
+// Inverse of im2col with row_stride p1 - p0 and pixel_stride 1: adds every column element to
+// the input pixel it was read from.
+template <std::size_t ConvDim>
+void col2im(const geometry<ConvDim>& geo,
+            const double* col,
+            std::size_t c0,
+            std::size_t c1,
+            std::size_t p0,
+            std::size_t p1,
+            double* in)
+{
+    const std::size_t width = p1 - p0;
+    for(std::size_t c = c0; c < c1; ++c)
+    {
+        double* in_c = in + (c - c0) * geo.in_pixels;
+        for(std::size_t t = 0; t < geo.taps; ++t)
+        {
+            const double* row = col + ((c - c0) * geo.taps + t) * width;
+            for(std::size_t p = p0; p < p1; ++p)
+            {
+                const auto index = geo.input_index(p, t);
+                if(index >= 0)
+                    in_c[index] += row[p - p0];
+            }
+        }
+    }
+}
+
+// Rows [k0, k0 + rows) and pixels [p0, p1) of one image and group of a packed tensor.
+template <class T>
+void load_block(const T* src,
+                std::size_t rows,
+                std::size_t pixels,
+                std::size_t p0,
+                std::size_t p1,
+                double* dst)
+{
+    for(std::size_t r = 0; r < rows; ++r)
+        for(std::size_t p = p0; p < p1; ++p)
+            dst[r * (p1 - p0) + p - p0] = double(src[r * pixels + p]);
+}
+
+template <std::size_t ConvDim, class Tin, class Tout>
+void forward_direct(const geometry<ConvDim>& geo,
+                    const Tin* in,
+                    const std::vector<double>& wei,
+                    Tout* out)
+{
+    const std::size_t k_len      = geo.groups * geo.k_per_group;
+    const std::ptrdiff_t width   = geo.out_len[ConvDim - 1];
+    const std::ptrdiff_t in_last = geo.in_len[ConvDim - 1];
+    const std::size_t lines      = geo.out_pixels / width;
+
+    par_for(geo.batch * k_len, 1, [&](std::size_t task) {
+        const std::size_t n = task / k_len;
+        const std::size_t k = task % k_len;
+        const std::size_t g = k / geo.k_per_group;
+
+        std::vector<double> acc(geo.out_pixels, 0.0);
+        for(std::size_t c = 0; c < geo.c_per_group; ++c)
+        {
+            const Tin* in_c = in + (n * geo.groups * geo.c_per_group + g * geo.c_per_group + c) *
+                                       geo.in_pixels;
+            for(std::size_t t = 0; t < geo.taps; ++t)
+            {
+                const double w = wei[(k * geo.c_per_group + c) * geo.taps + t];
+                // Along the innermost dimension the stride is 1, so input and output advance
+                // together and only the valid range needs computing.
+                const std::ptrdiff_t shift = geo.tap_offset[t][ConvDim - 1] - geo.pads[ConvDim - 1];
+                const std::ptrdiff_t x0    = std::max<std::ptrdiff_t>(0, -shift);
+                const std::ptrdiff_t x1    = std::min<std::ptrdiff_t>(width, in_last - shift);
+                if(x0 >= x1)
+                    continue;
+                for(std::size_t line = 0; line < lines; ++line)
+                {
+                    const std::size_t p = line * width;
+                    std::ptrdiff_t base = 0;
+                    bool inside         = true;
+                    for(std::size_t i = 0; i + 1 < ConvDim; ++i)
+                    {
+                        const std::ptrdiff_t x = geo.origin[p][i] + geo.tap_offset[t][i];
+                        inside                 = inside && x >= 0 && x < geo.in_len[i];
+                        base                   = base * geo.in_len[i] + x;
+                    }
+                    if(!inside)
+                        continue;
+                    const Tin* src = in_c + base * in_last + shift;
+                    double* dst    = acc.data() + p;
+                    for(std::ptrdiff_t x = x0; x < x1; ++x)
+                        dst[x] += w * double(src[x]);
+                }
+            }
+        }
+
+        Tout* out_k = out + (n * k_len + k) * geo.out_pixels;
+        std::copy(acc.begin(), acc.end(), out_k);
+    });
+}
+
+template <std::size_t ConvDim, class Tin, class Tout>
+void forward_gemm(const geometry<ConvDim>& geo,
+                  const Tin* in,
+                  const std::vector<double>& wei,
+                  Tout* out)
+{
+    const std::size_t rows   = geo.rows();
+    const std::size_t blocks = (geo.out_pixels + pixel_block - 1) / pixel_block;
+
+    par_for(geo.batch * geo.groups * blocks, 1, [&](std::size_t task) {
+        const std::size_t block = task % blocks;
+        const std::size_t g     = (task / blocks) % geo.groups;
+        const std::size_t n     = task / blocks / geo.groups;
+        const std::size_t p0    = block * pixel_block;
+        const std::size_t p1    = std::min(p0 + pixel_block, geo.out_pixels);
+        const std::size_t width = p1 - p0;
+
+        std::vector<double> col(rows * width);
+        std::vector<double> acc(geo.k_per_group * width, 0.0);
+
+        const Tin* in_g = in + (n * geo.groups + g) * geo.c_per_group * geo.in_pixels;
+        im2col(geo, in_g, 0, geo.c_per_group, p0, p1, col.data(), width, 1);
+        gemm_acc(geo.k_per_group,
+                 width,
+                 rows,
+                 wei.data() + g * geo.k_per_group * rows,
+                 rows,
+                 1,
+                 col.data(),
+                 acc.data());
+
+        Tout* out_g = out + (n * geo.groups + g) * geo.k_per_group * geo.out_pixels;
+        for(std::size_t k = 0; k < geo.k_per_group; ++k)
+            std::copy_n(acc.begin() + k * width, width, out_g + k * geo.out_pixels + p0);
+    });
+}
+
+template <std::size_t ConvDim, class Tin, class Twei, class Tout, class Range>
+void forward(const tensor<Tin>& in,
+             const tensor<Twei>& wei,
+             tensor<Tout>& out,
+             const Range& pads,
+             const Range& strides,
+             const Range& dilations,
+             std::size_t group_count)
+{
+    const geometry<ConvDim> geo(
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count);
+    if(geo.out_pixels == 0)
+        return;
+    const auto w = to_double(wei.data);
+
+    if(geo.k_per_group < direct_max_k && geo.strides[ConvDim - 1] == 1)
+        forward_direct(geo, in.data.data(), w, out.data.data());
+    else
+        forward_gemm(geo, in.data.data(), w, out.data.data());
+}
+
+template <std::size_t ConvDim, class Tin, class Twei, class Tout, class Range>
+void backward_data(tensor<Tin>& in,
+                   const tensor<Twei>& wei,
+                   const tensor<Tout>& out,
+                   const Range& pads,
+                   const Range& strides,
+                   const Range& dilations,
+                   std::size_t group_count)
+{
+    const geometry<ConvDim> geo(
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count);
+    const auto w             = to_double(wei.data);
+    const std::size_t rows   = geo.rows();
+    const std::size_t chunks = (geo.c_per_group + channel_block - 1) / channel_block;
+
+    par_for(geo.batch * geo.groups * chunks, 1, [&](std::size_t task) {
+        const std::size_t chunk      = task % chunks;
+        const std::size_t g          = (task / chunks) % geo.groups;
+        const std::size_t n          = task / chunks / geo.groups;
+        const std::size_t c0         = chunk * channel_block;
+        const std::size_t c1         = std::min(c0 + channel_block, geo.c_per_group);
+        const std::size_t chunk_rows = (c1 - c0) * geo.taps;
+
+        std::vector<double> acc((c1 - c0) * geo.in_pixels, 0.0);
+        std::vector<double> dout(geo.k_per_group * pixel_block);
+        std::vector<double> col(chunk_rows * pixel_block);
+
+        const Tout* out_g =
+            out.data.data() + (n * geo.groups + g) * geo.k_per_group * geo.out_pixels;
+        for(std::size_t p0 = 0; p0 < geo.out_pixels; p0 += pixel_block)
+        {
+            const std::size_t p1    = std::min(p0 + pixel_block, geo.out_pixels);
+            const std::size_t width = p1 - p0;
+            load_block(out_g, geo.k_per_group, geo.out_pixels, p0, p1, dout.data());
+            std::fill(col.begin(), col.end(), 0.0);
+            // col = W^T * dout, W being the k_per_group x rows weight matrix of the group.
+            gemm_acc(chunk_rows,
+                     width,
+                     geo.k_per_group,
+                     w.data() + g * geo.k_per_group * rows + c0 * geo.taps,
+                     1,
+                     rows,
+                     dout.data(),
+                     col.data());
+            col2im(geo, col.data(), c0, c1, p0, p1, acc.data());
+        }
+
+        Tin* in_g = in.data.data() + ((n * geo.groups + g) * geo.c_per_group + c0) * geo.in_pixels;
+        std::copy(acc.begin(), acc.end(), in_g);
+    });
+}
+
+template <std::size_t ConvDim, class Tin, class Twei, class Tout, class Range>
+void backward_weight(const tensor<Tin>& in,
+                     tensor<Twei>& wei,
+                     const tensor<Tout>& out,
+                     const Range& pads,
+                     const Range& strides,
+                     const Range& dilations,
+                     std::size_t group_count)
+{
+    const geometry<ConvDim> geo(
+        in.desc, wei.desc, out.desc, pads, strides, dilations, group_count);
+    const std::size_t rows   = geo.rows();
+    const std::size_t chunks = (geo.c_per_group + channel_block - 1) / channel_block;
+    // With few groups and channels, split the batch too and sum the partial results afterwards.
+    const std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    const std::size_t splits =
+        std::max<std::size_t>(1, std::min(geo.batch, threads / (geo.groups * chunks)));
+    const std::size_t wei_size = geo.groups * geo.k_per_group * rows;
+
+    std::vector<double> partial(splits * wei_size, 0.0);
+    par_for(splits * geo.groups * chunks, 1, [&](std::size_t task) {
+        const std::size_t chunk      = task % chunks;
+        const std::size_t g          = (task / chunks) % geo.groups;
+        const std::size_t split      = task / chunks / geo.groups;
+        const std::size_t c0         = chunk * channel_block;
+        const std::size_t c1         = std::min(c0 + channel_block, geo.c_per_group);
+        const std::size_t chunk_rows = (c1 - c0) * geo.taps;
+
+        std::vector<double> acc(geo.k_per_group * chunk_rows, 0.0);
+        std::vector<double> dout(geo.k_per_group * pixel_block);
+        std::vector<double> col(pixel_block * chunk_rows);
+
+        for(std::size_t n = split; n < geo.batch; n += splits)
+        {
+            const Tin* in_g =
+                in.data.data() + (n * geo.groups + g) * geo.c_per_group * geo.in_pixels;
+            const Tout* out_g =
+                out.data.data() + (n * geo.groups + g) * geo.k_per_group * geo.out_pixels;
+            for(std::size_t p0 = 0; p0 < geo.out_pixels; p0 += pixel_block)
+            {
+                const std::size_t p1    = std::min(p0 + pixel_block, geo.out_pixels);
+                const std::size_t width = p1 - p0;
+                load_block(out_g, geo.k_per_group, geo.out_pixels, p0, p1, dout.data());
+                // Transposed columns, so that dW += dout * col^T runs along the rows of col.
+                im2col(geo, in_g, c0, c1, p0, p1, col.data(), 1, chunk_rows);
+                gemm_acc(geo.k_per_group,
+                         chunk_rows,
+                         width,
+                         dout.data(),
+                         width,
+                         1,
+                         col.data(),
+                         acc.data());
+            }
+        }
+
+        double* dst = partial.data() + split * wei_size + g * geo.k_per_group * rows;
+        for(std::size_t k = 0; k < geo.k_per_group; ++k)
+            std::copy_n(acc.begin() + k * chunk_rows, chunk_rows, dst + k * rows + c0 * geo.taps);
+    });
+
+    for(std::size_t i = 0; i < wei_size; ++i)
+    {
+        double sum = 0;
+        for(std::size_t split = 0; split < splits; ++split)
+            sum += partial[split * wei_size + i];
+        wei.data[i] = sum;
+    }
+}
+
+} // namespace cpu_conv_fast
+
+inline bool cpu_convolution_fast_applicable(std::size_t spatial_dim,
+                                            const miopen::TensorDescriptor& in,
+                                            const miopen::TensorDescriptor& wei,
+                                            const miopen::TensorDescriptor& out)
+{
+    return selected_cpu_conv_engine() == cpu_conv_engine::fast && spatial_dim >= 1 &&
+           spatial_dim <= 4 && cpu_conv_fast::is_packed_nchw(in) &&
+           cpu_conv_fast::is_packed_nchw(wei) && cpu_conv_fast::is_packed_nchw(out);
+}
+
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_fast(std::size_t spatial_dim,
+                                  const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    visit_tensor_size(spatial_dim, [&](auto dim) {
+        cpu_conv_fast::forward<std::max<std::size_t>(decltype(dim){}, 1)>(
+            in, wei, out, pads, strides, dilations, group_count);
+    });
+}
+
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_fast(std::size_t spatial_dim,
+                                        tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    visit_tensor_size(spatial_dim, [&](auto dim) {
+        cpu_conv_fast::backward_data<std::max<std::size_t>(decltype(dim){}, 1)>(
+            in, wei, out, pads, strides, dilations, group_count);
+    });
+}
+
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_fast(std::size_t spatial_dim,
+                                          const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    visit_tensor_size(spatial_dim, [&](auto dim) {
+        cpu_conv_fast::backward_weight<std::max<std::size_t>(decltype(dim){}, 1)>(
+            in, wei, out, pads, strides, dilations, group_count);
+    });
+}
+
+#endif
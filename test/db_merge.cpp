@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_merge.hpp>
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+
+std::string merge(miopen::DbMerger& merger, const std::vector<std::string>& inputs)
+{
+    for(auto&& input : inputs)
+    {
+        std::istringstream ss(input);
+        merger.Add(ss);
+    }
+    std::ostringstream out;
+    merger.Write(out);
+    return out.str();
+}
+
+void check_perf_vote()
+{
+    miopen::DbMerger merger{miopen::DbKind::Perf};
+    const auto out = merge(merger,
+                           {"k1=A:1,2;B:7\nk2=A:5\n",
+                            "k1=A:3,4;C:8\n",
+                            "k1=A:3,4\nk2=A:6\nbroken\nk3=X\n"});
+    // A: 3,4 has two votes; k2: tie, the first input wins
+    EXPECT(out == "k1=A:3,4;B:7;C:8\nk2=A:5\n");
+    const auto& stats = merger.GetStats();
+    EXPECT(stats.files == 3);
+    EXPECT(stats.records == 2);
+    EXPECT(stats.entries == 4);
+    EXPECT(stats.conflicts == 2);
+    EXPECT(stats.by_vote == 2);
+    EXPECT(stats.by_time == 0);
+    EXPECT(stats.malformed == 2);
+}
+
+void check_find_time()
+{
+    miopen::DbMerger merger{miopen::DbKind::Find};
+    const auto out = merge(merger,
+                           {"k=miopenConvolutionFwdAlgoDirect:ConvAsm3x3U,0.5,0,c1\n",
+                            "k=miopenConvolutionFwdAlgoDirect:ConvAsm1x1U,0.2,0,c2\n",
+                            "k=miopenConvolutionFwdAlgoDirect:ConvAsm3x3U,0.5,0,c1\n",
+                            "k=miopenConvolutionFwdAlgoGEMM:not_find_db_data\n"});
+    // The faster one wins although the other has more votes
+    EXPECT(out == "k=miopenConvolutionFwdAlgoDirect:ConvAsm1x1U,0.2,0,c2\n");
+    EXPECT(merger.GetStats().by_time == 1);
+    EXPECT(merger.GetStats().malformed == 1);
+}
+
+void check_validator()
+{
+    miopen::DbMerger merger{miopen::DbKind::Perf,
+                            [](const std::string& key, const std::string& id, const std::string&) {
+                                return key != "bad" && id != "Old";
+                            }};
+    const auto out = merge(merger, {"bad=A:1\nk=A:1;Old:2\n", "k=A:2\n"});
+    // Invalid entries do not vote
+    EXPECT(out == "k=A:1\n");
+    EXPECT(merger.GetStats().invalid == 2);
+    EXPECT(merger.GetStats().by_vote == 1);
+}
+
+int main()
+{
+    check_perf_vote();
+    check_find_time();
+    check_validator();
+}
@@ -31,6 +31,7 @@
 #include "tensor_holder.hpp"
 #include "test.hpp"
 #include "verify.hpp"
+#include "verify_cache.hpp"
 
 #include <functional>
 #include <deque>
@@ -95,6 +96,7 @@ auto cpu_async(V& v, Ts&&... xs) -> std::future<decltype(v.cpu(xs...))>
 }
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_PATH)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_LIMIT)
 
 struct test_driver
 {
@@ -153,11 +155,23 @@ struct test_driver
             return e;
     }
 
+    // Size bound of the verification cache in MiB
+    static int compute_cache_limit()
+    {
+        auto e = miopen::Value(MIOPEN_VERIFY_CACHE_LIMIT{});
+        if(e == 0)
+            return 4096;
+        else
+            return e;
+    }
+
     std::string program_name;
     std::deque<argument> arguments;
     std::unordered_map<std::string, std::size_t> argument_index;
-    int cache_version      = 1;
+    int cache_version      = 2;
     std::string cache_path = compute_cache_path();
+    int cache_limit        = compute_cache_limit();
+    int cache_compress     = 1024;
     miopenDataType_t type  = miopenFloat;
     bool full_set          = false;
     bool verbose           = false;
@@ -192,6 +206,12 @@ struct test_driver
         v(rethrow, {"--rethrow"}, "Rethrow any exceptions found during verify");
         v(cache_path, {"--verification-cache", "-C"}, "Path to verification cache");
         v(disabled_cache, {"--disable-verification-cache"}, "Disable verification cache");
+        v(cache_limit,
+          {"--verification-cache-limit"},
+          "Evict least recently used verification cache entries above this many MiB");
+        v(cache_compress,
+          {"--verification-cache-compress"},
+          "Compress verification cache entries larger than this many KiB (0 disables)");
     }
 
     struct per_arg
@@ -609,21 +629,24 @@ struct test_driver
         auto f = p / key;
         if(boost::filesystem::exists(f) and not retry)
         {
-            miss = false;
-            return detach_async([=] {
-                result_type result;
-                load(f.string(), result);
-                return result;
-            });
-        }
-        else
-        {
-            miss = true;
-            return then(cpu_async(v, xs...), [=](auto data) {
-                save(f.string(), data);
-                return data;
-            });
+            result_type result;
+            if(verify_cache::load(f.string(), result))
+            {
+                miss = false;
+                verify_cache::touch(f.string());
+                std::promise<result_type> cached;
+                cached.set_value(std::move(result));
+                return cached.get_future();
+            }
         }
+        miss                 = true;
+        const auto limit     = std::size_t(cache_limit) << 20;
+        const auto threshold = std::size_t(cache_compress) << 10;
+        return then(cpu_async(v, xs...), [=](auto data) {
+            verify_cache::save(f.string(), data, threshold);
+            verify_cache::evict(p, limit);
+            return data;
+        });
     }
 
     template <class F, class V, class... Ts>
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/find_budget.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <thread>
+
+struct candidate
+{
+    std::string id;
+    float estimate;
+    float time;
+};
+
+std::vector<std::string> run(miopen::FindBudget& budget, const std::vector<candidate>& all)
+{
+    std::vector<std::string> evaluated;
+    for(auto&& c : all)
+        budget.Add("algo", c.id, c.estimate, [&evaluated, c]() {
+            evaluated.push_back(c.id);
+            return c.time;
+        });
+    budget.Run();
+    return evaluated;
+}
+
+void check_unlimited()
+{
+    // Everything is timed in the order it was added
+    miopen::FindBudget budget{0};
+    const auto evaluated = run(budget, {{"a", 10, 10}, {"b", 1, 1}, {"c", 1000, 1000}});
+    EXPECT(evaluated == std::vector<std::string>({"a", "b", "c"}));
+    EXPECT(budget.GetSkipped().empty());
+}
+
+void check_ordering_and_pruning()
+{
+    miopen::FindBudget budget{1e6f};
+    // The model overestimates by 10x, which calibration compensates
+    const auto evaluated = run(budget,
+                               {{"slow", 1000, 100},
+                                {"fast", 10, 1},
+                                {"close", 15, 1.5f},
+                                {"na", 12, -1},
+                                {"far", 100, 10}});
+    EXPECT(evaluated == std::vector<std::string>({"fast", "na", "close"}));
+    EXPECT(budget.GetSkipped().size() == 2);
+    EXPECT(budget.GetSkipped()[0].solver_id == "far");
+    EXPECT(budget.GetSkipped()[1].solver_id == "slow");
+    EXPECT(budget.GetSkipped()[1].estimate == 1000);
+}
+
+void check_not_applicable_first()
+{
+    // Nothing is skipped until something has been measured
+    miopen::FindBudget budget{1e6f};
+    const auto evaluated = run(budget, {{"na", 1, -1}, {"b", 100, 5}});
+    EXPECT(evaluated == std::vector<std::string>({"na", "b"}));
+    EXPECT(budget.GetSkipped().empty());
+}
+
+void check_exhausted()
+{
+    miopen::FindBudget budget{1};
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    // The first candidate always runs, an out of date estimate does not matter afterwards
+    const auto evaluated = run(budget, {{"a", 1, 1}, {"b", 1, 0.5f}});
+    EXPECT(evaluated == std::vector<std::string>({"a"}));
+    EXPECT(budget.GetSkipped().size() == 1);
+}
+
+int main()
+{
+    check_unlimited();
+    check_ordering_and_pruning();
+    check_not_applicable_first();
+    check_exhausted();
+}
@@ -203,6 +203,16 @@ void batchNormPerActivHostInference(const tensor<T>& input,
     });
 }
 
+// Adds the shortcut of a residual block, which has the same layout as the output
+template <class T>
+void residualAddHostInference(tensor<T>& output, const tensor<T>& residual)
+{
+    par_for(output.data.size(), 1, [&](int index) {
+        output.data[index] = static_cast<T>(static_cast<double>(output.data[index]) +
+                                            static_cast<double>(residual.data[index]));
+    });
+}
+
 template <class T, class U>
 void batchNormSpatialHostFwdTrain(const tensor<T>& input,
                                   tensor<T>& out,
@@ -27,6 +27,10 @@
 #include <miopen/miopen.h>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/fusion_plan.hpp>
+#include <miopen/solver_cache.hpp>
+
+#include <string>
+#include <vector>
 
 #include "get_handle.hpp"
 #include "test.hpp"
@@ -72,6 +76,51 @@ void chk_getop_bounds()
     EXPECT(miopenError != miopenStatusSuccess);
 }
 
+void chk_plan_cache()
+{
+    auto&& handle = get_handle();
+    miopen::TensorDescriptor inputTensor(miopenFloat, {1, 64, 28, 28});
+    miopen::TensorDescriptor convFilter(miopenFloat, {64, 64, 1, 1});
+    miopen::TensorDescriptor biasTensor(miopenFloat, {1, 64, 1, 1});
+    miopen::ConvolutionDescriptor convDesc;
+    miopenFusionOpDescriptor_t convoOp;
+    miopenFusionOpDescriptor_t biasOp;
+    miopenFusionOpDescriptor_t activOp;
+
+    // Recreating a plan shall give the same kernel, whether it is looked up or compiled
+    std::vector<std::string> compiled;
+    std::vector<std::shared_ptr<const miopen::CompiledFusionPlan>> plans;
+    for(int i = 0; i < 2; ++i)
+    {
+        miopen::FusionPlanDescriptor fp(miopenVerticalFusion, inputTensor);
+        STATUS(miopenCreateOpConvForward(&fp, &convoOp, &convDesc, &convFilter));
+        STATUS(miopenCreateOpBiasForward(&fp, &biasOp, &biasTensor));
+        STATUS(miopenCreateOpActivationForward(&fp, &activOp, miopenActivationRELU));
+        if(miopenCompileFusionPlan(&handle, &fp) != miopenStatusSuccess)
+            return; // Not supported on this device
+        compiled.push_back(fp.GetProgramName(handle) + ',' + fp.GetKernelName(handle) + ',' +
+                           fp.GetAlgorithmName(handle));
+        plans.push_back(fp.GetCompiledPlan());
+    }
+    EXPECT(compiled[0] == compiled[1]);
+    // The second plan reuses what compiling the first one built
+    if(miopen::IsSolverCacheEnabled())
+    {
+        EXPECT(plans[0] != nullptr);
+        EXPECT(plans[1] == plans[0]);
+    }
+
+    // So shall an unsupported sequence of ops stay unsupported
+    for(int i = 0; i < 2; ++i)
+    {
+        miopen::FusionPlanDescriptor fp(miopenVerticalFusion, inputTensor);
+        STATUS(miopenCreateOpBatchNormInference(&fp, &biasOp, miopenBNSpatial, &biasTensor));
+        EXPECT(miopenCreateOpConvForward(&fp, &convoOp, &convDesc, &convFilter) !=
+               miopenStatusSuccess);
+        EXPECT(!fp.isValid());
+    }
+}
+
 int main()
 {
     /*
@@ -79,4 +128,5 @@ int main()
      * bound checking on the incoming index
      */
     chk_getop_bounds();
+    chk_plan_cache();
 }
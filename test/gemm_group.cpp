@@ -0,0 +1,109 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/gemm_v2.hpp>
+#include "test.hpp"
+
+#include <vector>
+
+miopen::GemmDescriptor make_desc(int m, int n, int k)
+{
+    // row-major C = A * B, single batch
+    return {false, false, false, m, n, k, k, n, n, 1, 0, 0, 0, 1, 0, miopenFloat};
+}
+
+void check_disjoint()
+{
+    auto desc        = make_desc(4, 8, 16);
+    desc.batch_count = 3;
+
+    desc.strideC = 4 * 8;
+    EXPECT(miopen::IsGemmBatchDisjoint(desc));
+
+    // batches accumulate into the same C (1x1 backward weights)
+    desc.strideC = 0;
+    EXPECT(!miopen::IsGemmBatchDisjoint(desc));
+
+    desc.strideC = 4 * 8 - 1;
+    EXPECT(!miopen::IsGemmBatchDisjoint(desc));
+}
+
+void check_coalesce_uniform()
+{
+    const auto desc = make_desc(4, 8, 16);
+    float buffers[3];
+    auto a = DataCast(&buffers[0]);
+    auto b = DataCast(&buffers[1]);
+    auto c = DataCast(&buffers[2]);
+
+    std::vector<miopen::GemmGroupMember> members;
+    for(int i = 0; i < 5; i++)
+        members.push_back({desc, a, 0, b, i * 128, c, i * 32});
+
+    const auto runs = miopen::CoalesceGemmGroup(members);
+    EXPECT_EQUAL(runs.size(), 1);
+    EXPECT_EQUAL(runs[0].gemm_desc.batch_count, 5);
+    EXPECT_EQUAL(runs[0].gemm_desc.strideA, 0);
+    EXPECT_EQUAL(runs[0].gemm_desc.strideB, 128);
+    EXPECT_EQUAL(runs[0].gemm_desc.strideC, 32);
+    EXPECT_EQUAL(runs[0].b_offset, 0);
+}
+
+void check_coalesce_breaks()
+{
+    const auto desc  = make_desc(4, 8, 16);
+    const auto other = make_desc(4, 8, 32);
+    float buffers[4];
+    auto a = DataCast(&buffers[0]);
+    auto b = DataCast(&buffers[1]);
+    auto c = DataCast(&buffers[2]);
+    auto d = DataCast(&buffers[3]);
+
+    std::vector<miopen::GemmGroupMember> members = {
+        {desc, a, 0, b, 0, c, 0},
+        {desc, a, 0, b, 128, c, 32},
+        // stride changes
+        {desc, a, 0, b, 512, c, 64},
+        // other shape
+        {other, a, 0, b, 1024, c, 96},
+        // other buffer
+        {desc, a, 0, b, 0, d, 0},
+        // same C, must stay sequential
+        {desc, a, 0, b, 128, d, 0},
+    };
+
+    const auto runs = miopen::CoalesceGemmGroup(members);
+    EXPECT_EQUAL(runs.size(), 5);
+    EXPECT_EQUAL(runs[0].gemm_desc.batch_count, 2);
+    for(std::size_t i = 1; i < runs.size(); i++)
+        EXPECT_EQUAL(runs[i].gemm_desc.batch_count, 1);
+}
+
+int main()
+{
+    check_disjoint();
+    check_coalesce_uniform();
+    check_coalesce_breaks();
+}
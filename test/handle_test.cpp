@@ -1,6 +1,7 @@
 
 #include <miopen/handle.hpp>
 #include "get_handle.hpp"
+#include <memory>
 #include <vector>
 #include <thread>
 #include "test.hpp"
@@ -31,6 +32,112 @@ void test_multithreads()
     run2s(h, 4);
 }
 
+void test_streams()
+{
+    miopen::Handle h{};
+    EXPECT(h.GetStreamCount() == 1);
+    auto s1 = h.AddStream();
+    auto s2 = h.AddStream();
+    EXPECT(s1 == 1);
+    EXPECT(s2 == 2);
+    EXPECT(h.GetStreamCount() == 3);
+    EXPECT(h.GetActiveStream() == 0);
+    EXPECT(throws([&] { h.SetActiveStream(3); }));
+
+    // Both threads launch the same cached kernel, each on its own stream
+    auto on_stream = [&](std::size_t s, std::size_t n) {
+        h.SetActiveStream(s);
+        EXPECT(h.GetActiveStream() == s);
+        for(int i = 0; i < 8; i++)
+            run2s(h, n);
+    };
+    std::thread t1(on_stream, s1, 64);
+    std::thread t2(on_stream, s2, 64);
+    t1.join();
+    t2.join();
+    EXPECT(h.GetActiveStream() == 0);
+
+    // Producer on one stream, consumer on another
+    std::size_t n = 128;
+    std::vector<int> data_in(n, 1);
+    auto data_dev = h.Write(data_in);
+    h.SetActiveStream(s1);
+    h.AddKernel("GEMM", "", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(data_dev.get());
+    h.StreamWaitStream(s2, s1);
+    h.SetActiveStream(s2);
+    h.AddKernel("GEMM", "", Write2s(), "write", {n, 1, 1}, {n, 1, 1}, "")(data_dev.get());
+    std::fill(data_in.begin(), data_in.end(), 4);
+    EXPECT(h.Read<int>(data_dev, n) == data_in);
+    h.SetActiveStream(0);
+}
+
+void test_streams_grow_while_running()
+{
+    miopen::Handle h{};
+    std::thread launcher([&] {
+        for(int i = 0; i < 32; i++)
+            run2s(h, 16);
+    });
+    for(int i = 0; i < 16; i++)
+        h.AddStream();
+    launcher.join();
+    EXPECT(h.GetStreamCount() == 17);
+}
+
+void test_profiling_per_thread()
+{
+    miopen::Handle h{};
+    h.EnableProfiling(true);
+    run2s(h, 16);
+    std::thread other([&] {
+        EXPECT(not h.IsProfilingEnabled());
+        EXPECT(h.GetKernelTime() == 0.0f);
+    });
+    other.join();
+    EXPECT(h.IsProfilingEnabled());
+    h.EnableProfiling(false);
+}
+
+void test_concurrent_build()
+{
+    // Every thread builds the program; one build ends up in the cache
+    miopen::Handle h{};
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++)
+        threads.emplace_back([&] { run2s(h, 16); });
+    for(auto&& t : threads)
+        t.join();
+    run2s(h, 16);
+}
+
+void test_thread_state_released()
+{
+    const auto& entries = miopen::detail::GetThreadHandleEntries();
+    const auto before   = entries.size();
+    for(int i = 0; i < 8; i++)
+    {
+        miopen::Handle h{};
+        EXPECT(h.GetKernelTime() == 0.0f);
+    }
+    EXPECT(entries.size() == before);
+
+    // The state a thread keeps for handles destroyed by other threads is dropped when it first
+    // uses another handle
+    std::thread([] {
+        const auto& own = miopen::detail::GetThreadHandleEntries();
+        for(int i = 0; i < 8; i++)
+        {
+            auto h = std::make_shared<miopen::Handle>();
+            EXPECT(h->GetKernelTime() == 0.0f);
+            std::thread([&] { h.reset(); }).join();
+        }
+        EXPECT(own.size() == 8);
+        miopen::Handle h{};
+        EXPECT(h.GetKernelTime() == 0.0f);
+        EXPECT(own.size() == 1);
+    }).join();
+}
+
 std::string WriteError() { return "__kernel void write(__global int* data) { data[i] = 0; }\n"; }
 
 void test_errors()
@@ -64,6 +171,11 @@ void test_warnings()
 int main()
 {
     test_multithreads();
+    test_streams();
+    test_streams_grow_while_running();
+    test_profiling_per_thread();
+    test_concurrent_build();
+    test_thread_state_released();
     test_errors();
 // Warnings currently dont work in opencl
 #if !MIOPEN_BACKEND_OPENCL
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/logger.hpp>
+#include "test.hpp"
+
+#include <cstdlib>
+
+int message_evaluations = 0;
+
+std::string Message()
+{
+    ++message_evaluations;
+    return "should not be formatted";
+}
+
+void check_levels()
+{
+    EXPECT(miopen::IsLogging(miopen::LoggingLevel::Error));
+    EXPECT(miopen::IsLogging(miopen::LoggingLevel::Warning));
+    EXPECT(!miopen::IsLogging(miopen::LoggingLevel::Info));
+    EXPECT(!miopen::IsLogging(miopen::LoggingLevel::Info2));
+    EXPECT_EQUAL(miopen::detail::logging_level.load(),
+                 static_cast<int>(miopen::LoggingLevel::Warning));
+}
+
+void check_lazy_message()
+{
+    MIOPEN_LOG_I("Info: " << Message());
+    MIOPEN_LOG_I2("Info2: " << Message());
+    EXPECT_EQUAL(message_evaluations, 0);
+}
+
+void check_compiled_levels()
+{
+    EXPECT(miopen::IsLoggingCompiled(miopen::LoggingLevel::Error));
+    EXPECT(miopen::IsLoggingCompiled(miopen::LoggingLevel::Info2) == (MIOPEN_LOG_MAX_LEVEL >= 6));
+}
+
+int main()
+{
+    setenv("MIOPEN_LOG_LEVEL", "4", 1);
+    check_levels();
+    check_lazy_message();
+    check_compiled_levels();
+}
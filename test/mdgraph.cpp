@@ -55,6 +55,33 @@ void BNAlgTest(std::vector<int> inputs,
     alg = fp.GetAlgorithmName(handle);
 }
 
+miopenStatus_t ResidualAddTest(std::vector<int> inputs,
+                               std::vector<int> residual,
+                               miopenBatchNormMode_t bnmode,
+                               std::string& pgm)
+{
+    MIOPEN_LOG_I("*********************************************************");
+    auto&& handle = get_handle();
+    miopen::TensorDescriptor inputTensor;
+    miopen::TensorDescriptor scaleTensor;
+    miopen::TensorDescriptor residualTensor;
+    miopenFusionOpDescriptor_t bNormOp = nullptr;
+    miopenFusionOpDescriptor_t addOp   = nullptr;
+
+    // input and residual descriptors
+    STATUS(miopenSet4dTensorDescriptor(
+        &inputTensor, miopenFloat, inputs[0], inputs[1], inputs[2], inputs[3]));
+    STATUS(miopenSet4dTensorDescriptor(
+        &residualTensor, miopenFloat, residual[0], residual[1], residual[2], residual[3]));
+    miopen::FusionPlanDescriptor fp(miopenVerticalFusion, inputTensor);
+
+    miopenCreateOpBatchNormInference(&fp, &bNormOp, bnmode, &scaleTensor);
+    auto status = miopenCreateOpTensorAddForward(&fp, &addOp, &residualTensor);
+    if(status == miopenStatusSuccess)
+        pgm = fp.GetProgramName(handle);
+    return status;
+}
+
 void ConvAlgTest(std::vector<int> inputs,
                  std::vector<int> conv_filter,
                  std::vector<int> conv_desc,
@@ -147,4 +174,17 @@ int main()
     EXPECT(pgm_name == "MIOpenBatchNormActivInfer.cl");
     EXPECT(krn_name == "MIOpenBatchNormActivInferPerActEst");
     EXPECT(alg_name == "MIOpenBatchNormActivInferPerActEst");
+
+    // the residual is read with the indices of the batch norm output
+    for(auto bnmode : {miopenBNSpatial, miopenBNPerActivation})
+    {
+        pgm_name.clear();
+        EXPECT(ResidualAddTest({100, 32, 8, 8}, {100, 32, 8, 8}, bnmode, pgm_name) ==
+               miopenStatusSuccess);
+        EXPECT(pgm_name == "MIOpenBatchNormActivInfer.cl");
+        EXPECT(ResidualAddTest({100, 32, 8, 8}, {100, 32, 4, 4}, bnmode, pgm_name) ==
+               miopenStatusUnsupportedOp);
+        EXPECT(ResidualAddTest({100, 32, 8, 8}, {100, 16, 8, 8}, bnmode, pgm_name) ==
+               miopenStatusUnsupportedOp);
+    }
 }
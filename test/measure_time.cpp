@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/measure_time.hpp>
+#include "test.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Replays scripted times instead of running anything
+struct MockTimer
+{
+    std::vector<float> times;
+    std::size_t runs = 0;
+    int fail_at      = -1;
+
+    int operator()(float& time)
+    {
+        if(static_cast<int>(runs) == fail_at)
+            return 3;
+        time = times.at(runs++);
+        return 0;
+    }
+};
+
+static bool near(float a, float b) { return std::abs(a - b) < 1e-5f; }
+
+void check_statistics()
+{
+    std::vector<float> odd = {5, 1, 3};
+    EXPECT(near(miopen::Median(odd), 3));
+    std::vector<float> even = {4, 1, 3, 2};
+    EXPECT(near(miopen::Median(even), 2.5f));
+    std::vector<float> none;
+    EXPECT(near(miopen::Median(none), 0));
+
+    EXPECT(near(miopen::CoefficientOfVariation({2, 2, 2}), 0));
+    EXPECT(near(miopen::CoefficientOfVariation({1}), 0));
+    EXPECT(miopen::CoefficientOfVariation({1, 2, 3}) > 0.49f);
+    EXPECT(miopen::CoefficientOfVariation({1, 2, 3}) < 0.51f);
+}
+
+void check_early_stop()
+{
+    // The warm-up run is not a sample; stable samples stop at min_samples
+    MockTimer timer{{100, 1.0f, 1.01f, 0.99f, 5, 5}};
+    const auto r = miopen::MeasureTime(std::ref(timer));
+    EXPECT(r.status == 0);
+    EXPECT(!r.rejected);
+    EXPECT(r.samples == 3);
+    EXPECT(timer.runs == 4);
+    EXPECT(near(r.time, 1.0f));
+}
+
+void check_noisy()
+{
+    // Noisy samples are taken up to max_samples, and an outlier does not move the median
+    MockTimer timer{{9, 1, 3, 1, 3, 1, 3, 1, 3, 50, 7}};
+    const auto r = miopen::MeasureTime(std::ref(timer));
+    EXPECT(r.samples == 9);
+    EXPECT(timer.runs == 10);
+    EXPECT(near(r.time, 3));
+
+    // Noise settles after a few samples
+    MockTimer settling{{9, 4, 2, 2, 2, 2, 2, 2, 2, 2}};
+    const auto s = miopen::MeasureTime(std::ref(settling));
+    EXPECT(s.samples < 9);
+    EXPECT(near(s.time, 2));
+}
+
+void check_reject()
+{
+    // Far slower than the best known time: a single sample is enough
+    MockTimer slow{{9, 2, 2, 2}};
+    const auto r = miopen::MeasureTime(std::ref(slow), 1.0f);
+    EXPECT(r.rejected);
+    EXPECT(r.samples == 1);
+    EXPECT(near(r.time, 2));
+
+    // Within the margin of the best known time, keep sampling
+    MockTimer close{{9, 1.05f, 1.05f, 1.05f}};
+    const auto c = miopen::MeasureTime(std::ref(close), 1.0f);
+    EXPECT(!c.rejected);
+    EXPECT(c.samples == 3);
+
+    // A slow first sample does not reject a candidate whose later samples are fast
+    MockTimer warming{{9, 3, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f}};
+    miopen::TimingPolicy policy;
+    policy.reject_ratio = 4;
+    const auto w = miopen::MeasureTime(std::ref(warming), 1.0f, policy);
+    EXPECT(!w.rejected);
+    EXPECT(near(w.time, 0.9f));
+}
+
+void check_policy()
+{
+    miopen::TimingPolicy policy;
+    policy.warmup      = 2;
+    policy.min_samples = 2;
+    policy.max_samples = 2;
+    policy.cv_target   = 0;
+    MockTimer timer{{9, 9, 1, 2, 3}};
+    const auto r = miopen::MeasureTime(std::ref(timer), std::numeric_limits<float>::max(), policy);
+    EXPECT(r.samples == 2);
+    EXPECT(timer.runs == 4);
+    EXPECT(near(r.time, 1.5f));
+}
+
+void check_failure()
+{
+    MockTimer warmup{{1, 1, 1, 1}};
+    warmup.fail_at = 0;
+    const auto w   = miopen::MeasureTime(std::ref(warmup));
+    EXPECT(w.status == 3);
+    EXPECT(w.samples == 0);
+
+    MockTimer sample{{1, 1, 1, 1}};
+    sample.fail_at = 2;
+    const auto s   = miopen::MeasureTime(std::ref(sample));
+    EXPECT(s.status == 3);
+}
+
+int main()
+{
+    check_statistics();
+    check_early_stop();
+    check_noisy();
+    check_reject();
+    check_policy();
+    check_failure();
+}
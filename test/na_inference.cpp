@@ -69,10 +69,13 @@ struct verify_inference_batchnorm_activ
     tensor<U> bnbias{};
     tensor<U> estMean{};
     tensor<U> estVariance{};
+    tensor<T> residual{};
     miopenBatchNormMode_t bnmode;
     miopenFusionPlanDescriptor_t fusionplan;
     miopenFusionOpDescriptor_t bNormOp;
+    miopenFusionOpDescriptor_t addOp;
     miopenFusionOpDescriptor_t activOp;
+    bool doresidual = false;
     double epsilon;
 
     verify_inference_batchnorm_activ(miopenFusionPlanDescriptor_t pfusionplan,
@@ -84,7 +87,10 @@ struct verify_inference_batchnorm_activ
                                      tensor<U>& pestVariance,
                                      miopenBatchNormMode_t pbnmode,
                                      miopenFusionOpDescriptor_t pbNormOp,
-                                     miopenFusionOpDescriptor_t pactivOp)
+                                     miopenFusionOpDescriptor_t pactivOp,
+                                     bool pdoresidual,
+                                     tensor<T>& presidual,
+                                     miopenFusionOpDescriptor_t paddOp)
     {
         input           = pinput;
         inputDesc       = &pinput.desc;
@@ -98,6 +104,9 @@ struct verify_inference_batchnorm_activ
         fusionplan      = pfusionplan;
         bNormOp         = pbNormOp;
         activOp         = pactivOp;
+        doresidual      = pdoresidual;
+        residual        = presidual;
+        addOp           = paddOp;
         epsilon         = 1.0e-5;
     }
 
@@ -123,6 +132,10 @@ struct verify_inference_batchnorm_activ
             batchNormSpatialHostInference(
                 input, bout, bnscale, bnbias, epsilon, estMean, estVariance);
         }
+        if(doresidual)
+        {
+            residualAddHostInference(bout, residual);
+        }
         activationHostInfer(activ_mode, activ_gamma, activ_beta, activ_alpha, bout.data, aout.data);
         return aout;
     }
@@ -138,6 +151,7 @@ struct verify_inference_batchnorm_activ
         auto bnbias_dev      = handle.Write(bnbias.data);
         auto estMean_dev     = handle.Write(estMean.data);
         auto estVariance_dev = handle.Write(estVariance.data);
+        auto residual_dev    = handle.Write(residual.data);
 
         double activ_alpha, activ_beta, activ_gamma;
         miopenActivationMode_t activ_mode;
@@ -155,6 +169,12 @@ struct verify_inference_batchnorm_activ
                                           estMean_dev.get(),
                                           estVariance_dev.get(),
                                           epsilon);
+        if(doresidual)
+        {
+            // alpha and beta of the add are unused
+            miopenSetOpArgsTensorAddForward(
+                ptr_fusionargs.get(), addOp, nullptr, nullptr, residual_dev.get());
+        }
         miopenSetOpArgsActivForward(
             ptr_fusionargs.get(), activOp, &alpha, &beta, activ_alpha, activ_beta, activ_gamma);
         miopenExecuteFusionPlan(&handle,
@@ -168,7 +188,13 @@ struct verify_inference_batchnorm_activ
         return baout;
     }
 
-    void fail(float = 0) const { std::cerr << "BatchNorm+Activation Inference:" << std::endl; }
+    void fail(float = 0) const
+    {
+        if(doresidual)
+            std::cerr << "BatchNorm+Add+Activation Inference:" << std::endl;
+        else
+            std::cerr << "BatchNorm+Activation Inference:" << std::endl;
+    }
 };
 
 static std::string transform_mode(std::string s)
@@ -184,12 +210,14 @@ struct na_fusion_driver : test_driver
     tensor<PREC_TYPE> shift;
     tensor<PREC_TYPE> estMean;
     tensor<PREC_TYPE> estVariance;
+    tensor<T> residual;
     ptr_ActivationDesc ptr_activdesc = nullptr;
 
     miopenActivationMode_t activ_mode = miopenActivationRELU;
     std::string amode;
     miopenBatchNormMode_t bnmode{};
     int batchnormMode = 1;
+    bool tresidual{};
 
     unsigned long max_value = miopen_type<T>{} == miopenHalf ? 3 : 17;
     double alpha = 0., beta = 0., gamma = 0.;
@@ -205,6 +233,7 @@ struct na_fusion_driver : test_driver
             generate_data(
                 {"MIOPENACTIVATIONRELU", "MIOPENACTIVATIONLOGISTIC", "MIOPENACTIVATIONABS"}));
         add(batchnormMode, "batch-norm-mode", generate_data({0 /*, 1*/}));
+        add(tresidual, "test_residual", generate_data({false, true}));
     }
 
     void run()
@@ -277,17 +306,32 @@ struct na_fusion_driver : test_driver
         auto&& handle = get_handle();
 
         miopenFusionOpDescriptor_t bNormOp = nullptr;
+        miopenFusionOpDescriptor_t addOp   = nullptr;
         miopenFusionOpDescriptor_t activOp = nullptr;
 
         auto ptr_fusionplan = GetManagedFusionPlanDesc(&input.desc);
 
         miopenCreateOpBatchNormInference(ptr_fusionplan.get(), &bNormOp, bnmode, &scale.desc);
+        if(tresidual)
+        {
+            residual = tensor<T>{input.desc.GetLengths()};
+            for(std::size_t i = 0; i < residual.desc.GetElementSize(); i++)
+            {
+                residual[i] = 1e-2 * (((rand() % 2) == 1) ? -1 : 1) * T(rand() % 100);
+            }
+            miopenCreateOpTensorAddForward(ptr_fusionplan.get(), &addOp, &residual.desc);
+        }
+        else
+        {
+            residual = tensor<T>{1, 1, 1, 1};
+        }
         miopenCreateOpActivationForward(ptr_fusionplan.get(), &activOp, activ_mode);
 
         miopenStatus_t miopenError = miopenCompileFusionPlan(&handle, ptr_fusionplan.get());
         if(miopenError != miopenStatusSuccess)
         {
-            std::cerr << "BatchNorm+Activation Inference plan not supported." << std::endl;
+            std::cerr << (tresidual ? "BatchNorm+Add+Activation" : "BatchNorm+Activation")
+                      << " Inference plan not supported." << std::endl;
         }
         else
         {
@@ -300,7 +344,10 @@ struct na_fusion_driver : test_driver
                                                                   estVariance,
                                                                   bnmode,
                                                                   bNormOp,
-                                                                  activOp});
+                                                                  activOp,
+                                                                  tresidual,
+                                                                  residual,
+                                                                  addOp});
         }
     }
 };
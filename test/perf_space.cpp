@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/generic_search.hpp>
+#include <miopen/perf_space.hpp>
+#include <miopen/solver.hpp>
+#include "test.hpp"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct ToyContext
+{
+    int limit = 0;
+};
+
+struct ToyConfig : miopen::solver::Serializable<ToyConfig>
+{
+    int a         = 0;
+    int b         = 0;
+    int c         = 0;
+    int unvisited = 7;
+
+    ToyConfig() = default;
+    ToyConfig(bool) : a(1), b(1), c(1) {}
+    ToyConfig(int a_, int b_, int c_) : a(a_), b(b_), c(c_) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.a, "a");
+        f(self.b, "b");
+        f(self.c, "c");
+    }
+
+    bool SetNextValue()
+    {
+        if(++a <= 4)
+            return true;
+        a = 1;
+        b *= 2;
+        if(b <= 8)
+            return true;
+        b = 1;
+        return ++c <= 3 || (c = 1, false);
+    }
+
+    bool IsValid(const ToyContext& ctx) const { return a * b <= ctx.limit && (b + c) % 2 == 1; }
+
+    static miopen::solver::PerfSpace<ToyConfig> Space(const ToyContext& ctx, bool)
+    {
+        using miopen::solver::LinearDomain;
+        using miopen::solver::TwoPowerDomain;
+        const auto limit = ctx.limit;
+        miopen::solver::PerfSpace<ToyConfig> space{ToyConfig{true}};
+        space.Domain("a", LinearDomain(1, 4))
+            .Domain("b", TwoPowerDomain(1, 8))
+            .Domain("c", LinearDomain(1, 3))
+            .Constraint({"b", "a"}, [=](const ToyConfig& t) { return t.a * t.b <= limit; })
+            .Constraint({"c", "b"}, [](const ToyConfig& t) { return (t.b + t.c) % 2 == 1; });
+        return space;
+    }
+
+    bool operator==(const ToyConfig& o) const { return a == o.a && b == o.b && c == o.c; }
+};
+
+template <class Config, class Context>
+std::vector<Config> BruteForce(const Context& ctx, bool spare = false)
+{
+    std::vector<Config> configs;
+    Config v(spare);
+    do
+    {
+        if(v.IsValid(ctx))
+            configs.push_back(v);
+    } while(v.SetNextValue());
+    return configs;
+}
+
+template <class Config, class Context>
+std::vector<Config> Enumerate(const Context& ctx, bool spare = false)
+{
+    const miopen::solver::ComputedContainer<Config, Context> container(ctx, spare);
+    return {container.begin(), container.end()};
+}
+
+void check_toy()
+{
+    using miopen::solver::PerfSpace;
+    static_assert(miopen::solver::HasPerfSpace<ToyConfig, ToyContext>{}, "");
+
+    for(auto limit : {0, 1, 3, 8, 100})
+    {
+        const ToyContext ctx{limit};
+        const auto expected = BruteForce<ToyConfig>(ctx);
+        const auto space    = ToyConfig::Space(ctx, false);
+        EXPECT(Enumerate<ToyConfig>(ctx) == expected);
+        EXPECT(space.Size() == expected.size());
+        EXPECT(space.RawSize() == 4 * 4 * 3);
+        EXPECT(miopen::solver::ComputedContainer<ToyConfig, ToyContext>(ctx).empty() ==
+               expected.empty());
+        for(auto&& config : expected)
+        {
+            EXPECT(space.IsSatisfied(config));
+            EXPECT(config.unvisited == 7);
+        }
+    }
+
+    // Fields without a domain keep their first value, constraints naming no field apply to all
+    PerfSpace<ToyConfig> space{ToyConfig{2, 3, 4}};
+    space.Domain("b", {5, 6});
+    EXPECT(space.Size() == 2);
+    PerfSpace<ToyConfig>::Cursor cursor;
+    EXPECT(space.First(cursor));
+    EXPECT(cursor.value == ToyConfig(2, 5, 4));
+    EXPECT(space.Next(cursor));
+    EXPECT(cursor.value == ToyConfig(2, 6, 4));
+    EXPECT(!space.Next(cursor));
+
+    space.Constraint({}, [](const ToyConfig&) { return false; });
+    EXPECT(space.Size() == 0);
+    EXPECT(!space.First(cursor));
+
+    EXPECT(throws([] { PerfSpace<ToyConfig>{ToyConfig{}}.Domain("d", {1}); }));
+}
+
+void check_asm_1x1u()
+{
+    using Config = miopen::solver::PerformanceConfigConvAsm1x1U;
+    static_assert(miopen::solver::HasPerfSpace<Config, miopen::ConvolutionContext>{}, "");
+
+    struct Problem
+    {
+        int c, k, n, hw;
+        miopenDataType_t type;
+        int forward;
+    };
+    for(const auto& p : {Problem{64, 64, 16, 28, miopenFloat, 1},
+                         Problem{3, 96, 1, 7, miopenFloat, 0},
+                         Problem{256, 1000, 4, 1, miopenFloat, 1},
+                         Problem{32, 12, 8, 14, miopenHalf, 0}})
+    {
+        miopen::ConvolutionContext ctx;
+        ctx.n_inputs     = p.c;
+        ctx.n_outputs    = p.k;
+        ctx.batch_sz     = p.n;
+        ctx.in_height    = p.hw;
+        ctx.in_width     = p.hw;
+        ctx.out_height   = p.hw;
+        ctx.out_width    = p.hw;
+        ctx.in_data_type = p.type;
+        ctx.direction.Set(p.forward);
+
+        for(auto spare : {false, true})
+        {
+            // operator== of the config is internal to the solver
+            const auto to_strings = [](const std::vector<Config>& configs) {
+                std::vector<std::string> strings;
+                for(auto&& config : configs)
+                    strings.push_back(config.ToString());
+                return strings;
+            };
+            const auto expected = to_strings(BruteForce<Config>(ctx, spare));
+            EXPECT(to_strings(Enumerate<Config>(ctx, spare)) == expected);
+            EXPECT(Config::Space(ctx, spare).Size() == expected.size());
+        }
+    }
+}
+
+int main()
+{
+    check_toy();
+    check_asm_1x1u();
+}
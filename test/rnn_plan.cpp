@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/rnn.hpp>
+#include "test.hpp"
+
+#include <utility>
+#include <vector>
+
+// Rows that the per-time-step schedule touched for the reverse-direction bias.
+std::vector<std::pair<int, int>> per_step_rows(const std::vector<int>& in_n)
+{
+    std::vector<std::pair<int, int>> rows;
+    int cur_batch = 0;
+    for(std::size_t ti = 0; ti + 1 < in_n.size(); ti++)
+    {
+        rows.emplace_back(cur_batch, cur_batch + in_n[ti + 1]);
+        cur_batch += in_n[ti];
+    }
+    return rows;
+}
+
+void check_buckets(const std::vector<int>& in_n, std::size_t expected)
+{
+    const auto buckets = miopen::RNNBatchBuckets(in_n);
+    EXPECT_EQUAL(buckets.size(), expected);
+
+    int ti  = 0;
+    int row = 0;
+    for(auto&& bucket : buckets)
+    {
+        EXPECT(bucket.first_time == ti);
+        EXPECT(bucket.row == row);
+        for(int i = 0; i < bucket.steps; i++)
+        {
+            EXPECT(in_n[ti] == bucket.batch);
+            row += in_n[ti++];
+        }
+    }
+    EXPECT(ti == static_cast<int>(in_n.size()));
+
+    // At most one range per bucket, covering exactly the rows of the per-step launches.
+    const auto ranges = miopen::RNNReverseBiasRows(in_n);
+    EXPECT(ranges.size() <= buckets.size());
+    std::vector<int> covered(row, 0);
+    for(auto&& range : ranges)
+    {
+        EXPECT(range.rows > 0);
+        for(int r = range.row; r < range.row + range.rows; r++)
+            covered[r]++;
+    }
+    std::vector<int> expected_rows(row, 0);
+    for(auto&& range : per_step_rows(in_n))
+        for(int r = range.first; r < range.second; r++)
+            expected_rows[r]++;
+    EXPECT(covered == expected_rows);
+}
+
+void check_plan_cache()
+{
+    miopen::RNNPlanCache cache;
+    miopen::RNNPlanShape a, b;
+    a.seqLen = 3;
+    a.in_n   = {4, 4, 2};
+    b.seqLen = 3;
+    b.in_n   = {4, 2, 2};
+
+    EXPECT(cache.Find(a) == nullptr);
+    auto plan = std::make_shared<const miopen::RNNPlan>();
+    cache.Add(a, plan);
+    EXPECT(cache.Find(a) == plan);
+    EXPECT(cache.Find(b) == nullptr);
+}
+
+// GEMM calls of a single-layer bidirectional inference plan with hx.
+std::size_t plan_gemms(const std::vector<int>& in_n, bool pack_directions)
+{
+    const int hidden = 8;
+    miopen::RNNDescriptor rnn(hidden,
+                              1,
+                              miopenRNNTANH,
+                              miopenRNNlinear,
+                              miopenRNNbidirection,
+                              miopenRNNNoBias,
+                              miopenRNNdefault,
+                              miopenFloat);
+    miopen::RNNPlanShape shape;
+    shape.seqLen          = in_n.size();
+    shape.in_n            = in_n;
+    shape.in_h            = hidden;
+    shape.hy_d            = 2;
+    shape.hy_n            = in_n.front();
+    shape.hy_h            = hidden;
+    shape.out_h           = 2 * hidden;
+    shape.workSpaceSize   = 1 << 20;
+    shape.has_hx          = true;
+    shape.pack_directions = pack_directions;
+    return rnn.CompileForwardInferencePlan(shape).gemm_submissions;
+}
+
+void check_packed_directions()
+{
+    // Input projection, then two recurrent GEMMs per step.
+    EXPECT_EQUAL(plan_gemms({4, 4, 4, 4}, false), 9);
+    // The two directions share one GEMM while the reverse rows come after the forward rows
+    // and do not overlap them: steps 0 and 1.
+    EXPECT_EQUAL(plan_gemms({4, 4, 4, 4}, true), 7);
+    // Step 1 reads 2 rows in both directions; from step 2 on the reverse rows come first.
+    EXPECT_EQUAL(plan_gemms({4, 2, 2, 2}, false), 10);
+    EXPECT_EQUAL(plan_gemms({4, 2, 2, 2}, true), 9);
+    // With one step both directions write the same rows.
+    EXPECT_EQUAL(plan_gemms({4}, true), 3);
+}
+
+int main()
+{
+    check_buckets({8}, 1);
+    check_buckets({4, 4, 4, 4}, 1);
+    check_buckets({4, 4, 3, 3, 1}, 3);
+    check_buckets({5, 4, 3, 2, 1}, 5);
+    check_buckets({6, 6, 6, 2, 2, 1, 1, 1}, 3);
+    check_plan_cache();
+    check_packed_directions();
+}
@@ -32,6 +32,7 @@
 #include <limits>
 #include <memory>
 #include <miopen/convolution.hpp>
+#include <miopen/float_equal.hpp>
 #include <miopen/miopen.h>
 #include <miopen/softmax.hpp>
 #include <miopen/tensor.hpp>
@@ -42,56 +43,103 @@
 #include "tensor_holder.hpp"
 #include "verify.hpp"
 
+// scale * x + mask, blended into y as alpha * softmax + beta * y; the mask broadcasts over n
 struct verify_forward_sofmax
 {
+    miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate;
+    float alpha                        = 1;
+    float beta                         = 0;
+    float scale                        = 1;
+
     template <class T>
-    tensor<T> cpu(const tensor<T>& input) const
+    tensor<T> cpu(const tensor<T>& input, const tensor<T>& mask, const tensor<T>& prev) const
     {
-        auto out = input;
-        std::fill(out.begin(), out.end(), 0);
+        auto out = prev;
 
         int in_n, in_c, in_h, in_w;
         std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(input.desc.GetLengths());
+        const bool use_mask              = !mask.data.empty();
 
         par_ford(in_n, in_h, in_w)([&](int o, int i, int j) {
-            T max_c = std::numeric_limits<T>::lowest();
-            ford(in_c)([&](int w) { max_c = std::max(max_c, input(o, w, i, j)); });
+            auto z = [&](int w) {
+                const double m = use_mask ? double(mask(0, w, i, j)) : 0;
+                return scale * double(input(o, w, i, j)) + m;
+            };
+            double max_c = std::numeric_limits<double>::lowest();
+            if(algorithm != miopenSoftmaxFast)
+                ford(in_c)([&](int w) { max_c = std::max(max_c, z(w)); });
+            else
+                max_c = 0;
 
             double sum = 0;
-            ford(in_c)([&](int w) { sum += std::exp(input(o, w, i, j) - max_c); });
+            ford(in_c)([&](int w) { sum += std::exp(z(w) - max_c); });
 
-            ford(in_c)([&](int w) { out(o, w, i, j) = std::exp(input(o, w, i, j) - max_c) / sum; });
+            ford(in_c)([&](int w) {
+                const double v = algorithm == miopenSoftmaxLog ? z(w) - max_c - std::log(sum)
+                                                               : std::exp(z(w) - max_c) / sum;
+                out(o, w, i, j) = alpha * v + beta * double(prev(o, w, i, j));
+            });
 
         });
         return out;
     }
 
     template <class T>
-    tensor<T> gpu(const tensor<T>& input) const
+    tensor<T> gpu(const tensor<T>& input, const tensor<T>& mask, const tensor<T>& prev) const
     {
         auto&& handle = get_handle();
-        auto out      = input;
+        auto out      = prev;
 
+        auto in_dev  = handle.Write(input.data);
         auto out_dev = handle.Write(out.data);
 
-        float alpha = 1, beta = 0;
-
-        miopen::SoftmaxForward(handle, &alpha, &beta, input.desc, out_dev.get());
+        if(mask.data.empty() && miopen::float_equal(scale, 1))
+        {
+            miopen::SoftmaxForward(handle,
+                                   &alpha,
+                                   &beta,
+                                   input.desc,
+                                   in_dev.get(),
+                                   out.desc,
+                                   out_dev.get(),
+                                   algorithm);
+        }
+        else
+        {
+            auto mask_dev = handle.Write(mask.data);
+            miopen::ScaledMaskedSoftmaxForward(handle,
+                                               &alpha,
+                                               &beta,
+                                               input.desc,
+                                               in_dev.get(),
+                                               scale,
+                                               mask.desc,
+                                               mask.data.empty() ? nullptr : mask_dev.get(),
+                                               out.desc,
+                                               out_dev.get(),
+                                               algorithm);
+        }
 
         out.data = handle.Read<T>(out_dev, out.data.size());
         return out;
     }
 
     template <class T>
-    void fail(float, const tensor<T>& input) const
+    void fail(float, const tensor<T>& input, const tensor<T>& mask, const tensor<T>&) const
     {
         std::cout << "Forward Sofmax: " << std::endl;
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
+        std::cout << "Algorithm: " << algorithm << ", alpha: " << alpha << ", beta: " << beta
+                  << ", scale: " << scale << std::endl;
+        if(!mask.data.empty())
+            std::cout << "Mask tensor: " << mask.desc.ToString() << std::endl;
     }
 };
 
 struct verify_backward_sofmax
 {
+    miopenSoftmaxAlgorithm_t algorithm = miopenSoftmaxAccurate;
+
     template <class T>
     tensor<T> cpu(const tensor<T>& out, const tensor<T>& dout) const
     {
@@ -102,10 +150,20 @@ struct verify_backward_sofmax
 
         par_ford(in_n, in_h, in_w)([&](int o, int i, int j) {
             double sum = 0;
-            ford(in_c)([&](int c) { sum += out(o, c, i, j) * dout(o, c, i, j); });
-
-            ford(in_c)(
-                [&](int c) { input(o, c, i, j) = out(o, c, i, j) * (input(o, c, i, j) - sum); });
+            if(algorithm == miopenSoftmaxLog)
+            {
+                ford(in_c)([&](int c) { sum += dout(o, c, i, j); });
+                ford(in_c)([&](int c) {
+                    input(o, c, i, j) = dout(o, c, i, j) - std::exp(out(o, c, i, j)) * sum;
+                });
+            }
+            else
+            {
+                ford(in_c)([&](int c) { sum += out(o, c, i, j) * dout(o, c, i, j); });
+                ford(in_c)([&](int c) {
+                    input(o, c, i, j) = out(o, c, i, j) * (dout(o, c, i, j) - sum);
+                });
+            }
         });
         return input;
     }
@@ -116,13 +174,22 @@ struct verify_backward_sofmax
         auto&& handle = get_handle();
         auto input    = dout;
 
-        auto in_dev  = handle.Write(input.data);
-        auto out_dev = handle.Write(out.data);
+        auto in_dev   = handle.Create<T>(input.data.size());
+        auto dout_dev = handle.Write(dout.data);
+        auto out_dev  = handle.Write(out.data);
 
         float alpha = 1, beta = 0;
 
-        miopen::SoftmaxBackward(
-            handle, &alpha, out.desc, out_dev.get(), &beta, input.desc, in_dev.get());
+        miopen::SoftmaxBackward(handle,
+                                &alpha,
+                                out.desc,
+                                out_dev.get(),
+                                dout.desc,
+                                dout_dev.get(),
+                                &beta,
+                                input.desc,
+                                in_dev.get(),
+                                algorithm);
 
         input.data = handle.Read<T>(in_dev, input.data.size());
         return input;
@@ -133,6 +200,7 @@ struct verify_backward_sofmax
     {
         std::cout << "Backward Sofmax: " << std::endl;
         std::cout << "Output tensor: " << output.desc.ToString() << std::endl;
+        std::cout << "Algorithm: " << algorithm << std::endl;
     }
 };
 
@@ -140,25 +208,53 @@ template <class T>
 struct softmax_driver : test_driver
 {
     tensor<T> input;
+    int algorithm = miopenSoftmaxAccurate;
 
     softmax_driver()
     {
         add(input,
             "input",
             get_input_tensor(tensor_elem_gen_integer{miopen_type<T>{} == miopenHalf ? 5 : 17}));
+        add(algorithm,
+            "algorithm",
+            generate_data(
+                {int(miopenSoftmaxFast), int(miopenSoftmaxAccurate), int(miopenSoftmaxLog)}));
     }
 
     void run()
     {
-        auto out  = verify(verify_forward_sofmax{}, input);
+        const auto algo = static_cast<miopenSoftmaxAlgorithm_t>(algorithm);
+        // Integer inputs up to 17 overflow exp() without the max subtraction in half
+        if(algo == miopenSoftmaxFast && miopen_type<T>{} == miopenHalf)
+            return;
+
+        verify_forward_sofmax fwd;
+        fwd.algorithm = algo;
+        auto zeros    = input;
+        std::fill(zeros.begin(), zeros.end(), 0);
+        auto out = verify(fwd, input, tensor<T>{}, zeros);
+
+        int n, c, h, w;
+        std::tie(n, c, h, w) = miopen::tien<4>(input.desc.GetLengths());
+        tensor<T> mask(1, c, h, w);
+        mask.generate([](int, int ci, int hi, int wi) { return ((ci + 2 * hi + 3 * wi) % 4) - 2; });
+        auto prev = input;
+        prev.generate([](int ni, int ci, int hi, int wi) { return ((ni + ci + hi + wi) % 3) - 1; });
+        fwd.alpha = 0.5;
+        fwd.beta  = 0.25;
+        fwd.scale = 0.5;
+        verify(fwd, input, mask, prev);
+
         auto dout = input;
-        dout.generate([&](int n, int c, int h, int w) {
-            T x      = input(n, c, h, w);
-            double y = (877 * n + 547 * c + 701 * h + 1049 * w + static_cast<int>(769 * x)) % 2503;
+        dout.generate([&](int n_, int c_, int h_, int w_) {
+            T x      = input(n_, c_, h_, w_);
+            double y =
+                (877 * n_ + 547 * c_ + 701 * h_ + 1049 * w_ + static_cast<int>(769 * x)) % 2503;
             return ((x * y) / 1301.0);
         });
-        verify(verify_backward_sofmax{}, out.first, dout);
+        verify_backward_sofmax bwd;
+        bwd.algorithm = algo;
+        verify(bwd, out.first, dout);
     }
 };
-
 int main(int argc, const char* argv[]) { test_drive<softmax_driver>(argc, argv); }
@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_cache.hpp>
+#include <miopen/conv_cost_model.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+#include "test.hpp"
+
+#include <memory>
+#include <string>
+
+void check_cache()
+{
+    miopen::SolverCache<std::string> cache;
+    EXPECT(!cache.Find("a"));
+    cache.Insert("a", "x");
+    cache.Insert("b", "y");
+    EXPECT(cache.Find("a") == std::string("x"));
+    EXPECT(cache.Find("b") == std::string("y"));
+    cache.Insert("a", "z");
+    EXPECT(cache.Find("a") == std::string("z"));
+    cache.Clear();
+    EXPECT(!cache.Find("a"));
+}
+
+miopen::ConvolutionContext make_context(miopen::Handle& handle)
+{
+    miopen::ConvolutionContext context;
+    context.SetStream(&handle);
+    context.direction.Set(1);
+    context.n_inputs      = 16;
+    context.n_outputs     = 32;
+    context.in_height     = 28;
+    context.in_width      = 28;
+    context.kernel_size_h = 3;
+    context.kernel_size_w = 3;
+    context.in_layout     = "NCHW";
+    context.out_layout    = "NCHW";
+    context.group_counts  = 1;
+    return context;
+}
+
+void check_key()
+{
+    miopen::Handle handle;
+    const auto context = make_context(handle);
+    const auto key     = miopen::GetSolverCacheKey(context);
+
+    auto same = context;
+    EXPECT(miopen::GetSolverCacheKey(same) == key);
+
+    // Parts of the problem the perf-db key does not cover
+    auto strided       = context;
+    strided.out_stride = 64;
+    EXPECT(miopen::GetSolverCacheKey(strided) != key);
+
+    auto asm_kernels            = context;
+    asm_kernels.use_asm_kernels = true;
+    EXPECT(miopen::GetSolverCacheKey(asm_kernels) != key);
+
+    auto backward = context;
+    backward.direction.Set(0);
+    EXPECT(miopen::GetSolverCacheKey(backward) != key);
+}
+
+// Counts the applicability checks, which only a search that misses the cache runs
+static int applicability_checks = 0;
+
+template <int N>
+struct CountedSolver : miopen::solver::SolverBase<miopen::ConvolutionContext>
+{
+    bool IsApplicable(const miopen::ConvolutionContext&) const
+    {
+        ++applicability_checks;
+        return true;
+    }
+
+    miopen::solver::ConvSolution GetSolution(const miopen::ConvolutionContext&) const
+    {
+        miopen::solver::ConvSolution solution;
+        solution.construction_params.push_back({});
+        return solution;
+    }
+};
+
+struct PreferSecondModel : miopen::ConvCostModel
+{
+    float Estimate(const miopen::ConvCostFeatures&, const std::string& solver_id) const override
+    {
+        return solver_id == miopen::solver::SolverDbId(CountedSolver<1>{}) ? 1.0f : 2.0f;
+    }
+};
+
+struct PreferFirstModel : miopen::ConvCostModel
+{
+    float Estimate(const miopen::ConvCostFeatures&, const std::string& solver_id) const override
+    {
+        return solver_id == miopen::solver::SolverDbId(CountedSolver<0>{}) ? 1.0f : 2.0f;
+    }
+};
+
+std::vector<std::string> search(const miopen::ConvolutionContext& context)
+{
+    std::vector<std::string> ids;
+    for(const auto& solution :
+        miopen::solver::SearchForAllSolutions<CountedSolver<0>, CountedSolver<1>>(context, 0))
+        ids.push_back(solution.solver_id);
+    return ids;
+}
+
+void check_search_hits()
+{
+    miopen::Handle handle;
+    const auto context = make_context(handle);
+    const miopen::FindEnforce enforce;
+    if(!miopen::IsSolverCacheEnabled() || enforce.IsDbClean(context) || enforce.IsSearch(context))
+        return;
+
+    const auto previous_model = miopen::GetConvCostModel();
+    miopen::SetConvCostModel(std::make_shared<PreferFirstModel>());
+
+    const auto first   = miopen::solver::SolverDbId(CountedSolver<0>{});
+    const auto second  = miopen::solver::SolverDbId(CountedSolver<1>{});
+
+    applicability_checks = 0;
+    EXPECT(search(context) == std::vector<std::string>({first, second}));
+    EXPECT(applicability_checks == 2);
+
+    // Same problem: served from the cache
+    EXPECT(search(context) == std::vector<std::string>({first, second}));
+    EXPECT(applicability_checks == 2);
+
+    // A different setting of MIOPEN_DEBUG_GCN_ASM_KERNELS is a different entry
+    auto asm_kernels            = context;
+    asm_kernels.use_asm_kernels = !context.use_asm_kernels;
+    search(asm_kernels);
+    EXPECT(applicability_checks == 4);
+    search(asm_kernels);
+    EXPECT(applicability_checks == 4);
+
+    // A new model drops the ranking the previous one made
+    miopen::SetConvCostModel(std::make_shared<PreferSecondModel>());
+    EXPECT(search(context) == std::vector<std::string>({second, first}));
+    EXPECT(applicability_checks == 6);
+    EXPECT(search(context) == std::vector<std::string>({second, first}));
+    EXPECT(applicability_checks == 6);
+
+    miopen::SetConvCostModel(previous_model);
+}
+
+int main()
+{
+    check_cache();
+    check_key();
+    check_search_hits();
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tensor.hpp>
+#include "test.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+void check_cached_properties()
+{
+    const miopen::TensorDescriptor packed{miopenFloat, {2, 3, 4, 5}};
+    EXPECT_EQUAL(packed.GetElementSize(), 120);
+    EXPECT_EQUAL(packed.GetElementSpace(), 120);
+    EXPECT(packed.IsPacked());
+    EXPECT(packed.GetStrides() == std::vector<std::size_t>({60, 20, 5, 1}));
+
+    const miopen::TensorDescriptor padded{miopenFloat, {2, 3, 4, 5}, {200, 60, 15, 1}};
+    EXPECT_EQUAL(padded.GetElementSize(), 120);
+    EXPECT_EQUAL(padded.GetElementSpace(), 370);
+    EXPECT(!padded.IsPacked());
+
+    const miopen::TensorDescriptor empty;
+    EXPECT_EQUAL(empty.GetElementSize(), 1);
+    EXPECT_EQUAL(empty.GetElementSpace(), 1);
+
+    // A copy must carry the cached values along with the storage
+    auto copy = padded;
+    EXPECT(copy == padded);
+    EXPECT_EQUAL(copy.GetElementSpace(), 370);
+    EXPECT(!copy.IsPacked());
+}
+
+void check_storage()
+{
+    const miopen::TensorDescriptor d{miopenHalf, std::vector<std::size_t>{1, 2, 3, 4, 5, 6}};
+    EXPECT_EQUAL(d.GetSize(), miopen::max_tensor_dims);
+    EXPECT_EQUAL(d.GetElementSize(), 720);
+
+    bool thrown = false;
+    try
+    {
+        miopen::TensorDescriptor{miopenHalf, std::vector<std::size_t>{1, 2, 3, 4, 5, 6, 7}};
+    }
+    catch(const miopen::Exception& e)
+    {
+        thrown = e.status == miopenStatusBadParm;
+    }
+    EXPECT(thrown);
+
+    std::vector<std::size_t> lens = d.GetLengths();
+    EXPECT(lens == d.GetLengths());
+    lens.back() = 7;
+    EXPECT(lens != d.GetLengths());
+}
+
+void check_compare_and_hash()
+{
+    const miopen::TensorDescriptor a{miopenFloat, {2, 3, 4, 5}};
+    const miopen::TensorDescriptor b{miopenFloat, {2, 3, 4, 5}};
+    const miopen::TensorDescriptor c{miopenFloat, {2, 3, 5, 4}};
+    const miopen::TensorDescriptor h{miopenHalf, {2, 3, 4, 5}};
+    const std::hash<miopen::TensorDescriptor> hash{};
+
+    EXPECT(a == b);
+    EXPECT(a != c);
+    EXPECT(a != h);
+    EXPECT(a < c);
+    EXPECT(c > a);
+    EXPECT_EQUAL(hash(a), hash(b));
+    EXPECT(hash(a) != hash(c));
+    EXPECT(hash(a) != hash(h));
+}
+
+int main()
+{
+    check_cached_properties();
+    check_storage();
+    check_compare_and_hash();
+}
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "test.hpp"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_expr.hpp>
+#include "driver.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "verify.hpp"
+
+// y = 0.25 * y + x * (0.5 * max(x + bias, 0)), with bias broadcast over everything but channels.
+// The reference runs the four steps one after the other over whole tensors.
+template <class T>
+miopen::TensorExpression make_bias_relu_expression(const tensor<T>& x,
+                                                   const tensor<T>& bias,
+                                                   const tensor<T>& y,
+                                                   const tensor<T>& tmp)
+{
+    miopen::TensorExpression expr;
+    const int ix   = expr.AddTensor(x.desc);
+    const int ib   = expr.AddTensor(bias.desc);
+    const int iy   = expr.AddTensor(y.desc);
+    const int itmp = expr.AddTensor(tmp.desc);
+    expr.AddOp(miopenTensorOpAdd, 1, ix, 1, ib, 0, itmp);
+    expr.AddOp(miopenTensorOpMax, 1, itmp, 0, ib, 0, itmp);
+    expr.AddScale(itmp, 0.5);
+    expr.AddOp(miopenTensorOpMul, 1, itmp, 1, ix, 0.25, iy);
+    return expr;
+}
+
+template <class T>
+struct verify_tensor_expr
+{
+    tensor<T> x;
+    tensor<T> bias;
+    tensor<T> y;
+
+    verify_tensor_expr(const tensor<T>& px, const tensor<T>& pbias, const tensor<T>& py)
+        : x(px), bias(pbias), y(py)
+    {
+    }
+
+    tensor<T> cpu() const
+    {
+        auto tmp = tensor<T>{x.desc.GetLengths()};
+        auto yr  = y;
+        tmp.par_for_each([&](int n, int c, int h, int w) {
+            tmp(n, c, h, w) = T(double(x(n, c, h, w)) + double(bias(0, c, 0, 0)));
+        });
+        tmp.par_for_each(
+            [&](int n, int c, int h, int w) { tmp(n, c, h, w) = std::max(tmp(n, c, h, w), T(0)); });
+        tmp.par_for_each([&](int n, int c, int h, int w) {
+            tmp(n, c, h, w) = T(0.5 * double(tmp(n, c, h, w)));
+        });
+        yr.par_for_each([&](int n, int c, int h, int w) {
+            yr(n, c, h, w) =
+                T(double(tmp(n, c, h, w)) * double(x(n, c, h, w)) + 0.25 * double(yr(n, c, h, w)));
+        });
+        return yr;
+    }
+
+    tensor<T> gpu() const
+    {
+        auto&& handle = get_handle();
+        auto yr       = y;
+        auto tmp      = tensor<T>{x.desc.GetLengths()};
+        auto x_dev    = handle.Write(x.data);
+        auto b_dev    = handle.Write(bias.data);
+        auto y_dev    = handle.Write(yr.data);
+        auto tmp_dev  = handle.Write(tmp.data);
+
+        make_bias_relu_expression(x, bias, yr, tmp)
+            .Run(handle, {x_dev.get(), b_dev.get(), y_dev.get(), tmp_dev.get()});
+
+        yr.data = handle.Read<T>(y_dev, yr.data.size());
+        return yr;
+    }
+
+    void fail(float = 0)
+    {
+        std::cout << "Tensor expression: " << std::endl;
+        std::cout << "x: " << x.desc.ToString() << std::endl;
+        std::cout << "bias: " << bias.desc.ToString() << std::endl;
+    }
+};
+
+template <class T>
+struct tensor_expr_driver : test_driver
+{
+    std::vector<int> lens;
+
+    tensor_expr_driver()
+    {
+        std::vector<std::vector<int>> shapes = {{2, 3, 4, 5}, {16, 32, 8, 8}, {1, 7, 1, 13}};
+        add(lens, "lens", generate_data(shapes, shapes[1]));
+    }
+
+    void run()
+    {
+        auto x    = tensor<T>{lens}.generate(tensor_elem_gen_integer{17});
+        auto bias = tensor<T>{std::vector<int>{1, lens[1], 1, 1}}.generate(
+            [](auto, auto c, auto, auto) { return double(c % 5) - 2; });
+        auto y = tensor<T>{lens}.generate(tensor_elem_gen_integer{7});
+
+        // The host evaluator is the reference for the fused kernel, so check it against the
+        // unfused steps first
+        verify_tensor_expr<T> v{x, bias, y};
+        auto host = y;
+        auto tmp  = tensor<T>{x.desc.GetLengths()};
+        make_bias_relu_expression(x, bias, host, tmp)
+            .Evaluate({x.data.data(), bias.data.data(), host.data.data(), tmp.data.data()});
+        auto ref = v.cpu();
+        EXPECT(miopen::range_distance(ref) == miopen::range_distance(host));
+        EXPECT(miopen::rms_range(ref, host) < 1e-3);
+
+        verify_equals(v);
+    }
+};
+
+static void check_expression_shape()
+{
+    using miopen::TensorDescriptor;
+
+    miopen::TensorExpression expr;
+    const int x = expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16, 7, 7}));
+    const int b = expr.AddTensor(TensorDescriptor(miopenFloat, {1, 16, 1, 1}));
+    expr.AddOp(miopenTensorOpAdd, 1, x, 1, b, 0, x);
+
+    // H and W merge, N and C cannot since the bias steps through C only
+    auto shape = expr.GetFlattenedShape();
+    EXPECT(shape.lens == std::vector<std::size_t>({8, 16, 49}));
+    EXPECT(shape.strides[x] == std::vector<std::size_t>({784, 49, 1}));
+    EXPECT(shape.strides[b] == std::vector<std::size_t>({0, 1, 0}));
+    EXPECT(expr.IsLoaded(x) && expr.IsStored(x));
+    EXPECT(expr.IsLoaded(b) && !expr.IsStored(b));
+
+    // The compiled kernel does not depend on lengths or scaling factors
+    miopen::TensorExpression other;
+    const int ox = other.AddTensor(TensorDescriptor(miopenFloat, {2, 3, 5}));
+    const int ob = other.AddTensor(TensorDescriptor(miopenFloat, {2, 3, 5}));
+    other.AddOp(miopenTensorOpAdd, 2, ox, 3, ob, 1, ox);
+    EXPECT_EQUAL(expr.GetNetworkConfig(), other.GetNetworkConfig());
+    EXPECT(other.GetFlattenedShape().lens == std::vector<std::size_t>({30}));
+
+    // A Set step does not need the previous value
+    miopen::TensorExpression set;
+    const int s = set.AddTensor(TensorDescriptor(miopenHalf, {4, 4}));
+    set.AddSet(s, 1);
+    set.AddScale(s, 2);
+    EXPECT(!set.IsLoaded(s) && set.IsStored(s));
+    EXPECT(set.GetNetworkConfig() != expr.GetNetworkConfig());
+}
+
+static void check_expression_errors()
+{
+    using miopen::TensorDescriptor;
+
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        const int x = expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16}));
+        const int b = expr.AddTensor(TensorDescriptor(miopenFloat, {1, 16}));
+        expr.AddScale(b, 2);
+        expr.GetFlattenedShape();
+        (void)x;
+    }));
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16}));
+        expr.AddTensor(TensorDescriptor(miopenFloat, {8, 15}));
+    }));
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16}));
+        expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16, 1}));
+    }));
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        expr.AddTensor(TensorDescriptor(miopenInt8x4, {8, 16}));
+    }));
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        const int x = expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16}));
+        expr.AddCast(1, x, x + 1);
+    }));
+    EXPECT(throws([] {
+        miopen::TensorExpression expr;
+        for(std::size_t i = 0; i <= miopen::TensorExpression::max_tensors; ++i)
+            expr.AddTensor(TensorDescriptor(miopenFloat, {8, 16}));
+    }));
+}
+
+int main(int argc, const char* argv[])
+{
+    check_expression_shape();
+    check_expression_errors();
+    test_drive<tensor_expr_driver>(argc, argv);
+}
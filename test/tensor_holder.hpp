@@ -28,6 +28,7 @@
 
 #include "ford.hpp"
 #include "network_data.hpp"
+#include "serialize.hpp"
 #include <miopen/tensor.hpp>
 #include <miopen/functional.hpp>
 #include <miopen/type_name.hpp>
@@ -119,6 +120,11 @@ struct tensor
         assert(dims.size() == strides.size());
     }
 
+    tensor(const miopen::TensorLengths& dims)
+        : desc(miopen_type<T>{}, dims), data(desc.GetElementSize())
+    {
+    }
+
     tensor(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
         : desc(miopen_type<T>{}, {n, c, h, w}), data(n * c * h * w)
     {
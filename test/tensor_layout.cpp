@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+#include "test.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+struct layout_tensor
+{
+    miopenTensorDescriptor_t tensor{};
+
+    layout_tensor() { miopenCreateTensorDescriptor(&tensor); }
+    ~layout_tensor() { miopenDestroyTensorDescriptor(tensor); }
+
+    miopenStatus_t Set(miopenTensorLayout_t layout, std::vector<int> lens)
+    {
+        return miopenSetNdTensorDescriptorWithLayout(
+            tensor, miopenFloat, layout, lens.data(), static_cast<int>(lens.size()));
+    }
+
+    const miopen::TensorDescriptor& Get() const { return miopen::deref(tensor); }
+};
+
+// Lengths and strides as reported by miopenGetTensorDescriptor
+template <std::size_t N>
+std::pair<std::array<int, N>, std::array<int, N>> GetLengthsAndStrides(const layout_tensor& t)
+{
+    int size = 0;
+    miopenGetTensorDescriptorSize(t.tensor, &size);
+    EXPECT_EQUAL(size, static_cast<int>(N));
+    std::array<int, N> lens{};
+    std::array<int, N> strides{};
+    miopenDataType_t type;
+    miopenGetTensorDescriptor(t.tensor, &type, lens.data(), strides.data());
+    EXPECT(type == miopenFloat);
+    return {lens, strides};
+}
+
+void check_nhwc()
+{
+    layout_tensor t;
+    EXPECT(t.Set(miopenTensorNHWC, {2, 3, 4, 5}) == miopenStatusSuccess);
+
+    const auto ls = GetLengthsAndStrides<4>(t);
+    EXPECT(ls.first == (std::array<int, 4>{{2, 3, 4, 5}}));
+    EXPECT(ls.second == (std::array<int, 4>{{60, 1, 15, 3}}));
+
+    EXPECT(t.Get().IsPacked());
+    EXPECT_EQUAL(t.Get().GetElementSpace(), 120);
+    EXPECT_EQUAL(t.Get().GetLayout("NCHW"), "NHWC");
+    EXPECT(!t.Get().IsDefaultLayout());
+
+    // Setting the same lengths and strides explicitly describes the same tensor
+    layout_tensor strided;
+    std::array<int, 4> lens    = ls.first;
+    std::array<int, 4> strides = ls.second;
+    miopenSetTensorDescriptor(strided.tensor, miopenFloat, 4, lens.data(), strides.data());
+    EXPECT(strided.Get() == t.Get());
+    EXPECT_EQUAL(strided.Get().GetLayout("NCHW"), "NHWC");
+}
+
+void check_nchw()
+{
+    layout_tensor t;
+    EXPECT(t.Set(miopenTensorNCHW, {2, 3, 4, 5}) == miopenStatusSuccess);
+
+    const auto ls = GetLengthsAndStrides<4>(t);
+    EXPECT(ls.first == (std::array<int, 4>{{2, 3, 4, 5}}));
+    EXPECT(ls.second == (std::array<int, 4>{{60, 20, 5, 1}}));
+
+    EXPECT(t.Get() == miopen::TensorDescriptor(miopenFloat, {2, 3, 4, 5}));
+    EXPECT_EQUAL(t.Get().GetLayout("NCHW"), "NCHW");
+    EXPECT(t.Get().IsDefaultLayout());
+}
+
+void check_ndhwc()
+{
+    layout_tensor t;
+    EXPECT(t.Set(miopenTensorNDHWC, {2, 3, 4, 5, 6}) == miopenStatusSuccess);
+
+    const auto ls = GetLengthsAndStrides<5>(t);
+    EXPECT(ls.first == (std::array<int, 5>{{2, 3, 4, 5, 6}}));
+    EXPECT(ls.second == (std::array<int, 5>{{360, 1, 90, 18, 3}}));
+
+    EXPECT(t.Get().IsPacked());
+    EXPECT_EQUAL(t.Get().GetLayout("NCDHW"), "NDHWC");
+    EXPECT(!t.Get().IsDefaultLayout());
+
+    layout_tensor ncdhw;
+    EXPECT(ncdhw.Set(miopenTensorNCDHW, {2, 3, 4, 5, 6}) == miopenStatusSuccess);
+    EXPECT_EQUAL(ncdhw.Get().GetLayout("NCDHW"), "NCDHW");
+    EXPECT(ncdhw.Get().IsDefaultLayout());
+}
+
+void check_irregular()
+{
+    // Strides that fit neither layout report the labels unchanged
+    const miopen::TensorDescriptor irregular{miopenFloat, {2, 3, 4, 5}, {60, 1, 5, 15}};
+    EXPECT_EQUAL(irregular.GetLayout("NCHW"), "NCHW");
+    EXPECT(irregular.IsDefaultLayout());
+
+    // Only 4-D and 5-D tensors have a channels-last layout
+    const miopen::TensorDescriptor three_d{miopenFloat, {2, 3, 4}};
+    EXPECT_EQUAL(three_d.GetLayout("NCW"), "NCW");
+    EXPECT(three_d.IsDefaultLayout());
+}
+
+void check_errors()
+{
+    layout_tensor t;
+    EXPECT(t.Set(miopenTensorNHWC, {2, 3, 4}) == miopenStatusBadParm);
+    EXPECT(t.Set(miopenTensorNDHWC, {2, 3, 4, 5}) == miopenStatusBadParm);
+    EXPECT(t.Set(miopenTensorNHWC, {2, 0, 4, 5}) == miopenStatusBadParm);
+    EXPECT(t.Set(miopenTensorNHWC, {2, -3, 4, 5}) == miopenStatusBadParm);
+    EXPECT(miopenSetNdTensorDescriptorWithLayout(
+               t.tensor, miopenFloat, miopenTensorNHWC, nullptr, 4) == miopenStatusBadParm);
+
+    bool thrown = false;
+    try
+    {
+        miopen::TensorDescriptor{miopenFloat, {2, 3, 4, 5}}.GetLayout("NCH");
+    }
+    catch(const miopen::Exception& e)
+    {
+        thrown = e.status == miopenStatusBadParm;
+    }
+    EXPECT(thrown);
+}
+
+int main()
+{
+    check_nhwc();
+    check_nchw();
+    check_ndhwc();
+    check_irregular();
+    check_errors();
+}
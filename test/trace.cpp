@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include "test.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+void traced_work(int n)
+{
+    for(int i = 0; i < n; i++)
+    {
+        MIOPEN_TRACE_SCOPE("test", "outer");
+        MIOPEN_TRACE_SCOPE("test", [&] { return "inner " + std::to_string(i % 2); });
+    }
+}
+
+void check_histograms()
+{
+    const auto histograms = miopen::trace::GetHistograms();
+
+    EXPECT(histograms.count("test/outer") == 1);
+    EXPECT_EQUAL(histograms.at("test/outer").count, 30);
+    EXPECT_EQUAL(histograms.at("test/inner 0").count, 15);
+    EXPECT_EQUAL(histograms.at("test/inner 1").count, 15);
+
+    const auto& outer = histograms.at("test/outer");
+    EXPECT(outer.min <= outer.max);
+    EXPECT(outer.Percentile(0.5) <= outer.Percentile(0.99));
+    EXPECT(outer.Percentile(0.99) <= outer.max);
+}
+
+void check_chrome_trace()
+{
+    std::ostringstream ss;
+    miopen::trace::WriteChromeTrace(ss);
+    const auto json = ss.str();
+
+    EXPECT(json.find("{\"traceEvents\":[") == 0);
+    EXPECT(json.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+    EXPECT(json.find("\"name\":\"inner 1\"") != std::string::npos);
+}
+
+void check_ring_wrap()
+{
+    // A thread that records more events than its ring holds keeps the latest ones
+    const std::size_t ring_size = 1 << 16;
+    std::thread([&] {
+        for(std::size_t i = 0; i < ring_size + 100; i++)
+            MIOPEN_TRACE_SCOPE("test", "wrap");
+    }).join();
+
+    std::ostringstream ss;
+    miopen::trace::WriteChromeTrace(ss);
+    const auto json          = ss.str();
+    const std::string needle = "\"name\":\"wrap\"";
+    std::size_t events       = 0;
+    for(auto pos = json.find(needle); pos != std::string::npos; pos = json.find(needle, pos + 1))
+        events++;
+
+    EXPECT_EQUAL(events, ring_size);
+    EXPECT_EQUAL(miopen::trace::GetHistograms().at("test/wrap").count, ring_size + 100);
+}
+
+void check_histogram_buckets()
+{
+    miopen::trace::Histogram h;
+    for(std::uint64_t d : {1, 3, 5, 100, 1000})
+        h.Add(d);
+
+    EXPECT_EQUAL(h.count, 5);
+    EXPECT_EQUAL(h.min, 1);
+    EXPECT_EQUAL(h.max, 1000);
+    EXPECT_EQUAL(h.buckets[0], 1);
+    EXPECT_EQUAL(h.buckets[1], 1);
+    EXPECT_EQUAL(h.buckets[2], 1);
+    EXPECT_EQUAL(h.buckets[6], 1);
+    EXPECT_EQUAL(h.buckets[9], 1);
+    EXPECT_EQUAL(h.Percentile(0.5), 7);
+    EXPECT_EQUAL(h.Percentile(1.0), 1000);
+}
+
+int main()
+{
+    // Must happen before the first trace scope: the setting is cached.
+    setenv("MIOPEN_ENABLE_TRACE", "1", 1);
+    setenv("MIOPEN_TRACE_FILE", "/dev/null", 1);
+
+    EXPECT(miopen::trace::IsTracing());
+
+    std::thread t1(traced_work, 10);
+    std::thread t2(traced_work, 10);
+    traced_work(10);
+    t1.join();
+    t2.join();
+
+    check_histograms();
+    check_chrome_trace();
+    check_ring_wrap();
+    check_histogram_buckets();
+}
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/tuning_session.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <vector>
+
+void check_range()
+{
+    std::vector<float> data(300000);
+    miopen::FillRandomly(data.data(), data.size(), 1);
+    EXPECT(std::all_of(data.begin(), data.end(), [](float x) { return x >= 0 && x < 1; }));
+
+    // Not constant, and roughly centered
+    double sum = 0;
+    for(auto x : data)
+        sum += x;
+    EXPECT(std::abs(sum / data.size() - 0.5) < 0.01);
+    EXPECT(std::adjacent_find(data.begin(), data.end()) == data.end());
+
+    std::vector<float> weights(1000);
+    miopen::FillRandomly(weights.data(), weights.size(), 1, -0.5f, 0.001f);
+    EXPECT(std::all_of(weights.begin(), weights.end(), [](float x) {
+        return x >= -0.0005f && x < 0.0005f;
+    }));
+}
+
+void check_deterministic()
+{
+    // The values depend on the seed only, not on how the chunks are spread over threads
+    std::vector<float> a(200000);
+    std::vector<float> b(200000);
+    std::vector<float> c(200000);
+    miopen::FillRandomly(a.data(), a.size(), 7);
+    miopen::FillRandomly(b.data(), b.size(), 7);
+    miopen::FillRandomly(c.data(), c.size(), 8);
+    EXPECT(a == b);
+    EXPECT(a != c);
+
+    // A shorter buffer is a prefix of a longer one
+    std::vector<float> prefix(100000);
+    miopen::FillRandomly(prefix.data(), prefix.size(), 7);
+    EXPECT(std::equal(prefix.begin(), prefix.end(), a.begin()));
+}
+
+void check_chunks()
+{
+    // Every element is covered exactly once
+    std::vector<int> hits(1000001);
+    miopen::ParallelFill(hits.size(), 0, [&](std::size_t begin, std::size_t end, std::uint64_t) {
+        for(auto i = begin; i < end; ++i)
+            ++hits[i];
+    });
+    EXPECT(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+
+    miopen::ParallelFill(0, 0, [](std::size_t, std::size_t, std::uint64_t) { EXPECT(false); });
+}
+
+void check_session()
+{
+    using Contents = miopen::TuningSession::Contents;
+    using Operand  = miopen::TuningSession::Operand;
+
+    const miopen::TuningSession::Scope outer;
+    auto& session = outer.Get();
+    {
+        // Nested scopes share the session
+        const miopen::TuningSession::Scope inner;
+        EXPECT(&inner.Get() == &session);
+    }
+    EXPECT(&outer.Get() == &session);
+
+    auto& h = session.GetHandle();
+    EXPECT(&session.GetHandle() == &h);
+    EXPECT(session.GetStats().searches == 2);
+
+    const auto bot = session.GetBuffer<float>(Operand::Bot, 1000, Contents::Uniform);
+    EXPECT(session.GetBuffer<float>(Operand::Bot, 500, Contents::Uniform) == bot);
+    EXPECT(session.GetStats().reused == 1);
+
+    // Used as an output, the buffer has to be refilled before it is an input again
+    EXPECT(session.GetBuffer<float>(Operand::Bot, 1000, Contents::Output) == bot);
+    EXPECT(session.GetStats().reused == 2);
+    const auto bytes = session.GetStats().setup_bytes;
+    session.GetBuffer<float>(Operand::Bot, 1000, Contents::Uniform);
+    EXPECT(session.GetStats().reused == 2);
+    EXPECT(session.GetStats().setup_bytes == bytes + 1000 * sizeof(float));
+
+    // Operands do not share buffers
+    EXPECT(session.GetBuffer<float>(Operand::Top, 1000, Contents::Uniform) != bot);
+    EXPECT(session.GetStats().reused == 2);
+}
+
+int main()
+{
+    check_range();
+    check_deterministic();
+    check_chunks();
+    check_session();
+}
@@ -0,0 +1,461 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_TEST_VERIFY_CACHE_HPP
+#define MIOPEN_GUARD_TEST_VERIFY_CACHE_HPP
+
+#include "serialize.hpp"
+
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+// On-disk format of a verification cache entry:
+//
+//   header (64 bytes) | payload (starts at a 64-byte boundary)
+//
+// The payload is the serialize.hpp image of the cpu() result. Entries are read through mmap and
+// deserialized straight out of the mapping, so large tensors are copied exactly once. Payloads
+// above a size threshold are stored byte-shuffled and LZ compressed when that makes them smaller.
+namespace verify_cache {
+
+constexpr std::uint32_t format_version      = 1;
+constexpr std::uint32_t flag_compressed     = 1u << 0;
+constexpr std::size_t payload_alignment     = 64;
+constexpr std::size_t shuffle_stride        = sizeof(std::uint32_t);
+constexpr const char magic[8]               = {'M', 'I', 'O', 'V', 'C', 'A', 'C', 'H'};
+
+struct header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t raw_size;
+    std::uint64_t stored_size;
+    std::uint64_t checksum;
+    std::uint64_t reserved[3];
+};
+static_assert(sizeof(header) == payload_alignment, "Cache header must fill one alignment unit");
+
+// FNV-1a over 64-bit words, with the tail folded in byte by byte
+inline std::uint64_t checksum(const char* p, std::size_t n)
+{
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    std::size_t i   = 0;
+    for(; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p + i, sizeof(w));
+        h = (h ^ w) * 0x100000001b3ull;
+    }
+    for(; i < n; i++)
+        h = (h ^ static_cast<unsigned char>(p[i])) * 0x100000001b3ull;
+    return h;
+}
+
+// Split every 32-bit word into four byte planes; the sign/exponent bytes of float results and the
+// zero low mantissa bytes of integer-valued data then form long runs that compress well. Words are
+// moved whole rather than byte by byte so the loops stay cheap next to the codec.
+inline void shuffle(const char* in, char* out, std::size_t n)
+{
+    const std::size_t words = n / shuffle_stride;
+    char* plane0            = out;
+    char* plane1            = plane0 + words;
+    char* plane2            = plane1 + words;
+    char* plane3            = plane2 + words;
+    for(std::size_t i = 0; i < words; i++)
+    {
+        std::uint32_t w;
+        std::memcpy(&w, in + i * shuffle_stride, sizeof(w));
+        plane0[i] = static_cast<char>(w);
+        plane1[i] = static_cast<char>(w >> 8);
+        plane2[i] = static_cast<char>(w >> 16);
+        plane3[i] = static_cast<char>(w >> 24);
+    }
+    std::copy(in + words * shuffle_stride, in + n, out + words * shuffle_stride);
+}
+
+inline void unshuffle(const char* in, char* out, std::size_t n)
+{
+    const std::size_t words = n / shuffle_stride;
+    const auto* plane0      = reinterpret_cast<const unsigned char*>(in);
+    const auto* plane1      = plane0 + words;
+    const auto* plane2      = plane1 + words;
+    const auto* plane3      = plane2 + words;
+    for(std::size_t i = 0; i < words; i++)
+    {
+        const std::uint32_t w = plane0[i] | (std::uint32_t{plane1[i]} << 8) |
+                                (std::uint32_t{plane2[i]} << 16) |
+                                (std::uint32_t{plane3[i]} << 24);
+        std::memcpy(out + i * shuffle_stride, &w, sizeof(w));
+    }
+    std::copy(in + words * shuffle_stride, in + n, out + words * shuffle_stride);
+}
+
+// A small LZ77 codec in the spirit of LZ4: each sequence is a token byte holding the literal and
+// match lengths (extended with 255-continuation bytes), the literals, then a 16-bit match offset.
+// The last sequence carries only literals.
+namespace lz {
+
+constexpr std::size_t min_match  = 4;
+constexpr std::size_t hash_bits  = 16;
+constexpr std::size_t max_offset = 65535;
+
+inline std::uint32_t read32(const char* p)
+{
+    std::uint32_t x;
+    std::memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+inline std::size_t hash(std::uint32_t x) { return (x * 2654435761u) >> (32 - hash_bits); }
+
+inline void put_length(std::vector<char>& out, std::size_t n)
+{
+    for(; n >= 255; n -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(n));
+}
+
+inline void put_sequence(std::vector<char>& out,
+                         const char* lit,
+                         std::size_t lit_len,
+                         std::size_t match_len,
+                         std::size_t offset)
+{
+    const std::size_t ml = match_len == 0 ? 0 : match_len - min_match;
+    out.push_back(static_cast<char>((std::min<std::size_t>(lit_len, 15) << 4) |
+                                    std::min<std::size_t>(ml, 15)));
+    if(lit_len >= 15)
+        put_length(out, lit_len - 15);
+    out.insert(out.end(), lit, lit + lit_len);
+    if(match_len == 0)
+        return;
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(ml >= 15)
+        put_length(out, ml - 15);
+}
+
+inline std::vector<char> compress(const char* in, std::size_t n)
+{
+    std::vector<char> out;
+    out.reserve(n / 2);
+    std::vector<std::size_t> table(std::size_t{1} << hash_bits, std::size_t(-1));
+    std::size_t anchor = 0;
+    std::size_t i      = 0;
+    while(i + min_match <= n)
+    {
+        const auto h         = hash(read32(in + i));
+        const std::size_t c  = table[h];
+        table[h]             = i;
+        const bool candidate = c != std::size_t(-1) and i - c <= max_offset and
+                               read32(in + c) == read32(in + i);
+        if(not candidate)
+        {
+            i++;
+            continue;
+        }
+        std::size_t len = min_match;
+        while(i + len < n and in[c + len] == in[i + len])
+            len++;
+        put_sequence(out, in + anchor, i - anchor, len, i - c);
+        i += len;
+        anchor = i;
+    }
+    put_sequence(out, in + anchor, n - anchor, 0, 0);
+    return out;
+}
+
+inline bool get_length(const char*& p, const char* end, std::size_t& n)
+{
+    unsigned char b = 255;
+    while(b == 255)
+    {
+        if(p == end)
+            return false;
+        b = static_cast<unsigned char>(*p++);
+        n += b;
+    }
+    return true;
+}
+
+// Returns false on malformed input instead of reading or writing out of bounds
+inline bool decompress(const char* in, std::size_t n, char* out, std::size_t out_size)
+{
+    const char* p   = in;
+    const char* end = in + n;
+    std::size_t o   = 0;
+    while(p < end)
+    {
+        const auto token    = static_cast<unsigned char>(*p++);
+        std::size_t lit_len = token >> 4;
+        if(lit_len == 15 and not get_length(p, end, lit_len))
+            return false;
+        if(lit_len > std::size_t(end - p) or lit_len > out_size - o)
+            return false;
+        std::copy(p, p + lit_len, out + o);
+        p += lit_len;
+        o += lit_len;
+        if(p == end)
+            break;
+        if(end - p < 2)
+            return false;
+        const std::size_t offset = static_cast<unsigned char>(p[0]) |
+                                   (std::size_t(static_cast<unsigned char>(p[1])) << 8);
+        p += 2;
+        std::size_t len = token & 0xf;
+        if(len == 15 and not get_length(p, end, len))
+            return false;
+        len += min_match;
+        if(offset == 0 or offset > o or len > out_size - o)
+            return false;
+        // Overlapping matches repeat the last offset bytes; copying whole periods keeps runs fast
+        const std::size_t src = o - offset;
+        while(len > 0)
+        {
+            const std::size_t chunk = std::min(len, o - src);
+            std::copy(out + src, out + src + chunk, out + o);
+            o += chunk;
+            len -= chunk;
+        }
+    }
+    return o == out_size;
+}
+
+} // namespace lz
+
+// Read-only view of a whole file through mmap
+struct mapped_file
+{
+    mapped_file(const std::string& name)
+    {
+        const int fd = ::open(name.c_str(), O_RDONLY);
+        if(fd < 0)
+            return;
+        struct stat st;
+        if(::fstat(fd, &st) == 0 and st.st_size > 0)
+        {
+            void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p != MAP_FAILED)
+            {
+                data = static_cast<const char*>(p);
+                size = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    ~mapped_file()
+    {
+        if(data != nullptr)
+            ::munmap(const_cast<char*>(data), size);
+    }
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+// Lets serialize(std::istream&, ...) read straight out of a memory range
+struct memory_buf : std::streambuf
+{
+    memory_buf(const char* p, std::size_t n)
+    {
+        auto* b = const_cast<char*>(p);
+        setg(b, b, b + n);
+    }
+};
+
+// Lets serialize(std::ostream&, ...) append to a byte vector without an extra string copy
+struct vector_buf : std::streambuf
+{
+    std::vector<char> bytes;
+
+    protected:
+    int_type overflow(int_type c) override
+    {
+        if(c != traits_type::eof())
+            bytes.push_back(static_cast<char>(c));
+        return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        bytes.insert(bytes.end(), s, s + n);
+        return n;
+    }
+};
+
+// Returns false if the entry is missing, truncated, corrupt or from another format version; the
+// caller then recomputes the result.
+template <class T>
+bool load(const std::string& name, T& x)
+{
+    mapped_file f{name};
+    if(f.data == nullptr or f.size < sizeof(header))
+        return false;
+    header h;
+    std::memcpy(&h, f.data, sizeof(h));
+    if(not std::equal(magic, magic + sizeof(magic), h.magic) or h.version != format_version or
+       f.size != sizeof(header) + h.stored_size)
+        return false;
+    const char* payload = f.data + sizeof(header);
+    if(checksum(payload, h.stored_size) != h.checksum)
+        return false;
+
+    // Scratch buffers are left uninitialized; they are fully overwritten before use
+    std::unique_ptr<char[]> raw;
+    if((h.flags & flag_compressed) != 0)
+    {
+        std::unique_ptr<char[]> shuffled{new char[h.raw_size]};
+        if(not lz::decompress(payload, h.stored_size, shuffled.get(), h.raw_size))
+            return false;
+        raw.reset(new char[h.raw_size]);
+        unshuffle(shuffled.get(), raw.get(), h.raw_size);
+        payload = raw.get();
+    }
+    else if(h.raw_size != h.stored_size)
+    {
+        return false;
+    }
+
+    memory_buf buf{payload, h.raw_size};
+    std::istream is{&buf};
+    serialize(is, x);
+    return not is.fail();
+}
+
+// Writes to a temporary file first and renames it into place, so concurrent test processes never
+// observe a partially written entry.
+template <class T>
+void save(const std::string& name, const T& x, std::size_t compress_threshold)
+{
+    vector_buf buf;
+    {
+        std::ostream os{&buf};
+        serialize(os, x);
+    }
+    const auto& raw = buf.bytes;
+
+    header h{};
+    std::copy(magic, magic + sizeof(magic), h.magic);
+    h.version  = format_version;
+    h.raw_size = raw.size();
+
+    std::vector<char> packed;
+    if(compress_threshold > 0 and raw.size() >= compress_threshold)
+    {
+        std::vector<char> shuffled(raw.size());
+        shuffle(raw.data(), shuffled.data(), raw.size());
+        packed = lz::compress(shuffled.data(), shuffled.size());
+        if(packed.size() < raw.size())
+            h.flags |= flag_compressed;
+    }
+    const auto& stored = (h.flags & flag_compressed) != 0 ? packed : raw;
+    h.stored_size      = stored.size();
+    h.checksum         = checksum(stored.data(), stored.size());
+
+    const boost::filesystem::path target{name};
+    const auto tmp = target.parent_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+    {
+        std::ofstream os{tmp.string(), std::ios::binary};
+        os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        os.write(stored.data(), stored.size());
+        if(not os)
+        {
+            os.close();
+            boost::system::error_code ec;
+            boost::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp, target, ec);
+    if(ec)
+        boost::filesystem::remove(tmp, ec);
+}
+
+// Marks an entry as recently used for eviction purposes
+inline void touch(const std::string& name)
+{
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time(name, std::time(nullptr), ec);
+}
+
+// Removes least recently used entries until the directory fits in limit bytes; 0 means unbounded.
+// Errors are ignored since another process may be evicting the same entries.
+inline void evict(const boost::filesystem::path& dir, std::size_t limit)
+{
+    if(limit == 0)
+        return;
+    std::vector<std::tuple<std::time_t, std::size_t, boost::filesystem::path>> entries;
+    std::size_t total = 0;
+    boost::system::error_code ec;
+    for(boost::filesystem::directory_iterator it{dir, ec}, end; not ec and it != end;
+        it.increment(ec))
+    {
+        if(not boost::filesystem::is_regular_file(it->status(ec)))
+        {
+            ec.clear();
+            continue;
+        }
+        const auto size = boost::filesystem::file_size(it->path(), ec);
+        const auto time = boost::filesystem::last_write_time(it->path(), ec);
+        if(ec)
+        {
+            ec.clear();
+            continue;
+        }
+        entries.emplace_back(time, size, it->path());
+        total += size;
+    }
+    std::sort(entries.begin(), entries.end());
+    for(auto&& e : entries)
+    {
+        if(total <= limit)
+            break;
+        boost::filesystem::remove(std::get<2>(e), ec);
+        total -= std::get<1>(e);
+    }
+}
+
+} // namespace verify_cache
+
+#endif